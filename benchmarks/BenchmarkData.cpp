@@ -0,0 +1,246 @@
+#include "BenchmarkData.h"
+#include <fstream>
+#include <sstream>
+
+#if defined(__GRT_WINDOWS_BUILD__)
+    #include <windows.h>
+#else
+    #include <dirent.h>
+#endif
+
+//The gesture names, in the order ofApp adds them to each sample
+static const char* gestureNames[] = {
+    "mouthWidth",
+    "mouthHeight",
+    "leftEyebrowHeight",
+    "rightEyebrowHeight",
+    "leftEyeOpenness",
+    "rightEyeOpenness",
+    "jawOpenness",
+    "nostrilFlare"
+};
+
+static const UINT gestureCount = 8;
+
+static vector< string > listJSONFiles(const string &directory){
+
+    vector< string > files;
+
+#if defined(__GRT_WINDOWS_BUILD__)
+    WIN32_FIND_DATAA findData;
+    HANDLE handle = FindFirstFileA( (directory + "\\*.json").c_str(), &findData );
+    if( handle != INVALID_HANDLE_VALUE ){
+        do{
+            files.push_back( findData.cFileName );
+        }while( FindNextFileA( handle, &findData ) );
+        FindClose( handle );
+    }
+#else
+    DIR *dir = opendir( directory.c_str() );
+    if( dir != NULL ){
+        struct dirent *entry = NULL;
+        while( (entry = readdir( dir )) != NULL ){
+            const string name = entry->d_name;
+            if( name.size() > 5 && name.compare( name.size()-5, 5, ".json" ) == 0 ){
+                files.push_back( name );
+            }
+        }
+        closedir( dir );
+    }
+#endif
+
+    //ofDirectory sorts the files by name, so sort them here to get the same class labels
+    std::sort( files.begin(), files.end() );
+
+    return files;
+}
+
+bool BenchmarkData::loadGestureVectors(const string &directory,ClassificationData &data){
+
+    data.clear();
+    data.setNumDimensions( gestureCount );
+    data.setDatasetName( "gestureVectors" );
+
+    const vector< string > files = listJSONFiles( directory );
+
+    for(UINT i=0; i<files.size(); i++){
+        std::ifstream file( (directory + "/" + files[i]).c_str() );
+        if( !file.is_open() ) continue;
+
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        const string json = buffer.str();
+
+        VectorDouble sample( gestureCount );
+        bool parsed = true;
+        for(UINT j=0; j<gestureCount; j++){
+            if( !parseJSONNumber( json, gestureNames[j], sample[j] ) ){
+                parsed = false;
+                break;
+            }
+        }
+
+        if( parsed ) data.addSample( i+1, sample );
+    }
+
+    return data.getNumSamples() > 0;
+}
+
+ClassificationData BenchmarkData::createNoisyCopies(const ClassificationData &recordedData,const UINT numSamplesPerRecording,const double noiseLevel,Random &random){
+
+    const UINT N = recordedData.getNumDimensions();
+    const vector< MinMax > ranges = recordedData.getRanges();
+
+    ClassificationData data;
+    data.setNumDimensions( N );
+    data.setDatasetName( recordedData.getDatasetName() );
+
+    VectorDouble sample( N );
+    for(UINT i=0; i<recordedData.getNumSamples(); i++){
+        const UINT classLabel = recordedData[i].getClassLabel();
+        for(UINT n=0; n<numSamplesPerRecording; n++){
+            for(UINT j=0; j<N; j++){
+                const double range = ranges[j].maxValue - ranges[j].minValue;
+                sample[j] = recordedData[i][j] + random.getRandomNumberGauss( 0, noiseLevel * (range > 0 ? range : 1) );
+            }
+            data.addSample( classLabel, sample );
+        }
+    }
+
+    return data;
+}
+
+ClassificationData BenchmarkData::createClassificationData(const UINT numClasses,const UINT numSamplesPerClass,const UINT numDimensions,Random &random){
+
+    ClassificationData data;
+    data.setNumDimensions( numDimensions );
+    data.setDatasetName( "randomClusters" );
+
+    for(UINT k=0; k<numClasses; k++){
+        const VectorDouble center = random.getRandomVectorUniform( numDimensions, -10, 10 );
+        const double sigma = random.getRandomNumberUniform( 0.5, 2.0 );
+        VectorDouble sample( numDimensions );
+        for(UINT i=0; i<numSamplesPerClass; i++){
+            for(UINT j=0; j<numDimensions; j++){
+                sample[j] = center[j] + random.getRandomNumberGauss( 0, sigma );
+            }
+            data.addSample( k+1, sample );
+        }
+    }
+
+    return data;
+}
+
+RegressionData BenchmarkData::createRegressionData(const UINT numSamples,const UINT numInputDimensions,const UINT numTargetDimensions,Random &random){
+
+    RegressionData data;
+    data.setInputAndTargetDimensions( numInputDimensions, numTargetDimensions );
+    data.setDatasetName( "randomRegression" );
+
+    //Each target is a sigmoid of a random weighted sum of the inputs plus a sine term
+    MatrixDouble weights( numTargetDimensions, numInputDimensions );
+    for(UINT k=0; k<numTargetDimensions; k++){
+        for(UINT j=0; j<numInputDimensions; j++){
+            weights[k][j] = random.getRandomNumberUniform( -1, 1 );
+        }
+    }
+
+    VectorDouble input( numInputDimensions );
+    VectorDouble target( numTargetDimensions );
+    for(UINT i=0; i<numSamples; i++){
+        for(UINT j=0; j<numInputDimensions; j++){
+            input[j] = random.getRandomNumberUniform( -1, 1 );
+        }
+        for(UINT k=0; k<numTargetDimensions; k++){
+            double sum = 0;
+            for(UINT j=0; j<numInputDimensions; j++){
+                sum += weights[k][j] * input[j];
+            }
+            sum += 0.5 * sin( PI * input[ k % numInputDimensions ] ) + random.getRandomNumberGauss( 0, 0.05 );
+            target[k] = 1.0 / (1.0 + exp( -sum ));
+        }
+        data.addSample( input, target );
+    }
+
+    return data;
+}
+
+TimeSeriesClassificationData BenchmarkData::createTimeSeriesData(const UINT numClasses,const UINT numSamplesPerClass,const UINT length,const UINT numDimensions,Random &random){
+
+    TimeSeriesClassificationData data;
+    data.setNumDimensions( numDimensions );
+    data.setDatasetName( "sineTimeSeries" );
+
+    for(UINT k=0; k<numClasses; k++){
+        const VectorDouble frequency = random.getRandomVectorUniform( numDimensions, 0.5, 3.0 );
+        const VectorDouble phase = random.getRandomVectorUniform( numDimensions, 0, TWO_PI );
+        for(UINT i=0; i<numSamplesPerClass; i++){
+            const int lengthOffset = random.getRandomNumberInt( -(int)length/5, (int)length/5 + 1 );
+            const UINT M = (UINT)( (int)length + lengthOffset );
+            MatrixDouble timeseries( M, numDimensions );
+            for(UINT t=0; t<M; t++){
+                const double x = t / double(M);
+                for(UINT j=0; j<numDimensions; j++){
+                    timeseries[t][j] = sin( TWO_PI * frequency[j] * x + phase[j] ) + random.getRandomNumberGauss( 0, 0.1 );
+                }
+            }
+            data.addSample( k+1, timeseries );
+        }
+    }
+
+    return data;
+}
+
+TimeSeriesClassificationData BenchmarkData::createSymbolData(const UINT numClasses,const UINT numSamplesPerClass,const UINT length,const UINT numSymbols,Random &random){
+
+    TimeSeriesClassificationData data;
+    data.setNumDimensions( 1 );
+    data.setDatasetName( "symbolTimeSeries" );
+
+    for(UINT k=0; k<numClasses; k++){
+        const UINT step = 1 + k % (numSymbols-1 > 0 ? numSymbols-1 : 1);
+        for(UINT i=0; i<numSamplesPerClass; i++){
+            MatrixDouble timeseries( length, 1 );
+            UINT symbol = (UINT)random.getRandomNumberInt( 0, numSymbols );
+            for(UINT t=0; t<length; t++){
+                //Mostly follow the class step, with the occasional random symbol
+                if( random.getRandomNumberUniform() < 0.1 ) symbol = (UINT)random.getRandomNumberInt( 0, numSymbols );
+                else symbol = (symbol + step) % numSymbols;
+                timeseries[t][0] = symbol;
+            }
+            data.addSample( k+1, timeseries );
+        }
+    }
+
+    return data;
+}
+
+MatrixDouble BenchmarkData::createStream(const UINT numSamples,const UINT numDimensions,Random &random){
+
+    MatrixDouble stream( numSamples, numDimensions );
+
+    const VectorDouble frequency = random.getRandomVectorUniform( numDimensions, 0.001, 0.05 );
+    for(UINT i=0; i<numSamples; i++){
+        for(UINT j=0; j<numDimensions; j++){
+            stream[i][j] = sin( TWO_PI * frequency[j] * i ) + 0.5 * sin( TWO_PI * 4 * frequency[j] * i ) + random.getRandomNumberGauss( 0, 0.1 );
+        }
+    }
+
+    return stream;
+}
+
+bool BenchmarkData::parseJSONNumber(const string &json,const string &key,double &value){
+
+    //The gesture files are flat objects, so the value is the number after the first ':' that follows the quoted key
+    const size_t keyIndex = json.find( "\"" + key + "\"" );
+    if( keyIndex == string::npos ) return false;
+
+    const size_t colonIndex = json.find( ':', keyIndex + key.size() + 2 );
+    if( colonIndex == string::npos ) return false;
+
+    const char *start = json.c_str() + colonIndex + 1;
+    char *end = NULL;
+    value = strtod( start, &end );
+
+    return end != start;
+}
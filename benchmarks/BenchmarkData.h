@@ -0,0 +1,75 @@
+/**
+ @file
+ @brief The BenchmarkData class creates the datasets used by the GRT benchmarks: the 8 dimensional gesture vectors
+ recorded in the JSON files in bin/data/images, and synthetic classification, regression, time series and streaming data.
+
+ All the synthetic data is created from a seeded Random instance, so the same seed always gives the same datasets and
+ the results of two benchmark runs can be compared.
+ */
+
+#ifndef GRT_BENCHMARK_DATA_HEADER
+#define GRT_BENCHMARK_DATA_HEADER
+
+#include "GRT.h"
+
+using namespace GRT;
+
+class BenchmarkData{
+public:
+    /**
+     Loads the gesture vectors from each JSON file in the directory, in the same order and with the same class labels
+     (the index of the file + 1) as ofApp::setup().
+
+     @param const string &directory: the directory that contains the JSON files, e.g. bin/data/images
+     @param ClassificationData &data: the dataset the gesture vectors will be added to
+     @return returns true if at least one gesture vector was loaded, false otherwise
+     */
+    static bool loadGestureVectors(const string &directory,ClassificationData &data);
+
+    /**
+     Creates a larger dataset from a set of recorded samples by adding gaussian noise to each recorded sample. The noise
+     of each dimension is scaled by the range of that dimension in the recorded data.
+
+     @param const ClassificationData &recordedData: the recorded samples
+     @param const UINT numSamplesPerRecording: the number of noisy samples that will be created for each recorded sample
+     @param const double noiseLevel: the standard deviation of the noise, as a fraction of the range of each dimension
+     @param Random &random: the random generator
+     @return returns the new dataset
+     */
+    static ClassificationData createNoisyCopies(const ClassificationData &recordedData,const UINT numSamplesPerRecording,const double noiseLevel,Random &random);
+
+    /**
+     Creates a classification dataset with one gaussian cluster per class, the cluster centers are drawn uniformly from
+     [-10 10] in each dimension.
+     */
+    static ClassificationData createClassificationData(const UINT numClasses,const UINT numSamplesPerClass,const UINT numDimensions,Random &random);
+
+    /**
+     Creates a regression dataset where each target is a smooth nonlinear function of the inputs, squashed into [0 1]
+     so it can also be used by LogisticRegression.
+     */
+    static RegressionData createRegressionData(const UINT numSamples,const UINT numInputDimensions,const UINT numTargetDimensions,Random &random);
+
+    /**
+     Creates a time series dataset where each class is a set of sine waves with a class specific frequency and phase
+     in each dimension. The length of each time series varies by +/- 20% around the given length.
+     */
+    static TimeSeriesClassificationData createTimeSeriesData(const UINT numClasses,const UINT numSamplesPerClass,const UINT length,const UINT numDimensions,Random &random);
+
+    /**
+     Creates a 1 dimensional time series dataset of discrete symbols in the range [0 numSymbols-1], for the discrete HMM.
+     Each class walks through the symbols with a class specific step.
+     */
+    static TimeSeriesClassificationData createSymbolData(const UINT numClasses,const UINT numSamplesPerClass,const UINT length,const UINT numSymbols,Random &random);
+
+    /**
+     Creates a continuous stream of samples (one sample per row) made of a mix of sine waves and noise, used for the
+     filters and feature extraction modules.
+     */
+    static MatrixDouble createStream(const UINT numSamples,const UINT numDimensions,Random &random);
+
+protected:
+    static bool parseJSONNumber(const string &json,const string &key,double &value);
+};
+
+#endif //GRT_BENCHMARK_DATA_HEADER
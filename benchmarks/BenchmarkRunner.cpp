@@ -0,0 +1,216 @@
+#include "BenchmarkRunner.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+//A stream buffer that drops everything written to it, used to hide the output of the modules
+class BenchmarkNullBuffer : public std::streambuf{
+protected:
+    virtual int overflow(int c){ return traits_type::not_eof( c ); }
+};
+
+BenchmarkRunner::BenchmarkRunner(){
+    minTrainTime = 200;
+    maxTrainRepeats = 5;
+    minPredictions = 1000;
+    minPredictTime = 200;
+    maxPredictions = 1000000;
+    numWarmupPredictions = 10;
+    verbose = true;
+    showModuleOutput = false;
+}
+
+BenchmarkRunner::~BenchmarkRunner(){
+
+}
+
+bool BenchmarkRunner::run(const string &category,const string &name,const string &dataset,const UINT numInputDimensions,const UINT numTrainingSamples,BenchmarkTask &task){
+
+    if( !getShouldRun( category, name ) ) return false;
+
+    BenchmarkResult result;
+    result.category = category;
+    result.name = name;
+    result.dataset = dataset;
+    result.numInputDimensions = numInputDimensions;
+    result.numTrainingSamples = numTrainingSamples;
+    result.trainable = task.getTrainable();
+
+    BenchmarkNullBuffer nullBuffer;
+    std::streambuf *coutBuffer = NULL;
+    if( !showModuleOutput ) coutBuffer = std::cout.rdbuf( &nullBuffer );
+
+    //Train the module, repeating the training until it has taken at least minTrainTime
+    result.trainOk = true;
+    if( result.trainable ){
+        double totalTime = 0;
+        do{
+            const unsigned long long startTime = Timer::getHighResolutionTime();
+            const bool ok = task.train();
+            const double time = (Timer::getHighResolutionTime() - startTime) * 1.0e-6;
+            if( !ok ){
+                result.trainOk = false;
+                break;
+            }
+            totalTime += time;
+            if( result.numTrainRepeats == 0 || time < result.trainTimeMin ) result.trainTimeMin = time;
+            result.numTrainRepeats++;
+        }while( totalTime < minTrainTime && result.numTrainRepeats < maxTrainRepeats );
+
+        if( result.numTrainRepeats > 0 ) result.trainTimeMean = totalTime / result.numTrainRepeats;
+    }
+
+    //Run the predictions, cycling through the test samples
+    const UINT numTestSamples = task.getNumTestSamples();
+    if( result.trainOk && numTestSamples > 0 ){
+        result.predictOk = true;
+
+        UINT index = 0;
+        for(UINT i=0; i<numWarmupPredictions && result.predictOk; i++){
+            result.predictOk = task.predict( index );
+            if( ++index == numTestSamples ) index = 0;
+        }
+
+        unsigned long long totalTime = 0;
+        while( result.predictOk && result.numPredictions < maxPredictions && (result.numPredictions < minPredictions || totalTime*1.0e-6 < minPredictTime) ){
+            const unsigned long long startTime = Timer::getHighResolutionTime();
+            const bool ok = task.predict( index );
+            const unsigned long long time = Timer::getHighResolutionTime() - startTime;
+            if( !ok ){
+                result.predictOk = false;
+                break;
+            }
+            totalTime += time;
+            result.predictLatency.record( time );
+            result.numPredictions++;
+            if( ++index == numTestSamples ) index = 0;
+        }
+
+        result.predictTime = totalTime * 1.0e-6;
+        if( result.predictOk ) result.accuracy = task.getAccuracy();
+    }
+
+    if( coutBuffer != NULL ) std::cout.rdbuf( coutBuffer );
+
+    results.push_back( result );
+
+    if( verbose ) printResult( std::cout, result );
+
+    return true;
+}
+
+bool BenchmarkRunner::addDataset(const string &name,const UINT numSamples,const UINT numDimensions,const UINT numClasses,const string &source){
+    DatasetInfo info;
+    info.name = name;
+    info.numSamples = numSamples;
+    info.numDimensions = numDimensions;
+    info.numClasses = numClasses;
+    info.source = source;
+    datasets.push_back( info );
+    return true;
+}
+
+bool BenchmarkRunner::getShouldRun(const string &category,const string &name) const{
+    if( filter.empty() ) return true;
+    return (category + "/" + name).find( filter ) != string::npos;
+}
+
+string BenchmarkRunner::getJSON() const{
+
+    std::ostringstream stream;
+    stream << std::setprecision( 10 );
+
+    stream << "{\n";
+    stream << "  \"formatVersion\": 1,\n";
+    stream << "  \"metadata\": {";
+    for(UINT i=0; i<metadataKeys.size(); i++){
+        stream << (i > 0 ? ", " : "") << "\"" << escapeJSON( metadataKeys[i] ) << "\": \"" << escapeJSON( metadataValues[i] ) << "\"";
+    }
+    stream << "},\n";
+
+    stream << "  \"datasets\": [";
+    for(UINT i=0; i<datasets.size(); i++){
+        stream << (i > 0 ? "," : "") << "\n    {\"name\": \"" << escapeJSON( datasets[i].name ) << "\", \"numSamples\": " << datasets[i].numSamples;
+        stream << ", \"numDimensions\": " << datasets[i].numDimensions << ", \"numClasses\": " << datasets[i].numClasses;
+        stream << ", \"source\": \"" << escapeJSON( datasets[i].source ) << "\"}";
+    }
+    stream << "\n  ],\n";
+
+    stream << "  \"results\": [";
+    for(UINT i=0; i<results.size(); i++){
+        const BenchmarkResult &r = results[i];
+        stream << (i > 0 ? "," : "") << "\n    {\"category\": \"" << escapeJSON( r.category ) << "\", \"name\": \"" << escapeJSON( r.name ) << "\"";
+        stream << ", \"dataset\": \"" << escapeJSON( r.dataset ) << "\", \"numInputDimensions\": " << r.numInputDimensions;
+        stream << ", \"numTrainingSamples\": " << r.numTrainingSamples;
+        stream << ",\n     \"train\": ";
+        if( r.trainable ){
+            stream << "{\"ok\": " << (r.trainOk ? "true" : "false") << ", \"repeats\": " << r.numTrainRepeats;
+            stream << ", \"meanMs\": " << r.trainTimeMean << ", \"minMs\": " << r.trainTimeMin << "}";
+        }else stream << "null";
+        stream << ",\n     \"predict\": {\"ok\": " << (r.predictOk ? "true" : "false") << ", \"calls\": " << r.numPredictions;
+        stream << ", \"totalMs\": " << r.predictTime;
+        stream << ", \"throughputPerSec\": " << (r.predictTime > 0 ? r.numPredictions / (r.predictTime * 1.0e-3) : 0);
+        stream << ", \"latencyNs\": {\"mean\": " << r.predictLatency.getMean() << ", \"p50\": " << r.predictLatency.getPercentile(50);
+        stream << ", \"p90\": " << r.predictLatency.getPercentile(90) << ", \"p99\": " << r.predictLatency.getPercentile(99);
+        stream << ", \"p999\": " << r.predictLatency.getPercentile(99.9) << ", \"max\": " << r.predictLatency.getMaximum() << "}}";
+        stream << ",\n     \"accuracy\": ";
+        if( r.accuracy >= 0 ) stream << r.accuracy;
+        else stream << "null";
+        stream << "}";
+    }
+    stream << "\n  ]\n}\n";
+
+    return stream.str();
+}
+
+bool BenchmarkRunner::saveJSON(const string &filename) const{
+    std::ofstream file( filename.c_str() );
+    if( !file.is_open() ) return false;
+    file << getJSON();
+    file.close();
+    return true;
+}
+
+void BenchmarkRunner::printSummary(std::ostream &stream) const{
+    UINT numFailed = 0;
+    for(UINT i=0; i<results.size(); i++){
+        if( !results[i].trainOk || !results[i].predictOk ) numFailed++;
+    }
+    stream << "Ran " << results.size() << " benchmarks, " << numFailed << " could not be trained or run" << endl;
+    for(UINT i=0; i<results.size(); i++){
+        if( !results[i].trainOk || !results[i].predictOk ){
+            stream << "  " << results[i].category << "/" << results[i].name << " (" << results[i].dataset << "): ";
+            stream << (!results[i].trainOk ? "train failed" : "predict failed or not supported") << endl;
+        }
+    }
+}
+
+void BenchmarkRunner::printResult(std::ostream &stream,const BenchmarkResult &r) const{
+    std::ostringstream line;
+    line << std::fixed << std::setprecision( 2 );
+    line << std::left << std::setw( 18 ) << r.category << std::setw( 46 ) << r.name << std::setw( 22 ) << r.dataset;
+    if( r.trainable ){
+        if( r.trainOk ) line << " train " << std::setw( 10 ) << r.trainTimeMean << "ms";
+        else line << " train       FAILED";
+    }else line << "                    ";
+    if( r.predictOk ){
+        line << " predict " << std::setw( 10 ) << (r.predictTime > 0 ? r.numPredictions / (r.predictTime * 1.0e-3) : 0) << "/s";
+        line << " p50 " << std::setw( 9 ) << r.predictLatency.getPercentile(50) * 1.0e-3 << "us";
+        line << " p99 " << std::setw( 9 ) << r.predictLatency.getPercentile(99) * 1.0e-3 << "us";
+        if( r.accuracy >= 0 ) line << " acc " << r.accuracy;
+    }else if( r.trainOk ) line << " predict FAILED";
+    stream << line.str() << endl;
+}
+
+string BenchmarkRunner::escapeJSON(const string &value){
+    string escaped;
+    for(size_t i=0; i<value.size(); i++){
+        const char c = value[i];
+        if( c == '"' || c == '\\' ){
+            escaped += '\\';
+            escaped += c;
+        }else if( (unsigned char)c < 0x20 ) escaped += ' ';
+        else escaped += c;
+    }
+    return escaped;
+}
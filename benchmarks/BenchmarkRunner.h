@@ -0,0 +1,147 @@
+/**
+ @file
+ @brief The BenchmarkRunner class times the training and prediction of a module, and writes the results as JSON so that
+ the results of two builds can be compared.
+
+ Each module is wrapped in a BenchmarkTask. The runner calls BenchmarkTask::train() until it has spent at least the
+ minimum training time (or reached the maximum number of repeats), then calls BenchmarkTask::predict() for each test
+ sample in turn until it has made at least the minimum number of predictions and spent at least the minimum prediction
+ time. Each prediction is timed on its own with Timer::getHighResolutionTime() and counted in a LatencyHistogram, so
+ the results include the tail latency as well as the throughput.
+ */
+
+#ifndef GRT_BENCHMARK_RUNNER_HEADER
+#define GRT_BENCHMARK_RUNNER_HEADER
+
+#include "GRT.h"
+
+using namespace GRT;
+
+/**
+ The interface between the runner and a module. train() is timed as one call, predict() is timed per test sample.
+ */
+class BenchmarkTask{
+public:
+    BenchmarkTask(){}
+    virtual ~BenchmarkTask(){}
+
+    /**
+     Trains the module. Tasks for modules that do not need training should return true without doing anything.
+     */
+    virtual bool train(){ return true; }
+
+    /**
+     Returns true if train() does any work, so the train time is only reported for modules that are trained.
+     */
+    virtual bool getTrainable() const{ return false; }
+
+    /**
+     Runs the module on the test sample at the index, which is always in the range [0 getNumTestSamples()-1].
+     */
+    virtual bool predict(const UINT index) = 0;
+
+    virtual UINT getNumTestSamples() const = 0;
+
+    /**
+     Gets the accuracy of the predictions made so far, in the range [0 1], or a negative value if the task does not
+     have an accuracy.
+     */
+    virtual double getAccuracy() const{ return -1; }
+};
+
+class BenchmarkResult{
+public:
+    BenchmarkResult(){
+        numInputDimensions = 0;
+        numTrainingSamples = 0;
+        trainable = false;
+        trainOk = false;
+        numTrainRepeats = 0;
+        trainTimeMean = 0;
+        trainTimeMin = 0;
+        predictOk = false;
+        numPredictions = 0;
+        predictTime = 0;
+        accuracy = -1;
+    }
+
+    string category;                    ///< The type of module, e.g. classifier, regressifier, filter
+    string name;                        ///< The name of the module, plus any options that were used
+    string dataset;                     ///< The name of the dataset the module was run on
+    UINT numInputDimensions;
+    UINT numTrainingSamples;
+    bool trainable;
+    bool trainOk;
+    UINT numTrainRepeats;
+    double trainTimeMean;               ///< The mean time of one call to train, in milliseconds
+    double trainTimeMin;                ///< The fastest call to train, in milliseconds
+    bool predictOk;
+    unsigned long long numPredictions;
+    double predictTime;                 ///< The total time spent in predict, in milliseconds
+    LatencyHistogram predictLatency;    ///< The time of each prediction, in nanoseconds
+    double accuracy;
+};
+
+class BenchmarkRunner{
+public:
+    BenchmarkRunner();
+    ~BenchmarkRunner();
+
+    /**
+     Runs the task and stores the result, unless the name does not match the filter.
+
+     @param const string &category: the type of module
+     @param const string &name: the name of the module
+     @param const string &dataset: the name of the dataset
+     @param const UINT numInputDimensions: the number of input dimensions of the dataset
+     @param const UINT numTrainingSamples: the number of training samples, or zero if the module is not trained
+     @param BenchmarkTask &task: the task that trains and runs the module
+     @return returns true if the task was run, false if it was filtered out
+     */
+    bool run(const string &category,const string &name,const string &dataset,const UINT numInputDimensions,const UINT numTrainingSamples,BenchmarkTask &task);
+
+    /**
+     Adds a dataset to the list of datasets written with the results.
+     */
+    bool addDataset(const string &name,const UINT numSamples,const UINT numDimensions,const UINT numClasses,const string &source);
+
+    /**
+     Returns true if a benchmark with this name and category would be run with the current filter.
+     */
+    bool getShouldRun(const string &category,const string &name) const;
+
+    string getJSON() const;
+    bool saveJSON(const string &filename) const;
+    void printSummary(std::ostream &stream) const;
+    void printResult(std::ostream &stream,const BenchmarkResult &result) const;
+
+    const vector< BenchmarkResult >& getResults() const{ return results; }
+
+    static string escapeJSON(const string &value);
+
+    double minTrainTime;                ///< Train is repeated until it has taken at least this long, in milliseconds
+    UINT maxTrainRepeats;
+    unsigned long long minPredictions;
+    double minPredictTime;              ///< Predict is repeated until it has taken at least this long, in milliseconds
+    unsigned long long maxPredictions;
+    UINT numWarmupPredictions;
+    string filter;                      ///< Only benchmarks whose category/name contains this string are run
+    bool verbose;                       ///< If true, each result is printed as soon as it is run
+    bool showModuleOutput;              ///< If false, anything the modules write to std::cout is hidden while they run
+    vector< string > metadataKeys;
+    vector< string > metadataValues;
+
+protected:
+    struct DatasetInfo{
+        string name;
+        UINT numSamples;
+        UINT numDimensions;
+        UINT numClasses;
+        string source;
+    };
+
+    vector< DatasetInfo > datasets;
+    vector< BenchmarkResult > results;
+};
+
+#endif //GRT_BENCHMARK_RUNNER_HEADER
@@ -0,0 +1,528 @@
+/**
+ @file
+ @brief A headless benchmark of the GRT modules. It does not need openFrameworks, a camera or a window.
+
+ The benchmark times the training and prediction of every classifier, regressifier, clusterer, pre processing filter,
+ feature extraction module and post processing module in the GRT, and a few complete GestureRecognitionPipelines (the
+ macro benchmarks), on these workloads:
+ - gestureVectors: the 8 dimensional gesture vectors recorded in the JSON files in bin/data/images, with gaussian noise added to
+   create the training and test sets
+ - randomClusters: a large random classification dataset with one gaussian cluster per class
+ - randomRegression: a large random regression dataset
+ - sineTimeSeries and symbolTimeSeries: time series classification datasets for DTW and the discrete HMM
+ - stream: a continuous multi-dimensional stream for the filters and feature extraction modules
+
+ The results are printed as they are run and written as JSON to the output file, so they can be compared between
+ builds. Run with --help to see the options.
+ */
+
+#include "BenchmarkData.h"
+#include "BenchmarkRunner.h"
+#include <ctime>
+
+//--------------------------------------------------------------
+//The tasks that connect each type of module to the runner
+
+class ClassifierTask : public BenchmarkTask{
+public:
+    ClassifierTask(Classifier &classifier,const ClassificationData &trainingData,const ClassificationData &testData):classifier(classifier),trainingData(trainingData){
+        for(UINT i=0; i<testData.getNumSamples(); i++){
+            testSamples.push_back( testData[i].getSample() );
+            testLabels.push_back( testData[i].getClassLabel() );
+        }
+        numCorrect = 0;
+        numPredictions = 0;
+    }
+    virtual bool train(){ return classifier.train( trainingData ); }
+    virtual bool getTrainable() const{ return true; }
+    virtual bool predict(const UINT index){
+        if( !classifier.predict( testSamples[index] ) ) return false;
+        if( classifier.getPredictedClassLabel() == testLabels[index] ) numCorrect++;
+        numPredictions++;
+        return true;
+    }
+    virtual UINT getNumTestSamples() const{ return (UINT)testSamples.size(); }
+    virtual double getAccuracy() const{ return numPredictions > 0 ? numCorrect / double(numPredictions) : -1; }
+
+protected:
+    Classifier &classifier;
+    const ClassificationData &trainingData;
+    vector< VectorDouble > testSamples;
+    vector< UINT > testLabels;
+    unsigned long long numCorrect;
+    unsigned long long numPredictions;
+};
+
+class TimeSeriesClassifierTask : public BenchmarkTask{
+public:
+    TimeSeriesClassifierTask(Classifier &classifier,const TimeSeriesClassificationData &trainingData,const TimeSeriesClassificationData &testData):classifier(classifier),trainingData(trainingData),testData(testData){
+        numCorrect = 0;
+        numPredictions = 0;
+    }
+    virtual bool train(){ return classifier.train( trainingData ); }
+    virtual bool getTrainable() const{ return true; }
+    virtual bool predict(const UINT index){
+        if( !classifier.predict( testData[index].getData() ) ) return false;
+        if( classifier.getPredictedClassLabel() == testData[index].getClassLabel() ) numCorrect++;
+        numPredictions++;
+        return true;
+    }
+    virtual UINT getNumTestSamples() const{ return testData.getNumSamples(); }
+    virtual double getAccuracy() const{ return numPredictions > 0 ? numCorrect / double(numPredictions) : -1; }
+
+protected:
+    Classifier &classifier;
+    const TimeSeriesClassificationData &trainingData;
+    const TimeSeriesClassificationData &testData;
+    unsigned long long numCorrect;
+    unsigned long long numPredictions;
+};
+
+class RegressifierTask : public BenchmarkTask{
+public:
+    RegressifierTask(Regressifier &regressifier,const RegressionData &trainingData,const RegressionData &testData):regressifier(regressifier),trainingData(trainingData),testData(testData){}
+    virtual bool train(){ return regressifier.train( trainingData ); }
+    virtual bool getTrainable() const{ return true; }
+    virtual bool predict(const UINT index){ return regressifier.predict( testData[index].getInputVector() ); }
+    virtual UINT getNumTestSamples() const{ return testData.getNumSamples(); }
+
+protected:
+    Regressifier &regressifier;
+    const RegressionData &trainingData;
+    const RegressionData &testData;
+};
+
+class ClustererTask : public BenchmarkTask{
+public:
+    ClustererTask(Clusterer &clusterer,const ClassificationData &trainingData,const MatrixDouble &testData):clusterer(clusterer),trainingData(trainingData){
+        for(UINT i=0; i<testData.getNumRows(); i++){
+            testSamples.push_back( testData.getRowVector(i) );
+        }
+    }
+    virtual bool train(){ return clusterer.train( trainingData ); }
+    virtual bool getTrainable() const{ return true; }
+    virtual bool predict(const UINT index){ return clusterer.predict( testSamples[index] ); }
+    virtual UINT getNumTestSamples() const{ return (UINT)testSamples.size(); }
+
+protected:
+    Clusterer &clusterer;
+    const ClassificationData &trainingData;
+    vector< VectorDouble > testSamples;
+};
+
+class PreProcessingTask : public BenchmarkTask{
+public:
+    PreProcessingTask(PreProcessing &preProcessing,const MatrixDouble &stream):preProcessing(preProcessing){
+        for(UINT i=0; i<stream.getNumRows(); i++){
+            samples.push_back( stream.getRowVector(i) );
+        }
+    }
+    virtual bool predict(const UINT index){ return preProcessing.process( samples[index] ); }
+    virtual UINT getNumTestSamples() const{ return (UINT)samples.size(); }
+
+protected:
+    PreProcessing &preProcessing;
+    vector< VectorDouble > samples;
+};
+
+class FeatureExtractionTask : public BenchmarkTask{
+public:
+    FeatureExtractionTask(FeatureExtraction &featureExtraction,const MatrixDouble &stream,const ClassificationData *trainingData = NULL):featureExtraction(featureExtraction),trainingData(trainingData){
+        for(UINT i=0; i<stream.getNumRows(); i++){
+            samples.push_back( stream.getRowVector(i) );
+        }
+    }
+    virtual bool train(){ return trainingData == NULL || featureExtraction.train( *trainingData ); }
+    virtual bool getTrainable() const{ return trainingData != NULL; }
+    virtual bool predict(const UINT index){ return featureExtraction.computeFeatures( samples[index] ); }
+    virtual UINT getNumTestSamples() const{ return (UINT)samples.size(); }
+
+protected:
+    FeatureExtraction &featureExtraction;
+    const ClassificationData *trainingData;
+    vector< VectorDouble > samples;
+};
+
+class PostProcessingTask : public BenchmarkTask{
+public:
+    PostProcessingTask(PostProcessing &postProcessing,const vector< UINT > &labels):postProcessing(postProcessing){
+        for(UINT i=0; i<labels.size(); i++){
+            samples.push_back( VectorDouble(1,labels[i]) );
+        }
+    }
+    virtual bool predict(const UINT index){ return postProcessing.process( samples[index] ); }
+    virtual UINT getNumTestSamples() const{ return (UINT)samples.size(); }
+
+protected:
+    PostProcessing &postProcessing;
+    vector< VectorDouble > samples;
+};
+
+class PipelineTask : public BenchmarkTask{
+public:
+    PipelineTask(GestureRecognitionPipeline &pipeline,const ClassificationData *trainingData,const ClassificationData &testData):pipeline(pipeline),trainingData(trainingData){
+        for(UINT i=0; i<testData.getNumSamples(); i++){
+            testSamples.push_back( testData[i].getSample() );
+            testLabels.push_back( testData[i].getClassLabel() );
+        }
+        numCorrect = 0;
+        numPredictions = 0;
+    }
+    virtual bool train(){ return trainingData == NULL || pipeline.train( *trainingData ); }
+    virtual bool getTrainable() const{ return trainingData != NULL; }
+    virtual bool predict(const UINT index){
+        if( !pipeline.predict( testSamples[index] ) ) return false;
+        if( pipeline.getPredictedClassLabel() == testLabels[index] ) numCorrect++;
+        numPredictions++;
+        return true;
+    }
+    virtual UINT getNumTestSamples() const{ return pipeline.getTrained() ? (UINT)testSamples.size() : 0; }
+    virtual double getAccuracy() const{ return numPredictions > 0 ? numCorrect / double(numPredictions) : -1; }
+
+protected:
+    GestureRecognitionPipeline &pipeline;
+    const ClassificationData *trainingData;
+    vector< VectorDouble > testSamples;
+    vector< UINT > testLabels;
+    unsigned long long numCorrect;
+    unsigned long long numPredictions;
+};
+
+//--------------------------------------------------------------
+//The benchmark suites
+
+static void runClassifiers(BenchmarkRunner &runner,const ClassificationData &trainingData,const ClassificationData &testData){
+
+    const string dataset = trainingData.getDatasetName();
+    const UINT N = trainingData.getNumDimensions();
+    const UINT M = trainingData.getNumSamples();
+
+    { ANBC c; ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "ANBC", dataset, N, M, t ); }
+    { AdaBoost c; ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "AdaBoost", dataset, N, M, t ); }
+    {
+        BAG c;
+        c.addClassifierToEnsemble( KNN(5) );
+        c.addClassifierToEnsemble( MinDist( false, false, 10, 3 ) );
+        c.addClassifierToEnsemble( ANBC() );
+        ClassifierTask t( c, trainingData, testData );
+        runner.run( "classifier", "BAG(KNN,MinDist,ANBC)", dataset, N, M, t );
+    }
+    { DecisionTree c; ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "DecisionTree", dataset, N, M, t ); }
+    { FiniteStateMachine c( 200, 5 ); ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "FiniteStateMachine(5 clusters)", dataset, N, M, t ); }
+    { GMM c; ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "GMM", dataset, N, M, t ); }
+    { KNN c(1); ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "KNN(K=1)", dataset, N, M, t ); }
+    { KNN c(10); ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "KNN(K=10)", dataset, N, M, t ); }
+    {
+        KNN c(10);
+        c.enableBestKValueSearch( true );
+        c.setMinKSearchValue( 1 );
+        c.setMaxKSearchValue( 10 );
+        ClassifierTask t( c, trainingData, testData );
+        runner.run( "classifier", "KNN(searchK=1-10)", dataset, N, M, t );
+    }
+    { LDA c; ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "LDA", dataset, N, M, t ); }
+    { MinDist c; ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "MinDist", dataset, N, M, t ); }
+    { RandomForests c; ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "RandomForests", dataset, N, M, t ); }
+    { SVM c( SVM::LINEAR_KERNEL ); ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "SVM(linear)", dataset, N, M, t ); }
+    { SVM c( SVM::RBF_KERNEL ); ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "SVM(rbf)", dataset, N, M, t ); }
+    { Softmax c; ClassifierTask t( c, trainingData, testData ); runner.run( "classifier", "Softmax", dataset, N, M, t ); }
+}
+
+static void runTimeSeriesClassifiers(BenchmarkRunner &runner,const TimeSeriesClassificationData &trainingData,const TimeSeriesClassificationData &testData,const TimeSeriesClassificationData &symbolTrainingData,const TimeSeriesClassificationData &symbolTestData){
+
+    {
+        DTW c;
+        TimeSeriesClassifierTask t( c, trainingData, testData );
+        runner.run( "classifier", "DTW", trainingData.getDatasetName(), trainingData.getNumDimensions(), trainingData.getNumSamples(), t );
+    }
+    {
+        HMM c( 5, 10, HiddenMarkovModel::LEFTRIGHT );
+        TimeSeriesClassifierTask t( c, symbolTrainingData, symbolTestData );
+        runner.run( "classifier", "HMM(discrete)", symbolTrainingData.getDatasetName(), symbolTrainingData.getNumDimensions(), symbolTrainingData.getNumSamples(), t );
+    }
+}
+
+static void runRegressifiers(BenchmarkRunner &runner,const RegressionData &trainingData,const RegressionData &testData,const RegressionData &multiTrainingData,const RegressionData &multiTestData){
+
+    const string dataset = trainingData.getDatasetName();
+    const UINT N = trainingData.getNumInputDimensions();
+    const UINT M = trainingData.getNumSamples();
+
+    { LinearRegression r; RegressifierTask t( r, trainingData, testData ); runner.run( "regressifier", "LinearRegression", dataset, N, M, t ); }
+    { LogisticRegression r; RegressifierTask t( r, trainingData, testData ); runner.run( "regressifier", "LogisticRegression", dataset, N, M, t ); }
+    {
+        MLP r;
+        r.init( N, 10, trainingData.getNumTargetDimensions() );
+        RegressifierTask t( r, trainingData, testData );
+        runner.run( "regressifier", "MLP(hidden=10)", dataset, N, M, t );
+    }
+    { RegressionTree r; RegressifierTask t( r, trainingData, testData ); runner.run( "regressifier", "RegressionTree", dataset, N, M, t ); }
+    {
+        MultidimensionalRegression r( LinearRegression(), true );
+        RegressifierTask t( r, multiTrainingData, multiTestData );
+        runner.run( "regressifier", "MultidimensionalRegression(LinearRegression)", multiTrainingData.getDatasetName(), N, multiTrainingData.getNumSamples(), t );
+    }
+}
+
+static void runClusterers(BenchmarkRunner &runner,const ClassificationData &trainingData,const ClassificationData &smallTrainingData){
+
+    //The clusterers are run on the training data, as ClusterTree can only predict the regions that contain training samples
+    const MatrixDouble test = trainingData.getDataAsMatrixDouble();
+    const string dataset = trainingData.getDatasetName();
+    const UINT N = trainingData.getNumDimensions();
+    const UINT M = trainingData.getNumSamples();
+    const UINT K = trainingData.getNumClasses();
+
+    { KMeans c( K ); ClustererTask t( c, trainingData, test ); runner.run( "clusterer", "KMeans", dataset, N, M, t ); }
+    { GaussianMixtureModels c( K ); ClustererTask t( c, trainingData, test ); runner.run( "clusterer", "GaussianMixtureModels", dataset, N, M, t ); }
+    { ClusterTree c; ClustererTask t( c, trainingData, test ); runner.run( "clusterer", "ClusterTree", dataset, N, M, t ); }
+    { SelfOrganizingMap c( 20, SelfOrganizingMap::RANDOM_NETWORK, 100 ); ClustererTask t( c, trainingData, test ); runner.run( "clusterer", "SelfOrganizingMap", dataset, N, M, t ); }
+
+    //Hierarchical clustering is O(M^3), so it is run on a subset of the data
+    { HierarchicalClustering c; ClustererTask t( c, smallTrainingData, smallTrainingData.getDataAsMatrixDouble() ); runner.run( "clusterer", "HierarchicalClustering", smallTrainingData.getDatasetName(), N, smallTrainingData.getNumSamples(), t ); }
+}
+
+static void runPreProcessing(BenchmarkRunner &runner,const MatrixDouble &stream){
+
+    const UINT D = stream.getNumCols();
+    const string dataset = "stream";
+
+    { DeadZone m( -0.1, 0.1, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "DeadZone", dataset, D, 0, t ); }
+    { Derivative m( Derivative::FIRST_DERIVATIVE, 1, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "Derivative", dataset, D, 0, t ); }
+    { DoubleMovingAverageFilter m( 5, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "DoubleMovingAverageFilter(5)", dataset, D, 0, t ); }
+    {
+        //The LowPassFilter -> Derivative -> HighPassFilter chain as fused by GestureRecognitionPipeline::fusePreProcessingModules
+        FilterCascade m( D );
+        LowPassFilter( 0.1, 1, D ).appendToFilterCascade( m );
+        Derivative( Derivative::FIRST_DERIVATIVE, 1, D ).appendToFilterCascade( m );
+        HighPassFilter( 0.1, 1, D ).appendToFilterCascade( m );
+        PreProcessingTask t( m, stream ); runner.run( "preprocessing", "FilterCascade(LPF,Derivative,HPF)", dataset, D, 0, t );
+    }
+    { FIRFilter m( FIRFilter::LPF, 50, 100, 10, 1, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "FIRFilter(50 taps)", dataset, D, 0, t ); }
+    { FIRFilter m( FIRFilter::LPF, 256, 100, 10, 1, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "FIRFilter(256 taps)", dataset, D, 0, t ); }
+    { HighPassFilter m( 0.1, 1, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "HighPassFilter", dataset, D, 0, t ); }
+    { LowPassFilter m( 0.1, 1, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "LowPassFilter", dataset, D, 0, t ); }
+    { MedianFilter m( 5, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "MedianFilter(5)", dataset, D, 0, t ); }
+    { MedianFilter m( 51, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "MedianFilter(51)", dataset, D, 0, t ); }
+    { MovingAverageFilter m( 5, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "MovingAverageFilter(5)", dataset, D, 0, t ); }
+    { MovingAverageFilter m( 100, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "MovingAverageFilter(100)", dataset, D, 0, t ); }
+    { PercentileFilter m( 5, 90, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "PercentileFilter(5)", dataset, D, 0, t ); }
+    { SavitzkyGolayFilter m( 10, 10, 0, 2, D ); PreProcessingTask t( m, stream ); runner.run( "preprocessing", "SavitzkyGolayFilter(10,10)", dataset, D, 0, t ); }
+}
+
+static void runFeatureExtraction(BenchmarkRunner &runner,const MatrixDouble &stream,const MatrixDouble &spectrum,const ClassificationData &trainingData,const ClassificationData &testData){
+
+    const UINT D = stream.getNumCols();
+    const string dataset = "stream";
+
+    { FFT m( 256, 1, D, FFT::RECTANGULAR_WINDOW, true, false ); FeatureExtractionTask t( m, stream ); runner.run( "featureextraction", "FFT(256,hop=1)", dataset, D, 0, t ); }
+    { FFT m( 256, 16, D, FFT::HAMMING_WINDOW, true, false ); FeatureExtractionTask t( m, stream ); runner.run( "featureextraction", "FFT(256,hop=16)", dataset, D, 0, t ); }
+    { FFTFeatures m( spectrum.getNumCols(), 1 ); FeatureExtractionTask t( m, spectrum ); runner.run( "featureextraction", "FFTFeatures", "spectrum", spectrum.getNumCols(), 0, t ); }
+    { MovementIndex m( 100, D ); FeatureExtractionTask t( m, stream ); runner.run( "featureextraction", "MovementIndex(100)", dataset, D, 0, t ); }
+    { MovementTrajectoryFeatures m( 100, 10, MovementTrajectoryFeatures::CENTROID_VALUE, 10, D ); FeatureExtractionTask t( m, stream ); runner.run( "featureextraction", "MovementTrajectoryFeatures", dataset, D, 0, t ); }
+    { TimeDomainFeatures m( 100, 10, D ); FeatureExtractionTask t( m, stream ); runner.run( "featureextraction", "TimeDomainFeatures(100,10)", dataset, D, 0, t ); }
+    { TimeseriesBuffer m( 20, D ); FeatureExtractionTask t( m, stream ); runner.run( "featureextraction", "TimeseriesBuffer(20)", dataset, D, 0, t ); }
+    { ZeroCrossingCounter m( 20, 0.01, D ); FeatureExtractionTask t( m, stream ); runner.run( "featureextraction", "ZeroCrossingCounter(20)", dataset, D, 0, t ); }
+
+    //The quantizers are trained on the classification data and then quantize the test data
+    const MatrixDouble test = testData.getDataAsMatrixDouble();
+    const string trainingDataset = trainingData.getDatasetName();
+    const UINT N = trainingData.getNumDimensions();
+    const UINT M = trainingData.getNumSamples();
+    { KMeansQuantizer m( 10 ); FeatureExtractionTask t( m, test, &trainingData ); runner.run( "featureextraction", "KMeansQuantizer(10)", trainingDataset, N, M, t ); }
+    { KMeansFeatures m( vector< UINT >(1,20) ); FeatureExtractionTask t( m, test, &trainingData ); runner.run( "featureextraction", "KMeansFeatures(20)", trainingDataset, N, M, t ); }
+    { SOMQuantizer m( 10 ); FeatureExtractionTask t( m, test, &trainingData ); runner.run( "featureextraction", "SOMQuantizer(10)", trainingDataset, N, M, t ); }
+    { RBMQuantizer m( 10 ); FeatureExtractionTask t( m, test, &trainingData ); runner.run( "featureextraction", "RBMQuantizer(10)", trainingDataset, N, M, t ); }
+}
+
+static void runPostProcessing(BenchmarkRunner &runner,const vector< UINT > &labels){
+
+    { ClassLabelFilter m( 5, 10 ); PostProcessingTask t( m, labels ); runner.run( "postprocessing", "ClassLabelFilter(5,10)", "labels", 1, 0, t ); }
+    { ClassLabelChangeFilter m; PostProcessingTask t( m, labels ); runner.run( "postprocessing", "ClassLabelChangeFilter", "labels", 1, 0, t ); }
+    { ClassLabelTimeoutFilter m( 100 ); PostProcessingTask t( m, labels ); runner.run( "postprocessing", "ClassLabelTimeoutFilter(100ms)", "labels", 1, 0, t ); }
+}
+
+static void runPipelines(BenchmarkRunner &runner,const string &dataDirectory,const ClassificationData &recordedData,const ClassificationData &trainingData,const ClassificationData &testData){
+
+    const UINT N = recordedData.getNumDimensions();
+
+    //The pipeline used by ofApp: a KNN classifier trained on one recorded vector per gesture
+    {
+        GestureRecognitionPipeline pipeline;
+        pipeline.setClassifier( KNN() );
+        PipelineTask t( pipeline, &recordedData, testData );
+        runner.run( "pipeline", "ofApp(KNN)", recordedData.getDatasetName(), N, recordedData.getNumSamples(), t );
+    }
+
+    //The pipeline ofApp saved to bin/data, loaded rather than trained
+    {
+        GestureRecognitionPipeline pipeline;
+        pipeline.load( dataDirectory + "/GRTpipeline.grt" );
+        PipelineTask t( pipeline, NULL, testData );
+        runner.run( "pipeline", "GRTpipeline.grt", "gestureVectors", N, 0, t );
+    }
+
+    //A full streaming pipeline: smoothing, classification and post processing
+    {
+        GestureRecognitionPipeline pipeline;
+        pipeline.addPreProcessingModule( MovingAverageFilter( 5, N ) );
+        pipeline.setClassifier( KNN( 5 ) );
+        pipeline.addPostProcessingModule( ClassLabelFilter( 3, 5 ) );
+        PipelineTask t( pipeline, &trainingData, testData );
+        runner.run( "pipeline", "MovingAverageFilter+KNN+ClassLabelFilter", trainingData.getDatasetName(), N, trainingData.getNumSamples(), t );
+    }
+}
+
+//--------------------------------------------------------------
+
+static void printUsage(){
+    cout << "usage: grt_benchmark [options]\n";
+    cout << "  --output FILE   write the JSON results to FILE (default: grt_benchmark_results.json)\n";
+    cout << "  --data DIR      the openFrameworks data directory with GRTpipeline.grt and images/ (default: ../bin/data)\n";
+    cout << "  --filter TEXT   only run the benchmarks whose category/name contains TEXT, e.g. classifier/KNN\n";
+    cout << "  --quick         use smaller datasets and shorter timings, for a quick check\n";
+    cout << "  --scale N       multiply the size of the random datasets by N (default: 1)\n";
+    cout << "  --seed N        the seed of the synthetic datasets (default: 42)\n";
+    cout << "  --log           show the GRT log messages and anything else the modules print\n";
+    cout << "  --quiet         only print the summary\n";
+}
+
+int main(int argc,char *argv[]){
+
+    string outputFilename = "grt_benchmark_results.json";
+    string dataDirectory = "../bin/data";
+    string filter;
+    bool quick = false;
+    bool enableLogging = false;
+    bool verbose = true;
+    double scale = 1;
+    unsigned long long seed = 42;
+
+    for(int i=1; i<argc; i++){
+        const string arg = argv[i];
+        const bool hasValue = i+1 < argc;
+        if( arg == "--output" && hasValue ) outputFilename = argv[++i];
+        else if( arg == "--data" && hasValue ) dataDirectory = argv[++i];
+        else if( arg == "--filter" && hasValue ) filter = argv[++i];
+        else if( arg == "--scale" && hasValue ) scale = atof( argv[++i] );
+        else if( arg == "--seed" && hasValue ) seed = strtoull( argv[++i], NULL, 10 );
+        else if( arg == "--quick" ) quick = true;
+        else if( arg == "--log" ) enableLogging = true;
+        else if( arg == "--quiet" ) verbose = false;
+        else{
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if( !(scale > 0) ) scale = 1;
+
+    ErrorLog::enableLogging( enableLogging );
+    WarningLog::enableLogging( enableLogging );
+    InfoLog::enableLogging( enableLogging );
+    TrainingLog::enableLogging( enableLogging );
+
+    BenchmarkRunner runner;
+    runner.filter = filter;
+    runner.verbose = verbose;
+    runner.showModuleOutput = enableLogging;
+    if( quick ){
+        runner.minTrainTime = 0;
+        runner.maxTrainRepeats = 1;
+        runner.minPredictions = 200;
+        runner.minPredictTime = 20;
+    }
+
+    //Create the datasets
+    Random random( seed );
+
+    ClassificationData recordedData;
+    const string imageDirectory = dataDirectory + "/images";
+    if( !BenchmarkData::loadGestureVectors( imageDirectory, recordedData ) ){
+        cout << "WARNING: Failed to load any gesture vectors from " << imageDirectory << ", the gestureVectors benchmarks will use the training data saved in GRTtrainingData.grt" << endl;
+        recordedData.load( dataDirectory + "/GRTtrainingData.grt" );
+        recordedData.setDatasetName( "gestureVectors" );
+    }
+
+    const UINT numClasses = quick ? 5 : 10;
+    const UINT samplesPerClass = (UINT)( (quick ? 50 : 500) * scale );
+    const UINT numDimensions = 16;
+    const UINT streamLength = quick ? 2000 : 10000;
+
+    ClassificationData gestureTrainingData = BenchmarkData::createNoisyCopies( recordedData, 10, 0.02, random );
+    ClassificationData gestureTestData = BenchmarkData::createNoisyCopies( recordedData, 5, 0.02, random );
+    ClassificationData randomTrainingData = BenchmarkData::createClassificationData( numClasses, samplesPerClass, numDimensions, random );
+    ClassificationData randomTestData = randomTrainingData.partition( 80, true );
+    randomTrainingData.setDatasetName( "randomClusters" );
+    ClassificationData randomSubset = randomTrainingData.getBootstrappedDataset( quick ? 100 : 300 );
+    randomSubset.setDatasetName( "randomClustersSubset" );
+    RegressionData regressionTrainingData = BenchmarkData::createRegressionData( numClasses*samplesPerClass/2, 8, 1, random );
+    RegressionData regressionTestData = regressionTrainingData.partition( 80 );
+    RegressionData multiRegressionTrainingData = BenchmarkData::createRegressionData( numClasses*samplesPerClass/2, 8, 3, random );
+    RegressionData multiRegressionTestData = multiRegressionTrainingData.partition( 80 );
+    TimeSeriesClassificationData timeseriesTrainingData = BenchmarkData::createTimeSeriesData( numClasses, quick ? 10 : 20, 50, 3, random );
+    TimeSeriesClassificationData timeseriesTestData = timeseriesTrainingData.partition( 80, true );
+    TimeSeriesClassificationData symbolTrainingData = BenchmarkData::createSymbolData( numClasses, quick ? 10 : 20, 50, 10, random );
+    TimeSeriesClassificationData symbolTestData = symbolTrainingData.partition( 80, true );
+    const MatrixDouble stream = BenchmarkData::createStream( streamLength, 8, random );
+    MatrixDouble spectrum = BenchmarkData::createStream( quick ? 500 : 2000, 128, random );
+    for(UINT i=0; i<spectrum.getNumRows(); i++){
+        for(UINT j=0; j<spectrum.getNumCols(); j++) spectrum[i][j] = fabs( spectrum[i][j] );
+    }
+    vector< UINT > labels( streamLength );
+    UINT label = 1;
+    for(UINT i=0; i<streamLength; i++){
+        if( random.getRandomNumberUniform() < 0.05 ) label = (UINT)random.getRandomNumberInt( 0, numClasses+1 );
+        labels[i] = label;
+    }
+
+    runner.addDataset( "gestureVectors", recordedData.getNumSamples(), recordedData.getNumDimensions(), recordedData.getNumClasses(), imageDirectory );
+    runner.addDataset( gestureTrainingData.getDatasetName() + "(train)", gestureTrainingData.getNumSamples(), gestureTrainingData.getNumDimensions(), gestureTrainingData.getNumClasses(), "gestureVectors + 2% gaussian noise" );
+    runner.addDataset( randomTrainingData.getDatasetName() + "(train)", randomTrainingData.getNumSamples(), numDimensions, numClasses, "synthetic" );
+    runner.addDataset( regressionTrainingData.getDatasetName() + "(train)", regressionTrainingData.getNumSamples(), 8, 0, "synthetic, 1 target" );
+    runner.addDataset( timeseriesTrainingData.getDatasetName() + "(train)", timeseriesTrainingData.getNumSamples(), 3, numClasses, "synthetic" );
+    runner.addDataset( symbolTrainingData.getDatasetName() + "(train)", symbolTrainingData.getNumSamples(), 1, numClasses, "synthetic" );
+    runner.addDataset( "stream", streamLength, 8, 0, "synthetic" );
+
+    //Write the details of the build and the run, so results from different builds can be compared
+    char dateString[64];
+    const time_t now = time( NULL );
+    strftime( dateString, sizeof(dateString), "%Y-%m-%dT%H:%M:%S", localtime( &now ) );
+    runner.metadataKeys.push_back( "date" ); runner.metadataValues.push_back( dateString );
+    runner.metadataKeys.push_back( "grtVersion" ); runner.metadataValues.push_back( GRTBase::getGRTVersion() );
+#ifdef __VERSION__
+    runner.metadataKeys.push_back( "compiler" ); runner.metadataValues.push_back( __VERSION__ );
+#endif
+#ifdef NDEBUG
+    runner.metadataKeys.push_back( "build" ); runner.metadataValues.push_back( "release" );
+#else
+    runner.metadataKeys.push_back( "build" ); runner.metadataValues.push_back( "debug" );
+#endif
+    runner.metadataKeys.push_back( "numHardwareThreads" ); runner.metadataValues.push_back( Util::toString( ParallelTaskRunner::getNumHardwareThreads() ) );
+    runner.metadataKeys.push_back( "seed" ); runner.metadataValues.push_back( Util::toString( seed ) );
+    runner.metadataKeys.push_back( "mode" ); runner.metadataValues.push_back( quick ? "quick" : "full" );
+    runner.metadataKeys.push_back( "scale" ); runner.metadataValues.push_back( Util::toString( scale ) );
+    runner.metadataKeys.push_back( "filter" ); runner.metadataValues.push_back( filter );
+
+    //Run the benchmarks
+    runClassifiers( runner, gestureTrainingData, gestureTestData );
+    runClassifiers( runner, randomTrainingData, randomTestData );
+    runTimeSeriesClassifiers( runner, timeseriesTrainingData, timeseriesTestData, symbolTrainingData, symbolTestData );
+    runRegressifiers( runner, regressionTrainingData, regressionTestData, multiRegressionTrainingData, multiRegressionTestData );
+    runClusterers( runner, randomTrainingData, randomSubset );
+    runPreProcessing( runner, stream );
+    runFeatureExtraction( runner, stream, spectrum, randomTrainingData, randomTestData );
+    runPostProcessing( runner, labels );
+    runPipelines( runner, dataDirectory, recordedData, gestureTrainingData, gestureTestData );
+
+    cout << endl;
+    runner.printSummary( cout );
+
+    if( !runner.saveJSON( outputFilename ) ){
+        cout << "ERROR: Failed to save the results to " << outputFilename << endl;
+        return 1;
+    }
+    cout << "Saved the results to " << outputFilename << endl;
+
+    return 0;
+}
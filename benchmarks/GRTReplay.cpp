@@ -0,0 +1,314 @@
+/**
+ @file
+ @brief A headless replay driver that streams recorded gesture vectors through a saved GestureRecognitionPipeline, so
+ the recognition can be load tested without openFrameworks, a camera or the face tracker.
+
+ The samples are either the 8 dimensional gesture vectors recorded in the JSON files in bin/data/images (labelled in the
+ same order as ofApp::setup(), so they match the classes of GRTpipeline.grt), or the samples of a
+ TimeSeriesClassificationDataStream file. They are replayed in a loop for a fixed duration, either as fast as possible
+ or at a fixed rate.
+
+ At a fixed rate each sample is due at its own scheduled time, whether or not the previous prediction has finished. The
+ response latency is measured from the scheduled time, so when the pipeline can not keep up the time the samples spend
+ waiting is included in the tail latency instead of being hidden by a slower send rate. The service latency is the
+ time of the predict call on its own.
+
+ The driver reports the sustained throughput, the service and response latency percentiles, the fraction of
+ predictions that agree with the recorded class labels and, if a reference pipeline is given (for example the binary
+ GRTpipeline.grtb), the fraction of predictions that agree with the reference. Run with --help to see the options.
+ */
+
+#include "BenchmarkData.h"
+#include "BenchmarkRunner.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <limits>
+
+class ReplayResult{
+public:
+    ReplayResult(){
+        numSamples = 0;
+        rate = 0;
+        duration = 0;
+        numPredictions = 0;
+        numFailed = 0;
+        numLate = 0;
+        numAgreeWithLabels = 0;
+        numAgreeWithReference = 0;
+        numCompared = 0;
+        elapsedTime = 0;
+    }
+
+    double getThroughput() const{ return elapsedTime > 0 ? numPredictions / (elapsedTime * 1.0e-3) : 0; }
+    double getLabelAgreement() const{ return numPredictions > 0 ? numAgreeWithLabels / double(numPredictions) : 0; }
+    double getReferenceAgreement() const{ return numCompared > 0 ? numAgreeWithReference / double(numCompared) : -1; }
+
+    string pipelineFilename;
+    string referenceFilename;
+    string dataset;
+    UINT numSamples;
+    double rate;                        ///< The target rate in samples per second, or zero for as fast as possible
+    double duration;                    ///< The target duration, in seconds
+    unsigned long long numPredictions;
+    unsigned long long numFailed;
+    unsigned long long numLate;         ///< The predictions that started more than one period after they were due
+    unsigned long long numAgreeWithLabels;
+    unsigned long long numAgreeWithReference;
+    unsigned long long numCompared;
+    double elapsedTime;                 ///< The time spent replaying, in milliseconds
+    LatencyHistogram serviceLatency;    ///< The time of each predict call, in nanoseconds
+    LatencyHistogram responseLatency;   ///< The time from when each sample was due until its prediction was made, in nanoseconds
+};
+
+//--------------------------------------------------------------
+
+static const UINT FAILED_PREDICTION = std::numeric_limits< UINT >::max();
+
+static bool loadStream(const string &filename,vector< VectorDouble > &samples,vector< UINT > &labels,string &dataset){
+    TimeSeriesClassificationDataStream data;
+    if( !data.load( filename ) ) return false;
+    for(UINT i=0; i<data.getNumSamples(); i++){
+        samples.push_back( data[i].getSample() );
+        labels.push_back( data[i].getClassLabel() );
+    }
+    dataset = data.getDatasetName();
+    return samples.size() > 0;
+}
+
+static void waitUntil(const unsigned long long time){
+    //Sleep while the sample is far off, then spin so it is sent on time
+    for(;;){
+        const unsigned long long now = Timer::getHighResolutionTime();
+        if( now >= time ) return;
+        if( time - now > 2000000 ) std::this_thread::sleep_for( std::chrono::nanoseconds( time - now - 1000000 ) );
+    }
+}
+
+static void replay(GestureRecognitionPipeline &pipeline,const vector< VectorDouble > &samples,const vector< UINT > &labels,vector< UINT > &predictedLabels,ReplayResult &result){
+
+    const unsigned long long period = result.rate > 0 ? (unsigned long long)( 1.0e9 / result.rate ) : 0;
+    const unsigned long long startTime = Timer::getHighResolutionTime();
+    const unsigned long long endTime = startTime + (unsigned long long)( result.duration * 1.0e9 );
+    unsigned long long lastTime = startTime;
+
+    for(unsigned long long n=0; ; n++){
+        const unsigned long long dueTime = startTime + n * period;
+        if( period > 0 ){
+            if( dueTime >= endTime ) break;
+            waitUntil( dueTime );
+        }
+
+        const UINT index = (UINT)( n % samples.size() );
+        const unsigned long long t0 = Timer::getHighResolutionTime();
+        if( period == 0 && t0 >= endTime ) break;
+        const bool ok = pipeline.predict( samples[index] );
+        const unsigned long long t1 = Timer::getHighResolutionTime();
+        lastTime = t1;
+
+        result.serviceLatency.record( t1 - t0 );
+        result.responseLatency.record( t1 - (period > 0 ? dueTime : t0) );
+        if( period > 0 && t0 - dueTime > period ) result.numLate++;
+
+        if( !ok ){
+            result.numFailed++;
+            predictedLabels.push_back( FAILED_PREDICTION );
+            continue;
+        }
+        result.numPredictions++;
+        predictedLabels.push_back( pipeline.getPredictedClassLabel() );
+        if( predictedLabels.back() == labels[index] ) result.numAgreeWithLabels++;
+    }
+
+    result.elapsedTime = (lastTime - startTime) * 1.0e-6;
+}
+
+static void compareWithReference(GestureRecognitionPipeline &reference,const vector< VectorDouble > &samples,const vector< UINT > &predictedLabels,ReplayResult &result){
+    //Replays the same sequence after the timed run, so the reference does not slow the replay down. The pipelines may
+    //keep state between samples (filters, buffers), so the whole sequence is run through the reference in order
+    for(size_t n=0; n<predictedLabels.size(); n++){
+        if( !reference.predict( samples[ n % samples.size() ] ) || predictedLabels[n] == FAILED_PREDICTION ) continue;
+        if( reference.getPredictedClassLabel() == predictedLabels[n] ) result.numAgreeWithReference++;
+        result.numCompared++;
+    }
+}
+
+static void printResult(std::ostream &stream,const ReplayResult &r){
+    std::ostringstream text;
+    text << std::fixed << std::setprecision( 2 );
+    text << "Replayed " << r.dataset << " (" << r.numSamples << " samples) through " << r.pipelineFilename;
+    if( r.rate > 0 ) text << " at " << r.rate << " samples/s" << endl;
+    else text << " as fast as possible" << endl;
+    text << "  predictions      " << r.numPredictions << " in " << r.elapsedTime * 1.0e-3 << "s, " << r.numFailed << " failed" << endl;
+    text << "  throughput       " << r.getThroughput() << "/s" << endl;
+    text << "  service latency  p50 " << r.serviceLatency.getPercentile(50) * 1.0e-3 << "us p90 " << r.serviceLatency.getPercentile(90) * 1.0e-3;
+    text << "us p99 " << r.serviceLatency.getPercentile(99) * 1.0e-3 << "us p99.9 " << r.serviceLatency.getPercentile(99.9) * 1.0e-3;
+    text << "us max " << r.serviceLatency.getMaximum() * 1.0e-3 << "us" << endl;
+    if( r.rate > 0 ){
+        text << "  response latency p50 " << r.responseLatency.getPercentile(50) * 1.0e-3 << "us p90 " << r.responseLatency.getPercentile(90) * 1.0e-3;
+        text << "us p99 " << r.responseLatency.getPercentile(99) * 1.0e-3 << "us p99.9 " << r.responseLatency.getPercentile(99.9) * 1.0e-3;
+        text << "us max " << r.responseLatency.getMaximum() * 1.0e-3 << "us" << endl;
+        text << "  late             " << r.numLate << endl;
+    }
+    text << "  label agreement  " << r.getLabelAgreement() * 100.0 << "%" << endl;
+    if( r.numCompared > 0 ) text << "  reference agreement " << r.getReferenceAgreement() * 100.0 << "% with " << r.referenceFilename << endl;
+    stream << text.str();
+}
+
+static void writeLatency(std::ostream &stream,const LatencyHistogram &latency){
+    stream << "{\"mean\": " << latency.getMean() << ", \"p50\": " << latency.getPercentile(50) << ", \"p90\": " << latency.getPercentile(90);
+    stream << ", \"p99\": " << latency.getPercentile(99) << ", \"p999\": " << latency.getPercentile(99.9) << ", \"max\": " << latency.getMaximum() << "}";
+}
+
+static bool saveJSON(const string &filename,const ReplayResult &r){
+    std::ofstream file( filename.c_str() );
+    if( !file.is_open() ) return false;
+
+    file << std::setprecision( 10 );
+    file << "{\n";
+    file << "  \"formatVersion\": 1,\n";
+    file << "  \"pipeline\": \"" << BenchmarkRunner::escapeJSON( r.pipelineFilename ) << "\",\n";
+    file << "  \"reference\": ";
+    if( r.numCompared > 0 ) file << "\"" << BenchmarkRunner::escapeJSON( r.referenceFilename ) << "\",\n";
+    else file << "null,\n";
+    file << "  \"dataset\": \"" << BenchmarkRunner::escapeJSON( r.dataset ) << "\", \"numSamples\": " << r.numSamples << ",\n";
+    file << "  \"rate\": " << r.rate << ", \"durationSec\": " << r.duration << ",\n";
+    file << "  \"predictions\": " << r.numPredictions << ", \"failed\": " << r.numFailed << ", \"late\": " << r.numLate << ",\n";
+    file << "  \"elapsedMs\": " << r.elapsedTime << ", \"throughputPerSec\": " << r.getThroughput() << ",\n";
+    file << "  \"serviceLatencyNs\": ";
+    writeLatency( file, r.serviceLatency );
+    file << ",\n  \"responseLatencyNs\": ";
+    writeLatency( file, r.responseLatency );
+    file << ",\n  \"labelAgreement\": " << r.getLabelAgreement() << ",\n";
+    file << "  \"referenceAgreement\": ";
+    if( r.numCompared > 0 ) file << r.getReferenceAgreement();
+    else file << "null";
+    file << "\n}\n";
+
+    file.close();
+    return true;
+}
+
+//--------------------------------------------------------------
+
+static void printUsage(){
+    cout << "usage: grt_replay [options]\n";
+    cout << "  --data DIR        the openFrameworks data directory with GRTpipeline.grt and images/ (default: ../bin/data)\n";
+    cout << "  --pipeline FILE   the saved pipeline to load, text or binary (default: DIR/GRTpipeline.grt)\n";
+    cout << "  --reference FILE  a second pipeline whose predictions are compared with the first, e.g. DIR/GRTpipeline.grtb\n";
+    cout << "  --stream FILE     replay the samples of a TimeSeriesClassificationDataStream file instead of the gesture vectors\n";
+    cout << "  --rate HZ         the number of samples to send per second, 0 sends them as fast as possible (default: 0)\n";
+    cout << "  --duration SEC    how long to replay for (default: 10)\n";
+    cout << "  --noise LEVEL     add gaussian noise to the gesture vectors, as a fraction of the range of each dimension (default: 0)\n";
+    cout << "  --seed N          the seed of the noise (default: 42)\n";
+    cout << "  --output FILE     write the JSON results to FILE (default: grt_replay_results.json)\n";
+    cout << "  --log             show the GRT log messages\n";
+}
+
+int main(int argc,char *argv[]){
+
+    string dataDirectory = "../bin/data";
+    string pipelineFilename;
+    string referenceFilename;
+    string streamFilename;
+    string outputFilename = "grt_replay_results.json";
+    double rate = 0;
+    double duration = 10;
+    double noiseLevel = 0;
+    unsigned long long seed = 42;
+    bool enableLogging = false;
+
+    for(int i=1; i<argc; i++){
+        const string arg = argv[i];
+        const bool hasValue = i+1 < argc;
+        if( arg == "--data" && hasValue ) dataDirectory = argv[++i];
+        else if( arg == "--pipeline" && hasValue ) pipelineFilename = argv[++i];
+        else if( arg == "--reference" && hasValue ) referenceFilename = argv[++i];
+        else if( arg == "--stream" && hasValue ) streamFilename = argv[++i];
+        else if( arg == "--rate" && hasValue ) rate = atof( argv[++i] );
+        else if( arg == "--duration" && hasValue ) duration = atof( argv[++i] );
+        else if( arg == "--noise" && hasValue ) noiseLevel = atof( argv[++i] );
+        else if( arg == "--seed" && hasValue ) seed = strtoull( argv[++i], NULL, 10 );
+        else if( arg == "--output" && hasValue ) outputFilename = argv[++i];
+        else if( arg == "--log" ) enableLogging = true;
+        else{
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if( pipelineFilename.empty() ) pipelineFilename = dataDirectory + "/GRTpipeline.grt";
+    if( !(rate > 0) ) rate = 0;
+    if( !(duration > 0) ) duration = 10;
+
+    ErrorLog::enableLogging( enableLogging );
+    WarningLog::enableLogging( enableLogging );
+    InfoLog::enableLogging( enableLogging );
+
+    GestureRecognitionPipeline pipeline;
+    if( !pipeline.load( pipelineFilename ) || !pipeline.getTrained() ){
+        cout << "ERROR: Failed to load a trained pipeline from " << pipelineFilename << endl;
+        return 1;
+    }
+
+    GestureRecognitionPipeline reference;
+    if( !referenceFilename.empty() && (!reference.load( referenceFilename ) || !reference.getTrained()) ){
+        cout << "ERROR: Failed to load a trained reference pipeline from " << referenceFilename << endl;
+        return 1;
+    }
+
+    //Load the samples to replay
+    vector< VectorDouble > samples;
+    vector< UINT > labels;
+    string dataset;
+    if( !streamFilename.empty() ){
+        if( !loadStream( streamFilename, samples, labels, dataset ) ){
+            cout << "ERROR: Failed to load any samples from " << streamFilename << endl;
+            return 1;
+        }
+    }else{
+        ClassificationData recordedData;
+        const string imageDirectory = dataDirectory + "/images";
+        if( !BenchmarkData::loadGestureVectors( imageDirectory, recordedData ) ){
+            cout << "ERROR: Failed to load any gesture vectors from " << imageDirectory << endl;
+            return 1;
+        }
+        if( noiseLevel > 0 ){
+            Random random( seed );
+            recordedData = BenchmarkData::createNoisyCopies( recordedData, 1, noiseLevel, random );
+        }
+        for(UINT i=0; i<recordedData.getNumSamples(); i++){
+            samples.push_back( recordedData[i].getSample() );
+            labels.push_back( recordedData[i].getClassLabel() );
+        }
+        dataset = recordedData.getDatasetName();
+    }
+
+    if( samples[0].size() != pipeline.getInputVectorDimensionsSize() ){
+        cout << "ERROR: The samples have " << samples[0].size() << " dimensions, but the pipeline expects " << pipeline.getInputVectorDimensionsSize() << endl;
+        return 1;
+    }
+
+    ReplayResult result;
+    result.pipelineFilename = pipelineFilename;
+    result.referenceFilename = referenceFilename;
+    result.dataset = dataset;
+    result.numSamples = (UINT)samples.size();
+    result.rate = rate;
+    result.duration = duration;
+
+    vector< UINT > predictedLabels;
+    replay( pipeline, samples, labels, predictedLabels, result );
+    if( !referenceFilename.empty() ) compareWithReference( reference, samples, predictedLabels, result );
+
+    printResult( cout, result );
+
+    if( !outputFilename.empty() ){
+        if( saveJSON( outputFilename, result ) ) cout << "Wrote the results to " << outputFilename << endl;
+        else cout << "ERROR: Failed to write the results to " << outputFilename << endl;
+    }
+
+    return result.numFailed == 0 ? 0 : 1;
+}
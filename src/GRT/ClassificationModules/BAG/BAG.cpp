@@ -134,9 +134,13 @@ bool BAG::train_(ClassificationData &trainingData){
         }
     }
 
-    //Train the ensemble
+    //Train the ensemble, each classifier is seeded from its own stream so the ensemble only depends on the seed of the BAG
+    const unsigned long long firstStream = random.getRandomNumberUInt64();
     for(UINT i=0; i<ensembleSize; i++){
-        ClassificationData boostedDataset = trainingData.getBootstrappedDataset();
+        ClassificationData boostedDataset = trainingData.getBootstrappedDataset( 0, random );
+        
+        //A zero seed would seed the classifier from the system time
+        ensemble[i]->setRandomSeed( random.split( firstStream + i ).getRandomNumberUInt64() | 1 );
         
         trainingLog << "Training ensemble " << i+1 << ". Ensemble type: " << ensemble[i]->getClassType() << endl;
         
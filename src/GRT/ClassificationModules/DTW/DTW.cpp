@@ -258,7 +258,7 @@ bool DTW::train_(TimeSeriesClassificationData &labelledTrainingData){
 
     //Resize the prediction results to make sure it is setup for realtime prediction
     continuousInputDataBuffer.clear();
-    continuousInputDataBuffer.resize(averageTemplateLength,vector<double>(numInputDimensions,0));
+    continuousInputDataBuffer.resize(averageTemplateLength,numInputDimensions);
     classLikelihoods.resize(numTemplates,DEFAULT_NULL_LIKELIHOOD_VALUE);
     classDistances.resize(numTemplates,0);
     predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
@@ -487,25 +487,25 @@ bool DTW::predict_(VectorDouble &inputVector){
         return true;
     }
 
-    //Copy the data into a temporary matrix
+    //Copy the buffer window into the prediction matrix, the window is contiguous so each row is a straight copy. The matrix
+    //is kept between predictions so it is only allocated when the buffer size changes
     const UINT M = continuousInputDataBuffer.getSize();
     const UINT N = numInputDimensions;
-    MatrixDouble predictionTimeSeries(M,N);
+    continuousInputTimeSeries.resize(M,N);
+    const double *window = continuousInputDataBuffer.getWindow();
     for(UINT i=0; i<M; i++){
-        for(UINT j=0; j<N; j++){
-            predictionTimeSeries[i][j] = continuousInputDataBuffer[i][j];
-        }
+        std::copy( window + i*N, window + (i+1)*N, continuousInputTimeSeries[i] );
     }
 
-    //Run the prediction
-    return predict( predictionTimeSeries );
+    //Run the prediction, predict_ is called directly as predict would copy the matrix again
+    return predict_( continuousInputTimeSeries );
 
 }
 
 bool DTW::reset(){
     continuousInputDataBuffer.clear();
     if( trained ){
-        continuousInputDataBuffer.resize(averageTemplateLength,vector<double>(numInputDimensions,0));
+        continuousInputDataBuffer.resize(averageTemplateLength,numInputDimensions);
         recomputeNullRejectionThresholds();
     }
     return true;
@@ -1207,7 +1207,7 @@ bool DTW::loadModelFromFile( fstream &file ){
         
         //Resize the prediction results to make sure it is setup for realtime prediction
         continuousInputDataBuffer.clear();
-        continuousInputDataBuffer.resize(averageTemplateLength,vector<double>(numInputDimensions,0));
+        continuousInputDataBuffer.resize(averageTemplateLength,numInputDimensions);
         maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
         bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
         classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
@@ -1509,7 +1509,7 @@ bool DTW::loadLegacyModelFromFile( fstream &file ){
     
     //Resize the prediction results to make sure it is setup for realtime prediction
     continuousInputDataBuffer.clear();
-    continuousInputDataBuffer.resize(averageTemplateLength,vector<double>(numInputDimensions,0));
+    continuousInputDataBuffer.resize(averageTemplateLength,numInputDimensions);
     maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
     bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
     classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
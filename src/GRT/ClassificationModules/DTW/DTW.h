@@ -350,7 +350,8 @@ protected:
 	vector< DTWTemplate > templatesBuffer;		//A buffer to store the templates for each time series
     vector< MatrixDouble > distanceMatrices;
     vector< vector< IndexDist > > warpPaths;
-    CircularBuffer< VectorDouble > continuousInputDataBuffer;
+    MultiChannelCircularBuffer continuousInputDataBuffer;
+    MatrixDouble continuousInputTimeSeries;   //The buffer window used by the last continuous prediction
 	UINT				numTemplates;			//The number of templates in our buffer
     UINT                rejectionMode;          //The rejection mode used to reject null gestures during the prediction phase
 
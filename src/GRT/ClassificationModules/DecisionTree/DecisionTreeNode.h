@@ -275,6 +275,84 @@ public:
         return true;
     }
     
+    /**
+     This function appends the node and all it's children to two flat arrays, in depth first order (the node, then the
+     left child's tree, then the right child's tree). This is used to save a tree to a binary model file.
+     
+     @param vector< UINT > &nodeInfo: NODE_INFO_SIZE values are appended for each node
+     @param VectorDouble &nodeParameters: the threshold and then the class probabilities are appended for each node
+     @return returns true if the tree was appended, false otherwise
+     */
+    bool saveTreeToArrays(vector< UINT > &nodeInfo,VectorDouble &nodeParameters) const{
+        
+        nodeInfo.push_back( depth );
+        nodeInfo.push_back( nodeID );
+        nodeInfo.push_back( isLeafNode ? 1 : 0 );
+        nodeInfo.push_back( leftChild != NULL ? 1 : 0 );
+        nodeInfo.push_back( rightChild != NULL ? 1 : 0 );
+        nodeInfo.push_back( nodeSize );
+        nodeInfo.push_back( featureIndex );
+        nodeInfo.push_back( (UINT)classProbabilities.size() );
+        nodeParameters.push_back( threshold );
+        nodeParameters.insert( nodeParameters.end(), classProbabilities.begin(), classProbabilities.end() );
+        
+        Node *children[2] = {leftChild,rightChild};
+        for(UINT i=0; i<2; i++){
+            if( children[i] == NULL ) continue;
+            if( children[i]->getNodeType() != nodeType ){
+                errorLog << "saveTreeToArrays(vector< UINT > &nodeInfo,VectorDouble &nodeParameters) - Child node is not a DecisionTreeNode!" << endl;
+                return false;
+            }
+            if( !((DecisionTreeNode*)children[i])->saveTreeToArrays( nodeInfo, nodeParameters ) ) return false;
+        }
+        
+        return true;
+    }
+    
+    /**
+     This function loads the node and all it's children from the arrays written by saveTreeToArrays.
+     
+     @param const vector< UINT > &nodeInfo: the node info of all the nodes
+     @param const VectorDouble &nodeParameters: the parameters of all the nodes
+     @param UINT &infoIndex: the index of this node's info, this returns the index after the last node of the tree
+     @param UINT &parameterIndex: the index of this node's parameters, this returns the index after the last node of the tree
+     @return returns true if the tree was loaded, false otherwise
+     */
+    bool loadTreeFromArrays(const vector< UINT > &nodeInfo,const VectorDouble &nodeParameters,UINT &infoIndex,UINT &parameterIndex){
+        
+        clear();
+        
+        if( infoIndex + NODE_INFO_SIZE > nodeInfo.size() || parameterIndex + 1 + nodeInfo[infoIndex+7] > nodeParameters.size() ){
+            errorLog << "loadTreeFromArrays(...) - The arrays are too short!" << endl;
+            return false;
+        }
+        
+        depth = nodeInfo[infoIndex];
+        nodeID = nodeInfo[infoIndex+1];
+        isLeafNode = nodeInfo[infoIndex+2] != 0;
+        const bool hasChild[2] = {nodeInfo[infoIndex+3] != 0,nodeInfo[infoIndex+4] != 0};
+        nodeSize = nodeInfo[infoIndex+5];
+        featureIndex = nodeInfo[infoIndex+6];
+        const UINT numClasses = nodeInfo[infoIndex+7];
+        threshold = nodeParameters[parameterIndex];
+        classProbabilities.assign( nodeParameters.begin() + parameterIndex + 1, nodeParameters.begin() + parameterIndex + 1 + numClasses );
+        infoIndex += NODE_INFO_SIZE;
+        parameterIndex += 1 + numClasses;
+        
+        for(UINT i=0; i<2; i++){
+            if( !hasChild[i] ) continue;
+            DecisionTreeNode *child = new DecisionTreeNode;
+            if( i == 0 ) leftChild = child;
+            else rightChild = child;
+            if( !child->loadTreeFromArrays( nodeInfo, nodeParameters, infoIndex, parameterIndex ) ) return false;
+            child->setParent( this );
+        }
+        
+        return true;
+    }
+    
+    enum{ NODE_INFO_SIZE = 8 };
+    
 protected:
     /**
      This saves the DecisionTreeNode custom parameters to a file. It will be called automatically by the Node base class
@@ -122,23 +122,30 @@ bool GMM::predict_(VectorDouble &x){
 	UINT bestIndex = 0;
 	maxLikelihood = 0;
     bestDistance = 0;
-    double sum = 0;
+    
+    //Compute the log likelihood of each class, working in the log domain means that inputs that are a long way from every
+    //model do not all collapse to a likelihood of zero
+    if( classLogLikelihoods.size() != numClasses ) classLogLikelihoods.resize(numClasses);
+    double maxLogLikelihood = 0;
 	for(UINT k=0; k<numClasses; k++){
-        classDistances[k] = computeMixtureLikelihood(x,k);
-        
-        //cout << "K: " << k << " Dist: " << classDistances[k] << endl;
-        classLikelihoods[k] = classDistances[k];
-        sum += classLikelihoods[k];
-		if( classLikelihoods[k] > bestDistance ){
-			bestDistance = classLikelihoods[k];
+        classLogLikelihoods[k] = computeMixtureLogLikelihood(x,k);
+		if( k == 0 || classLogLikelihoods[k] > maxLogLikelihood ){
+			maxLogLikelihood = classLogLikelihoods[k];
 			bestIndex = k;
 		}
 	}
     
-    //Normalize the likelihoods
-    for(unsigned int k=0; k<numClasses; k++){
+    //Normalize the likelihoods, this is done relative to the best class so it is stable even if all the likelihoods underflow
+    double sum = 0;
+    for(UINT k=0; k<numClasses; k++){
+        classDistances[k] = exp( classLogLikelihoods[k] );
+        classLikelihoods[k] = exp( classLogLikelihoods[k] - maxLogLikelihood );
+        sum += classLikelihoods[k];
+    }
+    for(UINT k=0; k<numClasses; k++){
         classLikelihoods[k] /= sum;
     }
+    bestDistance = classDistances[bestIndex];
     maxLikelihood = classLikelihoods[bestIndex];
     
     if( useNullRejection ){
@@ -147,7 +154,10 @@ bool GMM::predict_(VectorDouble &x){
         
         //If the best distance is below the modles rejection threshold then set the predicted class label as the best class label
         //Otherwise set the predicted class label as the default null rejection class label of 0
-        if( classDistances[bestIndex] >= models[bestIndex].getNullRejectionThreshold() ){
+        //The likelihoods are compared in log space. A threshold of zero or below accepts every prediction, as it did when the
+        //likelihoods were compared directly (the log of a negative threshold would be NaN, which would reject everything)
+        const double nullRejectionThreshold = models[bestIndex].getNullRejectionThreshold();
+        if( nullRejectionThreshold <= 0 || classLogLikelihoods[bestIndex] >= log( nullRejectionThreshold ) ){
             predictedClassLabel = models[bestIndex].getClassLabel();
         }else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
    }else{
@@ -222,6 +232,11 @@ bool GMM::train_(ClassificationData &trainingData){
         //Compute the normalize factor
         models[k].recomputeNormalizationFactor();
         
+        //Build the compiled form of the model for the realtime prediction
+        if( !models[k].compileModel() ){
+            warningLog << "train_(ClassificationData &trainingData) - Failed to compile the Mixture Model for class " << classLabel << ", the legacy likelihood function will be used for this class." << endl;
+        }
+        
         //Compute the rejection thresholds
         double mu = 0;
         double sigma = 0;
@@ -278,6 +293,14 @@ double GMM::computeMixtureLikelihood(const VectorDouble &x,const UINT k){
     return models[k].computeMixtureLikelihood(x);
 }
     
+double GMM::computeMixtureLogLikelihood(const VectorDouble &x,const UINT k){
+    if( k >= numClasses ){
+        errorLog << "computeMixtureLogLikelihood(const VectorDouble x,const UINT k) - Invalid k value!" << endl;
+        return -numeric_limits< double >::max();
+    }
+    return models[k].computeMixtureLogLikelihood(x);
+}
+    
 bool GMM::saveModelToFile(fstream &file) const{
     
     if( !trained ){
@@ -515,6 +538,13 @@ bool GMM::loadModelFromFile(fstream &file){
             
         }
         
+        //Build the compiled form of each model for the realtime prediction
+        for(UINT k=0; k<numClasses; k++){
+            if( !models[k].compileModel() ){
+                warningLog << "loadModelFromFile(fstream &file) - Failed to compile the Mixture Model for class " << models[k].getClassLabel() << ", the legacy likelihood function will be used for this class." << endl;
+            }
+        }
+        
         //Set the null rejection thresholds
         nullRejectionThresholds.resize(numClasses);
         for(UINT k=0; k<numClasses; k++) {
@@ -787,6 +817,13 @@ bool GMM::loadLegacyModelFromFile( fstream &file ){
         
     }
     
+    //Build the compiled form of each model for the realtime prediction
+    for(UINT k=0; k<numClasses; k++){
+        if( !models[k].compileModel() ){
+            warningLog << "loadLegacyModelFromFile(fstream &file) - Failed to compile the Mixture Model for class " << models[k].getClassLabel() << ", the legacy likelihood function will be used for this class." << endl;
+        }
+    }
+    
     //Set the null rejection thresholds
     nullRejectionThresholds.resize(numClasses);
     for(UINT k=0; k<numClasses; k++) {
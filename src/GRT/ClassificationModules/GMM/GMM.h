@@ -185,12 +185,14 @@ public:
     
 protected:
     double computeMixtureLikelihood(const VectorDouble &x,UINT k);
+    double computeMixtureLogLikelihood(const VectorDouble &x,UINT k);
     bool loadLegacyModelFromFile( fstream &file );
     
     UINT numMixtureModels;
     UINT maxIter;
     double minChange;
     vector< MixtureModel > models;
+    VectorDouble classLogLikelihoods;
     
     DebugLog debugLog;
     ErrorLog errorLog;
@@ -89,6 +89,8 @@ public:
         trainingMu = 0;
         trainingSigma = 0;
         gamma = 1;
+        numDimensions = 0;
+        compiled = false;
     }
     ~MixtureModel(){
         gaussModels.clear();
@@ -103,6 +105,7 @@ public:
 	}
     
     double computeMixtureLikelihood(const vector<double> &x){
+        if( compiled ) return exp( computeMixtureLogLikelihood(x) );
         double sum = 0;
         for(UINT k=0; k<K; k++){
             sum += gauss(x,gaussModels[k].det,gaussModels[k].mu,gaussModels[k].invSigma);
@@ -111,11 +114,125 @@ public:
         return sum/normFactor;
     }
     
+    /**
+     Computes the log of the normalized mixture likelihood using the compiled model. Each component is evaluated as
+     logNorm_k - 0.5*|L_k^-1 (x-mu_k)|^2 and the components are combined with log-sum-exp, so inputs far from every
+     component still return a finite value rather than collapsing to zero. The compiled model must have been built
+     with compileModel(), otherwise the legacy likelihood is used.
+     
+     @param const vector<double> &x: the input vector, this should have the same number of dimensions as the model
+     @return returns the log mixture likelihood
+     */
+    double computeMixtureLogLikelihood(const vector<double> &x){
+        
+        if( !compiled ){
+            return log( computeMixtureLikelihood(x) );
+        }
+        
+        const UINT N = numDimensions;
+        
+        //Compute the whitened residuals z = L^-1 (x-mu) for all the components at once via forward substitution, the data is
+        //stored component-minor so the inner loops run over contiguous memory and can be vectorized by the compiler
+        double *z = &compiledZ[0];
+        const double *mu = &compiledMu[0];
+        for(UINT i=0; i<N; i++){
+            const double xi = x[i];
+            double *zi = z + i*K;
+            const double *mui = mu + i*K;
+            for(UINT k=0; k<K; k++) zi[k] = xi - mui[k];
+        }
+        
+        for(UINT i=0; i<N; i++){
+            double *zi = z + i*K;
+            for(UINT j=0; j<i; j++){
+                const double *zj = z + j*K;
+                const double *lij = &compiledL[ (i*N+j)*K ];
+                for(UINT k=0; k<K; k++) zi[k] -= lij[k] * zj[k];
+            }
+            const double *invDiag = &compiledInvDiag[ i*K ];
+            for(UINT k=0; k<K; k++) zi[k] *= invDiag[k];
+        }
+        
+        //Compute the log density of each component
+        double *logP = &compiledLogP[0];
+        for(UINT k=0; k<K; k++) logP[k] = compiledLogNorm[k];
+        for(UINT i=0; i<N; i++){
+            const double *zi = z + i*K;
+            for(UINT k=0; k<K; k++) logP[k] -= 0.5 * zi[k] * zi[k];
+        }
+        
+        //Combine the components using log-sum-exp
+        double maxLogP = logP[0];
+        for(UINT k=1; k<K; k++){
+            if( logP[k] > maxLogP ) maxLogP = logP[k];
+        }
+        double sum = 0;
+        for(UINT k=0; k<K; k++){
+            sum += exp( logP[k] - maxLogP );
+        }
+        
+        return maxLogP + log( sum ) - log( normFactor );
+    }
+    
+    /**
+     Builds the compiled prediction form of the mixture model. This factorizes each component's covariance matrix with a
+     Cholesky decomposition and stores the factors, means and log normalizers in one contiguous component-minor block.
+     If any of the covariance matrices are not positive definite then the model is left uncompiled and the legacy
+     likelihood function will be used.
+     
+     @return returns true if the model was compiled, false otherwise
+     */
+    bool compileModel(){
+        
+        compiled = false;
+        if( K == 0 || gaussModels.size() != K ) return false;
+        
+        const UINT N = (UINT)gaussModels[0].mu.size();
+        if( N == 0 ) return false;
+        
+        compiledMu.resize( N*K );
+        compiledL.assign( N*N*K, 0 );
+        compiledInvDiag.resize( N*K );
+        compiledLogNorm.resize( K );
+        compiledZ.resize( N*K );
+        compiledLogP.resize( K );
+        
+        for(UINT k=0; k<K; k++){
+            if( gaussModels[k].mu.size() != N || gaussModels[k].sigma.getNumRows() != N || gaussModels[k].sigma.getNumCols() != N ){
+                return false;
+            }
+            
+            Cholesky cholesky( gaussModels[k].sigma );
+            if( !cholesky.getSuccess() ){
+                return false;
+            }
+            
+            double logDiagSum = 0;
+            for(UINT i=0; i<N; i++){
+                compiledMu[ i*K+k ] = gaussModels[k].mu[i];
+                compiledInvDiag[ i*K+k ] = 1.0 / cholesky.el[i][i];
+                logDiagSum += log( cholesky.el[i][i] );
+                for(UINT j=0; j<i; j++){
+                    compiledL[ (i*N+j)*K+k ] = cholesky.el[i][j];
+                }
+            }
+            
+            //log( 1/((2PI)^(N/2) * det^0.5) ), where 0.5*log(det) is the sum of the log diagonal of the Cholesky factor
+            compiledLogNorm[k] = -0.5*N*log(TWO_PI) - logDiagSum;
+        }
+        
+        numDimensions = N;
+        compiled = true;
+        
+        return true;
+    }
+    
     bool resize(UINT K){
         if( K > 0 ){
             this->K = K;
             gaussModels.clear();
             gaussModels.resize(K);
+            compiled = false;
             return true;
         }
         return false;
@@ -155,6 +272,8 @@ public:
     
     UINT getK() const { return K; }
     
+    bool getIsCompiled() const { return compiled; }
+    
     UINT getClassLabel() const { return classLabel; }
     
     double getTrainingMu() const {
@@ -225,6 +344,16 @@ private:
     double normFactor;
     vector< GuassModel > gaussModels;
     
+    //The compiled prediction model, each buffer is stored component-minor (i.e. [dimension][component])
+    bool compiled;
+    UINT numDimensions;
+    VectorDouble compiledMu;
+    VectorDouble compiledL;                 //The strictly lower part of each Cholesky factor, stored as [i][j][component]
+    VectorDouble compiledInvDiag;           //The reciprocal of the diagonal of each Cholesky factor
+    VectorDouble compiledLogNorm;           //The log normalizer of each component
+    VectorDouble compiledZ;                 //Workspace for the whitened residuals
+    VectorDouble compiledLogP;              //Workspace for the component log densities
+    
 };
     
 }//End of namespace GRT
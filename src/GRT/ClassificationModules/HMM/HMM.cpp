@@ -104,6 +104,27 @@ bool HMM::train(ClassificationData trainingData){
 }
     
     
+//Trains the HMM for one class, the HMM for each class is independent so they can be trained at the same time
+class HMMClassTrainingTask : public ParallelTask{
+public:
+    HMMClassTrainingTask(vector< HiddenMarkovModel > &models,const vector< vector< vector< UINT > > > &observationSequences):models(models),observationSequences(observationSequences){
+        trainingFailed.resize(models.size(),0);
+    }
+    virtual ~HMMClassTrainingTask(){}
+    
+    virtual bool runTask(const UINT taskIndex,const UINT threadIndex){
+        if( !models[taskIndex].train( observationSequences[taskIndex] ) ){
+            trainingFailed[taskIndex] = 1;
+            return false;
+        }
+        return true;
+    }
+    
+    vector< HiddenMarkovModel > &models;
+    const vector< vector< vector< UINT > > > &observationSequences;
+    vector< UINT > trainingFailed;
+};
+    
 bool HMM::train_(TimeSeriesClassificationData &trainingData){
     
     clear();
@@ -124,56 +145,58 @@ bool HMM::train_(TimeSeriesClassificationData &trainingData){
 	models.resize( numClasses );
     classLabels.resize( numClasses );
 
-	//Init the models
+	//Init the models, each model gets its own stream so the models can be trained in parallel and the result only depends on the seed
+    const unsigned long long firstStream = random.getRandomNumberUInt64();
 	for(UINT k=0; k<numClasses; k++){
+		models[k].random = random.split( firstStream + k );
 		models[k].resetModel(numStates,numSymbols,modelType,delta);
 		models[k].maxNumIter = maxNumIter;
 		models[k].minImprovement = minImprovement;
 	}
     
-    //Train each of the models
+    //Convert the training data for each class into a list of observation sequences
+    vector< vector< vector< UINT > > > observationSequences( numClasses );
     for(UINT k=0; k<numClasses; k++){
         //Get the class ID of this gesture
         UINT classID = trainingData.getClassTracker()[k].classLabel;
         classLabels[k] = classID;
         
-        //Convert this classes training data into a list of observation sequences
         TimeSeriesClassificationData classData = trainingData.getClassData( classID );
-        vector< vector< UINT > > observationSequences;
-        if( !convertDataToObservationSequence( classData, observationSequences ) ){
+        if( !convertDataToObservationSequence( classData, observationSequences[k] ) ){
             return false;
         }
-        
-        //Train the model
-		if( !models[k].train( observationSequences ) ){
-            errorLog << "train_(TimeSeriesClassificationData &trainingData) - Failed to train HMM for class " << classID << endl;
-            return false;
+    }
+    
+    //Train each of the models, the models are independent so they are trained in parallel. If there are fewer classes
+    //than threads then the remaining threads are shared out to run the Baum-Welch algorithm of each model in parallel
+    const UINT numClassThreads = ParallelTaskRunner::getNumThreadsForTasks( numClasses );
+    const UINT numModelThreads = MAX( ParallelTaskRunner::getDefaultNumThreads() / numClassThreads, 1 );
+    for(UINT k=0; k<numClasses; k++){
+        models[k].numThreads = numModelThreads;
+    }
+    
+    HMMClassTrainingTask trainingTask( models, observationSequences );
+    if( !ParallelTaskRunner::run( trainingTask, numClasses, numClassThreads ) ){
+        for(UINT k=0; k<numClasses; k++){
+            if( trainingTask.trainingFailed[k] ){
+                errorLog << "train_(TimeSeriesClassificationData &trainingData) - Failed to train HMM for class " << classLabels[k] << endl;
+            }
         }
-	}
+        return false;
+    }
     
     //Compute the rejection thresholds
     nullRejectionThresholds.resize(numClasses);
     
     for(UINT k=0; k<numClasses; k++){
-        //Get the class ID of this gesture
-        UINT classID = trainingData.getClassTracker()[k].classLabel;
-        classLabels[k] = classID;
-        
-        //Convert this classes training data into a list of observation sequences
-        TimeSeriesClassificationData classData = trainingData.getClassData( classID );
-        vector< vector< UINT > > observationSequences;
-        if( !convertDataToObservationSequence( classData, observationSequences ) ){
-            return false;
-        }
-        
         //Test the model
         double loglikelihood = 0;
         double avgLoglikelihood = 0;
-        for(UINT i=0; i<observationSequences.size(); i++){
-            loglikelihood = models[k].predict( observationSequences[i] );
+        for(UINT i=0; i<observationSequences[k].size(); i++){
+            loglikelihood = models[k].predict( observationSequences[k][i] );
             avgLoglikelihood += fabs( loglikelihood );
         }
-        nullRejectionThresholds[k] = -( avgLoglikelihood / double( observationSequences.size() ) );
+        nullRejectionThresholds[k] = -( avgLoglikelihood / double( observationSequences[k].size() ) );
 	}
     
     //Flag that the model has been trained
@@ -36,6 +36,7 @@ HiddenMarkovModel::HiddenMarkovModel(){
 	modelType = ERGODIC;
 	logLikelihood = 0.0;
 	minImprovement = 1.0e-5;
+	numThreads = 0;
     
     debugLog.setProceedingText("[DEBUG HiddenMarkovModel]");
     errorLog.setProceedingText("[ERROR HiddenMarkovModel]");
@@ -55,6 +56,7 @@ HiddenMarkovModel::HiddenMarkovModel(const UINT numStates,const UINT numSymbols,
 	cThreshold = -1000;
 	logLikelihood = 0.0;
 	minImprovement = 1.0e-5;
+	numThreads = 0;
     
     debugLog.setProceedingText("[DEBUG HiddenMarkovModel]");
     errorLog.setProceedingText("[ERROR HiddenMarkovModel]");
@@ -74,6 +76,7 @@ HiddenMarkovModel::HiddenMarkovModel(const MatrixDouble &a,const MatrixDouble &b
 	cThreshold = -1000;
 	logLikelihood = 0.0;
 	minImprovement = 1.0e-5;
+	numThreads = 0;
 	modelTrained = false;
     
     debugLog.setProceedingText("[DEBUG HiddenMarkovModel]");
@@ -106,6 +109,8 @@ HiddenMarkovModel::HiddenMarkovModel(const HiddenMarkovModel &rhs){
 	this->modelType = rhs.modelType;
 	this->logLikelihood = rhs.logLikelihood;
 	this->minImprovement = rhs.minImprovement;
+	this->numThreads = rhs.numThreads;
+	this->random = rhs.random;
 	this->a = rhs.a;
 	this->b = rhs.b;
 	this->pi = rhs.pi;
@@ -147,7 +152,6 @@ bool HiddenMarkovModel::randomizeMatrices(const UINT numStates,const UINT numSym
 	//Fill Transition and Symbol Matrices randomly
     //It's best to choose values in the range [0.9 1.1] rather than [0 1]
     //That way, no single value will get too large or too small a weight when the values are normalized
-	Random random;
 	for(UINT i=0; i<a.getNumRows(); i++)
 		for(UINT j=0; j<a.getNumCols(); j++)
 			a[i][j] = random.getRandomNumberUniform(0.9,1);
@@ -486,34 +490,165 @@ bool HiddenMarkovModel::train(const vector< vector<UINT> > &trainingData){
 	return true;
 }
 
+//The number of observation sequences in each Baum-Welch task, the sequences are always split into chunks of this size
+//so that the expected counts are summed in the same order no matter how many threads are used
+#define HMM_BAUM_WELCH_CHUNK_SIZE 8
+
+//The expected counts of one chunk of observation sequences, which are used to re-estimate A and B
+class HMMExpectedCounts{
+public:
+    HMMExpectedCounts(){
+        loglikelihood = 0;
+    }
+    ~HMMExpectedCounts(){}
+    MatrixDouble aNum;      //The expected number of transitions from state i to state j, without the a[i][j] term
+    VectorDouble aDenom;    //The expected number of transitions from state i
+    MatrixDouble bNum;      //The expected number of times symbol j is emitted in state i
+    VectorDouble bDenom;    //The expected number of times in state i
+    double loglikelihood;   //The sum of the loglikelihoods of the sequences in the chunk
+};
+
+//Runs the forward backward algorithm for one chunk of observation sequences and accumulates the expected counts of
+//that chunk. Each thread has its own alpha, beta and c workspace which is sized for the longest sequence, so no
+//memory is allocated while the model is being trained
+class HMMBaumWelchTask : public ParallelTask{
+public:
+    HMMBaumWelchTask(HiddenMarkovModel &model,const vector< vector<UINT> > &obs):model(model),obs(obs){
+        const UINT N = model.numStates;
+        const UINT numObs = (UINT)obs.size();
+        UINT maxT = 0;
+        for(UINT k=0; k<numObs; k++){
+            if( obs[k].size() > maxT ) maxT = (UINT)obs[k].size();
+        }
+
+        numChunks = (numObs + HMM_BAUM_WELCH_CHUNK_SIZE - 1) / HMM_BAUM_WELCH_CHUNK_SIZE;
+        numThreads = ParallelTaskRunner::getNumThreadsForTasks(numChunks,model.numThreads);
+
+        workspaces.resize( numThreads );
+        emissions.resize( numThreads );
+        for(UINT i=0; i<numThreads; i++){
+            workspaces[i].alpha.resize(maxT,N);
+            workspaces[i].beta.resize(maxT,N);
+            workspaces[i].c.resize(maxT);
+            emissions[i].resize(N);
+        }
+
+        counts.resize( numChunks );
+        for(UINT i=0; i<numChunks; i++){
+            counts[i].aNum.resize(N,N);
+            counts[i].aDenom.resize(N);
+            counts[i].bNum.resize(N,model.numSymbols);
+            counts[i].bDenom.resize(N);
+        }
+
+        firstAlpha.resize(numObs,N);
+        secondBeta.resize(numObs,N);
+    }
+
+    virtual ~HMMBaumWelchTask(){}
+
+    virtual bool runTask(const UINT taskIndex,const UINT threadIndex){
+
+        const UINT N = model.numStates;
+        const UINT numObs = (UINT)obs.size();
+        const UINT startIndex = taskIndex * HMM_BAUM_WELCH_CHUNK_SIZE;
+        const UINT endIndex = startIndex + HMM_BAUM_WELCH_CHUNK_SIZE < numObs ? startIndex + HMM_BAUM_WELCH_CHUNK_SIZE : numObs;
+        HMMTrainingObject &hmm = workspaces[ threadIndex ];
+        VectorDouble &emission = emissions[ threadIndex ];
+        HMMExpectedCounts &chunk = counts[ taskIndex ];
+        UINT i,j,t = 0;
+
+        chunk.aNum.setAllValues( 0 );
+        chunk.bNum.setAllValues( 0 );
+        std::fill(chunk.aDenom.begin(),chunk.aDenom.end(),0);
+        std::fill(chunk.bDenom.begin(),chunk.bDenom.end(),0);
+        chunk.loglikelihood = 0;
+
+        for(UINT k=startIndex; k<endIndex; k++){
+            const vector< UINT > &o = obs[k];
+            const UINT T = (UINT)o.size();
+
+            if( !model.forwardBackward(hmm,o) ){
+                return false;
+            }
+            chunk.loglikelihood += hmm.pk;
+
+            for(t=0; t<T; t++){
+                const double *alphaT = hmm.alpha[t];
+                const double *betaT = hmm.beta[t];
+                const double scale = hmm.c[t];
+
+                //Accumulate the expected transitions from t to t+1
+                if( t+1 < T ){
+                    const double *betaNext = hmm.beta[t+1];
+                    const UINT symbol = o[t+1];
+                    for(j=0; j<N; j++) emission[j] = model.b[j][ symbol ] * betaNext[j];
+                    for(i=0; i<N; i++){
+                        double *aNum = chunk.aNum[i];
+                        const double alpha = alphaT[i];
+                        for(j=0; j<N; j++) aNum[j] += alpha * emission[j];
+                        chunk.aDenom[i] += alphaT[i] * betaT[i] / scale;
+                    }
+                }
+
+                //Accumulate the expected emissions at t
+                for(i=0; i<N; i++){
+                    const double gamma = alphaT[i] * betaT[i] / scale;
+                    chunk.bNum[i][ o[t] ] += gamma;
+                    chunk.bDenom[i] += gamma;
+                }
+            }
+
+            //Keep the values needed to re-estimate pi
+            for(i=0; i<N; i++){
+                firstAlpha[k][i] = hmm.alpha[0][i];
+                secondBeta[k][i] = T > 1 ? hmm.beta[1][i] : 0;
+            }
+        }
+
+        return true;
+    }
+
+    HiddenMarkovModel &model;
+    const vector< vector<UINT> > &obs;
+    UINT numChunks;
+    UINT numThreads;
+    vector< HMMTrainingObject > workspaces;     //The forward backward workspace for each thread
+    vector< VectorDouble > emissions;           //A workspace for each thread that holds b[j][o(t+1)] * beta[t+1][j]
+    vector< HMMExpectedCounts > counts;         //The expected counts for each chunk
+    MatrixDouble firstAlpha;                    //The alpha values at t=0 for each sequence
+    MatrixDouble secondBeta;                    //The beta values at t=1 for each sequence
+};
+
 bool HiddenMarkovModel::train_(const vector< vector<UINT> > &obs,const UINT maxIter, UINT &currentIter,double &newLoglikelihood){
     
     const UINT numObs = (unsigned int)obs.size();
-    UINT i,j,k,t = 0;
-    double num,denom,oldLoglikelihood = 0;
+    UINT i,j,k,c = 0;
+    double denom,oldLoglikelihood = 0;
     bool keepTraining = true;
     trainingIterationLog.clear();
     
-    //Create the array to hold the data for each training instance
-    vector< HMMTrainingObject > hmms( numObs );
-    
-    //Create epislon and gamma to hold the re-estimation variables
-    vector< vector< MatrixDouble > > epsilon( numObs );
-    vector< MatrixDouble > gamma( numObs );
+    if( numObs == 0 ){
+        errorLog << "train_(...) - There are no observation sequences!" << endl;
+        return false;
+    }
     
-    //Resize the hmms, epsilon and gamma matrices so they are ready to be filled
     for(k=0; k<numObs; k++){
-        const UINT T = (UINT)obs[k].size();
-        gamma[k].resize(T,numStates);
-        epsilon[k].resize(T);
-        for(t=0; t<T; t++) epsilon[k][t].resize(numStates,numStates);
-        
-        //Resize alpha, beta and phi
-        hmms[k].alpha.resize(T,numStates);
-        hmms[k].beta.resize(T,numStates);
-        hmms[k].c.resize(T);
+        if( obs[k].size() == 0 ){
+            errorLog << "train_(...) - Observation sequence " << k << " is empty!" << endl;
+            return false;
+        }
     }
     
+    //Create the Baum-Welch task, this allocates the workspace for each thread and the expected counts for each chunk of sequences
+    HMMBaumWelchTask baumWelch(*this,obs);
+    
+    //Create the matrices to hold the total expected counts
+    MatrixDouble aNum(numStates,numStates);
+    MatrixDouble bNum(numStates,numSymbols);
+    VectorDouble aDenom(numStates);
+    VectorDouble bDenom(numStates);
+    
     //For each training seq, run one pass of the forward backward
     //algorithm then reestimate a and b using the Baum-Welch
     oldLoglikelihood = 0;
@@ -521,14 +656,26 @@ bool HiddenMarkovModel::train_(const vector< vector<UINT> > &obs,const UINT maxI
     currentIter = 0;
     
     do{
-        newLoglikelihood = 0.0;
+        //Run the forwardbackward algorithm for each training example, the chunks of sequences are run in parallel
+        if( !ParallelTaskRunner::run(baumWelch,baumWelch.numChunks,baumWelch.numThreads) ){
+            return false;
+        }
         
-        //Run the forwardbackward algorithm for each training example
-        for(k=0; k<numObs; k++){
-            if( !forwardBackward(hmms[k],obs[k]) ){
-                return false;
+        //Sum the expected counts of each chunk, this is done in chunk order so the result does not depend on the number of threads
+        newLoglikelihood = 0.0;
+        aNum.setAllValues( 0 );
+        bNum.setAllValues( 0 );
+        std::fill(aDenom.begin(),aDenom.end(),0);
+        std::fill(bDenom.begin(),bDenom.end(),0);
+        for(c=0; c<baumWelch.numChunks; c++){
+            const HMMExpectedCounts &chunk = baumWelch.counts[c];
+            newLoglikelihood += chunk.loglikelihood;
+            for(i=0; i<numStates; i++){
+                for(j=0; j<numStates; j++) aNum[i][j] += chunk.aNum[i][j];
+                for(j=0; j<numSymbols; j++) bNum[i][j] += chunk.bNum[i][j];
+                aDenom[i] += chunk.aDenom[i];
+                bDenom[i] += chunk.bDenom[i];
             }
-            newLoglikelihood += hmms[k].pk;
         }
         
         //Set the new log likelihood as the average of the observations
@@ -552,27 +699,9 @@ bool HiddenMarkovModel::train_(const vector< vector<UINT> > &obs,const UINT maxI
 
             //Re-estimate A
             for(i=0; i<numStates; i++){
-                
-                //Compute the denominator of A (which is independent of j)
-                denom = 0;
-                for(k=0; k<numObs; k++){
-                    for(t=0; t<obs[k].size()-1; t++){
-                        denom += hmms[k].alpha[t][i] * hmms[k].beta[t][i] / hmms[k].c[t];
-                    }
-                }
-                
-                //Compute the numerator and also update a[i][j]
-                if( denom > 0 ){
+                if( aDenom[i] > 0 ){
                     for(j=0; j<numStates; j++){
-                        num = 0;
-                        for(k=0; k<numObs; k++){
-                            for(t=0; t<obs[k].size()-1; t++){
-                                num += hmms[k].alpha[t][i] * a[i][j] * b[j][ obs[k][t+1] ] * hmms[k].beta[t+1][j];
-                            }
-                        }
-                    
-                        //Update a[i][j]
-                        a[i][j] = num/denom;
+                        a[i][j] = a[i][j] * aNum[i][j] / aDenom[i];
                     }
                 }else{
                     errorLog << "Denom is zero for A!" << endl;
@@ -583,27 +712,15 @@ bool HiddenMarkovModel::train_(const vector< vector<UINT> > &obs,const UINT maxI
             //Re-estimate B
             bool renormB = false;
             for(i=0; i<numStates; i++){
+                if( bDenom[i] == 0 ){
+                    errorLog << "Denominator is zero for B!" << endl;
+                    return false;
+                }
                 for(j=0; j<numSymbols; j++){
-                    num=0.0;
-                    denom = 0.0;
-                    for(k=0; k<numObs; k++){
-                        const UINT T = (unsigned int)obs[k].size();
-                        for(t=0; t<T; t++){
-                            if( obs[k][t] == j ){
-                                num += hmms[k].alpha[t][i] * hmms[k].beta[t][i] / hmms[k].c[t];
-                            }
-                            denom += hmms[k].alpha[t][i] * hmms[k].beta[t][i] / hmms[k].c[t];
-                        }
-                    }
-                    
-                    if( denom == 0 ){
-                        errorLog << "Denominator is zero for B!" << endl;
-                        return false;
-                    }
                     //Update b[i][j]
                     //If there are no observations at all for a state then the probabilities will be zero which is bad
                     //So instead we flag that B needs to be renormalized later
-                    if( num > 0 ) b[i][j] = denom > 0 ? num/denom : 1.0e-5;
+                    if( bNum[i][j] > 0 ) b[i][j] = bNum[i][j] / bDenom[i];
                     else{ b[i][j] = 0; renormB = true; }
                 }
             }
@@ -621,44 +738,35 @@ bool HiddenMarkovModel::train_(const vector< vector<UINT> > &obs,const UINT maxI
             }
             
             //Re-estimate Pi - only if the model type is ERGODIC, otherwise Pi[0] == 1 and everything else is 0
+            //Pi is estimated from epsilon at t=0, which uses the updated A and B
             if (modelType==ERGODIC ){
+                VectorDouble gammaSum(numStates,0);
+                MatrixDouble epsilon(numStates,numStates);
                 for(k=0; k<numObs; k++){
-                    const UINT T = (unsigned int)obs[k].size();
+                    if( obs[k].size() < 2 ) continue;
+                    const UINT symbol = obs[k][1];
+                    
                     //Compute epsilon
-                    for(t=0; t<T-1; t++){
-                        denom = 0.0;
-                        for(i=0; i<numStates; i++){
-                            for(j=0; j<numStates; j++){
-                                epsilon[k][t][i][j] = hmms[k].alpha[t][i] * a[i][j] * b[j][ obs[k][t+1] ] * hmms[k].beta[t+1][j];
-                                denom += epsilon[k][t][i][j];
-                            }
-                        }
-                        //Normalize Epsilon
-                        for(i=0; i<numStates; i++){
-                            for(j=0; j<numStates; j++){
-                                if(denom!=0) epsilon[k][t][i][j] /= denom;
-                                else{ epsilon[k][t][i][j] = 0; }
-                            }
+                    denom = 0.0;
+                    for(i=0; i<numStates; i++){
+                        for(j=0; j<numStates; j++){
+                            epsilon[i][j] = baumWelch.firstAlpha[k][i] * a[i][j] * b[j][ symbol ] * baumWelch.secondBeta[k][j];
+                            denom += epsilon[i][j];
                         }
                     }
                     
-                    //Compute gamma
-                    for(t=0; t<T-1; t++){
-                        for(i=0; i<numStates; i++){
-                            gamma[k][t][i]= 0.0;
-                            for(j=0; j<numStates; j++)
-                                gamma[k][t][i] += epsilon[k][t][i][j];
+                    //Normalize epsilon and compute gamma
+                    for(i=0; i<numStates; i++){
+                        double gamma = 0.0;
+                        for(j=0; j<numStates; j++){
+                            gamma += denom != 0 ? epsilon[i][j] / denom : 0;
                         }
+                        gammaSum[i] += gamma;
                     }
                 }
                 
-                double sum = 0;
                 for(i=0; i<numStates; i++){
-                    sum=0.0;
-                    for(k=0; k<numObs; k++){
-                        sum += gamma[k][0][i];
-                    }
-                    pi[i] = sum / numObs;
+                    pi[i] = gammaSum[i] / numObs;
                 }
             }
         }
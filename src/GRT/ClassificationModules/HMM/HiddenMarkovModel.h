@@ -36,7 +36,7 @@
 
 namespace GRT {
 
-//This class is used for the HMM batch training
+//This class is used for the HMM batch training, it holds the forward backward workspace for one thread
 class HMMTrainingObject{
 public:
 	HMMTrainingObject(){
@@ -92,6 +92,8 @@ public:
 	double logLikelihood;	//The log likelihood of an observation sequence given the modal, calculated by the forward method
 	double cThreshold;		//The classification threshold for this model
 	double minImprovement;	//The minimum improvement value for the training loop
+	UINT numThreads;		//The maximum number of threads used to run the Baum-Welch algorithm, zero uses the ParallelTaskRunner default
+	Random random;			//The generator used to randomize the matrices
     CircularBuffer<UINT> observationSequence;
     vector< UINT > estimatedStates;
 
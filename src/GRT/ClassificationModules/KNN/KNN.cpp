@@ -103,6 +103,86 @@ bool KNN::deepCopyFrom(const Classifier *classifier){
     return false;
 }
 
+//Finds the sorted nearest neighbours of one query sample. Each query has its own list, so the queries are searched in
+//parallel. The lists hold the class index and distance of each neighbour, ordered by distance and then by the index of
+//the reference sample, so the lists are the same whichever search is used
+class KNNNeighbourSearchTask : public ParallelTask{
+public:
+    KNNNeighbourSearchTask(KNN &knn,const ClassificationData &referenceData,const ClassificationData &queryData,const UINT maxK,vector< vector< IndexedDouble > > &neighbourLists):knn(knn),queryData(queryData),maxK(maxK),neighbourLists(neighbourLists){
+        //Store the class index of each reference sample, so the search does not need to look up the class labels
+        classIndexs.resize( referenceData.getNumSamples(), 0 );
+        referenceSamples.resize( referenceData.getNumSamples() );
+        for(UINT i=0; i<referenceData.getNumSamples(); i++){
+            referenceSamples[i] = referenceData[i].getSample();
+            for(UINT j=0; j<knn.classLabels.size(); j++){
+                if( referenceData[i].getClassLabel() == knn.classLabels[j] ){
+                    classIndexs[i] = j;
+                    break;
+                }
+            }
+        }
+    }
+    virtual ~KNNNeighbourSearchTask(){}
+
+    virtual bool runTask(const UINT taskIndex,const UINT threadIndex){
+        const VectorDouble query = queryData[ taskIndex ].getSample();
+        vector< IndexedDouble > &neighbours = neighbourLists[ taskIndex ];
+
+        if( tree.getTreeBuilt() ){
+            vector< UINT > indices;
+            vector< double > distances;
+            const UINT numFound = tree.nearestSearch( query, maxK, indices, distances );
+            neighbours.resize( numFound );
+            for(UINT k=0; k<numFound; k++){
+                neighbours[k] = IndexedDouble( classIndexs[ indices[k] ], distances[k] );
+            }
+            return numFound == maxK;
+        }
+
+        //Compute the distance to every reference sample, then keep the maxK nearest
+        const UINT M = (UINT)referenceSamples.size();
+        vector< IndexedDouble > candidates( M );
+        for(UINT i=0; i<M; i++){
+            const VectorDouble &sample = referenceSamples[i];
+            double dist = 0;
+            switch( knn.distanceMethod ){
+                case KNN::EUCLIDEAN_DISTANCE:
+                    dist = knn.computeEuclideanDistance( query, sample );
+                    break;
+                case KNN::COSINE_DISTANCE:
+                    dist = knn.computeCosineDistance( query, sample );
+                    break;
+                case KNN::MANHATTAN_DISTANCE:
+                    dist = knn.computeManhattanDistance( query, sample );
+                    break;
+                default:
+                    return false;
+            }
+            candidates[i] = IndexedDouble( i, dist );
+        }
+        std::partial_sort( candidates.begin(), candidates.begin() + maxK, candidates.end(), compareDistance );
+
+        neighbours.resize( maxK );
+        for(UINT k=0; k<maxK; k++){
+            neighbours[k] = IndexedDouble( classIndexs[ candidates[k].index ], candidates[k].value );
+        }
+        return true;
+    }
+
+    static bool compareDistance(const IndexedDouble &a,const IndexedDouble &b){
+        if( a.value != b.value ) return a.value < b.value;
+        return a.index < b.index;
+    }
+
+    KNN &knn;
+    const ClassificationData &queryData;
+    const UINT maxK;
+    vector< vector< IndexedDouble > > &neighbourLists;
+    vector< VectorDouble > referenceSamples;
+    vector< UINT > classIndexs;
+    KDTree tree;
+};
+
 bool KNN::train_(ClassificationData &trainingData){
     
     //Clear any previous models
@@ -138,48 +218,58 @@ bool KNN::train_(ClassificationData &trainingData){
         return train_(trainingData,K);
     }
 
-    //If we have got this far then we are going to search for the best K value
-    UINT index = 0;
+    //If we have got this far then we are going to search for the best K value. The data is split once, with 80% used
+    //as the reference samples and 20% used to test them. The sorted neighbour list of each test sample is computed once
+    //for the largest K value, so each K value can then be scored from the first K neighbours of each list
+    ClassificationData trainingSet(trainingData);
+    ClassificationData testSet = trainingSet.partition(80,true,random);
+
+    const UINT maxK = MIN( maxKSearchValue, trainingSet.getNumSamples() );
+    vector< vector< IndexedDouble > > neighbourLists;
+    if( !computeNeighbourLists( trainingSet, testSet, maxK, neighbourLists ) ){
+        errorLog << "train_(ClassificationData &trainingData) - Failed to compute the nearest neighbours of the test samples" << endl;
+        return false;
+    }
+
+    //Get the class index of each test sample so it can be compared with the predicted class index
+    vector< UINT > testClassIndexs( testSet.getNumSamples(), 0 );
+    for(UINT i=0; i<testSet.getNumSamples(); i++){
+        for(UINT j=0; j<numClasses; j++){
+            if( testSet[i].getClassLabel() == classLabels[j] ){
+                testClassIndexs[i] = j;
+                break;
+            }
+        }
+    }
+
     double bestAccuracy = 0;
     vector< IndexedDouble > trainingAccuracyLog;
+    VectorDouble likelihoods;
+    VectorDouble distances;
 
     for(UINT k=minKSearchValue; k<=maxKSearchValue; k++){
-        //Randomly spilt the data and use 80% to train the algorithm and 20% to test it
-        ClassificationData trainingSet(trainingData);
-        ClassificationData testSet = trainingSet.partition(80,true);
 
-        if( !train_(trainingSet, k) ){
+        if( k == 0 || k > maxK ){
             errorLog << "Failed to train model for a k value of " << k << endl;
-        }else{
-
-            //Compute the classification error
-            double accuracy = 0;
-            for(UINT i=0; i<testSet.getNumSamples(); i++){
-
-                VectorDouble sample = testSet[i].getSample();
-
-                if( !predict( sample , k) ){
-                    errorLog << "Failed to predict label for test sample with a k value of " << k << endl;
-                    return false;
-                }
+            continue;
+        }
 
-                if( testSet[i].getClassLabel() == predictedClassLabel ){
-                    accuracy++;
-                }
+        //Compute the classification error
+        double accuracy = 0;
+        for(UINT i=0; i<testSet.getNumSamples(); i++){
+            if( computeClassScores( neighbourLists[i], k, likelihoods, distances ) == testClassIndexs[i] ){
+                accuracy++;
             }
+        }
 
-            accuracy = accuracy /double( testSet.getNumSamples() ) * 100.0;
-            trainingAccuracyLog.push_back( IndexedDouble(k,accuracy) );
-			
-			trainingLog << "K:\t" << k << "\tAccuracy:\t" << accuracy << endl;
+        accuracy = accuracy /double( testSet.getNumSamples() ) * 100.0;
+        trainingAccuracyLog.push_back( IndexedDouble(k,accuracy) );
 
-            if( accuracy > bestAccuracy ){
-                bestAccuracy = accuracy;
-            }
+		trainingLog << "K:\t" << k << "\tAccuracy:\t" << accuracy << endl;
 
-            index++;
+        if( accuracy > bestAccuracy ){
+            bestAccuracy = accuracy;
         }
-
     }
 
     if( bestAccuracy > 0 ){
@@ -233,22 +323,25 @@ bool KNN::train_(const ClassificationData &trainingData,const UINT K){
         trainingSigma.resize( numClasses, 0 );
         nullRejectionThresholds.resize( numClasses, 0 );
 
-        //Compute Mu for each of the classes
+        //Find the K nearest neighbours of every training sample in one sweep
         const unsigned int numTrainingExamples = trainingData.getNumSamples();
+        vector< vector< IndexedDouble > > neighbourLists;
+        if( !computeNeighbourLists( this->trainingData, trainingData, K, neighbourLists ) ){
+            errorLog << "train_(const ClassificationData &trainingData,const UINT K) - Failed to compute the nearest neighbours of the training samples" << endl;
+            trained = false;
+            useNullRejection = true;
+            return false;
+        }
+
+        //Compute Mu for each of the classes
         vector< IndexedDouble > predictionResults( numTrainingExamples );
+        VectorDouble likelihoods;
+        VectorDouble distances;
         for(UINT i=0; i<numTrainingExamples; i++){
-            predict( trainingData[i].getSample(), K);
-
-            UINT classLabelIndex = 0;
-            for(UINT k=0; k<numClasses; k++){
-                if( predictedClassLabel == classLabels[k] ){
-                    classLabelIndex = k;
-                    break;
-                }
-            }
+            const UINT classLabelIndex = computeClassScores( neighbourLists[i], K, likelihoods, distances );
 
             predictionResults[ i ].index = classLabelIndex;
-            predictionResults[ i ].value = classDistances[ classLabelIndex ];
+            predictionResults[ i ].value = distances[ classLabelIndex ];
 
             trainingMu[ classLabelIndex ] += predictionResults[ i ].value;
             counter[ classLabelIndex ]++;
@@ -336,6 +429,25 @@ bool KNN::predict_(VectorDouble &inputVector){
     return predict(inputVector,K);
 }
 
+bool KNN::predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const{
+
+    //Nothing is logged here, as the logs of this instance are shared by every thread that uses it
+    if( !trained || inputVector.size() != numInputDimensions || K > trainingData.getNumSamples() ){
+        return false;
+    }
+
+    //Scale a copy of the input vector if needed, the caller's vector is not changed
+    if( useScaling ){
+        VectorDouble scaledVector( numInputDimensions );
+        for(UINT i=0; i<numInputDimensions; i++){
+            scaledVector[i] = scale(inputVector[i], ranges[i].minValue, ranges[i].maxValue, 0, 1);
+        }
+        return predict(scaledVector,K,prediction);
+    }
+
+    return predict(inputVector,K,prediction);
+}
+
 bool KNN::predict(const VectorDouble &inputVector,const UINT K){
 
     if( !trained ){
@@ -353,6 +465,28 @@ bool KNN::predict(const VectorDouble &inputVector,const UINT K){
         return false;
     }
 
+    //Run the prediction into this instance's results, reusing the buffers of the last prediction
+    ClassifierPrediction prediction;
+    prediction.classLikelihoods.swap( classLikelihoods );
+    prediction.classDistances.swap( classDistances );
+
+    const bool result = predict(inputVector,K,prediction);
+
+    classLikelihoods.swap( prediction.classLikelihoods );
+    classDistances.swap( prediction.classDistances );
+    if( result ){
+        predictedClassLabel = prediction.predictedClassLabel;
+        maxLikelihood = prediction.maxLikelihood;
+    }else{
+        errorLog << "predict(VectorDouble inputVector,UINT K) - Failed to predict, the distance measure is unknown or a training sample has a class label of zero!" << endl;
+    }
+    return result;
+}
+
+bool KNN::predict(const VectorDouble &inputVector,const UINT K,ClassifierPrediction &prediction) const{
+
+    //The input has been checked by the caller. This can be run by several threads at once, so it must not write to the logs
+
     //TODO - need to build a kdtree of the training data to allow better realtime prediction
     const UINT M = trainingData.getNumSamples();
     vector< IndexedDouble > neighbours;
@@ -373,7 +507,6 @@ bool KNN::predict(const VectorDouble &inputVector,const UINT K){
                 dist = computeManhattanDistance(inputVector, trainingSample);
                 break;
             default:
-                errorLog << "predict(vector< double > inputVector) - unkown distance measure!" << endl;
                 return false;
                 break;
         }
@@ -399,17 +532,9 @@ bool KNN::predict(const VectorDouble &inputVector,const UINT K){
     }
 
     //Predict the class ID using the labels of the K nearest neighbours
-    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses);
-    if( classDistances.size() != numClasses ) classDistances.resize(numClasses);
-    
-    std::fill(classLikelihoods.begin(),classLikelihoods.end(),0);
-    std::fill(classDistances.begin(),classDistances.end(),0);
-
-    //Count the classes
     for(UINT k=0; k<neighbours.size(); k++){
         UINT classLabel = neighbours[k].index;
         if( classLabel == 0 ){
-            errorLog << "predict(VectorDouble inputVector) - Class label of training example can not be zero!" << endl;
             return false;
         }
 
@@ -421,47 +546,85 @@ bool KNN::predict(const VectorDouble &inputVector,const UINT K){
 				break;
 			}
 		}
-        classLikelihoods[ classLabelIndex ] += 1;
-        classDistances[ classLabelIndex ] += neighbours[k].value;
+        neighbours[k].index = classLabelIndex;
+    }
+
+    const UINT maxIndex = computeClassScores( neighbours, (UINT)neighbours.size(), prediction.classLikelihoods, prediction.classDistances );
+
+    //Set the maximum likelihood value
+    prediction.maxLikelihood = prediction.classLikelihoods[ maxIndex ];
+
+    if( useNullRejection ){
+        if( prediction.classDistances[ maxIndex ] <= nullRejectionThresholds[ maxIndex ] ){
+            prediction.predictedClassLabel = classLabels[maxIndex];
+        }else{
+            prediction.predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL; //Set the gesture label as the null label
+        }
+    }else{
+        prediction.predictedClassLabel = classLabels[maxIndex];
+    }
+
+    return true;
+}
+    
+bool KNN::computeNeighbourLists(const ClassificationData &referenceData,const ClassificationData &queryData,const UINT maxK,vector< vector< IndexedDouble > > &neighbourLists){
+
+    const UINT numQueries = queryData.getNumSamples();
+    neighbourLists.clear();
+    neighbourLists.resize( numQueries );
+
+    if( maxK == 0 || maxK > referenceData.getNumSamples() ) return false;
+    if( numQueries == 0 ) return true;
+
+    KNNNeighbourSearchTask task( *this, referenceData, queryData, maxK, neighbourLists );
+
+    //The Euclidean distance can be searched with a kd-tree, the other distances are searched by brute force
+    if( distanceMethod == EUCLIDEAN_DISTANCE ){
+        if( !task.tree.build( referenceData.getDataAsMatrixDouble() ) ) return false;
+    }
+
+    return ParallelTaskRunner::run( task, numQueries );
+}
+
+UINT KNN::computeClassScores(const vector< IndexedDouble > &neighbours,const UINT numNeighbours,VectorDouble &likelihoods,VectorDouble &distances) const{
+
+    if( likelihoods.size() != numClasses ) likelihoods.resize(numClasses);
+    if( distances.size() != numClasses ) distances.resize(numClasses);
+
+    std::fill(likelihoods.begin(),likelihoods.end(),0);
+    std::fill(distances.begin(),distances.end(),0);
+
+    //Count the classes
+    for(UINT k=0; k<numNeighbours; k++){
+        const UINT classLabelIndex = neighbours[k].index;
+        likelihoods[ classLabelIndex ] += 1;
+        distances[ classLabelIndex ] += neighbours[k].value;
     }
 
     //Get the max count
-    double maxCount = classLikelihoods[0];
+    double maxCount = likelihoods[0];
     UINT maxIndex = 0;
-    for(UINT i=1; i<classLikelihoods.size(); i++){
-        if( classLikelihoods[i] > maxCount ){
-            maxCount = classLikelihoods[i];
+    for(UINT i=1; i<likelihoods.size(); i++){
+        if( likelihoods[i] > maxCount ){
+            maxCount = likelihoods[i];
             maxIndex = i;
         }
     }
 
     //Compute the average distances per class
     for(UINT i=0; i<numClasses; i++){
-        if( classLikelihoods[i] > 0 )   classDistances[i] /= classLikelihoods[i];
-        else classDistances[i] = BIG_DISTANCE;
+        if( likelihoods[i] > 0 )   distances[i] /= likelihoods[i];
+        else distances[i] = BIG_DISTANCE;
     }
 
     //Normalize the likelihoods
     for(UINT i=0; i<numClasses; i++){
-        classLikelihoods[i] /= double( neighbours.size() );
+        likelihoods[i] /= double( numNeighbours );
     }
 
-    //Set the maximum likelihood value
-    maxLikelihood = classLikelihoods[ maxIndex ];
-
-    if( useNullRejection ){
-        if( classDistances[ maxIndex ] <= nullRejectionThresholds[ maxIndex ] ){
-            predictedClassLabel = classLabels[maxIndex];
-        }else{
-            predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL; //Set the gesture label as the null label
-        }
-    }else{
-        predictedClassLabel = classLabels[maxIndex];
-    }
-
-    return true;
+    return maxIndex;
 }
-    
+
 bool KNN::clear(){
     
     //Clear the Classifier variables
@@ -662,6 +825,129 @@ bool KNN::loadModelFromFile(fstream &file){
     return true;
 }
     
+bool KNN::saveModelToBinaryFile(BinaryModelFileWriter &file,const string &prefix) const{
+    
+    if( !file.addString( prefix + "Header", "GRT_KNN_BINARY_MODEL_V1.0" ) ) return false;
+    
+    //Write the classifier settings to the file
+    if( !Classifier::saveBaseSettingsToBinaryFile( file, prefix ) ){
+        errorLog << "saveModelToBinaryFile(BinaryModelFileWriter &file,const string &prefix) - Failed to save classifier base settings!" << endl;
+        return false;
+    }
+    
+    if( !file.addUInt( prefix + "K", K ) ) return false;
+    if( !file.addUInt( prefix + "DistanceMethod", distanceMethod ) ) return false;
+    if( !file.addBool( prefix + "SearchForBestKValue", searchForBestKValue ) ) return false;
+    if( !file.addUInt( prefix + "MinKSearchValue", minKSearchValue ) ) return false;
+    if( !file.addUInt( prefix + "MaxKSearchValue", maxKSearchValue ) ) return false;
+    
+    if( trained ){
+        if( useNullRejection ){
+            if( !file.addDoubleArray( prefix + "TrainingMu", trainingMu ) ) return false;
+            if( !file.addDoubleArray( prefix + "TrainingSigma", trainingSigma ) ) return false;
+        }
+        
+        //Pack the training samples into one row major array
+        const UINT M = trainingData.getNumSamples();
+        vector< UINT > labels(M);
+        VectorDouble samples(M*numInputDimensions);
+        for(UINT i=0; i<M; i++){
+            labels[i] = trainingData[i].getClassLabel();
+            for(UINT j=0; j<numInputDimensions; j++){
+                samples[i*numInputDimensions+j] = trainingData[i][j];
+            }
+        }
+        
+        if( !file.addUIntArray( prefix + "TrainingLabels", labels ) ) return false;
+        if( !file.addDoubleArray( prefix + "TrainingData", samples ) ) return false;
+    }
+    
+    return true;
+}
+    
+bool KNN::loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix){
+    
+    string header;
+    if( !file.getString( prefix + "Header", header ) || header != "GRT_KNN_BINARY_MODEL_V1.0" ){
+        errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Could not find Model File Header!" << endl;
+        return false;
+    }
+    
+    //Load the base settings from the file
+    if( !Classifier::loadBaseSettingsFromBinaryFile( file, prefix ) ){
+        errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to load base settings!" << endl;
+        return false;
+    }
+    
+    if( !file.getUInt( prefix + "K", K ) ||
+        !file.getUInt( prefix + "DistanceMethod", distanceMethod ) ||
+        !file.getBool( prefix + "SearchForBestKValue", searchForBestKValue ) ||
+        !file.getUInt( prefix + "MinKSearchValue", minKSearchValue ) ||
+        !file.getUInt( prefix + "MaxKSearchValue", maxKSearchValue ) ){
+        errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to read the KNN settings!" << endl;
+        clear();
+        return false;
+    }
+    
+    if( trained ){
+        
+        trainingMu.resize(numClasses,0);
+        trainingSigma.resize(numClasses,0);
+        
+        if( useNullRejection ){
+            if( !file.getDoubleArray( prefix + "TrainingMu", trainingMu ) || !file.getDoubleArray( prefix + "TrainingSigma", trainingSigma ) ||
+                trainingMu.size() != numClasses || trainingSigma.size() != numClasses ){
+                errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to read TrainingMu and TrainingSigma!" << endl;
+                clear();
+                return false;
+            }
+        }
+        
+        vector< UINT > labels;
+        if( !file.getUIntArray( prefix + "TrainingLabels", labels ) ){
+            errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to read TrainingLabels!" << endl;
+            clear();
+            return false;
+        }
+        const UINT M = (UINT)labels.size();
+        
+        //Use the samples in place if the file allows it, otherwise copy them out of the file first
+        UINT numValues = 0;
+        VectorDouble samplesCopy;
+        const double *samples = file.getDoubleArrayPointer( prefix + "TrainingData", numValues );
+        if( samples == NULL ){
+            if( !file.getDoubleArray( prefix + "TrainingData", samplesCopy ) ){
+                errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to read TrainingData!" << endl;
+                clear();
+                return false;
+            }
+            numValues = (UINT)samplesCopy.size();
+            samples = numValues > 0 ? &samplesCopy[0] : NULL;
+        }
+        
+        if( numValues != M*numInputDimensions ){
+            errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - The size of the TrainingData does not match the number of samples!" << endl;
+            clear();
+            return false;
+        }
+        
+        trainingData.setNumDimensions(numInputDimensions);
+        trainingData.reserve(M);
+        VectorDouble sample(numInputDimensions);
+        for(UINT i=0; i<M; i++){
+            std::copy( samples + i*numInputDimensions, samples + (i+1)*numInputDimensions, sample.begin() );
+            trainingData.addSample(labels[i], sample);
+        }
+        
+        maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
+        bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
+        classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
+        classDistances.resize(numClasses,DEFAULT_NULL_DISTANCE_VALUE);
+    }
+    
+    return true;
+}
+    
 bool KNN::recomputeNullRejectionThresholds(){
     
     if( !trained ){
@@ -721,7 +1007,7 @@ bool KNN::setDistanceMethod(UINT distanceMethod){
     return false;
 }
 
-double KNN::computeEuclideanDistance(const VectorDouble &a,const VectorDouble &b){
+double KNN::computeEuclideanDistance(const VectorDouble &a,const VectorDouble &b) const{
     double dist = 0;
     for(UINT j=0; j<numInputDimensions; j++){
         dist += SQR( a[j] - b[j] );
@@ -729,7 +1015,7 @@ double KNN::computeEuclideanDistance(const VectorDouble &a,const VectorDouble &b
     return sqrt( dist );
 }
 
-double KNN::computeCosineDistance(const VectorDouble &a,const VectorDouble &b){
+double KNN::computeCosineDistance(const VectorDouble &a,const VectorDouble &b) const{
     double dist = 0;
 
     double dotAB = 0;
@@ -747,7 +1033,7 @@ double KNN::computeCosineDistance(const VectorDouble &a,const VectorDouble &b){
     return dist;
 }
 
-double KNN::computeManhattanDistance(const VectorDouble &a,const VectorDouble &b){
+double KNN::computeManhattanDistance(const VectorDouble &a,const VectorDouble &b) const{
     double dist = 0;
 
     for(UINT j=0; j<numInputDimensions; j++){
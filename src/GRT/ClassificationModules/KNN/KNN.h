@@ -43,6 +43,7 @@
 #define GRT_KNN_HEADER
 
 #include "../../CoreModules/Classifier.h"
+#include "../../Util/KDTree.h"
 
 namespace GRT{
     
@@ -110,6 +111,18 @@ public:
      @return returns true if the prediction was performed, false otherwise
     */
     virtual bool predict_(VectorDouble &inputVector);
+
+    /**
+     This predicts the class of the inputVector without changing the KNN instance (including its logs), so one trained KNN
+     model can be shared by several threads. This overrides the predictShared function in the Classifier base class.
+
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassifierPrediction &prediction: returns the predicted class label, likelihoods and distances
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const;
+
+    virtual bool getSupportsSharedPrediction() const{ return true; }
     
     /**
      This overrides the clear function in the Classifier base class.
@@ -137,6 +150,27 @@ public:
      */
     virtual bool loadModelFromFile(fstream &file);
     
+    /**
+     This saves the trained KNN model to a binary model file, the training data is stored as one array of doubles.
+     This overrides the saveModelToBinaryFile function in the MLBase base class.
+     
+     @param BinaryModelFileWriter &file: a reference to the binary model file the KNN model will be added to
+     @param const string &prefix: the prefix of the section names
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveModelToBinaryFile(BinaryModelFileWriter &file,const string &prefix) const;
+    
+    /**
+     This loads a trained KNN model from a binary model file. The training samples are copied straight from the file
+     (or its memory mapping), so nothing needs to be parsed.
+     This overrides the loadModelFromBinaryFile function in the MLBase base class.
+     
+     @param const BinaryModelFileReader &file: a reference to the binary model file the KNN model will be loaded from
+     @param const string &prefix: the prefix of the section names
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix);
+    
     /**
      This recomputes the null rejection thresholds for each of the classes in the KNN model.
      This will be called automatically if the setGamma(double gamma) function is called.
@@ -224,10 +258,30 @@ public:
 protected:
     bool train_(const ClassificationData &trainingData,const UINT K);
     bool predict(const VectorDouble &inputVector,const UINT K);
+    bool predict(const VectorDouble &inputVector,const UINT K,ClassifierPrediction &prediction) const; //Does not check the input or write to the logs
     bool loadLegacyModelFromFile( fstream &file );
-    double computeEuclideanDistance(const VectorDouble &a,const VectorDouble &b);
-    double computeCosineDistance(const VectorDouble &a,const VectorDouble &b);
-    double computeManhattanDistance(const VectorDouble &a,const VectorDouble &b);
+    double computeEuclideanDistance(const VectorDouble &a,const VectorDouble &b) const;
+    double computeCosineDistance(const VectorDouble &a,const VectorDouble &b) const;
+    double computeManhattanDistance(const VectorDouble &a,const VectorDouble &b) const;
+
+    /**
+     Finds the maxK nearest reference samples of each query sample. Each list holds the class index and distance of the
+     neighbours, sorted by distance, so the scores for any K <= maxK can be computed from the first K entries of the list.
+     The queries are searched in parallel, using a kd-tree if the distance method is EUCLIDEAN_DISTANCE.
+
+     @param const ClassificationData &referenceData: the samples the neighbours are found in
+     @param const ClassificationData &queryData: the samples whose neighbours are found
+     @param const UINT maxK: the number of neighbours to find, must not be greater than the number of reference samples
+     @param vector< vector< IndexedDouble > > &neighbourLists: returns the sorted neighbour list of each query sample
+     @return returns true if the neighbours were found, false otherwise
+     */
+    bool computeNeighbourLists(const ClassificationData &referenceData,const ClassificationData &queryData,const UINT maxK,vector< vector< IndexedDouble > > &neighbourLists);
+
+    /**
+     Computes the class likelihoods and average class distances from the first numNeighbours entries of a neighbour list,
+     where the index of each entry is a class index. Returns the index of the class with the most neighbours.
+     */
+    UINT computeClassScores(const vector< IndexedDouble > &neighbours,const UINT numNeighbours,VectorDouble &likelihoods,VectorDouble &distances) const;
     
     UINT K;                                     ///> The number of neighbours to search for
     UINT distanceMethod;                        ///> The distance method used to compute the distance between each data point
@@ -239,6 +293,8 @@ protected:
     VectorDouble trainingSigma;                 ///> Holds the stddev of the max-class distance of the training data for each of classes
     
     static RegisterClassifierModule< KNN > registerModule;
+
+    friend class KNNNeighbourSearchTask;
     
 public:
     enum DistanceMethods{EUCLIDEAN_DISTANCE=0,COSINE_DISTANCE,MANHATTAN_DISTANCE};
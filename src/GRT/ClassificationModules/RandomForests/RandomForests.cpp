@@ -150,8 +150,13 @@ bool RandomForests::train_(ClassificationData &trainingData){
     tree.setMinNumSamplesPerNode( minNumSamplesPerNode );
     tree.setMaxDepth( maxDepth );
     
+    //Each tree is seeded from its own stream, so the forest only depends on the seed of the random forest
+    const unsigned long long firstStream = random.getRandomNumberUInt64();
     for(UINT i=0; i<forestSize; i++){
-        ClassificationData data = trainingData.getBootstrappedDataset();
+        ClassificationData data = trainingData.getBootstrappedDataset( 0, random );
+        
+        //A zero seed would seed the tree from the system time
+        tree.setRandomSeed( random.split( firstStream + i ).getRandomNumberUInt64() | 1 );
         
         if( !tree.train( data ) ){
             errorLog << "train_(ClassificationData &labelledTrainingData) - Failed to train tree at forest index: " << i << endl;
@@ -418,6 +423,100 @@ bool RandomForests::loadModelFromFile(fstream &file){
     return true;
 }
     
+bool RandomForests::saveModelToBinaryFile(BinaryModelFileWriter &file,const string &prefix) const{
+    
+    if( !file.addString( prefix + "Header", "GRT_RANDOM_FOREST_BINARY_MODEL_V1.0" ) ) return false;
+    
+    //Write the classifier settings to the file
+    if( !Classifier::saveBaseSettingsToBinaryFile( file, prefix ) ){
+        errorLog << "saveModelToBinaryFile(BinaryModelFileWriter &file,const string &prefix) - Failed to save classifier base settings!" << endl;
+        return false;
+    }
+    
+    if( !file.addUInt( prefix + "ForestSize", forestSize ) ) return false;
+    if( !file.addUInt( prefix + "NumSplittingSteps", numRandomSplits ) ) return false;
+    if( !file.addUInt( prefix + "MinNumSamplesPerNode", minNumSamplesPerNode ) ) return false;
+    if( !file.addUInt( prefix + "MaxDepth", maxDepth ) ) return false;
+    if( !file.addUInt( prefix + "TrainingMode", trainingMode ) ) return false;
+    
+    if( trained ){
+        if( forest.size() != forestSize ){
+            errorLog << "saveModelToBinaryFile(BinaryModelFileWriter &file,const string &prefix) - The number of trees does not match the ForestSize!" << endl;
+            return false;
+        }
+        
+        vector< UINT > nodeInfo;
+        VectorDouble nodeParameters;
+        for(UINT i=0; i<forestSize; i++){
+            if( !forest[i]->saveTreeToArrays( nodeInfo, nodeParameters ) ){
+                errorLog << "saveModelToBinaryFile(BinaryModelFileWriter &file,const string &prefix) - Failed to save tree " << i << "!" << endl;
+                return false;
+            }
+        }
+        
+        if( !file.addUIntArray( prefix + "NodeInfo", nodeInfo ) ) return false;
+        if( !file.addDoubleArray( prefix + "NodeParameters", nodeParameters ) ) return false;
+    }
+    
+    return true;
+}
+    
+bool RandomForests::loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix){
+    
+    clear();
+    
+    string header;
+    if( !file.getString( prefix + "Header", header ) || header != "GRT_RANDOM_FOREST_BINARY_MODEL_V1.0" ){
+        errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Could not find Model File Header!" << endl;
+        return false;
+    }
+    
+    //Load the base settings from the file
+    if( !Classifier::loadBaseSettingsFromBinaryFile( file, prefix ) ){
+        errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to load base settings!" << endl;
+        return false;
+    }
+    
+    if( !file.getUInt( prefix + "ForestSize", forestSize ) ||
+        !file.getUInt( prefix + "NumSplittingSteps", numRandomSplits ) ||
+        !file.getUInt( prefix + "MinNumSamplesPerNode", minNumSamplesPerNode ) ||
+        !file.getUInt( prefix + "MaxDepth", maxDepth ) ||
+        !file.getUInt( prefix + "TrainingMode", trainingMode ) ){
+        errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to read the forest settings!" << endl;
+        clear();
+        return false;
+    }
+    
+    if( trained ){
+        vector< UINT > nodeInfo;
+        VectorDouble nodeParameters;
+        if( !file.getUIntArray( prefix + "NodeInfo", nodeInfo ) || !file.getDoubleArray( prefix + "NodeParameters", nodeParameters ) ){
+            errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to read the forest!" << endl;
+            clear();
+            return false;
+        }
+        
+        UINT infoIndex = 0;
+        UINT parameterIndex = 0;
+        for(UINT i=0; i<forestSize; i++){
+            DecisionTreeNode *tree = new DecisionTreeNode;
+            
+            if( !tree->loadTreeFromArrays( nodeInfo, nodeParameters, infoIndex, parameterIndex ) ){
+                errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to load tree " << i << "!" << endl;
+                delete tree;
+                clear();
+                return false;
+            }
+            tree->setParent( NULL );
+            
+            //Add the tree to the forest
+            forest.push_back( tree );
+        }
+    }
+    
+    return true;
+}
+    
 UINT RandomForests::getForestSize()const{
     return forestSize;
 }
@@ -133,6 +133,27 @@ public:
      */
     virtual bool loadModelFromFile(fstream &file);
     
+    /**
+     This saves the trained RandomForests model to a binary model file. The nodes of all the trees are stored in two
+     flat arrays, see DecisionTreeNode::saveTreeToArrays.
+     This overrides the saveModelToBinaryFile function in the MLBase base class.
+     
+     @param BinaryModelFileWriter &file: a reference to the binary model file the RandomForests model will be added to
+     @param const string &prefix: the prefix of the section names
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveModelToBinaryFile(BinaryModelFileWriter &file,const string &prefix) const;
+    
+    /**
+     This loads a trained RandomForests model from a binary model file.
+     This overrides the loadModelFromBinaryFile function in the MLBase base class.
+     
+     @param const BinaryModelFileReader &file: a reference to the binary model file the RandomForests model will be loaded from
+     @param const string &prefix: the prefix of the section names
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix);
+    
     /**
      Gets the number of trees in the random forest.
      
@@ -1,5 +1,7 @@
 
 #include "libsvm.h"
+#include "../../../Util/ParallelTaskRunner.h"
+#include <map>
 
 namespace LIBSVM {
 
@@ -1434,7 +1436,7 @@ private:
 //
 static void solve_c_svc(
 	const svm_problem *prob, const svm_parameter* param,
-	double *alpha, Solver::SolutionInfo* si, double Cp, double Cn)
+	double *alpha, Solver::SolutionInfo* si, double Cp, double Cn, const double *initial_alpha)
 {
 	int l = prob->l;
 	double *minus_ones = new double[l];
@@ -1442,9 +1444,10 @@ static void solve_c_svc(
 
 	int i;
 
+	// a warm start must be a feasible point, i.e. 0 <= alpha <= C and y^T alpha = 0
 	for(i=0;i<l;i++)
 	{
-		alpha[i] = 0;
+		alpha[i] = initial_alpha != NULL ? initial_alpha[i] : 0;
 		minus_ones[i] = -1;
 		if(prob->y[i] > 0) y[i] = +1; else y[i] = -1;
 	}
@@ -1641,14 +1644,14 @@ struct decision_function
 
 static decision_function svm_train_one(
 	const svm_problem *prob, const svm_parameter *param,
-	double Cp, double Cn)
+	double Cp, double Cn, const double *initial_alpha = NULL)
 {
 	double *alpha = Malloc(double,prob->l);
 	Solver::SolutionInfo si;
 	switch(param->svm_type)
 	{
 		case C_SVC:
-			solve_c_svc(prob,param,alpha,&si,Cp,Cn);
+			solve_c_svc(prob,param,alpha,&si,Cp,Cn,initial_alpha);
 			break;
 		case NU_SVC:
 			solve_nu_svc(prob,param,alpha,&si);
@@ -1885,22 +1888,51 @@ static void multiclass_probability(int k, double **r, double *p)
 }
 
 // Cross-validation decision values for probability estimates
+static svm_model *svm_train_internal(const svm_problem *prob, const svm_parameter *param, int nr_threads, int **probability_perm, const svm_model *warm_start = NULL);
+static void svm_cross_validation_internal(const svm_problem *prob, const svm_parameter *param, int nr_fold, double *target, int nr_threads);
+
+// Random shuffle of [0,l). The shuffles are drawn from a GRT::Random seeded with param->seed rather than rand(), so
+// training does not share any global state between threads and gives the same model for the same seed
+static int *svm_random_permutation(int l, GRT::Random &random)
+{
+	int *perm = Malloc(int,l);
+	for(int i=0;i<l;i++) perm[i]=i;
+	for(int i=0;i<l;i++)
+	{
+		int j = i+(int)random.getRandomIndex(l-i);
+		std::swap(perm[i],perm[j]);
+	}
+	return perm;
+}
+
+// The shuffles used by svm_binary_svc_probability for each of the k*(k-1)/2 sub-problems, generated in the same
+// order as the serial code so that the sub-problems can then be trained in any order
+static int **svm_probability_permutations(int nr_class, const int *count, GRT::Random &random)
+{
+	int **perms = Malloc(int *,nr_class*(nr_class-1)/2);
+	int p = 0;
+	for(int i=0;i<nr_class;i++)
+		for(int j=i+1;j<nr_class;j++)
+			perms[p++] = svm_random_permutation(count[i]+count[j],random);
+	return perms;
+}
+
+static void svm_free_permutations(int **perms, int n)
+{
+	if(perms == NULL) return;
+	for(int i=0;i<n;i++)
+		free(perms[i]);
+	free(perms);
+}
+
 static void svm_binary_svc_probability(
 	const svm_problem *prob, const svm_parameter *param,
-	double Cp, double Cn, double& probA, double& probB)
+	double Cp, double Cn, const int *perm, double& probA, double& probB)
 {
 	int i;
 	int nr_fold = 5;
-	int *perm = Malloc(int,prob->l);
 	double *dec_values = Malloc(double,prob->l);
 
-	// random shuffle
-	for(i=0;i<prob->l;i++) perm[i]=i;
-	for(i=0;i<prob->l;i++)
-	{
-		int j = i+rand()%(prob->l-i);
-		std::swap(perm[i],perm[j]);
-	}
 	for(i=0;i<nr_fold;i++)
 	{
 		int begin = i*prob->l/nr_fold;
@@ -1953,7 +1985,7 @@ static void svm_binary_svc_probability(
 			subparam.weight_label[1]=-1;
 			subparam.weight[0]=Cp;
 			subparam.weight[1]=Cn;
-			struct svm_model *submodel = svm_train(&subprob,&subparam);
+			struct svm_model *submodel = svm_train_internal(&subprob,&subparam,1,NULL);
 			for(j=begin;j<end;j++)
 			{
 				svm_predict_values(submodel,prob->x[perm[j]],&(dec_values[perm[j]])); 
@@ -1968,7 +2000,6 @@ static void svm_binary_svc_probability(
 	}		
 	sigmoid_train(prob->l,dec_values,prob->y,probA,probB);
 	free(dec_values);
-	free(perm);
 }
 
 // Return parameter of a Laplace distribution 
@@ -1976,7 +2007,7 @@ static double svm_svr_probability(
 	const svm_problem *prob, const svm_parameter *param)
 {
 	int i;
-	int nr_fold = 5;
+	int nr_fold = min(5,prob->l);
 	double *ymv = Malloc(double,prob->l);
 	double mae = 0;
 
@@ -2066,7 +2097,131 @@ static void svm_group_classes(const svm_problem *prob, int *nr_class_ret, int **
 //
 // Interface functions
 //
+// Trains one of the k*(k-1)/2 binary sub-problems of a classification model, each sub-problem only writes to its own
+// decision function and probability values so the sub-problems can be trained in parallel
+class PairwiseTrainingTask : public GRT::ParallelTask
+{
+public:
+	virtual ~PairwiseTrainingTask() {}
+
+	virtual bool runTask(const GRT::UINT p, const GRT::UINT threadIndex)
+	{
+		const int i = pair_i[p], j = pair_j[p];
+		svm_problem sub_prob;
+		int si = start[i], sj = start[j];
+		int ci = count[i], cj = count[j];
+		sub_prob.l = ci+cj;
+		sub_prob.x = Malloc(svm_node *,sub_prob.l);
+		sub_prob.y = Malloc(double,sub_prob.l);
+		int k;
+		for(k=0;k<ci;k++)
+		{
+			sub_prob.x[k] = x[si+k];
+			sub_prob.y[k] = +1;
+		}
+		for(k=0;k<cj;k++)
+		{
+			sub_prob.x[ci+k] = x[sj+k];
+			sub_prob.y[ci+k] = -1;
+		}
+
+		if(param->probability)
+			svm_binary_svc_probability(&sub_prob,param,weighted_C[i],weighted_C[j],perms[p],probA[p],probB[p]);
+
+		f[p] = svm_train_one(&sub_prob,param,weighted_C[i],weighted_C[j],initial_alpha != NULL ? initial_alpha[p] : NULL);
+		free(sub_prob.x);
+		free(sub_prob.y);
+		return true;
+	}
+
+	const svm_parameter *param;
+	svm_node **x;
+	const int *start;
+	const int *count;
+	const double *weighted_C;
+	const int *pair_i;
+	const int *pair_j;
+	int **perms;
+	double **initial_alpha;
+	decision_function *f;
+	double *probA;
+	double *probB;
+};
+
 svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
+{
+	return svm_train_internal(prob,param,0,NULL);
+}
+
+svm_model *svm_train_warm_start(const svm_problem *prob, const svm_parameter *param, const svm_model *warm_start_model, int nr_threads)
+{
+	return svm_train_internal(prob,param,nr_threads,NULL,warm_start_model);
+}
+
+// Builds the initial alphas of each C_SVC sub-problem from a model that was trained with a different C on the same
+// nodes. If C has increased then the old alphas are still feasible and are used as they are, otherwise they are scaled
+// down by the ratio of the two C values. Each alpha at the upper bound costs a full kernel column when the solver builds
+// its initial gradient, so a sub-problem is only warm started if most of its old support vectors are free, otherwise its
+// entry is NULL and it starts from zero. Returns NULL if the model can not be used as a warm start
+static double **svm_warm_start_alphas(const svm_parameter *param, const svm_model *warm_start, int nr_class,
+	const int *label, const int *start, const int *count, svm_node **x, const double *weighted_C)
+{
+	if(warm_start == NULL || param->svm_type != C_SVC || warm_start->param.svm_type != C_SVC) return NULL;
+	if(warm_start->nr_class != nr_class || warm_start->param.C <= 0) return NULL;
+	for(int i=0;i<nr_class;i++)
+		if(warm_start->label[i] != label[i]) return NULL;
+
+	// find the position of each support vector of the warm start model
+	std::map<const svm_node*,int> sv_position;
+	for(int i=0;i<warm_start->l;i++)
+		sv_position[warm_start->SV[i]] = i;
+
+	double ratio = param->C / warm_start->param.C;
+	double scale = std::min(ratio, 1.0);
+	double **initial_alpha = Malloc(double *,nr_class*(nr_class-1)/2);
+	int p = 0;
+	for(int i=0;i<nr_class;i++)
+		for(int j=i+1;j<nr_class;j++)
+		{
+			int ci = count[i], cj = count[j];
+			int nr_free = 0, nr_bounded = 0;
+			initial_alpha[p] = Malloc(double,ci+cj);
+			for(int k=0;k<ci+cj;k++)
+			{
+				const svm_node *node = k < ci ? x[start[i]+k] : x[start[j]+k-ci];
+				std::map<const svm_node*,int>::const_iterator it = sv_position.find(node);
+				double alpha = 0;
+				if(it != sv_position.end())
+				{
+					// classifier (i,j): coefficients of class i are in sv_coef[j-1], of class j in sv_coef[i]
+					double coef = k < ci ? warm_start->sv_coef[j-1][it->second] : warm_start->sv_coef[i][it->second];
+					double upper_bound = k < ci ? weighted_C[i] : weighted_C[j];
+					alpha = fabs(coef);
+					if(alpha > 0)
+					{
+						if(alpha >= upper_bound / ratio) ++nr_bounded;
+						else ++nr_free;
+					}
+					alpha = std::min(alpha * scale, upper_bound);
+				}
+				initial_alpha[p][k] = alpha;
+			}
+			if(nr_bounded > nr_free)
+			{
+				free(initial_alpha[p]);
+				initial_alpha[p] = NULL;
+			}
+			++p;
+		}
+	return initial_alpha;
+}
+
+// nr_threads is the maximum number of threads used to train the sub-problems, zero uses the GRT default. The kernel
+// caches of the sub-problems that are trained at the same time share param->cache_size. If probability_perm is not
+// NULL then it holds the shuffles used to estimate the probabilities, otherwise they are generated here
+// If warm_start is not NULL then it must be a C_SVC model trained on the same svm_node pointers, its alphas are used
+// as the starting point of the solver for each sub-problem
+static svm_model *svm_train_internal(const svm_problem *prob, const svm_parameter *param, int nr_threads, int **probability_perm, const svm_model *warm_start)
 {
 	svm_model *model = Malloc(svm_model,1);
 	model->param = *param;
@@ -2164,43 +2319,73 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 			probB=Malloc(double,nr_class*(nr_class-1)/2);
 		}
 
+		int nr_pair = nr_class*(nr_class-1)/2;
+		int *pair_i = Malloc(int,nr_pair);
+		int *pair_j = Malloc(int,nr_pair);
 		int p = 0;
 		for(i=0;i<nr_class;i++)
 			for(int j=i+1;j<nr_class;j++)
 			{
-				svm_problem sub_prob;
+				pair_i[p] = i;
+				pair_j[p] = j;
+				++p;
+			}
+
+		// the shuffles are drawn before any sub-problem is trained, so the model is the same for any number of threads
+		int **perms = NULL;
+		GRT::Random random(param->seed);
+		if(param->probability)
+			perms = probability_perm != NULL ? probability_perm : svm_probability_permutations(nr_class,count,random);
+
+		double **initial_alpha = svm_warm_start_alphas(param,warm_start,nr_class,label,start,count,x,weighted_C);
+
+		// the caches of the sub-problems that run at the same time share the cache budget
+		int nr_pair_threads = (int)GRT::ParallelTaskRunner::getNumThreadsForTasks(nr_pair,nr_threads);
+		svm_parameter sub_param = *param;
+		sub_param.cache_size = param->cache_size / nr_pair_threads;
+
+		PairwiseTrainingTask task;
+		task.param = &sub_param;
+		task.x = x;
+		task.start = start;
+		task.count = count;
+		task.weighted_C = weighted_C;
+		task.pair_i = pair_i;
+		task.pair_j = pair_j;
+		task.perms = perms;
+		task.initial_alpha = initial_alpha;
+		task.f = f;
+		task.probA = probA;
+		task.probB = probB;
+		GRT::ParallelTaskRunner::run(task,nr_pair,nr_pair_threads);
+
+		p = 0;
+		for(i=0;i<nr_class;i++)
+			for(int j=i+1;j<nr_class;j++)
+			{
 				int si = start[i], sj = start[j];
 				int ci = count[i], cj = count[j];
-				sub_prob.l = ci+cj;
-				sub_prob.x = Malloc(svm_node *,sub_prob.l);
-				sub_prob.y = Malloc(double,sub_prob.l);
 				int k;
-				for(k=0;k<ci;k++)
-				{
-					sub_prob.x[k] = x[si+k];
-					sub_prob.y[k] = +1;
-				}
-				for(k=0;k<cj;k++)
-				{
-					sub_prob.x[ci+k] = x[sj+k];
-					sub_prob.y[ci+k] = -1;
-				}
-
-				if(param->probability)
-					svm_binary_svc_probability(&sub_prob,param,weighted_C[i],weighted_C[j],probA[p],probB[p]);
-
-				f[p] = svm_train_one(&sub_prob,param,weighted_C[i],weighted_C[j]);
 				for(k=0;k<ci;k++)
 					if(!nonzero[si+k] && fabs(f[p].alpha[k]) > 0)
 						nonzero[si+k] = true;
 				for(k=0;k<cj;k++)
 					if(!nonzero[sj+k] && fabs(f[p].alpha[ci+k]) > 0)
 						nonzero[sj+k] = true;
-				free(sub_prob.x);
-				free(sub_prob.y);
 				++p;
 			}
 
+		free(pair_i);
+		free(pair_j);
+		if(perms != probability_perm)
+			svm_free_permutations(perms,nr_pair);
+		if(initial_alpha != NULL)
+		{
+			for(i=0;i<nr_pair;i++)
+				free(initial_alpha[i]);
+			free(initial_alpha);
+		}
+
 		// build output
 
 		model->nr_class = nr_class;
@@ -2305,14 +2490,69 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 	return model;
 }
 
+// Trains the model of one cross validation fold and predicts the samples that were left out, each fold only writes
+// to the targets of its own samples so the folds can be trained in parallel
+class CrossValidationTask : public GRT::ParallelTask
+{
+public:
+	virtual ~CrossValidationTask() {}
+
+	virtual bool runTask(const GRT::UINT i, const GRT::UINT threadIndex)
+	{
+		int begin = fold_start[i];
+		int end = fold_start[i+1];
+		int j;
+		struct svm_model *submodel = svm_train_internal(&subprobs[i],param,nr_threads,fold_perms != NULL ? fold_perms[i] : NULL);
+		if(param->probability && 
+		   (param->svm_type == C_SVC || param->svm_type == NU_SVC))
+		{
+			double *prob_estimates=Malloc(double,svm_get_nr_class(submodel));
+			for(j=begin;j<end;j++)
+				target[perm[j]] = svm_predict_probability(submodel,prob->x[perm[j]],prob_estimates);
+			free(prob_estimates);			
+		}
+		else
+			for(j=begin;j<end;j++)
+				target[perm[j]] = svm_predict(submodel,prob->x[perm[j]]);
+		svm_free_and_destroy_model(&submodel);
+		return true;
+	}
+
+	const svm_problem *prob;
+	const svm_parameter *param;
+	const svm_problem *subprobs;
+	const int *fold_start;
+	const int *perm;
+	int ***fold_perms;
+	int nr_threads;
+	double *target;
+};
+
 // Stratified cross validation
 void svm_cross_validation(const svm_problem *prob, const svm_parameter *param, int nr_fold, double *target)
+{
+	svm_cross_validation_internal(prob,param,nr_fold,target,0);
+}
+
+// nr_threads is the maximum number of threads used to train the folds and their sub-problems, zero uses the GRT default
+static void svm_cross_validation_internal(const svm_problem *prob, const svm_parameter *param, int nr_fold, double *target, int nr_threads)
 {
 	int i;
-	int *fold_start = Malloc(int,nr_fold+1);
 	int l = prob->l;
-	int *perm = Malloc(int,l);
+
+	// every fold needs at least one sample, and a fold can only be tested on a model trained on the other folds
+	if(nr_fold < 2 || nr_fold > l)
+	{
+		info("ERROR: the number of folds (%d) must be at least 2 and at most the number of samples (%d)\n",nr_fold,l);
+		for(i=0;i<l;i++)
+			target[i] = 0;
+		return;
+	}
+
+	int *fold_start = Malloc(int,(size_t)nr_fold+1);
+	int *perm = Malloc(int,(size_t)l);
 	int nr_class;
+	GRT::Random random(param->seed);
 
 	// stratified cv may not give leave-one-out rate
 	// Each class to l folds -> some folds may have zero elements
@@ -2333,7 +2573,7 @@ void svm_cross_validation(const svm_problem *prob, const svm_parameter *param, i
 		for (c=0; c<nr_class; c++) 
 			for(i=0;i<count[c];i++)
 			{
-				int j = i+rand()%(count[c]-i);
+				int j = i+(int)random.getRandomIndex(count[c]-i);
 				std::swap(index[start[c]+j],index[start[c]+i]);
 			}
 		for(i=0;i<nr_fold;i++)
@@ -2370,19 +2610,21 @@ void svm_cross_validation(const svm_problem *prob, const svm_parameter *param, i
 		for(i=0;i<l;i++) perm[i]=i;
 		for(i=0;i<l;i++)
 		{
-			int j = i+rand()%(l-i);
+			int j = i+(int)random.getRandomIndex(l-i);
 			std::swap(perm[i],perm[j]);
 		}
 		for(i=0;i<=nr_fold;i++)
 			fold_start[i]=i*l/nr_fold;
 	}
 
+	// build the training set of each fold
+	svm_problem *subprobs = Malloc(svm_problem,(size_t)nr_fold);
 	for(i=0;i<nr_fold;i++)
 	{
 		int begin = fold_start[i];
 		int end = fold_start[i+1];
 		int j,k;
-		struct svm_problem subprob;
+		struct svm_problem &subprob = subprobs[i];
 
 		subprob.l = l-(end-begin);
 		subprob.x = Malloc(struct svm_node*,subprob.l);
@@ -2401,22 +2643,64 @@ void svm_cross_validation(const svm_problem *prob, const svm_parameter *param, i
 			subprob.y[k] = prob->y[perm[j]];
 			++k;
 		}
-		struct svm_model *submodel = svm_train(&subprob,param);
-		if(param->probability && 
-		   (param->svm_type == C_SVC || param->svm_type == NU_SVC))
+	}
+
+	// the probability shuffles of every fold are drawn in fold order before any fold is trained, so the folds can be
+	// trained in parallel and still give the same results as training them one after the other. The regression
+	// probability estimate runs its own cross validation, so in that case the folds are always trained in order
+	bool classification = param->svm_type == C_SVC || param->svm_type == NU_SVC;
+	int nr_fold_threads = 1;
+	int ***fold_perms = NULL;
+	int *fold_nr_pair = NULL;
+	if(classification || !param->probability)
+		nr_fold_threads = (int)GRT::ParallelTaskRunner::getNumThreadsForTasks(nr_fold,nr_threads);
+	if(classification && param->probability)
+	{
+		fold_perms = Malloc(int **,nr_fold);
+		fold_nr_pair = Malloc(int,nr_fold);
+		int *group_perm = Malloc(int,l);
+		for(i=0;i<nr_fold;i++)
 		{
-			double *prob_estimates=Malloc(double,svm_get_nr_class(submodel));
-			for(j=begin;j<end;j++)
-				target[perm[j]] = svm_predict_probability(submodel,prob->x[perm[j]],prob_estimates);
-			free(prob_estimates);			
-		}
-		else
-			for(j=begin;j<end;j++)
-				target[perm[j]] = svm_predict(submodel,prob->x[perm[j]]);
-		svm_free_and_destroy_model(&submodel);
-		free(subprob.x);
-		free(subprob.y);
-	}		
+			int fold_nr_class;
+			int *start = NULL;
+			int *label = NULL;
+			int *count = NULL;
+			svm_group_classes(&subprobs[i],&fold_nr_class,&label,&start,&count,group_perm);
+			fold_perms[i] = svm_probability_permutations(fold_nr_class,count,random);
+			fold_nr_pair[i] = fold_nr_class*(fold_nr_class-1)/2;
+			free(start);
+			free(label);
+			free(count);
+		}
+		free(group_perm);
+	}
+
+	// the threads that are not used by the folds are used to train the sub-problems of each fold
+	int nr_total_threads = nr_threads > 0 ? nr_threads : (int)GRT::ParallelTaskRunner::getDefaultNumThreads();
+	svm_parameter fold_param = *param;
+	fold_param.cache_size = param->cache_size / nr_fold_threads;
+
+	CrossValidationTask task;
+	task.prob = prob;
+	task.param = &fold_param;
+	task.subprobs = subprobs;
+	task.fold_start = fold_start;
+	task.perm = perm;
+	task.fold_perms = fold_perms;
+	task.nr_threads = std::max(nr_total_threads / nr_fold_threads, 1);
+	task.target = target;
+	GRT::ParallelTaskRunner::run(task,nr_fold,nr_fold_threads);
+
+	for(i=0;i<nr_fold;i++)
+	{
+		free(subprobs[i].x);
+		free(subprobs[i].y);
+		if(fold_perms != NULL)
+			svm_free_permutations(fold_perms[i],fold_nr_pair[i]);
+	}
+	free(subprobs);
+	free(fold_perms);
+	free(fold_nr_pair);
 	free(fold_start);
 	free(perm);	
 }
@@ -2548,39 +2832,49 @@ double svm_predict_probability(
 	if ((model->param.svm_type == C_SVC || model->param.svm_type == NU_SVC) &&
 	    model->probA!=NULL && model->probB!=NULL)
 	{
-		int i;
 		int nr_class = model->nr_class;
 		double *dec_values = Malloc(double, nr_class*(nr_class-1)/2);
 		svm_predict_values(model, x, dec_values);
-
-		double min_prob=1e-7;
-		double **pairwise_prob=Malloc(double *,nr_class);
-		for(i=0;i<nr_class;i++)
-			pairwise_prob[i]=Malloc(double,nr_class);
-		int k=0;
-		for(i=0;i<nr_class;i++)
-			for(int j=i+1;j<nr_class;j++)
-			{
-				pairwise_prob[i][j]=std::min(std::max(sigmoid_predict(dec_values[k],model->probA[k],model->probB[k]),min_prob),1-min_prob);
-				pairwise_prob[j][i]=1-pairwise_prob[i][j];
-				k++;
-			}
-		multiclass_probability(nr_class,pairwise_prob,prob_estimates);
-
-		int prob_max_idx = 0;
-		for(i=1;i<nr_class;i++)
-			if(prob_estimates[i] > prob_estimates[prob_max_idx])
-				prob_max_idx = i;
-		for(i=0;i<nr_class;i++)
-			free(pairwise_prob[i]);
+		double pred_result = svm_predict_probability_from_decision_values(model, dec_values, prob_estimates);
 		free(dec_values);
-		free(pairwise_prob);	     
-		return model->label[prob_max_idx];
+		return pred_result;
 	}
 	else 
 		return svm_predict(model, x);
 }
 
+// The model must be a C_SVC or NU_SVC model with probability information, and dec_values must hold the
+// nr_class*(nr_class-1)/2 decision values computed by svm_predict_values
+double svm_predict_probability_from_decision_values(
+	const svm_model *model, const double *dec_values, double *prob_estimates)
+{
+	int i;
+	int nr_class = model->nr_class;
+
+	double min_prob=1e-7;
+	double **pairwise_prob=Malloc(double *,nr_class);
+	for(i=0;i<nr_class;i++)
+		pairwise_prob[i]=Malloc(double,nr_class);
+	int k=0;
+	for(i=0;i<nr_class;i++)
+		for(int j=i+1;j<nr_class;j++)
+		{
+			pairwise_prob[i][j]=std::min(std::max(sigmoid_predict(dec_values[k],model->probA[k],model->probB[k]),min_prob),1-min_prob);
+			pairwise_prob[j][i]=1-pairwise_prob[i][j];
+			k++;
+		}
+	multiclass_probability(nr_class,pairwise_prob,prob_estimates);
+
+	int prob_max_idx = 0;
+	for(i=1;i<nr_class;i++)
+		if(prob_estimates[i] > prob_estimates[prob_max_idx])
+			prob_max_idx = i;
+	for(i=0;i<nr_class;i++)
+		free(pairwise_prob[i]);
+	free(pairwise_prob);	     
+	return model->label[prob_max_idx];
+}
+
 static const char *svm_type_table[] =
 {
 	"c_svc","nu_svc","one_class","epsilon_svr","nu_svr",NULL
@@ -95,6 +95,7 @@ struct svm_parameter
     svm_parameter(){
         weight_label = NULL;
         weight = NULL;
+        seed = 1;
     }
 	int svm_type;
 	int kernel_type;
@@ -113,6 +114,7 @@ struct svm_parameter
 	double p;	/* for EPSILON_SVR */
 	int shrinking;	/* use the shrinking heuristics */
 	int probability; /* do probability estimates */
+	unsigned long long seed; /* seeds the shuffles used for cross validation and probability estimates */
 };
 
 //
@@ -140,6 +142,7 @@ struct svm_model
 };
 
 struct svm_model *svm_train(const struct svm_problem *prob, const struct svm_parameter *param);
+struct svm_model *svm_train_warm_start(const struct svm_problem *prob, const struct svm_parameter *param, const struct svm_model *warm_start_model, int nr_threads);
 void svm_cross_validation(const struct svm_problem *prob, const struct svm_parameter *param, int nr_fold, double *target);
 
 int svm_save_model(const char *model_file_name, const struct svm_model *model);
@@ -153,6 +156,7 @@ double svm_get_svr_probability(const struct svm_model *model);
 double svm_predict_values(const struct svm_model *model, const struct svm_node *x, double* dec_values);
 double svm_predict(const struct svm_model *model, const struct svm_node *x);
 double svm_predict_probability(const struct svm_model *model, const struct svm_node *x, double* prob_estimates);
+double svm_predict_probability_from_decision_values(const struct svm_model *model, const double *dec_values, double* prob_estimates);
 
 void svm_free_model_content(struct svm_model *model_ptr);
 void svm_free_and_destroy_model(struct svm_model **model_ptr_ptr);
@@ -29,6 +29,8 @@ SVM::SVM(UINT kernelType,UINT svmType,bool useScaling,bool useNullRejection,bool
     
     //Setup the default SVM parameters
     model = NULL;
+    compiled = false;
+    numSupportVectors = 0;
 	param.weight_label = NULL;
 	param.weight = NULL;
     prob.l = 0;
@@ -71,6 +73,8 @@ SVM::SVM(UINT kernelType,UINT svmType,bool useScaling,bool useNullRejection,bool
     
 SVM::SVM(const SVM &rhs){
     model = NULL;
+    compiled = false;
+    numSupportVectors = 0;
 	param.weight_label = NULL;
 	param.weight = NULL;
     prob.l = 0;
@@ -104,11 +108,14 @@ SVM& SVM::operator=(const SVM &rhs){
         this->kFoldValue = rhs.kFoldValue;
         this->classificationThreshold = rhs.classificationThreshold;
         this->crossValidationResult = rhs.crossValidationResult;
+        this->parameterSearchResults = rhs.parameterSearchResults;
         this->useAutoGamma = rhs.useAutoGamma;
         this->useCrossValidation = rhs.useCrossValidation;
         
         //Classifier variables
         copyBaseVariables( (Classifier*)&rhs );
+        
+        compileModel();
     }
     return *this;
 }
@@ -130,11 +137,18 @@ bool SVM::deepCopyFrom(const Classifier *classifier){
         this->kFoldValue = ptr->kFoldValue;
         this->classificationThreshold = ptr->classificationThreshold;
         this->crossValidationResult = ptr->crossValidationResult;
+        this->parameterSearchResults = ptr->parameterSearchResults;
         this->useAutoGamma = ptr->useAutoGamma;
         this->useCrossValidation = ptr->useCrossValidation;
         
         //Classifier variables
-        return copyBaseVariables( classifier );
+        if( !copyBaseVariables( classifier ) ){
+            return false;
+        }
+        
+        compileModel();
+        
+        return true;
     }
     
     return false;
@@ -169,6 +183,260 @@ bool SVM::train_(ClassificationData &trainingData){
     return true;
 }
 
+//The task used to evaluate the candidates of the parameter search. Each task trains and tests one group of candidates on
+//one cross validation fold, the candidates in a group share the same gamma value and are ordered by increasing C so each
+//C_SVC model can be warm started from the model trained with the previous C value
+class SVMParameterSearchTask : public ParallelTask{
+public:
+    SVMParameterSearchTask(const svm_problem &prob,const svm_parameter &param,const vector< SVMParameterSearchResult > &candidates,const vector< vector< UINT > > &groups,const vector< UINT > &samples,const vector< UINT > &sampleFolds,const UINT numFolds,const double cacheSize):
+        prob(prob),param(param),candidates(candidates),groups(groups),samples(samples),sampleFolds(sampleFolds),numFolds(numFolds),cacheSize(cacheSize){
+        numCorrect.resize(candidates.size()*numFolds,0);
+    }
+    
+    virtual bool runTask(const UINT taskIndex,const UINT threadIndex){
+        const vector< UINT > &group = groups[ taskIndex / numFolds ];
+        const UINT fold = taskIndex % numFolds;
+        
+        //The sub problem uses the nodes of the full problem, so the training data is not copied
+        vector< svm_node* > x;
+        vector< double > y;
+        vector< UINT > testSamples;
+        for(UINT i=0; i<samples.size(); i++){
+            if( sampleFolds[i] == fold ) testSamples.push_back( samples[i] );
+            else{
+                x.push_back( prob.x[ samples[i] ] );
+                y.push_back( prob.y[ samples[i] ] );
+            }
+        }
+        if( x.size() == 0 || testSamples.size() == 0 ) return false;
+        
+        svm_problem subProblem;
+        subProblem.l = (int)x.size();
+        subProblem.x = &x[0];
+        subProblem.y = &y[0];
+        
+        //The candidates are scored using the votes, so the probability models are not needed
+        svm_parameter p = param;
+        p.probability = 0;
+        p.cache_size = cacheSize;
+        
+        svm_model *previousModel = NULL;
+        for(UINT k=0; k<group.size(); k++){
+            const UINT c = group[k];
+            p.C = candidates[c].C;
+            p.gamma = candidates[c].gamma;
+            p.nu = candidates[c].nu;
+            
+            svm_model *model = svm_train_warm_start(&subProblem,&p,p.svm_type == C_SVC ? previousModel : NULL,1);
+            if( previousModel != NULL ) svm_free_and_destroy_model(&previousModel);
+            if( model == NULL ) return false;
+            
+            UINT correct = 0;
+            for(UINT i=0; i<testSamples.size(); i++){
+                if( svm_predict(model,prob.x[ testSamples[i] ]) == prob.y[ testSamples[i] ] ) correct++;
+            }
+            numCorrect[ c*numFolds + fold ] = correct;
+            previousModel = model;
+        }
+        if( previousModel != NULL ) svm_free_and_destroy_model(&previousModel);
+        
+        return true;
+    }
+    
+    const svm_problem &prob;
+    const svm_parameter &param;
+    const vector< SVMParameterSearchResult > &candidates;
+    const vector< vector< UINT > > &groups;
+    const vector< UINT > &samples;
+    const vector< UINT > &sampleFolds;
+    const UINT numFolds;
+    const double cacheSize;
+    vector< UINT > numCorrect;
+};
+    
+bool SVM::trainWithParameterSearch(ClassificationData &trainingData,const VectorDouble &cValues,const VectorDouble &gammaValues,const VectorDouble &nuValues,const bool useSuccessiveHalving){
+    
+    //Clear any previous model
+    clear();
+    
+    const UINT numTrainingExamples = trainingData.getNumSamples();
+    
+    if( numTrainingExamples == 0 ){
+        errorLog << "trainWithParameterSearch(...) - Training data has zero samples!" << endl;
+        return false;
+    }
+    
+    if( param.svm_type != C_SVC && param.svm_type != NU_SVC ){
+        errorLog << "trainWithParameterSearch(...) - The parameter search only supports C_SVC and NU_SVC models!" << endl;
+        return false;
+    }
+    
+    const UINT numFolds = kFoldValue;
+    if( numFolds < 2 || numFolds > numTrainingExamples ){
+        errorLog << "trainWithParameterSearch(...) - The kFoldValue (" << numFolds << ") must be at least 2 and can not be larger than the number of training samples (" << numTrainingExamples << ")!" << endl;
+        return false;
+    }
+    
+    //Convert the labelled classification data into the LIBSVM data format, the scaled problem is shared by all the candidates
+    if( !convertClassificationDataToLIBSVMFormat(trainingData) ){
+        errorLog << "trainWithParameterSearch(...) - Failed To Convert Labelled Classification Data To LIBSVM Format!" << endl;
+        return false;
+    }
+    
+    //Build the candidate grid, any empty list uses the current value. The gamma values are ignored by the linear kernel
+    VectorDouble Cs = cValues;
+    VectorDouble gammas = gammaValues;
+    VectorDouble nus = nuValues;
+    if( param.svm_type != C_SVC || Cs.size() == 0 ) Cs.assign(1,param.C);
+    if( param.svm_type != NU_SVC || nus.size() == 0 ) nus.assign(1,param.nu);
+    if( param.kernel_type == LINEAR_KERNEL || gammas.size() == 0 ) gammas.assign(1,useAutoGamma ? 1.0/numInputDimensions : param.gamma);
+    std::sort(Cs.begin(),Cs.end());
+    
+    vector< SVMParameterSearchResult > candidates;
+    for(UINT i=0; i<gammas.size(); i++){
+        for(UINT j=0; j<nus.size(); j++){
+            for(UINT k=0; k<Cs.size(); k++){
+                SVMParameterSearchResult candidate;
+                candidate.C = Cs[k];
+                candidate.gamma = gammas[i];
+                candidate.nu = nus[j];
+                candidates.push_back( candidate );
+            }
+        }
+    }
+    
+    //Check the parameters of each candidate
+    svm_parameter searchParam = param;
+    for(UINT c=0; c<candidates.size(); c++){
+        searchParam.C = candidates[c].C;
+        searchParam.gamma = candidates[c].gamma;
+        searchParam.nu = candidates[c].nu;
+        if( svm_check_parameter(&prob,&searchParam) != NULL ){
+            errorLog << "trainWithParameterSearch(...) - Invalid candidate parameters C: " << candidates[c].C << " gamma: " << candidates[c].gamma << " nu: " << candidates[c].nu << endl;
+            return false;
+        }
+    }
+    
+    //Shuffle the samples of each class using a fixed seed, so the folds (and the search) are the same each time the search is run.
+    //Each round uses the first samples of each class, so the samples used by each round include the samples of the previous rounds
+    vector< double > labels;
+    vector< vector< UINT > > classSamples;
+    for(int i=0; i<prob.l; i++){
+        UINT k = 0;
+        while( k < labels.size() && labels[k] != prob.y[i] ) k++;
+        if( k == labels.size() ){
+            labels.push_back( prob.y[i] );
+            classSamples.push_back( vector< UINT >() );
+        }
+        classSamples[k].push_back( i );
+    }
+    Random random( 1 );
+    for(UINT k=0; k<classSamples.size(); k++){
+        for(UINT i=(UINT)classSamples[k].size(); i>1; i--){
+            std::swap( classSamples[k][i-1], classSamples[k][ random.getRandomNumberInt(0,i) ] );
+        }
+    }
+    
+    //Each round keeps the best third of the candidates and uses three times as much data as the previous round
+    UINT numRounds = 1;
+    if( useSuccessiveHalving ){
+        UINT n = (UINT)candidates.size();
+        while( n > 3 ){
+            n = (n+2)/3;
+            numRounds++;
+        }
+    }
+    
+    vector< UINT > survivors( candidates.size() );
+    for(UINT c=0; c<candidates.size(); c++) survivors[c] = c;
+    
+    const UINT numThreads = ParallelTaskRunner::getNumThreadsForTasks( (UINT)candidates.size()*numFolds );
+    const double cacheSize = MAX(param.cache_size/numThreads,1.0);
+    
+    trainingLog << "Running parameter search, candidates: " << candidates.size() << " rounds: " << numRounds << " folds: " << numFolds << endl;
+    
+    UINT bestCandidate = 0;
+    for(UINT r=0; r<numRounds; r++){
+        
+        //Select the samples for this round, with at least one sample of each class in each fold where possible. The folds are
+        //assigned in turn across all the classes, so the folds stay balanced even if some classes only have a few samples
+        const double fraction = pow(3.0,-double(numRounds-1-r));
+        vector< UINT > samples;
+        vector< UINT > sampleFolds;
+        UINT fold = 0;
+        for(UINT k=0; k<classSamples.size(); k++){
+            const UINT numClassSamples = (UINT)classSamples[k].size();
+            UINT n = (UINT)ceil( fraction * numClassSamples );
+            if( n < numFolds ) n = numFolds;
+            if( n > numClassSamples ) n = numClassSamples;
+            for(UINT i=0; i<n; i++){
+                samples.push_back( classSamples[k][i] );
+                sampleFolds.push_back( fold );
+                if( ++fold == numFolds ) fold = 0;
+            }
+        }
+        
+        //Group the candidates that share the same gamma and nu values, the candidates are already ordered by increasing C
+        vector< vector< UINT > > groups;
+        for(UINT i=0; i<survivors.size(); i++){
+            const SVMParameterSearchResult &candidate = candidates[ survivors[i] ];
+            if( groups.size() == 0 || candidates[ groups.back().back() ].gamma != candidate.gamma || candidates[ groups.back().back() ].nu != candidate.nu ){
+                groups.push_back( vector< UINT >() );
+            }
+            groups.back().push_back( survivors[i] );
+        }
+        
+        SVMParameterSearchTask task(prob,param,candidates,groups,samples,sampleFolds,numFolds,cacheSize);
+        if( !ParallelTaskRunner::run(task,(UINT)groups.size()*numFolds,numThreads) ){
+            errorLog << "trainWithParameterSearch(...) - Failed to evaluate the candidates in round " << r << "!" << endl;
+            return false;
+        }
+        
+        //Score the candidates
+        vector< IndexedDouble > scores( survivors.size() );
+        for(UINT i=0; i<survivors.size(); i++){
+            const UINT c = survivors[i];
+            UINT correct = 0;
+            for(UINT f=0; f<numFolds; f++) correct += task.numCorrect[ c*numFolds + f ];
+            candidates[c].round = r;
+            candidates[c].numSamples = (UINT)samples.size();
+            candidates[c].accuracy = correct / double(samples.size()) * 100.0;
+            parameterSearchResults.push_back( candidates[c] );
+            scores[i] = IndexedDouble(c,candidates[c].accuracy);
+            
+            trainingLog << "Round: " << r << "\tC: " << candidates[c].C << "\tGamma: " << candidates[c].gamma << "\tNu: " << candidates[c].nu << "\tSamples: " << samples.size() << "\tAccuracy: " << candidates[c].accuracy << endl;
+        }
+        
+        //Keep the best third of the candidates, ties are broken by the candidate order so the search is deterministic
+        for(UINT i=1; i<scores.size(); i++){
+            for(UINT j=i; j>0 && scores[j].value > scores[j-1].value; j--){
+                std::swap(scores[j],scores[j-1]);
+            }
+        }
+        bestCandidate = scores[0].index;
+        
+        const UINT numToKeep = (UINT)(survivors.size()+2)/3;
+        survivors.resize( numToKeep );
+        for(UINT i=0; i<numToKeep; i++) survivors[i] = scores[i].index;
+        std::sort(survivors.begin(),survivors.end());
+    }
+    
+    trainingLog << "Best parameters, C: " << candidates[bestCandidate].C << " gamma: " << candidates[bestCandidate].gamma << " nu: " << candidates[bestCandidate].nu << " accuracy: " << candidates[bestCandidate].accuracy << endl;
+    
+    //Install the best parameters and train the final model on all the training data
+    param.C = candidates[bestCandidate].C;
+    param.gamma = candidates[bestCandidate].gamma;
+    param.nu = candidates[bestCandidate].nu;
+    useAutoGamma = false;
+    
+    if( !trainSVM() ){
+        errorLog << "trainWithParameterSearch(...) - Failed To Train SVM Model!" << endl;
+        return false;
+    }
+    
+    return true;
+}
+
 bool SVM::predict_(VectorDouble &inputVector){
     
     if( !trained ){
@@ -308,15 +576,16 @@ bool SVM::trainSVM(){
     
     //Verify the problem and the parameters
     if( !validateProblemAndParameters() ) return false;
-
-    //Scale the training data if needed
-    if( useScaling ){
-        for(int i=0; i<prob.l; i++)
-            for(UINT j=0; j<numInputDimensions; j++)
-                prob.x[i][j].value = scale(prob.x[i][j].value,ranges[j].minValue,ranges[j].maxValue,SVM_MIN_SCALE_RANGE,SVM_MAX_SCALE_RANGE);
-    }
+    
+    //Seed the shuffles used by the cross validation and the probability estimates
+    param.seed = random.getRandomNumberUInt64();
 
     if( useCrossValidation ){
+        if( kFoldValue < 2 || kFoldValue > (UINT)prob.l ){
+            errorLog << "trainSVM() - The kFoldValue (" << kFoldValue << ") must be at least 2 and can not be larger than the number of training samples (" << prob.l << ")!" << endl;
+            return false;
+        }
+        
         int i;
         double total_correct = 0;
         double total_error = 0;
@@ -368,6 +637,8 @@ bool SVM::trainSVM(){
         }
         classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
         classDistances.resize(numClasses,DEFAULT_NULL_DISTANCE_VALUE);
+        
+        compileModel();
     }
 
     return trained;
@@ -377,6 +648,12 @@ bool SVM::predictSVM(VectorDouble &inputVector){
 
 		if( !trained || inputVector.size() != numInputDimensions ) return false;
 
+		//Use the compiled model if it is available, this does not allocate any memory
+		if( compiled ){
+			predictedClassLabel = (UINT)predictCompiledModel( inputVector );
+			return true;
+		}
+
 		svm_node *x = NULL;
 
 		//Copy the input data into the SVM format
@@ -411,31 +688,41 @@ bool SVM::predictSVM(VectorDouble &inputVector,double &maxProbability, VectorDou
 
 		if( !trained || param.probability == 0 || inputVector.size() != numInputDimensions ) return false;
 
+		double predict_label = 0;
 		double *prob_estimates = NULL;
 		svm_node *x = NULL;
 
-		//Setup the memory for the probability estimates
-		prob_estimates = new double[ model->nr_class ];
-
-		//Copy the input data into the SVM format
-		x = new svm_node[numInputDimensions+1];
-		for(UINT j=0; j<numInputDimensions; j++){
-			x[j].index = (int)j+1;
-			x[j].value = inputVector[j];
-		}
-		//The last value in the input vector must be set to -1
-		x[numInputDimensions].index = -1;
-		x[numInputDimensions].value = 0;
-
-		//Scale the input data if required
-		if( useScaling ){
-			for(UINT j=0; j<numInputDimensions; j++)
-				x[j].value = scale(x[j].value,ranges[j].minValue,ranges[j].maxValue,SVM_MIN_SCALE_RANGE,SVM_MAX_SCALE_RANGE);
+		if( compiled ){
+			//Use the compiled model to compute the decision values, this does not allocate any memory
+			prob_estimates = &probabilityEstimates[0];
+			predict_label = predictCompiledModel( inputVector );
+			if( svm_check_probability_model(model) ){
+				predict_label = svm_predict_probability_from_decision_values(model,&decisionValues[0],prob_estimates);
+			}else std::fill(probabilityEstimates.begin(),probabilityEstimates.end(),0);
+		}else{
+			//Setup the memory for the probability estimates
+			prob_estimates = new double[ model->nr_class ];
+
+			//Copy the input data into the SVM format
+			x = new svm_node[numInputDimensions+1];
+			for(UINT j=0; j<numInputDimensions; j++){
+				x[j].index = (int)j+1;
+				x[j].value = inputVector[j];
+			}
+			//The last value in the input vector must be set to -1
+			x[numInputDimensions].index = -1;
+			x[numInputDimensions].value = 0;
+
+			//Scale the input data if required
+			if( useScaling ){
+				for(UINT j=0; j<numInputDimensions; j++)
+					x[j].value = scale(x[j].value,ranges[j].minValue,ranges[j].maxValue,SVM_MIN_SCALE_RANGE,SVM_MAX_SCALE_RANGE);
+			}
+
+			//Perform the SVM prediction
+			predict_label = svm_predict_probability(model,x,prob_estimates);
 		}
 
-		//Perform the SVM prediction
-		double predict_label = svm_predict_probability(model,x,prob_estimates);
-
 		predictedClassLabel = 0;
 		maxProbability = 0;
 		probabilites.resize(model->nr_class);
@@ -456,11 +743,191 @@ bool SVM::predictSVM(VectorDouble &inputVector,double &maxProbability, VectorDou
         }
 
 		//Clean up the memory
-		delete[] prob_estimates;
-		delete[] x;
+		if( !compiled ){
+			delete[] prob_estimates;
+			delete[] x;
+		}
 
 		return true;
 }
+
+bool SVM::compileModel(){
+
+    compiled = false;
+
+    if( model == NULL ) return false;
+
+    //Only the classification models with the standard kernels are compiled, any other model uses the LIBSVM prediction functions
+    const svm_parameter &modelParam = model->param;
+    if( modelParam.svm_type != C_SVC && modelParam.svm_type != NU_SVC ) return false;
+    if( modelParam.kernel_type == PRECOMPUTED_KERNEL ) return false;
+
+    const UINT K = (UINT)model->nr_class;
+    const UINT L = (UINT)model->l;
+    const UINT D = numInputDimensions;
+    const UINT numClassifiers = K*(K-1)/2;
+    if( K == 0 || D == 0 ) return false;
+
+    //Pack the support vectors, any index that is missing from a sparse support vector is zero. Adding the zero terms does
+    //not change the kernel sums, so the kernel values match the LIBSVM values exactly
+    numSupportVectors = L;
+    compiledSupportVectors.assign(D*L,0);
+    for(UINT i=0; i<L; i++){
+        int lastIndex = 0;
+        for(const svm_node *node = model->SV[i]; node->index != -1; node++){
+            if( node->index <= lastIndex || node->index > (int)D ){
+                warningLog << "compileModel() - Support vector " << i << " has an invalid index, the model will not be compiled!" << endl;
+                return false;
+            }
+            compiledSupportVectors[ (node->index-1)*L + i ] = node->value;
+            lastIndex = node->index;
+        }
+    }
+
+    compiledCoefficients.resize( (K-1)*L );
+    for(UINT k=0; k+1<K; k++){
+        for(UINT i=0; i<L; i++){
+            compiledCoefficients[ k*L + i ] = model->sv_coef[k][i];
+        }
+    }
+
+    supportVectorStart.resize( K );
+    supportVectorStart[0] = 0;
+    for(UINT k=1; k<K; k++){
+        supportVectorStart[k] = supportVectorStart[k-1] + model->nSV[k-1];
+    }
+
+    //The linear kernel is a dot product, so each one-vs-one classifier can be collapsed into a single weight vector
+    compiledLinearWeights.clear();
+    if( modelParam.kernel_type == LINEAR_KERNEL ){
+        compiledLinearWeights.assign(numClassifiers*D,0);
+        UINT p = 0;
+        for(UINT i=0; i<K; i++){
+            for(UINT j=i+1; j<K; j++){
+                double *w = &compiledLinearWeights[ p*D ];
+                const double *coef1 = &compiledCoefficients[ (j-1)*L ];
+                const double *coef2 = &compiledCoefficients[ i*L ];
+                for(UINT d=0; d<D; d++){
+                    const double *sv = &compiledSupportVectors[ d*L ];
+                    double sum = 0;
+                    for(UINT n=supportVectorStart[i]; n<supportVectorStart[i]+model->nSV[i]; n++) sum += coef1[n] * sv[n];
+                    for(UINT n=supportVectorStart[j]; n<supportVectorStart[j]+model->nSV[j]; n++) sum += coef2[n] * sv[n];
+                    w[d] = sum;
+                }
+                p++;
+            }
+        }
+    }
+
+    //Setup the buffers used for prediction
+    scaledInput.resize( D );
+    kernelValues.resize( L );
+    decisionValues.resize( numClassifiers > 0 ? numClassifiers : 1 );
+    probabilityEstimates.resize( K );
+    votes.resize( K );
+
+    compiled = true;
+
+    return true;
+}
+
+double SVM::predictCompiledModel(const VectorDouble &inputVector){
+
+    const svm_parameter &modelParam = model->param;
+    const UINT K = (UINT)model->nr_class;
+    const UINT L = numSupportVectors;
+    const UINT D = numInputDimensions;
+    UINT i,j,n,d = 0;
+
+    //Scale the input data if required
+    for(d=0; d<D; d++){
+        scaledInput[d] = useScaling ? scale(inputVector[d],ranges[d].minValue,ranges[d].maxValue,SVM_MIN_SCALE_RANGE,SVM_MAX_SCALE_RANGE) : inputVector[d];
+    }
+    const double *x = &scaledInput[0];
+
+    if( modelParam.kernel_type == LINEAR_KERNEL ){
+        //Each classifier is a single dot product with its weight vector
+        UINT p = 0;
+        for(i=0; i<K; i++){
+            for(j=i+1; j<K; j++){
+                const double *w = &compiledLinearWeights[ p*D ];
+                double sum = 0;
+                for(d=0; d<D; d++) sum += w[d] * x[d];
+                decisionValues[p] = sum - model->rho[p];
+                p++;
+            }
+        }
+    }else{
+        //Compute the kernel between the input and all the support vectors, one dimension at a time so the inner loops run over contiguous memory
+        double *k = L > 0 ? &kernelValues[0] : NULL;
+        const double *sv = L > 0 ? &compiledSupportVectors[0] : NULL;
+        std::fill(kernelValues.begin(),kernelValues.end(),0);
+        if( modelParam.kernel_type == RBF_KERNEL ){
+            for(d=0; d<D; d++){
+                const double xd = x[d];
+                const double *row = sv + d*L;
+                for(n=0; n<L; n++){
+                    const double diff = xd - row[n];
+                    k[n] += diff * diff;
+                }
+            }
+            for(n=0; n<L; n++) k[n] = exp(-modelParam.gamma*k[n]);
+        }else{
+            for(d=0; d<D; d++){
+                const double xd = x[d];
+                const double *row = sv + d*L;
+                for(n=0; n<L; n++) k[n] += xd * row[n];
+            }
+            if( modelParam.kernel_type == POLY_KERNEL ){
+                for(n=0; n<L; n++){
+                    //Raise the value to the integer power the same way LIBSVM does
+                    double base = modelParam.gamma*k[n]+modelParam.coef0;
+                    double result = 1.0;
+                    for(int t=modelParam.degree; t>0; t/=2){
+                        if( t%2 == 1 ) result *= base;
+                        base = base * base;
+                    }
+                    k[n] = result;
+                }
+            }else{
+                for(n=0; n<L; n++) k[n] = tanh(modelParam.gamma*k[n]+modelParam.coef0);
+            }
+        }
+
+        //Combine the kernel values into the decision value of each one-vs-one classifier
+        UINT p = 0;
+        for(i=0; i<K; i++){
+            for(j=i+1; j<K; j++){
+                const double *coef1 = &compiledCoefficients[ (j-1)*L ];
+                const double *coef2 = &compiledCoefficients[ i*L ];
+                const UINT si = supportVectorStart[i];
+                const UINT sj = supportVectorStart[j];
+                double sum = 0;
+                for(n=si; n<si+model->nSV[i]; n++) sum += coef1[n] * k[n];
+                for(n=sj; n<sj+model->nSV[j]; n++) sum += coef2[n] * k[n];
+                decisionValues[p] = sum - model->rho[p];
+                p++;
+            }
+        }
+    }
+
+    //Each classifier votes for one of its classes
+    std::fill(votes.begin(),votes.end(),0);
+    UINT p = 0;
+    for(i=0; i<K; i++){
+        for(j=i+1; j<K; j++){
+            if( decisionValues[p++] > 0 ) ++votes[i];
+            else ++votes[j];
+        }
+    }
+
+    UINT maxVoteIndex = 0;
+    for(i=1; i<K; i++){
+        if( votes[i] > votes[maxVoteIndex] ) maxVoteIndex = i;
+    }
+
+    return model->label[ maxVoteIndex ];
+}
     
 bool SVM::convertClassificationDataToLIBSVMFormat(ClassificationData &trainingData){
     
@@ -493,6 +960,13 @@ bool SVM::convertClassificationDataToLIBSVMFormat(ClassificationData &trainingDa
         prob.x[i][numInputDimensions].value = 0;
     }
     
+    //Scale the training data if needed, the problem is only scaled once so it can be used to train several models
+    if( useScaling ){
+        for(int i=0; i<prob.l; i++)
+            for(UINT j=0; j<numInputDimensions; j++)
+                prob.x[i][j].value = scale(prob.x[i][j].value,ranges[j].minValue,ranges[j].maxValue,SVM_MIN_SCALE_RANGE,SVM_MAX_SCALE_RANGE);
+    }
+    
     return true;
 }
 
@@ -924,6 +1398,8 @@ bool SVM::loadModelFromFile(fstream &file){
         bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
         classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
         classDistances.resize(numClasses,DEFAULT_NULL_DISTANCE_VALUE);
+        
+        compileModel();
     }
     
     return true;
@@ -935,7 +1411,9 @@ bool SVM::clear(){
     Classifier::clear();
     
     crossValidationResult = 0;
+    parameterSearchResults.clear();
     trained = false;
+    compiled = false;
     svm_free_and_destroy_model(&model);
     svm_destroy_param(&param);
     deleteProblemSet();
@@ -1053,6 +1531,8 @@ double SVM::getC() const{
     
 double SVM::getCrossValidationResult() const{ return crossValidationResult; }
 
+vector< SVMParameterSearchResult > SVM::getParameterSearchResults() const{ return parameterSearchResults; }
+
 bool SVM::setSVMType(const UINT svmType){
     if( validateSVMType(svmType) ){
         param.svm_type = (int)svmType;
@@ -1323,6 +1803,7 @@ bool SVM::deepCopyParam( const svm_parameter &source_param, svm_parameter &targe
     target_param.p = source_param.p;
     target_param.shrinking = source_param.shrinking;
     target_param.probability = source_param.probability;
+    target_param.seed = source_param.seed;
 
     //Copy any dynamic memory
     if( source_param.weight_label != NULL ){
@@ -1640,6 +2121,8 @@ bool SVM::loadLegacyModelFromFile( fstream &file ){
     //Finally, flag that the model has been trained to show it has been loaded and can be used for prediction
     trained = true;
     
+    compileModel();
+    
     return true;
 }
     
@@ -46,6 +46,27 @@ using namespace LIBSVM;
 #define SVM_MIN_SCALE_RANGE -1.0
 #define SVM_MAX_SCALE_RANGE 1.0
 
+//This class holds the result of one candidate of the SVM parameter search
+class SVMParameterSearchResult{
+public:
+    SVMParameterSearchResult(){
+        C = 0;
+        gamma = 0;
+        nu = 0;
+        round = 0;
+        numSamples = 0;
+        accuracy = 0;
+    }
+    ~SVMParameterSearchResult(){}
+    
+    double C;               //The C value of the candidate
+    double gamma;           //The gamma value of the candidate
+    double nu;              //The nu value of the candidate
+    UINT round;             //The successive halving round the candidate was evaluated in
+    UINT numSamples;        //The number of training samples used to evaluate the candidate in this round
+    double accuracy;        //The cross validation accuracy of the candidate (as a percentage)
+};
+
 class SVM : public Classifier{
 public:
     /**
@@ -160,6 +181,28 @@ public:
      This initializes the default SVM settings and parameters. Any previous model, settings, or problems will be cleared.
      */
 	void initDefaultSVMSettings();
+    
+    /**
+     Trains the SVM after searching for the best C and gamma values (or nu and gamma values for a NU_SVC model).
+     
+     Each candidate is scored using the kFoldValue cross validation accuracy. The candidates are evaluated in parallel, and
+     the candidates that share a gamma value are trained in order of increasing C with each C_SVC model warm started from
+     the model with the previous C value. If useSuccessiveHalving is true then all the candidates are first evaluated on
+     a small stratified subset of the training data, and only the best third of the candidates are kept for the next round,
+     which uses three times as much data, until the last round uses all the training data.
+     
+     The best parameters are set and the final model is trained with them on all the training data. Auto gamma is disabled
+     so the searched gamma value is kept if the SVM is retrained. The result of every candidate in every round can be
+     accessed using getParameterSearchResults().
+     
+     @param ClassificationData &trainingData: the training data
+     @param const VectorDouble &cValues: the C values to search, if empty then the current C value will be used
+     @param const VectorDouble &gammaValues: the gamma values to search, if empty then the current gamma value (or the auto gamma value) will be used
+     @param const VectorDouble &nuValues: the nu values to search for a NU_SVC model, if empty then the current nu value will be used
+     @param const bool useSuccessiveHalving: sets if successive halving should be used, if false every candidate is evaluated on all the training data
+     @return returns true if the search was successful and the SVM was trained, false otherwise
+     */
+    bool trainWithParameterSearch(ClassificationData &trainingData,const VectorDouble &cValues,const VectorDouble &gammaValues,const VectorDouble &nuValues = VectorDouble(),const bool useSuccessiveHalving = true);
 
     /**
      Gets if cross validation is enabled.
@@ -245,6 +288,13 @@ public:
      */
     double getCrossValidationResult() const;
     
+    /**
+     Gets the results of the last parameter search, with one row for each candidate evaluated in each round.
+     
+     @return returns the results of the last parameter search, or an empty vector if no search has been run
+     */
+    vector< SVMParameterSearchResult > getParameterSearchResults() const;
+    
     /**
      Sets the SVM type.
      This should be one of the SVMTypes enumeration types.
@@ -349,6 +399,8 @@ protected:
     
     bool predictSVM(VectorDouble &inputVector);
 	bool predictSVM(VectorDouble &inputVector,double &maxProbability, VectorDouble &probabilites);
+    bool compileModel();
+    double predictCompiledModel(const VectorDouble &inputVector);
     bool loadLegacyModelFromFile( fstream &file );
     
     struct svm_model *deepCopyModel() const;
@@ -364,6 +416,20 @@ protected:
 	double crossValidationResult;
 	bool useAutoGamma;
     bool useCrossValidation;
+    vector< SVMParameterSearchResult > parameterSearchResults;
+
+    //The compiled model, which packs the support vectors into one contiguous matrix so predictions do not walk the LIBSVM nodes
+    bool compiled;
+    UINT numSupportVectors;
+    VectorDouble compiledSupportVectors;        //The support vectors, stored as [dimension][supportVector]
+    VectorDouble compiledCoefficients;          //The support vector coefficients, stored as [class-1][supportVector]
+    VectorDouble compiledLinearWeights;         //The weight vector of each one-vs-one classifier for the linear kernel, stored as [classifier][dimension]
+    vector< UINT > supportVectorStart;          //The index of the first support vector of each class
+    VectorDouble scaledInput;
+    VectorDouble kernelValues;
+    VectorDouble decisionValues;
+    VectorDouble probabilityEstimates;
+    vector< UINT > votes;
     
     static RegisterClassifierModule< SVM > registerModule;
     
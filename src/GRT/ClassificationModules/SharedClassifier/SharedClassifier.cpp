@@ -0,0 +1,187 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "SharedClassifier.h"
+
+namespace GRT{
+
+//Register the SharedClassifier module with the Classifier base class
+RegisterClassifierModule< SharedClassifier > SharedClassifier::registerModule("SharedClassifier");
+
+SharedClassifier::SharedClassifier(const Classifier *sharedClassifier)
+{
+    this->sharedClassifier = NULL;
+    classType = "SharedClassifier";
+    classifierType = classType;
+    classifierMode = STANDARD_CLASSIFIER_MODE;
+    setLogText();
+
+    if( sharedClassifier != NULL ) setSharedClassifier( sharedClassifier );
+}
+
+SharedClassifier::SharedClassifier(const SharedClassifier &rhs){
+    sharedClassifier = NULL;
+    classType = "SharedClassifier";
+    classifierType = classType;
+    classifierMode = STANDARD_CLASSIFIER_MODE;
+    setLogText();
+    *this = rhs;
+}
+
+SharedClassifier::~SharedClassifier(void)
+{
+}
+
+SharedClassifier& SharedClassifier::operator=(const SharedClassifier &rhs){
+    if( this != &rhs ){
+        //SharedClassifier variables
+        this->sharedClassifier = rhs.sharedClassifier;
+
+        //Classifier variables
+        copyBaseVariables( (Classifier*)&rhs );
+    }
+    return *this;
+}
+
+bool SharedClassifier::deepCopyFrom(const Classifier *classifier){
+
+    if( classifier == NULL ) return false;
+
+    if( this->getClassifierType() == classifier->getClassifierType() ){
+        SharedClassifier *ptr = (SharedClassifier*)classifier;
+
+        //Only the pointer is copied, the model stays with the shared classifier
+        this->sharedClassifier = ptr->sharedClassifier;
+
+        //Classifier variables
+        return copyBaseVariables( classifier );
+    }
+
+    return false;
+}
+
+bool SharedClassifier::train_(ClassificationData &trainingData){
+    errorLog << "train_(ClassificationData &trainingData) - A SharedClassifier can not be trained, train the shared classifier instead!" << endl;
+    return false;
+}
+
+bool SharedClassifier::predict_(VectorDouble &inputVector){
+
+    if( sharedClassifier == NULL ){
+        errorLog << "predict_(VectorDouble &inputVector) - The shared classifier has not been set!" << endl;
+        return false;
+    }
+
+    //Check the input against the base variables copied from the shared classifier, so any error is written to this
+    //instance's log rather than to the log of the shared classifier, which every session would write to at once
+    if( !trained ){
+        errorLog << "predict_(VectorDouble &inputVector) - The shared classifier has not been trained!" << endl;
+        return false;
+    }
+
+    if( inputVector.size() != numInputDimensions ){
+        errorLog << "predict_(VectorDouble &inputVector) - The size of the input vector (" << inputVector.size() << ") does not match the number of features of the shared classifier (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+
+    //Predict into this instance's results, reusing the buffers of the last prediction
+    prediction.classLikelihoods.swap( classLikelihoods );
+    prediction.classDistances.swap( classDistances );
+
+    const bool result = sharedClassifier->predictShared( inputVector, prediction );
+
+    classLikelihoods.swap( prediction.classLikelihoods );
+    classDistances.swap( prediction.classDistances );
+    if( result ){
+        predictedClassLabel = prediction.predictedClassLabel;
+        maxLikelihood = prediction.maxLikelihood;
+        bestDistance = prediction.bestDistance;
+    }else{
+        errorLog << "predict_(VectorDouble &inputVector) - The " << sharedClassifier->getClassifierType() << " shared classifier failed to predict!" << endl;
+    }
+
+    return result;
+}
+
+bool SharedClassifier::clear(){
+
+    //Clear the Classifier variables
+    Classifier::clear();
+
+    //Clear the SharedClassifier variables
+    sharedClassifier = NULL;
+
+    return true;
+}
+
+bool SharedClassifier::saveModelToFile(fstream &file) const{
+    errorLog << "saveModelToFile(fstream &file) - A SharedClassifier can not be saved, save the shared classifier instead!" << endl;
+    return false;
+}
+
+bool SharedClassifier::loadModelFromFile(fstream &file){
+    errorLog << "loadModelFromFile(fstream &file) - A SharedClassifier can not be loaded, load the shared classifier instead!" << endl;
+    return false;
+}
+
+bool SharedClassifier::setSharedClassifier(const Classifier *sharedClassifier){
+
+    if( sharedClassifier == NULL ){
+        errorLog << "setSharedClassifier(const Classifier *sharedClassifier) - The shared classifier is NULL!" << endl;
+        return false;
+    }
+
+    if( !sharedClassifier->getTrained() ){
+        errorLog << "setSharedClassifier(const Classifier *sharedClassifier) - The shared classifier has not been trained!" << endl;
+        return false;
+    }
+
+    if( !sharedClassifier->getSupportsSharedPrediction() ){
+        errorLog << "setSharedClassifier(const Classifier *sharedClassifier) - The " << sharedClassifier->getClassifierType() << " classifier does not support shared prediction!" << endl;
+        return false;
+    }
+
+    //Copy the class labels, ranges and thresholds, these are small and are needed by the pipeline
+    if( !copyBaseVariables( sharedClassifier ) ){
+        return false;
+    }
+
+    //The base variables include the type and the logs of the shared classifier, so set them back
+    classType = "SharedClassifier";
+    classifierType = classType;
+    setLogText();
+
+    this->sharedClassifier = sharedClassifier;
+
+    return true;
+}
+
+const Classifier* SharedClassifier::getSharedClassifier() const{
+    return sharedClassifier;
+}
+
+void SharedClassifier::setLogText(){
+    debugLog.setProceedingText("[DEBUG SharedClassifier]");
+    errorLog.setProceedingText("[ERROR SharedClassifier]");
+    trainingLog.setProceedingText("[TRAINING SharedClassifier]");
+    warningLog.setProceedingText("[WARNING SharedClassifier]");
+}
+
+} //End of namespace GRT
@@ -0,0 +1,161 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The SharedClassifier class lets several GestureRecognitionPipelines use one trained classifier without copying
+ its model.
+
+ A SharedClassifier only holds a pointer to a trained classifier that supports shared prediction (see
+ Classifier::predictShared) plus the results of its own last prediction. Copying a SharedClassifier, which is what
+ GestureRecognitionPipeline::setClassifier does, only copies the pointer and the small base variables (the class
+ labels, ranges and null rejection thresholds), so the memory used by each pipeline does not grow with the size of the
+ model. The shared classifier must not be changed or deleted while any SharedClassifier points to it.
+
+ A SharedClassifier can not be trained, saved or loaded; train, save and load the shared classifier instead. It is
+ used by the PipelinePool to give each session its own pipeline state around one shared model.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_SHARED_CLASSIFIER_HEADER
+#define GRT_SHARED_CLASSIFIER_HEADER
+
+#include "../../CoreModules/Classifier.h"
+
+namespace GRT{
+
+class SharedClassifier : public Classifier
+{
+public:
+    /**
+     Default Constructor
+
+     @param const Classifier *sharedClassifier: the trained classifier that will be used for the predictions, it must support shared prediction. Default value is sharedClassifier = NULL
+     */
+    SharedClassifier(const Classifier *sharedClassifier = NULL);
+
+    /**
+     Defines the copy constructor, only the pointer to the shared classifier is copied.
+
+     @param const SharedClassifier &rhs: the instance from which all the data will be copied into this instance
+     */
+    SharedClassifier(const SharedClassifier &rhs);
+
+    /**
+     Default Destructor, the shared classifier is not deleted.
+     */
+    virtual ~SharedClassifier(void);
+
+    /**
+     Defines how the data from the rhs SharedClassifier should be copied to this SharedClassifier
+
+     @param const SharedClassifier &rhs: another instance of a SharedClassifier
+     @return returns a pointer to this instance of the SharedClassifier
+     */
+    SharedClassifier &operator=(const SharedClassifier &rhs);
+
+    /**
+     This is required for the Gesture Recognition Pipeline for when the pipeline.setClassifier(...) method is called.
+     It copies the pointer to the shared classifier from the Base Class Classifier pointer (which should be pointing to a SharedClassifier instance) into this instance
+
+     @param Classifier *classifier: a pointer to the Classifier Base Class, this should be pointing to another SharedClassifier instance
+     @return returns true if the clone was successfull, false otherwise
+     */
+    virtual bool deepCopyFrom(const Classifier *classifier);
+
+    /**
+     A SharedClassifier can not be trained, this will always return false. Train the shared classifier instead.
+
+     @param ClassificationData trainingData: a reference to the training data
+     @return returns false
+     */
+    virtual bool train_(ClassificationData &trainingData);
+
+    /**
+     This predicts the class of the inputVector with the shared classifier, the results are stored in this instance.
+     This overrides the predict function in the Classifier base class.
+
+     @param VectorDouble inputVector: the input vector to classify
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predict_(VectorDouble &inputVector);
+
+    /**
+     This overrides the clear function in the Classifier base class.
+     It removes the pointer to the shared classifier and sets all the base variables to their default values.
+
+     @return returns true if the module was cleared succesfully, false otherwise
+     */
+    virtual bool clear();
+
+    /**
+     A SharedClassifier can not be saved, this will always return false. Save the shared classifier (or the pipeline it was trained in) instead.
+
+     @param fstream &file: a reference to the file the model would be saved to
+     @return returns false
+     */
+    virtual bool saveModelToFile(fstream &file) const;
+
+    /**
+     A SharedClassifier can not be loaded, this will always return false. Load the shared classifier instead.
+
+     @param fstream &file: a reference to the file the model would be loaded from
+     @return returns false
+     */
+    virtual bool loadModelFromFile(fstream &file);
+
+    /**
+     Sets the classifier that will be used for the predictions. The classifier must be trained and must support shared
+     prediction, and it must not be changed or deleted while this instance points to it.
+
+     @param const Classifier *sharedClassifier: the trained classifier that will be used for the predictions
+     @return returns true if the shared classifier was set, false otherwise
+     */
+    bool setSharedClassifier(const Classifier *sharedClassifier);
+
+    /**
+     Gets the classifier that is used for the predictions.
+
+     @return returns a pointer to the shared classifier, or NULL if it has not been set
+     */
+    const Classifier* getSharedClassifier() const;
+
+    //Tell the compiler we are using the following functions from the MLBase class to stop hidden virtual function warnings
+    using MLBase::saveModelToFile;
+    using MLBase::loadModelFromFile;
+    using MLBase::train;
+    using MLBase::train_;
+    using MLBase::predict;
+    using MLBase::predict_;
+
+protected:
+    void setLogText();
+
+    const Classifier *sharedClassifier;         ///> The trained classifier that is used for the predictions, it is not owned by this instance
+    ClassifierPrediction prediction;            ///> Holds the buffers used for each prediction
+
+    static RegisterClassifierModule< SharedClassifier > registerModule;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_SHARED_CLASSIFIER_HEADER
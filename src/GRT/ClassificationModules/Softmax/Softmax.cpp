@@ -24,6 +24,95 @@ namespace GRT{
 
 //Register the Softmax module with the Classifier base class
 RegisterClassifierModule< Softmax >  Softmax::registerModule("Softmax");
+    
+//The cross entropy of one one-vs-rest model plus an L2 penalty on the weights, theta[0] is the bias. The training data is packed
+//into one row-major array, so each evaluation is a single pass over contiguous memory
+class SoftmaxModelObjective : public LBFGSObjective{
+public:
+    SoftmaxModelObjective(const VectorDouble &X,const VectorDouble &y,const UINT N,const double regularization):X(X),y(y),N(N),regularization(regularization){}
+    
+    virtual double evaluate(const VectorDouble &theta,VectorDouble &gradient){
+        const UINT M = (UINT)y.size();
+        double cost = 0;
+        std::fill(gradient.begin(),gradient.end(),0);
+        for(UINT i=0; i<M; i++){
+            const double *x = &X[i*N];
+            double z = theta[0];
+            for(UINT j=0; j<N; j++) z += x[j] * theta[j+1];
+            
+            //log(1+exp(z)) - y*z, written so it does not overflow for large |z|
+            cost += (z > 0 ? z : 0) + log( 1.0 + exp( -fabs(z) ) ) - y[i] * z;
+            
+            const double error = 1.0 / (1.0 + exp(-z)) - y[i];
+            gradient[0] += error;
+            for(UINT j=0; j<N; j++) gradient[j+1] += error * x[j];
+        }
+        cost /= M;
+        for(UINT j=0; j<=N; j++) gradient[j] /= M;
+        for(UINT j=1; j<=N; j++){
+            cost += 0.5 * regularization * theta[j] * theta[j];
+            gradient[j] += regularization * theta[j];
+        }
+        return cost;
+    }
+    
+    const VectorDouble &X;
+    const VectorDouble &y;
+    const UINT N;
+    const double regularization;
+};
+    
+//Trains the one-vs-rest model of each class, the models only share the packed training data so they can be trained in parallel
+class SoftmaxTrainingTask : public ParallelTask{
+public:
+    SoftmaxTrainingTask(const VectorDouble &X,const vector< UINT > &labels,const vector< UINT > &classLabels,vector< SoftmaxModel > &models,const UINT N,const double regularization,const UINT maxNumIterations,const double minChange):
+        X(X),labels(labels),classLabels(classLabels),models(models),N(N),regularization(regularization),maxNumIterations(maxNumIterations),minChange(minChange){
+        numIterations.resize(classLabels.size(),0);
+        cost.resize(classLabels.size(),0);
+    }
+    
+    virtual bool runTask(const UINT taskIndex,const UINT threadIndex){
+        const UINT M = (UINT)labels.size();
+        
+        //Relabel the data as positive samples (with label 1.0) and negative samples (with label 0.0)
+        VectorDouble y(M);
+        for(UINT i=0; i<M; i++){
+            y[i] = labels[i] == classLabels[taskIndex] ? 1.0 : 0;
+        }
+        
+        //The cost is convex, so the weights can start at zero
+        VectorDouble theta(N+1,0);
+        SoftmaxModelObjective objective(X,y,N,regularization);
+        LBFGSOptimizer optimizer;
+        if( !optimizer.minimize(objective,theta,maxNumIterations,minChange) ){
+            return false;
+        }
+        
+        SoftmaxModel &model = models[taskIndex];
+        model.classLabel = classLabels[taskIndex];
+        model.N = N;
+        model.w0 = theta[0];
+        model.w.resize(N);
+        for(UINT j=0; j<N; j++){
+            model.w[j] = theta[j+1];
+        }
+        numIterations[taskIndex] = optimizer.getNumIterations();
+        cost[taskIndex] = optimizer.getValue();
+        
+        return true;
+    }
+    
+    const VectorDouble &X;
+    const vector< UINT > &labels;
+    const vector< UINT > &classLabels;
+    vector< SoftmaxModel > &models;
+    const UINT N;
+    const double regularization;
+    const UINT maxNumIterations;
+    const double minChange;
+    vector< UINT > numIterations;
+    vector< double > cost;
+};
 
 Softmax::Softmax(bool useScaling)
 {
@@ -31,6 +120,8 @@ Softmax::Softmax(bool useScaling)
     minChange = 1.0e-10;
     maxNumIterations = 1000;
     learningRate = 0.01;
+    trainingMethod = LBFGS;
+    regularization = 1.0e-4;
     classType = "Softmax";
     classifierType = classType;
     classifierMode = STANDARD_CLASSIFIER_MODE;
@@ -60,6 +151,8 @@ Softmax& Softmax::operator=(const Softmax &rhs){
         this->learningRate = rhs.learningRate;
         this->minChange = rhs.minChange;
         this->maxNumIterations = rhs.maxNumIterations;
+        this->trainingMethod = rhs.trainingMethod;
+        this->regularization = rhs.regularization;
         this->models = rhs.models;
         
         //Copy the base classifier variables
@@ -78,6 +171,8 @@ bool Softmax::deepCopyFrom(const Classifier *classifier){
         this->learningRate = ptr->learningRate;
         this->minChange = ptr->minChange;
         this->maxNumIterations = ptr->maxNumIterations;
+        this->trainingMethod = ptr->trainingMethod;
+        this->regularization = ptr->regularization;
         this->models = ptr->models;
         
         //Copy the base classifier variables
@@ -112,11 +207,24 @@ bool Softmax::train_(ClassificationData &trainingData){
         trainingData.scale(0, 1);
     }
     
-    //Train a regression model for each class in the training data
+    //Set the class labels
     for(UINT k=0; k<numClasses; k++){
-        
-        //Set the class label
         classLabels[k] = trainingData.getClassTracker()[k].classLabel;
+    }
+    
+    if( trainingMethod == LBFGS ){
+        if( !trainSoftmaxModelsLBFGS(trainingData) ){
+            errorLog << "train(ClassificationData labelledTrainingData) - Failed to train the models!" << endl;
+            return false;
+        }
+        
+        //Flag that the algorithm has been trained
+        trained = true;
+        return trained;
+    }
+    
+    //Train a regression model for each class in the training data
+    for(UINT k=0; k<numClasses; k++){
         
         //Train the model
         if( !trainSoftmaxModel(classLabels[k],models[k],trainingData) ){
@@ -199,12 +307,11 @@ bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,Classificati
     UINT M = data.getNumSamples();
     UINT iter = 0;
     bool keepTraining = true;
-    Random random;
     VectorDouble y(M);
     vector< UINT > randomTrainingOrder(M);
     
     //Init the model
-    model.init( classLabel,  N );
+    model.init( classLabel, N, random );
     
     //Setup the target vector, the input data is relabelled as positive samples (with label 1.0) and negative samples (with label 0.0)
     for(UINT i=0; i<M; i++){
@@ -217,7 +324,7 @@ bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,Classificati
     for(UINT i=0; i<M; i++){
         randomTrainingOrder[i] = i;
     }
-    std::random_shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
+    random.shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
     
     //Run the main stochastic gradient descent training algorithm
     while( keepTraining ){
@@ -259,6 +366,33 @@ bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,Classificati
     return true;
 }
     
+bool Softmax::trainSoftmaxModelsLBFGS(ClassificationData &data){
+    
+    const UINT N = data.getNumDimensions();
+    const UINT M = data.getNumSamples();
+    
+    //Pack the training data into one contiguous array, which is shared by all the models
+    VectorDouble X(M*N);
+    vector< UINT > labels(M);
+    for(UINT i=0; i<M; i++){
+        for(UINT j=0; j<N; j++){
+            X[i*N+j] = data[i][j];
+        }
+        labels[i] = data[i].getClassLabel();
+    }
+    
+    SoftmaxTrainingTask task(X,labels,classLabels,models,N,regularization,maxNumIterations,minChange);
+    if( !ParallelTaskRunner::run(task,numClasses) ){
+        return false;
+    }
+    
+    for(UINT k=0; k<numClasses; k++){
+        trainingLog << "Class: " << classLabels[k] << " Iterations: " << task.numIterations[k] << " Cost: " << task.cost[k] << endl;
+    }
+    
+    return true;
+}
+    
 bool Softmax::clear(){
     
     //Clear the Classifier variables
@@ -421,6 +555,31 @@ UINT Softmax::getMaxNumIterations(){
     return maxNumIterations;
 }
     
+bool Softmax::setTrainingMethod(UINT trainingMethod){
+    if( trainingMethod == STOCHASTIC_GRADIENT_DESCENT || trainingMethod == LBFGS ){
+        this->trainingMethod = trainingMethod;
+        return true;
+    }
+    warningLog << "setTrainingMethod(UINT trainingMethod) - Unknown training method: " << trainingMethod << endl;
+    return false;
+}
+    
+bool Softmax::setRegularization(double regularization){
+    if( regularization >= 0 ){
+        this->regularization = regularization;
+        return true;
+    }
+    return false;
+}
+    
+UINT Softmax::getTrainingMethod(){
+    return trainingMethod;
+}
+    
+double Softmax::getRegularization(){
+    return regularization;
+}
+    
 vector< SoftmaxModel > Softmax::getModels(){
     return models;
 }
@@ -148,6 +148,26 @@ public:
      */
     bool setMaxNumIterations(UINT maxNumIterations);
     
+    /**
+     Sets the method used to train the models, this should be one of the TrainingMethods enums. LBFGS (the default) minimizes
+     the cross entropy of each one-vs-rest model using full passes over the training data, and normally converges in far
+     fewer passes than STOCHASTIC_GRADIENT_DESCENT. With LBFGS, the models of the classes are trained in parallel.
+     
+     @param UINT trainingMethod: the new training method
+     @return returns true if the training method was updated, false otherwise
+     */
+    bool setTrainingMethod(UINT trainingMethod);
+    
+    /**
+     Sets the L2 regularization value used by the LBFGS training method. This penalizes the squared size of the weights
+     (but not the bias), which stops the weights growing without bound if a class is linearly separable from the others.
+     The value must be greater than or equal to zero.
+     
+     @param double regularization: the new regularization value
+     @return returns true if the regularization value was updated, false otherwise
+     */
+    bool setRegularization(double regularization);
+    
     /**
      Gets the current learningRate value, this is value used to update the weights at each step of the stochastic gradient descent.
      
@@ -170,6 +190,20 @@ public:
      */
     UINT getMaxNumIterations();
     
+    /**
+     Gets the method used to train the models, this will be one of the TrainingMethods enums.
+     
+     @return returns the training method
+     */
+    UINT getTrainingMethod();
+    
+    /**
+     Gets the L2 regularization value used by the LBFGS training method.
+     
+     @return returns the regularization value
+     */
+    double getRegularization();
+    
     /**
      Get the softmax models for each class. The Softmax class must be trained first.
      
@@ -181,13 +215,18 @@ public:
     using MLBase::saveModelToFile;
     using MLBase::loadModelFromFile;
     
+    enum TrainingMethods{ STOCHASTIC_GRADIENT_DESCENT=0, LBFGS };
+    
 protected:
     bool trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,ClassificationData &data);
+    bool trainSoftmaxModelsLBFGS(ClassificationData &data);
     bool loadLegacyModelFromFile( fstream &file );
     
     double learningRate;
     double minChange;
     UINT maxNumIterations;
+    UINT trainingMethod;
+    double regularization;
     vector< SoftmaxModel > models;
     
     static RegisterClassifierModule< Softmax > registerModule;
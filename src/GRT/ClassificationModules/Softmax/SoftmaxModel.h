@@ -43,20 +43,13 @@ public:
         
     }
     
-    bool init(UINT classLabel,UINT N){
+    bool init(UINT classLabel,UINT N,Random &random){
         this->classLabel = classLabel;
         this->N = N;
         
-        //Resize the weights
-        w.clear();
-        w.resize(N);
-        
         //Randomize the weights
-        Random rand;
-        for(UINT i=0; i<N; i++){
-            w[i] = rand.getRandomNumberUniform(-0.1,0.1);
-        }
-        w0 = rand.getRandomNumberUniform(-0.1,0.1);
+        w = random.getRandomVectorUniform(N,-0.1,0.1);
+        w0 = random.getRandomNumberUniform(-0.1,0.1);
         
         return true;
     }
@@ -171,7 +171,6 @@ bool GaussianMixtureModels::train_(MatrixDouble &data){
     }
     
     //Pick K random starting points for the inital guesses of Mu
-    Random random;
     vector< UINT > randomIndexs(numTrainingSamples);
     for(UINT i=0; i<numTrainingSamples; i++) randomIndexs[i] = i;
     for(UINT i=0; i<numClusters; i++){
@@ -234,10 +234,9 @@ bool KMeans::train_(MatrixDouble &data){
 	count.resize(numClusters);
 
 	//Randomly pick k data points as the starting clusters
-	Random random;
 	vector< UINT > randIndexs(numTrainingSamples);
 	for(UINT i=0; i<numTrainingSamples; i++) randIndexs[i] = i;
-    std::random_shuffle(randIndexs.begin(), randIndexs.end());
+    random.shuffle(randIndexs.begin(), randIndexs.end());
 
     //Copy the clusters
 	for(UINT k=0; k<numClusters; k++){
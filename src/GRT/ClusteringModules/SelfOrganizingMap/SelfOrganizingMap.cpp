@@ -130,7 +130,6 @@ bool SelfOrganizingMap::train_( MatrixDouble &data ){
     const UINT N = data.getNumCols();
     numInputDimensions = N;
     numOutputDimensions = numClusters;
-    Random rand;
     
     //Setup the neurons
     neurons.resize( numClusters );
@@ -143,10 +142,10 @@ bool SelfOrganizingMap::train_( MatrixDouble &data ){
     for(UINT j=0; j<numClusters; j++){
         
         //Init the neuron
-        neurons[j].init( N, 0.5 );
+        neurons[j].init( N, 0.5, random );
         
         //Set the weights as a random training example
-        neurons[j].weights = data.getRowVector( rand.getRandomNumberInt(0, M) );
+        neurons[j].weights = data.getRowVector( random.getRandomNumberInt(0, M) );
     }
     
     //Setup the network weights
@@ -164,13 +163,13 @@ bool SelfOrganizingMap::train_( MatrixDouble &data ){
             UINT indexB = 0;
             double weight = 0;
             for(UINT i=0; i<numClusters*numClusters; i++){
-                indexA = rand.getRandomNumberInt(0, numClusters);
-                indexB = rand.getRandomNumberInt(0, numClusters);
+                indexA = random.getRandomNumberInt(0, numClusters);
+                indexB = random.getRandomNumberInt(0, numClusters);
                 
                 //Make sure the two random indexs are the same (as this is a diagonal and should be 1)
                 if( indexA != indexB ){
                     //Pick a random weight between these two neurons
-                    weight = rand.getRandomNumberUniform(0,1);
+                    weight = random.getRandomNumberUniform(0,1);
                     
                     //The weight betwen neurons a and b is the mirrored
                     networkWeights[indexA][indexB] = weight;
@@ -210,7 +209,7 @@ bool SelfOrganizingMap::train_( MatrixDouble &data ){
     for(UINT i=0; i<M; i++){
         randomTrainingOrder[i] = i;
     }
-    std::random_shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
+    random.shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
     
     //Enter the main training loop
     while( keepTraining ){
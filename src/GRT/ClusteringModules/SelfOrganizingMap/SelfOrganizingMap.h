@@ -51,20 +51,13 @@ public:
         return weights[ index ];
     }
     
-    bool init(const UINT numInputs,const double sigma = 2.0){
+    bool init(const UINT numInputs,const double sigma,Random &random){
         
         this->numInputs = numInputs;
         this->sigma = sigma;
-        weights.resize( numInputs );
-        
-        //Set the random seed
-        Random random;
-        random.setSeed( (unsigned long long)time(NULL) );
         
         //Randomise the weights between [0.4 0.6]
-        for(unsigned int i=0; i<numInputs; i++){
-            weights[i] = random.getRandomNumberUniform(0.4,0.6);
-        }
+        weights = random.getRandomVectorUniform(numInputs,0.4,0.6);
         
         initialized = true;
 
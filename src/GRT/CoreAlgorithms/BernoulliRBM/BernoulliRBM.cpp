@@ -126,7 +126,7 @@ bool BernoulliRBM::train_(MatrixDouble &data){
         double a = 1.0 / numVisibleUnits;
         for(UINT i=0; i<numHiddenUnits; i++) {
             for(UINT j=0; j<numVisibleUnits; j++) {
-                weightsMatrix[i][j] = rand.getRandomNumberUniform(-a, a);
+                weightsMatrix[i][j] = random.getRandomNumberUniform(-a, a);
             }
         }
 
@@ -213,6 +213,7 @@ bool BernoulliRBM::train_(MatrixDouble &data){
     MatrixDouble hDiff( batchSize, numVisibleUnits );         //Stores the difference between h1-h2
     MatrixDouble cDiff( numHiddenUnits, numVisibleUnits );    //Stores the difference between c1-c2
     VectorDouble vDiffSum( numVisibleUnits );                 //Stores the column sum of vDiff
+    VectorDouble r( std::max(numVisibleUnits,numHiddenUnits) ); //Stores one row of uniform random values, used to sample h1 and v2
     VectorDouble hDiffSum( numHiddenUnits );                  //Stores the column sum of hDiff
     VectorDouble visibleLayerBiasVelocity( numVisibleUnits ); //Stores the velocity update of the visibleLayerBias
     VectorDouble hiddenLayerBiasVelocity( numHiddenUnits );   //Stores the velocity update of the hiddenLayerBias
@@ -225,7 +226,7 @@ bool BernoulliRBM::train_(MatrixDouble &data){
     //Randomize the order that the training samples will be used in
     for(UINT i=0; i<numTrainingSamples; i++) indexList[i] = i;
     if( randomiseTrainingOrder ){
-        std::random_shuffle(indexList.begin(), indexList.end());
+        random.shuffle(indexList.begin(), indexList.end());
     }
     
     //Start the main training loop
@@ -235,7 +236,7 @@ bool BernoulliRBM::train_(MatrixDouble &data){
         error = 0;
         
         //Randomize the batch order
-        std::random_shuffle(batchIndexs.begin(),batchIndexs.end());
+        random.shuffle(batchIndexs.begin(),batchIndexs.end());
         
         //Run each of the batch updates
         for(UINT k=0; k<numBatches; k+=batchStepSize){
@@ -275,16 +276,18 @@ bool BernoulliRBM::train_(MatrixDouble &data){
             //Compute h1
             h1.multiple(v1, wT);
             for(n=0; n<batchIndexs[k].batchSize; n++){
+                random.getRandomNumbersUniform(&r[0],numHiddenUnits);
                 for(i=0; i<numHiddenUnits; i++){
-                    h1_p[n][i] = sigmoidRandom( h1_p[n][i] + hlb_p[i] );
+                    h1_p[n][i] = sigmoidRandom( h1_p[n][i] + hlb_p[i], r[i] );
                 }
             }
             
             //Compute v2
             v2.multiple(h1, weightsMatrix);
             for(n=0; n<batchIndexs[k].batchSize; n++){
+                random.getRandomNumbersUniform(&r[0],numVisibleUnits);
                 for(i=0; i<numVisibleUnits; i++){
-                    v2_p[n][i] = sigmoidRandom( v2_p[n][i] + vlb_p[i] );
+                    v2_p[n][i] = sigmoidRandom( v2_p[n][i] + vlb_p[i], r[i] );
                 }
             }
             
@@ -149,8 +149,8 @@ protected:
         return 1.0 / (1.0 + exp(-x));
     }
     
-    inline double sigmoidRandom(const double &x){
-        return (1.0 / (1.0 + exp(-x)) > rand.getRandomNumberUniform(0.0,1.0)) ? 1.0 : 0.0;
+    inline double sigmoidRandom(const double &x,const double &r){
+        return (1.0 / (1.0 + exp(-x)) > r) ? 1.0 : 0.0;
     }
 
     bool randomizeWeightsForTraining;
@@ -171,7 +171,6 @@ protected:
     VectorDouble nh_samples;
     VectorDouble outputData;
     vector<MinMax> ranges;
-    Random rand;
     
     struct BatchIndexs{
         UINT startIndex;
@@ -5,6 +5,11 @@
  
  @brief This class implements a template based EvolutionaryAlgorithm.
  
+ The fitness of the individuals in each generation is estimated in parallel, using the ParallelTaskRunner. If you
+ override evaluateFitness(...) then your version must be safe to call for different individuals at the same time,
+ otherwise call setNumThreads(1) to evaluate the individuals one at a time. The current population and the parents
+ are kept in two buffers that are swapped at each generation, so evolving the population does not allocate memory.
+ 
  @remark This implementation is based on Michalewicz, Zbigniew. Genetic algorithms + data structures= evolution programs. springer, 1996.
  
  */
@@ -37,6 +42,24 @@
 
 namespace GRT{
 
+template <typename INDIVIDUAL> class EvolutionaryAlgorithm;
+
+//Evaluates the fitness of one individual in each task, each task only writes to its own individual and weight
+template <typename INDIVIDUAL>
+class EvolutionaryAlgorithmFitnessTask : public ParallelTask{
+public:
+    EvolutionaryAlgorithmFitnessTask(EvolutionaryAlgorithm< INDIVIDUAL > &algorithm,const MatrixDouble &trainingData):algorithm(algorithm),trainingData(trainingData){}
+
+    virtual bool runTask(const UINT taskIndex,const UINT threadIndex){
+        algorithm.populationWeights[ taskIndex ].value = algorithm.evaluateFitness( algorithm.population[ taskIndex ], trainingData );
+        algorithm.populationWeights[ taskIndex ].index = taskIndex;
+        return true;
+    }
+
+    EvolutionaryAlgorithm< INDIVIDUAL > &algorithm;
+    const MatrixDouble &trainingData;
+};
+
 template <typename INDIVIDUAL>
 class EvolutionaryAlgorithm : public GRTBase{
 
@@ -52,6 +75,7 @@ public:
         maxIteration = 1000;
         minNumIterationsNoChange = 1;
         storeRate = 1;
+        numThreads = 0;
         bestIndividualIndex = 0;
         bestIndividualFitness = 0;
         mutationRate = 0.01;
@@ -159,29 +183,24 @@ public:
      */
     virtual bool estimatePopulationFitness( const MatrixDouble &trainingData, double &bestFitness, UINT &bestIndex ){
         
-        UINT index = 0;
         bestFitness = 0;
         bestIndex = 0;
         
         if( !initialized ) return false;
         
-        typename vector< INDIVIDUAL >::iterator populationIter = population.begin();
-        vector< IndexedDouble >::iterator weightsIter = populationWeights.begin();
+        //Compute the fitness of each individual
+        EvolutionaryAlgorithmFitnessTask< INDIVIDUAL > fitnessTask( *this, trainingData );
+        if( !ParallelTaskRunner::run( fitnessTask, populationSize, numThreads ) ){
+            errorLog << "estimatePopulationFitness(...) - Failed to estimate the fitness of the population!" << endl;
+            return false;
+        }
         
-        while( populationIter != population.end() ){
-            //Compute the fitness of the current individual
-            weightsIter->value = evaluateFitness( *populationIter, trainingData );
-            weightsIter->index = index++;
-            
-            //Check to see if this is the best fitness so far
-            if( weightsIter->value > bestFitness ){
-                bestFitness = weightsIter->value;
-                bestIndex = weightsIter->index;
+        //Find the best fitness, the individuals are checked in order so the result does not depend on the number of threads
+        for(UINT i=0; i<populationSize; i++){
+            if( populationWeights[i].value > bestFitness ){
+                bestFitness = populationWeights[i].value;
+                bestIndex = i;
             }
-            
-            //Update the iterators
-            populationIter++;
-            weightsIter++;
         }
         
         return true;
@@ -197,17 +216,19 @@ public:
         
         if( !initialized ) return false;
         
-        UINT i=0;
         UINT index = 0;
         UINT mom = 0;
         UINT dad = 0;
         UINT crossOverPoint = 0;
-        typename vector< INDIVIDUAL >::iterator populationIter = population.begin();
+        
+        //Swap the buffers, the population that has just been evaluated becomes the parents and the children will be written over the old parents
+        population.swap( parents );
+        
+        typename vector< INDIVIDUAL >::iterator populationIter = parents.begin();
         vector< IndexedDouble >::iterator weightsIter = populationWeights.begin();
         
         //Get the current weights values
-        weightsIter = populationWeights.begin();
-        while( populationIter != population.end() ){
+        while( populationIter != parents.end() ){
             weightsIter->value = baiseWeights ? pow( populationIter->fitness, baiseCoeff ) : populationIter->fitness;
             weightsIter->index = index++;
             
@@ -233,7 +254,7 @@ public:
         
         if( useElitism ){
             //The first child is simply a copy of the best parent
-            populationIter->gene = parents[ bestIndividualIndex ].gene;
+            std::copy( parents[ bestIndividualIndex ].gene.begin(), parents[ bestIndividualIndex ].gene.end(), populationIter->gene.begin() );
             populationIter++;
         }
         
@@ -254,17 +275,10 @@ public:
             crossOverPoint = rand.getRandomNumberInt(0, geneSize);
             
             //Generate the new individual using cross over (this is the first child)
-            for(i=0; i<geneSize; i++){
-                if( i < crossOverPoint ) populationIter->gene[i] = parents[ mom ].gene[i];
-                else populationIter->gene[i] = parents[ dad ].gene[i];
-            }
+            crossOver( parents[ mom ].gene, parents[ dad ].gene, crossOverPoint, populationIter->gene );
             
             //Perform random mutation
-            for(i=0; i<geneSize; i++){
-                if( rand.getRandomNumberUniform(0.0,1.0) <= mutationRate ){
-                    populationIter->gene[ i ] = generateRandomGeneValue();
-                }
-            }
+            mutate( populationIter->gene );
             
             //Update the iterator
             populationIter++;
@@ -272,17 +286,10 @@ public:
             //Generate the second child (as long as we have not got to the end of the population)
             if( populationIter != population.end() ){
                 
-                for(i=0; i<geneSize; i++){
-                    if( i < crossOverPoint ) populationIter->gene[i] = parents[ dad ].gene[i];
-                    else populationIter->gene[i] = parents[ mom ].gene[i];
-                }
+                crossOver( parents[ dad ].gene, parents[ mom ].gene, crossOverPoint, populationIter->gene );
                 
                 //Perform random mutation
-                for(i=0; i<geneSize; i++){
-                    if( rand.getRandomNumberUniform(0.0,1.0) <= mutationRate ){
-                        populationIter->gene[ i ] = generateRandomGeneValue();
-                    }
-                }
+                mutate( populationIter->gene );
                 
                 //Update the iterator
                 populationIter++;
@@ -290,9 +297,6 @@ public:
             
         }
         
-        //Store the parents for the next iteration
-        parents = population;
-        
         return true;
     }
     
@@ -468,11 +472,28 @@ public:
         return true;
     }
     
+    /**
+     Sets the maximum number of threads that will be used to estimate the fitness of the population. Setting this to 1
+     will evaluate the individuals one at a time, which you should do if your evaluateFitness(...) function is not thread safe.
+     
+     @param const UINT numThreads: the maximum number of threads, zero will use the ParallelTaskRunner default
+     @return returns true if the number of threads was set
+     */
+    bool setNumThreads(const UINT numThreads){
+        this->numThreads = numThreads;
+        return true;
+    }
+    
+    UINT getNumThreads() const{
+        return numThreads;
+    }
+    
     virtual bool setPopulation( const vector< INDIVIDUAL > &newPopulation ){
         
         if( newPopulation.size() == 0 ) return false;
         
         population = newPopulation;
+        parents = population;
         populationSize = (UINT)population.size();
         populationWeights.resize( populationSize );
         accumSumLookup.resize( populationSize );
@@ -501,6 +522,36 @@ public:
         return false;
     }
     
+    /**
+     Creates a child gene using the elements of the first parent before the cross over point and the elements of the
+     second parent from the cross over point onwards. The child gene must already be the same size as the parents.
+     */
+    inline void crossOver(const VectorDouble &first,const VectorDouble &second,const UINT crossOverPoint,VectorDouble &child) const{
+        std::copy( first.begin(), first.begin() + crossOverPoint, child.begin() );
+        std::copy( second.begin() + crossOverPoint, second.end(), child.begin() + crossOverPoint );
+    }
+    
+    /**
+     Replaces each element of the gene with a new random value, with a probability given by the mutationRate. Rather than
+     drawing a random number for every element, the gap to the next mutated element is drawn from a geometric distribution.
+     */
+    void mutate(VectorDouble &gene){
+        const UINT N = (UINT)gene.size();
+        if( mutationRate <= 0 ) return;
+        if( mutationRate >= 1 ){
+            for(UINT i=0; i<N; i++) gene[i] = generateRandomGeneValue();
+            return;
+        }
+        const double logKeepProbability = log( 1.0 - mutationRate );
+        UINT i = 0;
+        while( i < N ){
+            const double gap = floor( log( 1.0 - rand.getRandomNumberUniform(0.0,1.0) ) / logKeepProbability );
+            if( gap >= N - i ) break;
+            i += (UINT)gap;
+            gene[ i++ ] = generateRandomGeneValue();
+        }
+    }
+    
     virtual bool printBest() const{
         if( !initialized ) return false;
         
@@ -519,6 +570,7 @@ public:
     UINT minNumIterationsNoChange;
     UINT maxIteration;
     UINT storeRate;
+    UINT numThreads;
     UINT bestIndividualIndex;
     double bestIndividualFitness;
     double mutationRate;
@@ -6,6 +6,11 @@
  
  @brief This class implements the MeanShift clustering algorithm.
  
+ The points are stored in a KDTree at the start of each search, so each iteration only visits the points that are
+ close to the current mean instead of every point. The search can be run from one starting mean, or from a number of
+ seeds that are shifted in parallel using the ParallelTaskRunner. When several seeds are used, the seeds that converge
+ to within the merge radius of each other are merged into one mode.
+ 
  @remark This implementation is based on http://en.wikipedia.org/wiki/Mean-shift
  
  */
@@ -34,9 +39,35 @@
 #define GRT_MEAN_SHIFT_HEADER
 
 #include "../../CoreModules/MLBase.h"
+#include "../../Util/KDTree.h"
 
 namespace GRT {
 
+class MeanShift;
+
+//Shifts one seed in each task, each task only writes to its own result
+class MeanShiftSeedTask : public ParallelTask{
+public:
+    MeanShiftSeedTask(MeanShift &meanShift,const vector< VectorDouble > &seeds,const vector< VectorDouble > &points,const double searchRadius,const double gamma):meanShift(meanShift),seeds(seeds),points(points),searchRadius(searchRadius),gamma(gamma){
+        means.resize( seeds.size() );
+        numIterations.resize( seeds.size(), 0 );
+        numPointsWithinSearchRadius.resize( seeds.size(), 0 );
+        converged.resize( seeds.size(), 0 );
+    }
+    
+    virtual bool runTask(const UINT taskIndex,const UINT threadIndex);
+    
+    MeanShift &meanShift;
+    const vector< VectorDouble > &seeds;
+    const vector< VectorDouble > &points;
+    const double searchRadius;
+    const double gamma;
+    vector< VectorDouble > means;
+    vector< UINT > numIterations;
+    vector< UINT > numPointsWithinSearchRadius;
+    vector< char > converged;
+};
+
 class MeanShift : public MLBase{
 public:
     MeanShift() {
@@ -56,44 +87,143 @@ public:
         
         //clear the results from any previous search
         clear();
+        modes.clear();
+        modeSupport.clear();
         
-        const unsigned int numDimensions = (unsigned int)meanStart.size();
-        const unsigned int numPoints = (unsigned int)points.size();
+        if( !tree.build( points ) ){
+            errorLog << "search(...) - Failed to build the search tree, the points must not be empty and must all have the same size!" << endl;
+            return false;
+        }
+        
+        if( meanStart.size() != tree.getNumDimensions() ){
+            errorLog << "search(...) - The size of the start mean does not match the size of the points!" << endl;
+            return false;
+        }
+        
+        const double gamma = 1.0 / (2 * SQR(sigma) );
+        UINT numPointsWithinSearchRadius = 0;
+        bool converged = false;
+        
+        numTrainingIterationsToConverge = shiftMean( meanStart, points, searchRadius, gamma, mean, numPointsWithinSearchRadius, converged, true );
+        trained = true;
+        
+        return true;
+    }
+    
+    /**
+     Runs the search from each of the seeds, and merges the seeds that converge to the same place into modes. The seeds
+     are shifted in parallel, and the modes are found by checking the seeds in order, so the modes do not depend on the
+     number of threads. Seeds that do not converge within maxNumEpochs iterations, or that have no points within the
+     search radius, are ignored.
+     
+     @param const vector< VectorDouble > &seeds: the starting mean for each search, these are often a subset of the points
+     @param const vector< VectorDouble > &points: the points that will be searched
+     @param const double searchRadius: the radius around the mean that points are used from
+     @param const double sigma: the sigma of the Gaussian kernel. Default value = 20.0
+     @param const double mergeRadius: seeds that converge within this distance of a mode are merged into that mode, zero will use half the search radius. Default value = 0
+     @return returns true if the search was run, false otherwise
+     */
+    bool search( const vector< VectorDouble > &seeds, const vector< VectorDouble > &points, const double searchRadius, const double sigma = 20.0, const double mergeRadius = 0 ){
+        
+        //clear the results from any previous search
+        clear();
+        modes.clear();
+        modeSupport.clear();
+        
+        if( seeds.size() == 0 ){
+            errorLog << "search(...) - There are no seeds!" << endl;
+            return false;
+        }
+        
+        if( !tree.build( points ) ){
+            errorLog << "search(...) - Failed to build the search tree, the points must not be empty and must all have the same size!" << endl;
+            return false;
+        }
+        
+        for(size_t i=0; i<seeds.size(); i++){
+            if( seeds[i].size() != tree.getNumDimensions() ){
+                errorLog << "search(...) - The size of seed " << i << " does not match the size of the points!" << endl;
+                return false;
+            }
+        }
+        
+        //Shift each seed until it converges
         const double gamma = 1.0 / (2 * SQR(sigma) );
+        MeanShiftSeedTask task( *this, seeds, points, searchRadius, gamma );
+        if( !ParallelTaskRunner::run( task, (UINT)seeds.size() ) ){
+            errorLog << "search(...) - Failed to run the search!" << endl;
+            return false;
+        }
+        
+        //Merge the converged seeds into modes, each seed is merged into the first mode that is within the merge radius
+        const double mergeDistance = mergeRadius > 0 ? mergeRadius : searchRadius / 2.0;
+        numTrainingIterationsToConverge = 0;
+        for(size_t i=0; i<seeds.size(); i++){
+            numTrainingIterationsToConverge = MAX( numTrainingIterationsToConverge, task.numIterations[i] );
+            if( !task.converged[i] ) continue;
+            
+            bool merged = false;
+            for(size_t k=0; k<modes.size(); k++){
+                if( euclideanDist( modes[k], task.means[i] ) < mergeDistance ){
+                    modeSupport[k]++;
+                    merged = true;
+                    break;
+                }
+            }
+            if( !merged ){
+                modes.push_back( task.means[i] );
+                modeSupport.push_back( 1 );
+            }
+        }
+        
+        trainingLog << "search(...) - Found " << modes.size() << " modes from " << seeds.size() << " seeds" << endl;
+        
+        //The main mean is set to the mode that the most seeds converged to
+        UINT bestMode = 0;
+        for(UINT k=1; k<modes.size(); k++){
+            if( modeSupport[k] > modeSupport[bestMode] ) bestMode = k;
+        }
+        if( modes.size() > 0 ) mean = modes[ bestMode ];
+        
+        trained = true;
+        
+        return true;
+    }
+    
+    /**
+     Shifts a mean until it converges, only using the points within the search radius of the mean at each iteration.
+     The search tree must have been built from the points before this is called. This function does not change the
+     MeanShift instance unless logging is enabled, so it can be called from several threads at the same time.
+     
+     @return returns the number of iterations that were run
+     */
+    UINT shiftMean( const VectorDouble &meanStart, const vector< VectorDouble > &points, const double searchRadius, const double gamma, VectorDouble &currentMean, UINT &numPointsWithinSearchRadius, bool &converged, const bool logIterations ){
+        
+        const unsigned int numDimensions = (unsigned int)meanStart.size();
         unsigned int iteration = 0;
-        VectorDouble numer(2,0);
-        VectorDouble denom(2,0);
-        VectorDouble kernelDist(2,0);
-        double pointsWithinSearchRadius = 0;
+        VectorDouble numer(numDimensions,0);
+        VectorDouble denom(numDimensions,0);
+        vector< UINT > neighbours;
         
-        mean = meanStart;
-        VectorDouble lastMean = mean;
+        currentMean = meanStart;
+        VectorDouble lastMean = currentMean;
+        converged = false;
         
         //Start the search loop
         while( true ){
             
             //Reset the counters
-            pointsWithinSearchRadius = 0;
             std::fill(numer.begin(),numer.end(),0);
             std::fill(denom.begin(),denom.end(),0);
-            std::fill(kernelDist.begin(),kernelDist.end(),0);
             
             //Update the numerator and denominator for points that are with the search radius
-            for(unsigned int i=0; i<numPoints; i++){
-                
-                //Compute the distance of the current point to the mean
-                double distToMean = euclideanDist( mean, points[i] );
-                
-                //If the point is within the search radius then update numer and denom
-                if( distToMean < searchRadius ){
-                    
-                    for(unsigned int j=0; j<numDimensions; j++){
-                        kernelDist[j] = gaussKernel( points[i][j], mean[j], gamma );
-                        numer[j] += kernelDist[j] * points[i][j];
-                        denom[j] += kernelDist[j];
-                    }
-                    
-                    pointsWithinSearchRadius++;
+            numPointsWithinSearchRadius = tree.radiusSearch( currentMean, searchRadius, neighbours );
+            for(unsigned int n=0; n<numPointsWithinSearchRadius; n++){
+                const VectorDouble &x = points[ neighbours[n] ];
+                for(unsigned int j=0; j<numDimensions; j++){
+                    const double kernelDist = exp( gamma * SQR(x[j]-currentMean[j]) );
+                    numer[j] += kernelDist * x[j];
+                    denom[j] += kernelDist;
                 }
             }
             
@@ -101,42 +231,63 @@ public:
             double change = 0;
             for(unsigned int j=0; j<numDimensions; j++){
                 
-                mean[j] = numer[j] / denom[j];
+                currentMean[j] = numer[j] / denom[j];
                 
-                change += SQR( mean[j] - lastMean[j] );
+                change += SQR( currentMean[j] - lastMean[j] );
                 
-                lastMean[j] = mean[j];
+                lastMean[j] = currentMean[j];
             }
             change = sqrt( change );
             
-            trainingLog << "iteration: " << iteration;
-            trainingLog << " mean: ";
-            for(unsigned int j=0; j<numDimensions; j++){
-                trainingLog << mean[j] << " ";
+            if( logIterations ){
+                trainingLog << "iteration: " << iteration;
+                trainingLog << " mean: ";
+                for(unsigned int j=0; j<numDimensions; j++){
+                    trainingLog << currentMean[j] << " ";
+                }
+                trainingLog << " change: " << change << endl;
             }
-            trainingLog << " change: " << change << endl;
             
             if( change < minChange ){
-                trainingLog << "min changed limit reached - stopping search" << endl;
+                if( logIterations ) trainingLog << "min changed limit reached - stopping search" << endl;
+                converged = numPointsWithinSearchRadius > 0;
+                break;
+            }
+            
+            //If there are no points within the radius then the mean is undefined, so there is no point continuing
+            if( numPointsWithinSearchRadius == 0 ){
+                if( logIterations ) trainingLog << "no points within the search radius - stopping search." << endl;
                 break;
             }
             
             if( ++iteration >= maxNumEpochs ){
-                trainingLog << "max number of iterations reached - stopping search." << endl;
+                if( logIterations ) trainingLog << "max number of iterations reached - stopping search." << endl;
                 break;
             }
             
         }
-        numTrainingIterationsToConverge = iteration;
-        trained = true;
         
-        return true;
+        return iteration;
     }
     
     VectorDouble getMean() const {
         return mean;
     }
     
+    /**
+     Gets the modes found by the last multi-seed search, in the order they were first reached by the seeds.
+     */
+    vector< VectorDouble > getModes() const {
+        return modes;
+    }
+    
+    /**
+     Gets the number of seeds that converged to each mode in the last multi-seed search.
+     */
+    vector< UINT > getModeSupport() const {
+        return modeSupport;
+    }
+    
     double gaussKernel( const double &x, const double &mu, const double gamma ){
         return exp( gamma * SQR(x-mu) );
     }
@@ -165,9 +316,19 @@ public:
 protected:
 
     VectorDouble mean;
+    vector< VectorDouble > modes;
+    vector< UINT > modeSupport;
+    KDTree tree;
     
 };
 
+inline bool MeanShiftSeedTask::runTask(const UINT taskIndex,const UINT threadIndex){
+    bool seedConverged = false;
+    numIterations[ taskIndex ] = meanShift.shiftMean( seeds[ taskIndex ], points, searchRadius, gamma, means[ taskIndex ], numPointsWithinSearchRadius[ taskIndex ], seedConverged, false );
+    converged[ taskIndex ] = seedConverged ? 1 : 0;
+    return true;
+}
+
 }
 
 #endif //GRT_MEAN_SHIFT_HEADER
\ No newline at end of file
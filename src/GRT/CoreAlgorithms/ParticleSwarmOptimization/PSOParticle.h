@@ -153,27 +153,46 @@ public:
         
         if( !initialized ) return false;
         
-        double r1 = 0;
-        double r2 = 0;
-        double vMax = 0;
+        if( globalBestX.size() != K ) return false;
+        if( K == 0 ) return true;
+        
+        //The workspace is not copied with the particle, so it is allocated the first time each particle is updated
+        if( r1.size() != K ){
+            r1.resize(K);
+            r2.resize(K);
+        }
+        
+        //Draw the random coefficients first, so the update loop below has no function calls or branches and can be vectorized
+        for(unsigned int k=0; k<K; k++){
+            r1[k] = random.getRandomNumberUniform(0.0,1.0);
+            r2[k] = random.getRandomNumberUniform(0.0,1.0);
+        }
+        
+        double *px = &x[0];
+        double *pv = &v[0];
+        double *pMin = &xMin[0];
+        double *pMax = &xMax[0];
+        const double *pLocalBest = &localBestX[0];
+        const double *pGlobalBest = &globalBestX[0];
+        const double *pr1 = &r1[0];
+        const double *pr2 = &r2[0];
         for(unsigned int k=0; k<K; k++){
-            r1 = random.getRandomNumberUniform(0.0,1.0);
-            r2 = random.getRandomNumberUniform(0.0,1.0);
-            
             //Update the velocity
-            v[k] = ( w * v[k] ) + ( c1 * r1 * (localBestX[k]-x[k]) ) + ( c2 * r2 * (globalBestX[k]-x[k]) );
+            double vk = ( w * pv[k] ) + ( c1 * pr1[k] * (pLocalBest[k]-px[k]) ) + ( c2 * pr2[k] * (pGlobalBest[k]-px[k]) );
             
             //Velocity Clamping
-            vMax = 0.1 * ((xMax[k]-xMin[k])/2.0);
-            if( v[k] > vMax ){ v[k] = vMax; }
-            else if( v[k] < -vMax ){ v[k] = -vMax; }
+            const double vMax = 0.1 * ((pMax[k]-pMin[k])/2.0);
+            vk = vk > vMax ? vMax : vk;
+            vk = vk < -vMax ? -vMax : vk;
+            pv[k] = vk;
             
             //Position Update
-            x[k] = x[k] + v[k];
+            const double xk = px[k] + vk;
+            px[k] = xk;
             
             //Update the xMax xMin values
-            if( x[k] > xMax[k] ){ xMax[k] = x[k]; }
-            else if( x[k] < xMin[k] ){ xMin[k] = x[k]; }
+            pMax[k] = xk > pMax[k] ? xk : pMax[k];
+            pMin[k] = xk < pMin[k] ? xk : pMin[k];
         }
         
         return true;
@@ -241,6 +260,17 @@ public:
         return true;
     }
     
+    /**
+     Sets the particles random number generator, for example a stream split from the generator of the swarm.
+     
+     @param const Random &random: the generator the particle should use
+     @return returns true if the generator was set, false otherwise
+     */
+    bool setRandom(const Random &random){
+        this->random = random;
+        return true;
+    }
+    
     /**
      Gets the Normal Gaussian Distrubution for x, given mu and sigma
      
@@ -284,6 +314,8 @@ public:
     vector< double > localBestX;
     vector< double > xMin;
     vector< double > xMax;
+    vector< double > r1;            ///< Workspace for the random coefficients used by update, this is not copied by the equals operator
+    vector< double > r2;            ///< Workspace for the random coefficients used by update, this is not copied by the equals operator
     Random random;
 
 };
@@ -5,6 +5,12 @@
  
  @brief This class implements a template based ParticleSwarmOptimization algorithm.
  
+ Each stage of a search iteration (propagating, evaluating and updating the particles) runs the particles in parallel,
+ using the ParallelTaskRunner. Each particle has its own random number generator, and the global best is found by
+ checking the particle costs in order once they have all been evaluated, so the search gives the same result for any
+ number of threads. If you use your own particle type then its propagate, evaluate and update functions must only
+ change that particle, otherwise call setNumThreads(1) to run the particles one at a time.
+ 
  @remark This implementation is based on Reyes-Sierra, Margarita, and CA Coello Coello. "Multi-objective particle swarm optimizers: A survey of the state-of-the-art." International journal of computational intelligence research 2, no. 3 (2006): 287-308.
  
  */
@@ -37,6 +43,35 @@
 
 namespace GRT{
 
+template<class PARTICLE_TYPE,class OBSERVATION_TYPE> class ParticleSwarmOptimization;
+
+//Runs one stage of a search iteration for each particle, each task only changes its own particle and cost
+template<class PARTICLE_TYPE,class OBSERVATION_TYPE>
+class ParticleSwarmOptimizationTask : public ParallelTask{
+public:
+    enum Stages{ PROPAGATE=0, EVALUATE, UPDATE };
+    
+    ParticleSwarmOptimizationTask(ParticleSwarmOptimization< PARTICLE_TYPE, OBSERVATION_TYPE > &pso,const unsigned int stage,OBSERVATION_TYPE *observation = NULL):pso(pso),stage(stage),observation(observation){}
+    
+    virtual bool runTask(const UINT taskIndex,const UINT threadIndex){
+        PARTICLE_TYPE &particle = pso.particles[ taskIndex ];
+        switch( stage ){
+            case PROPAGATE:
+                return particle.propagate( pso.propagationModel );
+            case EVALUATE:
+                pso.particleCosts[ taskIndex ] = particle.evaluate( *observation );
+                return true;
+            case UPDATE:
+                return particle.update( pso.globalBestX );
+        }
+        return false;
+    }
+    
+    ParticleSwarmOptimization< PARTICLE_TYPE, OBSERVATION_TYPE > &pso;
+    const unsigned int stage;
+    OBSERVATION_TYPE *observation;
+};
+
 template<class PARTICLE_TYPE,class OBSERVATION_TYPE>
 class ParticleSwarmOptimization{
     
@@ -49,6 +84,8 @@ public:
         minImprovement = 1.0e-10;
         maxIter = 500;
         maxNumIterNoChange = 10;
+        numThreads = 0;
+        storeHistory = true;
     }
     
     /**
@@ -57,6 +94,7 @@ public:
     virtual ~ParticleSwarmOptimization(){
         globalBestX.clear();
         particles.clear();
+        particleCosts.clear();
     }
     
     /**
@@ -106,18 +144,21 @@ public:
         globalBestX.clear();
         globalBestX.resize(K,0);
         
-        //Initialize the new particles with random positions and velocities
-        Random random;
+        //Initialize the new particles with random positions and velocities. Each particle gets its own stream of the swarm's
+        //generator, so the particles can be propagated in parallel and the search is the same for a given seed
         particles.resize(numParticles);
-        typename vector< PARTICLE_TYPE >::iterator pIter = particles.begin();
-        for(pIter = particles.begin(); pIter != particles.end(); pIter++){
-            pIter->setRandomSeed( random.getRandomNumberInt(0, 100000) );
-            pIter->init(K,xMin,xMax);
+        particleCosts.resize(numParticles,0);
+        const unsigned long long firstStream = random.getRandomNumberUInt64();
+        for(unsigned int i=0; i<numParticles; i++){
+            particles[i].setRandom( random.split( firstStream + i ) );
+            particles[i].init(K,xMin,xMax);
         }
         
         //Store the initial distrubution
-        iterHistory.push_back( particles );
-        globalBestXHistory.push_back( globalBestX );
+        if( storeHistory ){
+            iterHistory.push_back( particles );
+            globalBestXHistory.push_back( globalBestX );
+        }
         
         //Flag that everything has been initialized
         initialized = true;
@@ -153,12 +194,10 @@ public:
         if( !initialized ) return false;
 
         //Propagate all the particles
-        typename vector< PARTICLE_TYPE >::iterator pIter;
-        for(pIter = particles.begin(); pIter != particles.end(); pIter++){
-            if( !pIter->propagate( propagationModel ) ){
-                errorLog << "search(...) - Particle propagation failed!" << endl;
-                return false;
-            }
+        ParticleSwarmOptimizationTask< PARTICLE_TYPE, OBSERVATION_TYPE > propagateTask( *this, ParticleSwarmOptimizationTask< PARTICLE_TYPE, OBSERVATION_TYPE >::PROPAGATE );
+        if( !ParallelTaskRunner::run( propagateTask, (UINT)particles.size(), numThreads ) ){
+            errorLog << "search(...) - Particle propagation failed!" << endl;
+            return false;
         }
         
         unsigned int iterCounter = 0;
@@ -172,10 +211,15 @@ public:
         globalBestCost = 0;
         
         while( keepSearching ){
-            currentMaxima = searchIteration( observation );
+            if( !searchIteration( observation, currentMaxima ) ){
+                errorLog << "search(...) - Search iteration " << iterCounter << " failed!" << endl;
+                return false;
+            }
             
-            iterHistory.push_back( particles );
-            globalBestXHistory.push_back( globalBestX );
+            if( storeHistory ){
+                iterHistory.push_back( particles );
+                globalBestXHistory.push_back( globalBestX );
+            }
             
             delta = fabs( currentMaxima - lastMaxima );
             lastMaxima = currentMaxima;
@@ -204,31 +248,42 @@ public:
      You need to initialize the PSO algorithm first before you can use this function.
      
      @param OBSERVATION_TYPE &observation: a reference to the observation data used for the search
-     @return returns true if the search ran successfully, false otherwise
+     @return returns the best cost of the particles in this iteration, or zero if the iteration failed
      */
     virtual double searchIteration(OBSERVATION_TYPE &observation){
+        double currentMaxima = 0;
+        if( !searchIteration( observation, currentMaxima ) ) return 0;
+        return currentMaxima;
+    }
+    
+    /**
+     Performs one iteration of the search, as above, but reports if the iteration failed.
+     
+     @param OBSERVATION_TYPE &observation: a reference to the observation data used for the search
+     @param double &currentBestMaxima: returns the best cost of the particles in this iteration
+     @return returns true if the iteration ran successfully, false otherwise
+     */
+    virtual bool searchIteration(OBSERVATION_TYPE &observation,double &currentBestMaxima){
         
-        if( !initialized ) return 0;
+        currentBestMaxima = 0;
+        if( !initialized ) return false;
         
-        unsigned int index = 0;
+        const unsigned int numParticles = (unsigned int)particles.size();
         unsigned int bestIndex = 0;
-        double currentBestMaxima = 0;
-        double epsilon = 0;
-        typename vector< PARTICLE_TYPE >::iterator pIter;
         
-        //Compute the cost for each particle, tracking the best cost of all the particles in the swarm
-        for(pIter = particles.begin(); pIter != particles.end(); pIter++){
-            
-            //Evaluate the current particle
-            epsilon = pIter->evaluate(observation);
-
-            //Check to see if this is the best
-            if( epsilon >  currentBestMaxima ){
-                currentBestMaxima = epsilon;
-                bestIndex = index;
+        //Compute the cost for each particle
+        ParticleSwarmOptimizationTask< PARTICLE_TYPE, OBSERVATION_TYPE > evaluateTask( *this, ParticleSwarmOptimizationTask< PARTICLE_TYPE, OBSERVATION_TYPE >::EVALUATE, &observation );
+        if( !ParallelTaskRunner::run( evaluateTask, numParticles, numThreads ) ){
+            errorLog << "searchIteration(...) - Particle evaluation failed!" << endl;
+            return false;
+        }
+        
+        //Find the best cost of all the particles in the swarm, the costs are checked in order so the result does not depend on the number of threads
+        for(unsigned int i=0; i<numParticles; i++){
+            if( particleCosts[i] > currentBestMaxima ){
+                currentBestMaxima = particleCosts[i];
+                bestIndex = i;
             }
-            
-            index++;
         }
         
         //Check to see if we need to update the global cost and position
@@ -238,11 +293,13 @@ public:
         }
 
         //Update the position and velocity of all of the particles
-        for(pIter = particles.begin(); pIter != particles.end(); pIter++){
-            pIter->update( globalBestX );
+        ParticleSwarmOptimizationTask< PARTICLE_TYPE, OBSERVATION_TYPE > updateTask( *this, ParticleSwarmOptimizationTask< PARTICLE_TYPE, OBSERVATION_TYPE >::UPDATE );
+        if( !ParallelTaskRunner::run( updateTask, numParticles, numThreads ) ){
+            errorLog << "searchIteration(...) - Particle update failed!" << endl;
+            return false;
         }
         
-        return currentBestMaxima;
+        return true;
     }
     
     /**
@@ -259,12 +316,50 @@ public:
         
         return true;
     }
+    
+    /**
+     Sets the maximum number of threads that will be used to propagate, evaluate and update the particles. Setting this to 1
+     will run the particles one at a time, which you should do if your particle functions are not thread safe.
+     
+     @param const unsigned int numThreads: the maximum number of threads, zero will use the ParallelTaskRunner default
+     @return returns true if the number of threads was set
+     */
+    bool setNumThreads(const unsigned int numThreads){
+        this->numThreads = numThreads;
+        return true;
+    }
+    
+    /**
+     Sets if the particles and global best state vector should be stored in iterHistory and globalBestXHistory at each iteration.
+     Turning this off saves copying the whole swarm at every iteration of the search.
+     
+     @param const bool storeHistory: true if the search history should be stored
+     @return returns true if the parameter was set
+     */
+    bool setStoreHistory(const bool storeHistory){
+        this->storeHistory = storeHistory;
+        return true;
+    }
+    
+    /**
+     Sets the seed of the random number generator used to initialize the particles. Running the search twice from the
+     same seed gives the same result, for any number of threads.
+     
+     @param const unsigned long long seed: the new seed, zero will set the seed using the current system time
+     @return returns true if the seed was set
+     */
+    bool setRandomSeed(const unsigned long long seed){
+        random.setSeed( seed );
+        return true;
+    }
 
     bool initialized;   ///< A flag to indicate if the PSO algorithm has been initialized
     unsigned int K;     ///< The size of the particles state vector
     double minImprovement;
     unsigned int maxIter;
     unsigned int maxNumIterNoChange;
+    unsigned int numThreads;    ///< The maximum number of threads used to run the particles, zero uses the ParallelTaskRunner default
+    bool storeHistory;  ///< If true, the particles and global best state vector will be stored at each iteration
     double globalBestCost;  ///< The current global best cost over all the particles
     vector< double > finalX;  ///< The final estimate
     vector< double > globalBestX;   ///< The state vector of the particle with the best cost
@@ -272,8 +367,10 @@ public:
     vector< double > xMax;  ///< The maximum range of the state space
     vector< double > propagationModel;  ///<The propagation model used to update each particle
     vector< PARTICLE_TYPE > particles;  ///< A vector containing all the particles used for the search
+    vector< double > particleCosts;     ///< The cost of each particle at the current iteration
     vector< vector< double > > globalBestXHistory;  ///< A buffer to keep track of the search history
     vector< vector< PARTICLE_TYPE > > iterHistory;  ///< A buffer to keep track of the search history
+    Random random;  ///< The generator the streams of the particles are split from
     
     InfoLog infoLog;
     ErrorLog errorLog;
@@ -33,6 +33,7 @@ PrincipalComponentAnalysis::PrincipalComponentAnalysis(){
 	numInputDimensions = 0;
 	numPrincipalComponents = 0;
     maxVariance = 0;
+    batchNumSamples = 0;
     
     classType = "PrincipalComponentAnalysis";
     errorLog.setProceedingText("[ERROR PrincipalComponentAnalysis]");
@@ -62,39 +63,256 @@ bool PrincipalComponentAnalysis::computeFeatureVector(const MatrixDouble &data,U
     return computeFeatureVector_(data,MAX_NUM_PCS);
 }
 
-bool PrincipalComponentAnalysis::computeFeatureVector_(const MatrixDouble &data,const UINT analysisMode){
-
+bool PrincipalComponentAnalysis::computeFeatureVectorRandomized(const MatrixDouble &data,UINT numPrincipalComponents,bool normData,UINT numOversamples,UINT numPowerIterations){
+    
     trained = false;
     const UINT M = data.getNumRows();
     const UINT N = data.getNumCols();
+    
+    if( numPrincipalComponents == 0 || numPrincipalComponents > N ){
+        errorLog << "computeFeatureVectorRandomized(...) - The number of principal components (";
+        errorLog << numPrincipalComponents << ") must be greater than zero and not greater than the number of columns in your data (" << N << ")" << endl;
+        return false;
+    }
+    if( M < 2 ){
+        errorLog << "computeFeatureVectorRandomized(...) - The data must have at least two rows!" << endl;
+        return false;
+    }
+    
+    this->numPrincipalComponents = numPrincipalComponents;
+    this->normData = normData;
     this->numInputDimensions = N;
-
-    MatrixDouble msData( M, N );
-
+    const UINT K = numPrincipalComponents;
+    const UINT L = MIN(K+numOversamples,N);
+    
     //Compute the mean and standard deviation of the input data
     mean = data.getMean();
     stdDev = data.getStdDev();
+    
+    //Start from a random [N L] basis, a fixed seed is used so the same data always gives the same components
+    Random random( 5489 );
+    MatrixDouble Q(N,L);
+    for(UINT j=0; j<N; j++)
+        for(UINT l=0; l<L; l++)
+            Q[j][l] = random.getRandomNumberGauss();
+    orthonormalizeColumns( Q );
+    
+    //Each pass multiplies the basis by X'X, where X is the mean subtracted (and normalized) data. X'X is never built,
+    //each row x adds x'(xQ) to the result, so each pass only needs one [N L] matrix
+    MatrixDouble Z(N,L);
+    VectorDouble x(N);
+    VectorDouble y(L);
+    double totalVariance = 0;
+    for(UINT iter=0; iter<=numPowerIterations; iter++){
+        Z.setAllValues(0);
+        for(UINT i=0; i<M; i++){
+            getCenteredRow( data, i, x );
+            if( iter == 0 ){
+                for(UINT j=0; j<N; j++) totalVariance += x[j]*x[j];
+            }
+            std::fill(y.begin(),y.end(),0);
+            for(UINT j=0; j<N; j++){
+                const double xj = x[j];
+                const double *q = Q[j];
+                for(UINT l=0; l<L; l++) y[l] += xj * q[l];
+            }
+            for(UINT j=0; j<N; j++){
+                const double xj = x[j];
+                double *z = Z[j];
+                for(UINT l=0; l<L; l++) z[l] += xj * y[l];
+            }
+        }
+        Q = Z;
+        orthonormalizeColumns( Q );
+    }
+    
+    //Project X'X onto the basis, giving a small [L L] matrix with the same top eigenvalues
+    MatrixDouble T(L,L);
+    T.setAllValues(0);
+    for(UINT i=0; i<M; i++){
+        getCenteredRow( data, i, x );
+        std::fill(y.begin(),y.end(),0);
+        for(UINT j=0; j<N; j++){
+            const double xj = x[j];
+            const double *q = Q[j];
+            for(UINT l=0; l<L; l++) y[l] += xj * q[l];
+        }
+        for(UINT l=0; l<L; l++){
+            const double yl = y[l];
+            double *t = T[l];
+            for(UINT m=0; m<=l; m++) t[m] += yl * y[m];
+        }
+    }
+    
+    EigenvalueDecomposition eig;
+    if( !eig.decomposeSymmetric( T ) ){
+        mean.clear();
+        stdDev.clear();
+        componentWeights.clear();
+        sortedEigenvalues.clear();
+        eigenvectors.clear();
+        errorLog << "computeFeatureVectorRandomized(...) - Failed to decompose the projected matrix!" << endl;
+        return false;
+    }
+    
+    //The eigenvalues are in ascending order, so the top K components are the last K eigenvectors mapped back through the basis
+    MatrixDouble U = eig.getEigenvectors();
+    VectorDouble lambda = eig.getRealEigenvalues();
+    eigenvectors.resize(N,K);
+    eigenvalues.resize(K);
+    componentWeights.resize(K);
+    sortedEigenvalues.resize(K);
+    maxVariance = 0;
+    for(UINT k=0; k<K; k++){
+        const UINT c = L-1-k;
+        for(UINT j=0; j<N; j++){
+            double sum = 0;
+            for(UINT l=0; l<L; l++) sum += Q[j][l] * U[l][c];
+            eigenvectors[j][k] = sum;
+        }
+        eigenvalues[k] = lambda[c] > 0 ? lambda[c] / double(M-1) : 0;
+        componentWeights[k] = totalVariance > 0 ? eigenvalues[k] / (totalVariance/double(M-1)) : 0;
+        sortedEigenvalues[k] = IndexedDouble(k,eigenvalues[k]);
+        maxVariance += componentWeights[k];
+    }
+    
+    //Flag that the features have been computed
+    trained = true;
+    
+    return true;
+}
 
-    if( normData ){
-        //Normalize the data
-        for(UINT i=0; i<M; i++)
-            for(UINT j=0; j<N; j++)
-                msData[i][j] = (data[i][j]-mean[j]) / stdDev[j];
+bool PrincipalComponentAnalysis::addBatch(const MatrixDouble &batch){
+    
+    const UINT M = batch.getNumRows();
+    const UINT N = batch.getNumCols();
+    
+    if( M == 0 || N == 0 ){
+        errorLog << "addBatch(const MatrixDouble &batch) - The batch is empty!" << endl;
+        return false;
+    }
+    if( batchNumSamples > 0 && N != batchMean.size() ){
+        errorLog << "addBatch(const MatrixDouble &batch) - The number of columns in the batch (" << N << ") does not match the number of columns in the previous batches (" << batchMean.size() << ")!" << endl;
+        return false;
+    }
+    
+    VectorDouble mu = batch.getMean();
+    MatrixDouble scatter;
+    computeScatterMatrix( batch, mu, scatter );
+    
+    if( batchNumSamples == 0 ){
+        batchMean = mu;
+        batchScatter = scatter;
+        batchNumSamples = M;
+        return true;
+    }
+    
+    //Merge the batch with the previous batches using the pairwise update of Chan, Golub and LeVeque
+    const double na = batchNumSamples;
+    const double nb = M;
+    const double n = na + nb;
+    VectorDouble delta(N);
+    for(UINT j=0; j<N; j++) delta[j] = mu[j] - batchMean[j];
+    for(UINT j=0; j<N; j++){
+        const double dj = delta[j] * na * nb / n;
+        for(UINT k=0; k<N; k++){
+            batchScatter[j][k] += scatter[j][k] + dj * delta[k];
+        }
+    }
+    for(UINT j=0; j<N; j++) batchMean[j] += delta[j] * nb / n;
+    batchNumSamples += M;
+    
+    return true;
+}
 
-    }else{
-        //Mean Subtract Data
-        for(UINT i=0; i<M; i++)
-            for(UINT j=0; j<N; j++)
-                msData[i][j] = data[i][j] - mean[j];
+bool PrincipalComponentAnalysis::computeFeatureVectorFromBatches(double maxVariance,bool normData){
+    trained = false;
+    this->maxVariance = maxVariance;
+    this->normData = normData;
+    return computeFeatureVectorFromBatches_(MAX_VARIANCE);
+}
+
+bool PrincipalComponentAnalysis::computeFeatureVectorFromBatches(UINT numPrincipalComponents,bool normData){
+    trained = false;
+    if( numPrincipalComponents > batchMean.size() ){
+        errorLog << "computeFeatureVectorFromBatches(UINT numPrincipalComponents,bool normData) - The number of principal components (";
+        errorLog << numPrincipalComponents << ") is greater than the number of columns in your data (" << batchMean.size() << ")" << endl;
+        return false;
+    }
+    this->numPrincipalComponents = numPrincipalComponents;
+    this->normData = normData;
+    return computeFeatureVectorFromBatches_(MAX_NUM_PCS);
+}
+
+bool PrincipalComponentAnalysis::clearBatches(){
+    batchNumSamples = 0;
+    batchMean.clear();
+    batchScatter.clear();
+    return true;
+}
+
+bool PrincipalComponentAnalysis::computeFeatureVectorFromBatches_(const UINT analysisMode){
+    
+    if( batchNumSamples < 2 ){
+        errorLog << "computeFeatureVectorFromBatches(...) - At least two samples must be added before the principal components can be computed!" << endl;
+        return false;
+    }
+    
+    const UINT N = (UINT)batchMean.size();
+    this->numInputDimensions = N;
+    
+    mean = batchMean;
+    stdDev.resize(N);
+    MatrixDouble cov( batchScatter );
+    for(UINT j=0; j<N; j++){
+        for(UINT k=0; k<N; k++){
+            cov[j][k] /= double(batchNumSamples-1);
+        }
+        stdDev[j] = sqrt( cov[j][j] );
+    }
+    
+    return computeFeatureVectorFromCovariance_(cov,analysisMode);
+}
+
+bool PrincipalComponentAnalysis::computeFeatureVector_(const MatrixDouble &data,const UINT analysisMode){
+
+    trained = false;
+    const UINT M = data.getNumRows();
+    const UINT N = data.getNumCols();
+    this->numInputDimensions = N;
+
+    //Compute the mean of the input data
+    mean = data.getMean();
+
+    //Get the covariance matrix, this is computed directly from the data so a mean subtracted copy of the data is not needed
+    MatrixDouble cov;
+    computeScatterMatrix( data, mean, cov );
+    stdDev.resize(N);
+    for(UINT j=0; j<N; j++){
+        for(UINT k=0; k<N; k++){
+            cov[j][k] /= double(M-1);
+        }
+        stdDev[j] = sqrt( cov[j][j] );
     }
 
-    //Get the covariance matrix
-    MatrixDouble cov = msData.getCovarianceMatrix();
+    return computeFeatureVectorFromCovariance_(cov,analysisMode);
+}
+
+bool PrincipalComponentAnalysis::computeFeatureVectorFromCovariance_(MatrixDouble &cov,const UINT analysisMode){
+
+    const UINT N = numInputDimensions;
+
+    //Scaling the covariance by the standard deviations gives the covariance of the z-normalized data
+    if( normData ){
+        for(UINT j=0; j<N; j++)
+            for(UINT k=0; k<N; k++)
+                cov[j][k] /= stdDev[j] * stdDev[k];
+    }
 
-    //Use Eigen Value Decomposition to find eigenvectors of the covariance matrix
+    //The covariance matrix is symmetric, so use the symmetric eigen solver to find its eigenvectors
     EigenvalueDecomposition eig;
 
-    if( !eig.decompose( cov ) ){
+    if( !eig.decomposeSymmetric( cov ) ){
         mean.clear();
         stdDev.clear();
         componentWeights.clear();
@@ -175,6 +393,64 @@ bool PrincipalComponentAnalysis::computeFeatureVector_(const MatrixDouble &data,
     return true;
 }
 
+void PrincipalComponentAnalysis::computeScatterMatrix(const MatrixDouble &data,const VectorDouble &mean,MatrixDouble &scatter) const{
+    
+    const UINT M = data.getNumRows();
+    const UINT N = data.getNumCols();
+    scatter.resize(N,N);
+    scatter.setAllValues(0);
+    
+    //Accumulate the upper triangle one row at a time, so the data is read in order and the inner loop runs along a row
+    VectorDouble x(N);
+    for(UINT i=0; i<M; i++){
+        for(UINT j=0; j<N; j++) x[j] = data[i][j] - mean[j];
+        for(UINT j=0; j<N; j++){
+            const double xj = x[j];
+            double *s = scatter[j];
+            for(UINT k=j; k<N; k++) s[k] += xj * x[k];
+        }
+    }
+    
+    //Copy the upper triangle to the lower triangle
+    for(UINT j=0; j<N; j++)
+        for(UINT k=0; k<j; k++)
+            scatter[j][k] = scatter[k][j];
+}
+    
+void PrincipalComponentAnalysis::getCenteredRow(const MatrixDouble &data,const UINT row,VectorDouble &x) const{
+    const UINT N = data.getNumCols();
+    if( normData ){
+        for(UINT j=0; j<N; j++) x[j] = (data[row][j]-mean[j]) / stdDev[j];
+    }else{
+        for(UINT j=0; j<N; j++) x[j] = data[row][j] - mean[j];
+    }
+}
+    
+void PrincipalComponentAnalysis::orthonormalizeColumns(MatrixDouble &Q){
+    
+    const UINT N = Q.getNumRows();
+    const UINT L = Q.getNumCols();
+    
+    //Modified Gram-Schmidt, run twice so the columns stay orthogonal to working precision
+    for(UINT pass=0; pass<2; pass++){
+        for(UINT l=0; l<L; l++){
+            double originalNorm = 0;
+            for(UINT j=0; j<N; j++) originalNorm += Q[j][l] * Q[j][l];
+            for(UINT m=0; m<l; m++){
+                double dot = 0;
+                for(UINT j=0; j<N; j++) dot += Q[j][l] * Q[j][m];
+                for(UINT j=0; j<N; j++) Q[j][l] -= dot * Q[j][m];
+            }
+            double norm = 0;
+            for(UINT j=0; j<N; j++) norm += Q[j][l] * Q[j][l];
+            norm = sqrt( norm );
+            //If the column is linearly dependent on the previous columns then the data has a lower rank than the basis, so the column is not needed
+            const double scale = norm > 1.0e-10 * sqrt( originalNorm ) ? 1.0/norm : 0;
+            for(UINT j=0; j<N; j++) Q[j][l] *= scale;
+        }
+    }
+}
+
 bool PrincipalComponentAnalysis::project(const MatrixDouble &data,MatrixDouble &prjData){
 	
     if( !trained ){
@@ -17,6 +17,12 @@
  this algorithm, the user should first run the computeFeatureVector(...) function to build the PCA feature vector and
  then run the project(...) function to project new data onto the new principal subspace.
  
+ If only the top K components of a large dataset are needed, the computeFeatureVectorRandomized(...) function can be used
+ instead. This estimates the top K components using randomized subspace iteration, which only needs a few passes over the
+ data and never builds the full [N N] covariance matrix. Datasets that are too large to be stored in memory can be added
+ one batch at a time using the addBatch(...) function, the principal components of all the batches added so far can then
+ be computed using the computeFeatureVectorFromBatches(...) function.
+ 
  @remark This implementation is based on Bishop, Christopher M. Pattern recognition and machine learning. Vol. 1. New York: springer, 2006.
  */
 
@@ -88,6 +94,61 @@ class PrincipalComponentAnalysis : public GRTBase{
      */
     bool computeFeatureVector(const MatrixDouble &data,UINT numPrincipalComponents,bool normData=false);
     
+    /**
+     Estimates the top K principal components of the input data using randomized subspace iteration. This is much faster
+     than computeFeatureVector(...) when K is much smaller than the number of dimensions, as the full covariance matrix is
+     never computed. Each power iteration makes two more passes over the data and improves the accuracy of the components,
+     the default values are normally enough unless the eigenvalues of the data decay very slowly.
+     
+     Only the top K eigenvalues are estimated, so the component weights are computed relative to the total variance of the
+     data and the eigenvalue and eigenvector matrices only have K columns.
+     
+     @param const MatrixDouble &data: a matrix containing the data from which the principal components will be computed. This should be an [M N] matrix, where M==samples and N==dimensions
+     @param UINT numPrincipalComponents: sets the number of principal components. This must be a value be less than or equal to the number of dimensions in the input data
+     @param bool normData: sets if the data will be z-normalized before running the PCA algorithm. Default value=false
+     @param UINT numOversamples: the number of extra random vectors that are used to improve the estimate of the components. Default value=10
+     @param UINT numPowerIterations: the number of power iterations. Default value=2
+     @return returns true if the principal components of the input matrix could be computed, false otherwise
+     */
+    bool computeFeatureVectorRandomized(const MatrixDouble &data,UINT numPrincipalComponents,bool normData=false,UINT numOversamples=10,UINT numPowerIterations=2);
+    
+    /**
+     Adds a batch of data to the incremental PCA. Only the mean and the scatter matrix of all the data added so far are
+     stored, so the batches can be discarded once they have been added. All the batches must have the same number of
+     columns. Call computeFeatureVectorFromBatches(...) to compute the principal components of the data added so far.
+     
+     @param const MatrixDouble &batch: an [M N] matrix containing the new data, where M==samples and N==dimensions
+     @return returns true if the batch was added, false otherwise
+     */
+    bool addBatch(const MatrixDouble &batch);
+    
+    /**
+     Computes the principal components of all the data added using the addBatch(...) function, the result is the same as
+     running computeFeatureVector(...) on all the data at once. This can be called again after more batches are added.
+     
+     @param double maxVariance: sets the variance that should represented by the top K principal components. This should be a value between [0 1]. Default value=0.95
+     @param bool normData: sets if the data will be z-normalized before running the PCA algorithm. Default value=false
+     @return returns true if the principal components could be computed, false otherwise
+     */
+    bool computeFeatureVectorFromBatches(double maxVariance=0.95,bool normData=false);
+    
+    /**
+     Computes the principal components of all the data added using the addBatch(...) function, using a fixed number of
+     principal components.
+     
+     @param UINT numPrincipalComponents: sets the number of principal components. This must be a value be less than or equal to the number of dimensions in the data
+     @param bool normData: sets if the data will be z-normalized before running the PCA algorithm. Default value=false
+     @return returns true if the principal components could be computed, false otherwise
+     */
+    bool computeFeatureVectorFromBatches(UINT numPrincipalComponents,bool normData=false);
+    
+    /**
+     Removes all the data that has been added using the addBatch(...) function. This does not change the current principal components.
+     
+     @return returns true if the batches were cleared
+     */
+    bool clearBatches();
+    
     /**
      Projects the input data matrix onto the principal subspace. The new projected data will be stored in the prjData 
      matrix. The computeFeatureVector function should have been called at least once before this function is called.
@@ -134,6 +195,12 @@ class PrincipalComponentAnalysis : public GRTBase{
      */
     UINT getNumPrincipalComponents() const { return numPrincipalComponents; }
     
+    /**
+     Returns the number of samples that have been added using the addBatch(...) function.
+     @return returns the number of samples that have been added using the addBatch(...) function
+     */
+    UINT getNumBatchSamples() const { return batchNumSamples; }
+    
     /**
      Returns the maxVariance parameter, set by the user when the computeFeatureVector was called.
      returns the maxVariance parameter, set by the user when the computeFeatureVector was called
@@ -181,6 +248,11 @@ class PrincipalComponentAnalysis : public GRTBase{
 	
 protected:
     bool computeFeatureVector_(const MatrixDouble &data,UINT analysisMode);
+    bool computeFeatureVectorFromBatches_(UINT analysisMode);
+    bool computeFeatureVectorFromCovariance_(MatrixDouble &cov,UINT analysisMode);
+    void computeScatterMatrix(const MatrixDouble &data,const VectorDouble &mean,MatrixDouble &scatter) const;
+    void getCenteredRow(const MatrixDouble &data,const UINT row,VectorDouble &x) const;
+    static void orthonormalizeColumns(MatrixDouble &Q);
 
     bool trained;
     bool normData;
@@ -193,6 +265,9 @@ protected:
     VectorDouble eigenvalues;
     vector< IndexedDouble > sortedEigenvalues;
     MatrixDouble eigenvectors;
+    UINT batchNumSamples;
+    VectorDouble batchMean;
+    MatrixDouble batchScatter;
     
     ErrorLog errorLog;
     WarningLog warningLog;
@@ -150,6 +150,11 @@ bool Classifier::clear(){
     return true;
 }
 
+bool Classifier::predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const{
+    //Shared prediction is not supported by default, see getSupportsSharedPrediction
+    return false;
+}
+
 string Classifier::getClassifierType() const{
     return classifierType; 
 }
@@ -385,5 +390,81 @@ bool Classifier::loadBaseSettingsFromFile(fstream &file){
     return true;
 }
 
+bool Classifier::saveBaseSettingsToBinaryFile(BinaryModelFileWriter &file,const string &prefix) const{
+    
+    if( !MLBase::saveBaseSettingsToBinaryFile( file, prefix ) ) return false;
+    
+    if( !file.addBool( prefix + "UseNullRejection", useNullRejection ) ) return false;
+    if( !file.addUInt( prefix + "ClassifierMode", classifierMode ) ) return false;
+    if( !file.addDouble( prefix + "NullRejectionCoeff", nullRejectionCoeff ) ) return false;
+    
+    if( trained ){
+        if( !file.addUInt( prefix + "NumClasses", numClasses ) ) return false;
+        
+        if( useNullRejection && nullRejectionThresholds.size() ){
+            if( !file.addDoubleArray( prefix + "NullRejectionThresholds", nullRejectionThresholds ) ) return false;
+        }else{
+            if( !file.addDoubleArray( prefix + "NullRejectionThresholds", VectorDouble(numClasses,0) ) ) return false;
+        }
+        
+        if( !file.addUIntArray( prefix + "ClassLabels", classLabels ) ) return false;
+        
+        if( useScaling ){
+            VectorDouble minMax(ranges.size()*2);
+            for(UINT i=0; i<ranges.size(); i++){
+                minMax[i*2] = ranges[i].minValue;
+                minMax[i*2+1] = ranges[i].maxValue;
+            }
+            if( !file.addDoubleArray( prefix + "Ranges", minMax ) ) return false;
+        }
+    }
+    
+    return true;
+}
+
+bool Classifier::loadBaseSettingsFromBinaryFile(const BinaryModelFileReader &file,const string &prefix){
+    
+    //Try and load the base settings from the file
+    if( !MLBase::loadBaseSettingsFromBinaryFile( file, prefix ) ){
+        return false;
+    }
+    
+    if( !file.getBool( prefix + "UseNullRejection", useNullRejection ) ||
+        !file.getUInt( prefix + "ClassifierMode", classifierMode ) ||
+        !file.getDouble( prefix + "NullRejectionCoeff", nullRejectionCoeff ) ){
+        errorLog << "loadBaseSettingsFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to read the classifier settings!" << endl;
+        clear();
+        return false;
+    }
+    
+    //If the model is trained then load the model settings
+    if( trained ){
+        if( !file.getUInt( prefix + "NumClasses", numClasses ) ||
+            !file.getDoubleArray( prefix + "NullRejectionThresholds", nullRejectionThresholds ) ||
+            !file.getUIntArray( prefix + "ClassLabels", classLabels ) ||
+            nullRejectionThresholds.size() != numClasses || classLabels.size() != numClasses ){
+            errorLog << "loadBaseSettingsFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to read the class settings!" << endl;
+            clear();
+            return false;
+        }
+        
+        if( useScaling ){
+            VectorDouble minMax;
+            if( !file.getDoubleArray( prefix + "Ranges", minMax ) || minMax.size() != numInputDimensions*2 ){
+                errorLog << "loadBaseSettingsFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to read the Ranges!" << endl;
+                clear();
+                return false;
+            }
+            ranges.resize(numInputDimensions);
+            for(UINT i=0; i<ranges.size(); i++){
+                ranges[i].minValue = minMax[i*2];
+                ranges[i].maxValue = minMax[i*2+1];
+            }
+        }
+    }
+    
+    return true;
+}
+
 } //End of namespace GRT
 
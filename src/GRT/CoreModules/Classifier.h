@@ -38,6 +38,24 @@ namespace GRT{
 #define DEFAULT_NULL_LIKELIHOOD_VALUE 0
 #define DEFAULT_NULL_DISTANCE_VALUE 0
 
+/**
+ Holds the results of one prediction made with Classifier::predictShared.
+ */
+class ClassifierPrediction{
+public:
+    ClassifierPrediction(){
+        predictedClassLabel = 0;
+        maxLikelihood = 0;
+        bestDistance = 0;
+    }
+
+    UINT predictedClassLabel;
+    double maxLikelihood;
+    double bestDistance;
+    VectorDouble classLikelihoods;
+    VectorDouble classDistances;
+};
+
 class Classifier : public MLBase
 {
 public:
@@ -234,6 +252,28 @@ public:
      return returns true if the classifier can be used to classify timeseries data, false otherwise
      */
     bool getTimeseriesCompatible() const{ return classifierMode==TIMESERIES_CLASSIFIER_MODE; }
+
+    /**
+     Indicates if the classifier implements predictShared, in which case one trained instance can be used by several
+     threads (or several pipelines) at the same time.
+
+     @return returns true if the classifier supports shared prediction, false otherwise
+     */
+    virtual bool getSupportsSharedPrediction() const{ return false; }
+
+    /**
+     Predicts the class of the inputVector without changing this classifier, so one trained classifier can be used by
+     several threads at the same time. The results are written to the prediction instead of to this classifier, so
+     getPredictedClassLabel() and the other prediction getters of this classifier are not updated. This function must not
+     write to the logs of this classifier either, a failure is only reported by the return value and the caller should
+     check the input (and log any failure) itself.
+     Classifiers that support this should override this function and getSupportsSharedPrediction.
+
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassifierPrediction &prediction: returns the predicted class label, likelihoods and distances
+     @return returns true if the prediction was performed, false otherwise (the Classifier base class will always return false)
+     */
+    virtual bool predictShared(const VectorDouble &inputVector,ClassifierPrediction &prediction) const;
     
     /**
      Defines a map between a string (which will contain the name of the classifier, such as ANBC) and a function returns a new instance of that classifier
@@ -299,6 +339,20 @@ protected:
      @return returns true if the base settings were loaded, false otherwise
      */
     bool loadBaseSettingsFromFile(fstream &file);
+    
+    /**
+     Saves the core base settings to a binary model file.
+     
+     @return returns true if the base settings were saved, false otherwise
+     */
+    bool saveBaseSettingsToBinaryFile(BinaryModelFileWriter &file,const string &prefix) const;
+    
+    /**
+     Loads the core base settings from a binary model file.
+     
+     @return returns true if the base settings were loaded, false otherwise
+     */
+    bool loadBaseSettingsFromBinaryFile(const BinaryModelFileReader &file,const string &prefix);
 
     string classifierType;
     bool supportsNullRejection;
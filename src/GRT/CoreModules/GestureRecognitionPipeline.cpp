@@ -19,6 +19,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include "GestureRecognitionPipeline.h"
+#include "../PreProcessingModules/FilterCascade.h"
 
 namespace GRT{
 
@@ -111,6 +112,7 @@ GestureRecognitionPipeline& GestureRecognitionPipeline::operator=(const GestureR
 	    this->testConfusionMatrix = rhs.testConfusionMatrix;
         this->crossValidationResults = rhs.crossValidationResults;
         this->testResults = rhs.testResults;
+        this->profiler.setEnabled( rhs.profiler.getEnabled() );
 
         //Copy the GRT Base variables
         this->debugLog = rhs.debugLog;
@@ -290,8 +292,9 @@ bool GestureRecognitionPipeline::train(ClassificationData trainingData,const UIN
     Timer timer;
     timer.start();
 
-    //Spilt the data into K folds
-    bool spiltResult = trainingData.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling);
+    //Spilt the data into K folds, the folds use their own stream of the classifier's seed so they are repeatable
+    Random random( classifier->getRandomSeed(), 1 );
+    bool spiltResult = trainingData.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling, random);
     
     if( !spiltResult ){
         return false;
@@ -548,8 +551,9 @@ bool GestureRecognitionPipeline::train(TimeSeriesClassificationData trainingData
     Timer timer;
     timer.start();
     
-    //Spilt the data into K folds
-    if( !trainingData.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling) ){
+    //Spilt the data into K folds, the folds use their own stream of the classifier's seed so they are repeatable
+    Random random( classifier->getRandomSeed(), 1 );
+    if( !trainingData.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling, random) ){
         errorLog << "train(TimeSeriesClassificationData trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed To Spilt Dataset into KFolds!" << endl;
         return false;
     }
@@ -709,8 +713,9 @@ bool GestureRecognitionPipeline::train(RegressionData trainingData,const UINT kF
     Timer timer;
     timer.start();
     
-    //Spilt the data into K folds
-    bool spiltResult = trainingData.spiltDataIntoKFolds(kFoldValue);
+    //Spilt the data into K folds, the folds use their own stream of the regressifier's seed so they are repeatable
+    Random random( regressifier->getRandomSeed(), 1 );
+    bool spiltResult = trainingData.spiltDataIntoKFolds(kFoldValue, random);
     
     if( !spiltResult ){
         return false;
@@ -1130,6 +1135,8 @@ bool GestureRecognitionPipeline::predict(const VectorDouble &inputVector){
         return false;
     }
 
+    PipelineProfilerScope predictScope( profiler, PipelineProfiler::PREDICT );
+
 	if( getIsClassifierSet() ){
         return predict_classifier( inputVector );
     }
@@ -1292,7 +1299,9 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
     //Update the context module
     predictionModuleIndex = START_OF_PIPELINE;
     if( contextModules[ START_OF_PIPELINE ].size() > 0 ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CONTEXT_START_OF_PIPELINE );
         for(UINT moduleIndex=0; moduleIndex<contextModules[ START_OF_PIPELINE ].size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::CONTEXT_START_OF_PIPELINE, moduleIndex );
             if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at START_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1306,7 +1315,9 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
     
     //Perform any pre-processing
     if( getIsPreProcessingSet() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::PRE_PROCESSING );
         for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::PRE_PROCESSING, moduleIndex );
             if( !preProcessingModules[moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_classifier(VectorDouble inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1318,7 +1329,9 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
     //Update the context module
     predictionModuleIndex = AFTER_PREPROCESSING;
     if( contextModules[ AFTER_PREPROCESSING ].size() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CONTEXT_AFTER_PREPROCESSING );
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_PREPROCESSING ].size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::CONTEXT_AFTER_PREPROCESSING, moduleIndex );
             if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1333,7 +1346,9 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
     
     //Perform any feature extraction
     if( getIsFeatureExtractionSet() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::FEATURE_EXTRACTION );
         for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::FEATURE_EXTRACTION, moduleIndex );
             if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
                 errorLog << "predict_classifier(VectorDouble inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1345,7 +1360,9 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
     //Update the context module
     predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
     if( contextModules[ AFTER_FEATURE_EXTRACTION ].size() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CONTEXT_AFTER_FEATURE_EXTRACTION );
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::CONTEXT_AFTER_FEATURE_EXTRACTION, moduleIndex );
             if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1359,15 +1376,20 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
     }
     
     //Perform the classification
-    if( !classifier->predict(inputVector) ){
-        errorLog << "predict_classifier(VectorDouble inputVector) - Prediction Failed! " << classifier->getLastErrorMessage() << endl;
-        return false;
+    {
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CLASSIFIER );
+        if( !classifier->predict(inputVector) ){
+            errorLog << "predict_classifier(VectorDouble inputVector) - Prediction Failed! " << classifier->getLastErrorMessage() << endl;
+            return false;
+        }
     }
     predictedClassLabel = classifier->getPredictedClassLabel();
     
     //Update the context module
     if( contextModules[ AFTER_CLASSIFIER ].size() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CONTEXT_AFTER_CLASSIFIER );
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_CLASSIFIER ].size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::CONTEXT_AFTER_CLASSIFIER, moduleIndex );
             if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( vector<double>(1,predictedClassLabel) ) ){
                 errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1390,7 +1412,9 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
         }
         
         VectorDouble data;
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::POST_PROCESSING );
         for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::POST_PROCESSING, moduleIndex );
             
             //Select which input we should give the postprocessing module
             if( postProcessingModules[moduleIndex]->getIsPostProcessingInputModePredictedClassLabel() ){
@@ -1435,7 +1459,9 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
     //Update the context module
     predictionModuleIndex = END_OF_PIPELINE;
     if( contextModules[ END_OF_PIPELINE ].size() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CONTEXT_END_OF_PIPELINE );
         for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::CONTEXT_END_OF_PIPELINE, moduleIndex );
             if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( vector<double>(1,predictedClassLabel) ) ){
                 errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1456,7 +1482,9 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
     //Update the context module
     predictionModuleIndex = START_OF_PIPELINE;
     if( contextModules[ START_OF_PIPELINE ].size() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CONTEXT_START_OF_PIPELINE );
         for(UINT moduleIndex=0; moduleIndex<contextModules[ START_OF_PIPELINE ].size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::CONTEXT_START_OF_PIPELINE, moduleIndex );
             if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at START_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1470,7 +1498,9 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
     
     //Perform any pre-processing
     if( getIsPreProcessingSet() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::PRE_PROCESSING );
         for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::PRE_PROCESSING, moduleIndex );
             if( !preProcessingModules[moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_regressifier(VectorDouble inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1482,7 +1512,9 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
     //Update the context module
     predictionModuleIndex = AFTER_PREPROCESSING;
     if( contextModules[ AFTER_PREPROCESSING ].size() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CONTEXT_AFTER_PREPROCESSING );
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_PREPROCESSING ].size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::CONTEXT_AFTER_PREPROCESSING, moduleIndex );
             if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1497,7 +1529,9 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
     
     //Perform any feature extraction
     if( getIsFeatureExtractionSet() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::FEATURE_EXTRACTION );
         for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::FEATURE_EXTRACTION, moduleIndex );
             if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
                 errorLog << "predict_regressifier(VectorDouble inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1509,7 +1543,9 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
     //Update the context module
     predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
     if( contextModules[ AFTER_FEATURE_EXTRACTION ].size() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CONTEXT_AFTER_FEATURE_EXTRACTION );
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::CONTEXT_AFTER_FEATURE_EXTRACTION, moduleIndex );
             if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1523,15 +1559,20 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
     }
     
     //Perform the regression
-    if( !regressifier->predict(inputVector) ){
-        errorLog << "predict_regressifier(VectorDouble inputVector) - Prediction Failed! " << regressifier->getLastErrorMessage() << endl;
-        return false;
+    {
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CLASSIFIER );
+        if( !regressifier->predict(inputVector) ){
+            errorLog << "predict_regressifier(VectorDouble inputVector) - Prediction Failed! " << regressifier->getLastErrorMessage() << endl;
+            return false;
+        }
     }
     regressionData = regressifier->getRegressionData();
     
     //Update the context module
     if( contextModules[ AFTER_CLASSIFIER ].size() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CONTEXT_AFTER_CLASSIFIER );
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_CLASSIFIER ].size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::CONTEXT_AFTER_CLASSIFIER, moduleIndex );
             if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( regressionData ) ){
                 errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1553,7 +1594,9 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
             return false;
         }
           
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::POST_PROCESSING );
         for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::POST_PROCESSING, moduleIndex );
             if( regressionData.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
                 errorLog << "predict_regressifier(VectorDouble inputVector) - The size of the regression vector (" << int(regressionData.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
                 return false;
@@ -1571,7 +1614,9 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
     //Update the context module
     predictionModuleIndex = END_OF_PIPELINE;
     if( contextModules[ END_OF_PIPELINE ].size() ){
+        PipelineProfilerScope stageScope( profiler, PipelineProfiler::CONTEXT_END_OF_PIPELINE );
         for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
+            PipelineProfilerScope moduleScope( profiler, PipelineProfiler::CONTEXT_END_OF_PIPELINE, moduleIndex );
             if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
                 return false;
@@ -1762,6 +1807,9 @@ bool GestureRecognitionPipeline::savePipelineToFile(const string &filename) cons
 }
 
 bool GestureRecognitionPipeline::load(const string &filename){
+    if( BinaryModelFile::isBinaryModelFile( filename ) ){
+        return loadPipelineFromBinaryFile( filename );
+    }
     return loadPipelineFromFile( filename );
 }
     
@@ -2017,6 +2065,189 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
     return true;
 }
     
+bool GestureRecognitionPipeline::savePipelineToBinaryFile(const string &filename) const{
+    
+    if( !initialized ){
+        errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to write pipeline to file as the pipeline has not been initialized yet!" << endl;
+        return false;
+    }
+    
+    BinaryModelFileWriter file;
+    
+    //Write the pipeline header info
+    file.addString( "Pipeline/Header", "GRT_PIPELINE_BINARY_FILE_V1.0" );
+    file.addString( "Pipeline/PipelineMode", getPipelineModeAsString() );
+    file.addUInt( "Pipeline/NumPreprocessingModules", getNumPreProcessingModules() );
+    file.addUInt( "Pipeline/NumFeatureExtractionModules", getNumFeatureExtractionModules() );
+    file.addUInt( "Pipeline/NumPostprocessingModules", getNumPostProcessingModules() );
+    file.addBool( "Pipeline/Trained", getTrained() );
+    
+    //Write the module datatypes and models, the sections of each module are prefixed with the name of the module
+    for(UINT i=0; i<getNumPreProcessingModules(); i++){
+        const string prefix = "PreProcessingModule_" + Util::intToString(i+1) + "/";
+        file.addString( prefix + "Datatype", preProcessingModules[i]->getPreProcessingType() );
+        if( !preProcessingModules[i]->saveModelToBinaryFile( file, prefix ) ){
+            errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to write preprocessing module " << i << " settings to file!" << endl;
+            return false;
+        }
+    }
+    
+    for(UINT i=0; i<getNumFeatureExtractionModules(); i++){
+        const string prefix = "FeatureExtractionModule_" + Util::intToString(i+1) + "/";
+        file.addString( prefix + "Datatype", featureExtractionModules[i]->getFeatureExtractionType() );
+        if( !featureExtractionModules[i]->saveModelToBinaryFile( file, prefix ) ){
+            errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to write feature extraction module " << i << " settings to file!" << endl;
+            return false;
+        }
+    }
+    
+    switch( pipelineMode ){
+        case PIPELINE_MODE_NOT_SET:
+            break;
+        case CLASSIFICATION_MODE:
+            if( getIsClassifierSet() ){
+                file.addString( "Classifier/Datatype", classifier->getClassifierType() );
+                if( !classifier->saveModelToBinaryFile( file, "Classifier/" ) ){
+                    errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to write classifier model to file!" << endl;
+                    return false;
+                }
+            }
+            break;
+        case REGRESSION_MODE:
+            if( getIsRegressifierSet() ){
+                file.addString( "Regressifier/Datatype", regressifier->getRegressifierType() );
+                if( !regressifier->saveModelToBinaryFile( file, "Regressifier/" ) ){
+                    errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to write regressifier model to file!" << endl;
+                    return false;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    
+    for(UINT i=0; i<getNumPostProcessingModules(); i++){
+        const string prefix = "PostProcessingModule_" + Util::intToString(i+1) + "/";
+        file.addString( prefix + "Datatype", postProcessingModules[i]->getPostProcessingType() );
+        if( !postProcessingModules[i]->saveModelToBinaryFile( file, prefix ) ){
+            errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to write post processing module " << i << " settings to file!" << endl;
+            return false;
+        }
+    }
+    
+    if( !file.save( filename ) ){
+        errorLog << "savePipelineToBinaryFile(const string &filename) - Failed to write file: " << filename << endl;
+        return false;
+    }
+    
+    return true;
+}
+    
+bool GestureRecognitionPipeline::loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMap){
+    
+    //Clear any previous setup
+    clearAll();
+    
+    BinaryModelFileReader file;
+    if( !file.open( filename, useMemoryMap ) ){
+        errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMap) - Failed to open file with filename: " << filename << endl;
+        return false;
+    }
+    
+    string word;
+    if( !file.getString( "Pipeline/Header", word ) || word != "GRT_PIPELINE_BINARY_FILE_V1.0" ){
+        errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMap) - Failed to read file header" << endl;
+        return false;
+    }
+    
+    UINT numPreprocessingModules = 0;
+    UINT numFeatureExtractionModules = 0;
+    UINT numPostprocessingModules = 0;
+    if( !file.getString( "Pipeline/PipelineMode", word ) ||
+        !file.getUInt( "Pipeline/NumPreprocessingModules", numPreprocessingModules ) ||
+        !file.getUInt( "Pipeline/NumFeatureExtractionModules", numFeatureExtractionModules ) ||
+        !file.getUInt( "Pipeline/NumPostprocessingModules", numPostprocessingModules ) ||
+        !file.getBool( "Pipeline/Trained", trained ) ){
+        errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMap) - Failed to read the pipeline settings" << endl;
+        clearAll();
+        return false;
+    }
+    pipelineMode = getPipelineModeFromString(word);
+    
+    //Create and load the modules
+    preProcessingModules.resize(numPreprocessingModules,NULL);
+    for(UINT i=0; i<numPreprocessingModules; i++){
+        const string prefix = "PreProcessingModule_" + Util::intToString(i+1) + "/";
+        if( file.getString( prefix + "Datatype", word ) ) preProcessingModules[i] = PreProcessing::createInstanceFromString( word );
+        if( preProcessingModules[i] == NULL || !preProcessingModules[i]->loadModelFromBinaryFile( file, prefix ) ){
+            errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMap) - Failed to load preprocessing module " << i << " from file!" << endl;
+            clearAll();
+            return false;
+        }
+    }
+    
+    featureExtractionModules.resize(numFeatureExtractionModules,NULL);
+    for(UINT i=0; i<numFeatureExtractionModules; i++){
+        const string prefix = "FeatureExtractionModule_" + Util::intToString(i+1) + "/";
+        if( file.getString( prefix + "Datatype", word ) ) featureExtractionModules[i] = FeatureExtraction::createInstanceFromString( word );
+        if( featureExtractionModules[i] == NULL || !featureExtractionModules[i]->loadModelFromBinaryFile( file, prefix ) ){
+            errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMap) - Failed to load feature extraction module " << i << " from file!" << endl;
+            clearAll();
+            return false;
+        }
+    }
+    
+    switch( pipelineMode ){
+        case PIPELINE_MODE_NOT_SET:
+            break;
+        case CLASSIFICATION_MODE:
+            if( file.getString( "Classifier/Datatype", word ) ) classifier = Classifier::createInstanceFromString( word );
+            if( classifier == NULL || !classifier->loadModelFromBinaryFile( file, "Classifier/" ) ){
+                errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMap) - Failed to load classifier model from file!" << endl;
+                clearAll();
+                return false;
+            }
+            initialized = true;
+            break;
+        case REGRESSION_MODE:
+            if( file.getString( "Regressifier/Datatype", word ) ) regressifier = Regressifier::createInstanceFromString( word );
+            if( regressifier == NULL || !regressifier->loadModelFromBinaryFile( file, "Regressifier/" ) ){
+                errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMap) - Failed to load regressifier model from file!" << endl;
+                clearAll();
+                return false;
+            }
+            initialized = true;
+            break;
+        default:
+            break;
+    }
+    
+    postProcessingModules.resize(numPostprocessingModules,NULL);
+    for(UINT i=0; i<numPostprocessingModules; i++){
+        const string prefix = "PostProcessingModule_" + Util::intToString(i+1) + "/";
+        if( file.getString( prefix + "Datatype", word ) ) postProcessingModules[i] = PostProcessing::createInstanceFromString( word );
+        if( postProcessingModules[i] == NULL || !postProcessingModules[i]->loadModelFromBinaryFile( file, prefix ) ){
+            errorLog << "loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMap) - Failed to load post processing module " << i << " from file!" << endl;
+            clearAll();
+            return false;
+        }
+    }
+    
+    //Set the expected input vector size
+    inputVectorDimensions = 0;
+    if( numPreprocessingModules > 0 ){
+        inputVectorDimensions = preProcessingModules[0]->getNumInputDimensions();
+    }else if( numFeatureExtractionModules > 0 ){
+        inputVectorDimensions = featureExtractionModules[0]->getNumInputDimensions();
+    }else if( pipelineMode == CLASSIFICATION_MODE ){
+        inputVectorDimensions = classifier->getNumInputFeatures();
+    }else if( pipelineMode == REGRESSION_MODE ){
+        inputVectorDimensions = regressifier->getNumInputFeatures();
+    }
+    
+    return true;
+}
+    
 bool GestureRecognitionPipeline::preProcessData(VectorDouble inputVector,bool computeFeatures){
     
     if( getIsPreProcessingSet() ){
@@ -2648,6 +2879,52 @@ bool GestureRecognitionPipeline::removePreProcessingModule(UINT moduleIndex){
 
     return true;
 }
+    
+bool GestureRecognitionPipeline::fusePreProcessingModules(){
+    
+    vector< PreProcessing* > fusedModules;
+    UINT numFusedModules = 0;
+    UINT moduleIndex = 0;
+    
+    while( moduleIndex < preProcessingModules.size() ){
+        
+        //Find the longest run of linear filters starting at this module, all with the same dimensionality
+        const UINT numDimensions = preProcessingModules[ moduleIndex ]->getNumInputDimensions();
+        FilterCascade cascade( numDimensions );
+        UINT runLength = 0;
+        while( moduleIndex + runLength < preProcessingModules.size() ){
+            const PreProcessing *module = preProcessingModules[ moduleIndex + runLength ];
+            if( module->getNumInputDimensions() != numDimensions || module->getNumOutputDimensions() != numDimensions ) break;
+            
+            //Append the module to a copy, so a module that fails part way through does not change the cascade
+            FilterCascade candidate( cascade );
+            if( !module->appendToFilterCascade( candidate ) ) break;
+            cascade = candidate;
+            runLength++;
+        }
+        
+        //There is nothing to gain from replacing a single module
+        if( runLength < 2 || !cascade.init( numDimensions ) ){
+            fusedModules.push_back( preProcessingModules[ moduleIndex++ ] );
+            continue;
+        }
+        
+        fusedModules.push_back( new FilterCascade( cascade ) );
+        for(UINT i=0; i<runLength; i++){
+            delete preProcessingModules[ moduleIndex + i ];
+            preProcessingModules[ moduleIndex + i ] = NULL;
+        }
+        moduleIndex += runLength;
+        numFusedModules += runLength;
+    }
+    
+    if( numFusedModules > 0 ){
+        preProcessingModules = fusedModules;
+        profiler.reset();
+    }
+    
+    return true;
+}
    
 bool GestureRecognitionPipeline::removeAllFeatureExtractionModules(){
     deleteAllFeatureExtractionModules();
@@ -2748,6 +3025,61 @@ bool GestureRecognitionPipeline::clearTestResults(){
     return true;
 }
 
+bool GestureRecognitionPipeline::setProfilingEnabled(const bool enabled){
+    return profiler.setEnabled( enabled );
+}
+
+bool GestureRecognitionPipeline::getProfilingEnabled() const{
+    return profiler.getEnabled();
+}
+
+bool GestureRecognitionPipeline::resetProfiling(){
+    return profiler.reset();
+}
+
+const PipelineProfiler& GestureRecognitionPipeline::getProfiler() const{
+    return profiler;
+}
+
+string GestureRecognitionPipeline::getProfilingReport() const{
+    
+    //Name each module by its type, so the report shows which module each set of stats belongs to
+    vector< vector< string > > moduleNames( PipelineProfiler::NUM_STAGES );
+    const UINT contextStages[ NUM_CONTEXT_LEVELS ] = {PipelineProfiler::CONTEXT_START_OF_PIPELINE,PipelineProfiler::CONTEXT_AFTER_PREPROCESSING,PipelineProfiler::CONTEXT_AFTER_FEATURE_EXTRACTION,PipelineProfiler::CONTEXT_AFTER_CLASSIFIER,PipelineProfiler::CONTEXT_END_OF_PIPELINE};
+    for(UINT level=0; level<NUM_CONTEXT_LEVELS; level++){
+        for(UINT i=0; i<contextModules[level].size(); i++){
+            moduleNames[ contextStages[level] ].push_back( contextModules[level][i]->getContextType() );
+        }
+    }
+    for(UINT i=0; i<preProcessingModules.size(); i++){
+        moduleNames[ PipelineProfiler::PRE_PROCESSING ].push_back( preProcessingModules[i]->getPreProcessingType() );
+    }
+    for(UINT i=0; i<featureExtractionModules.size(); i++){
+        moduleNames[ PipelineProfiler::FEATURE_EXTRACTION ].push_back( featureExtractionModules[i]->getFeatureExtractionType() );
+    }
+    for(UINT i=0; i<postProcessingModules.size(); i++){
+        moduleNames[ PipelineProfiler::POST_PROCESSING ].push_back( postProcessingModules[i]->getPostProcessingType() );
+    }
+    
+    return profiler.getJSON( moduleNames );
+}
+
+bool GestureRecognitionPipeline::saveProfilingReport(const string &filename) const{
+    
+    std::fstream file;
+    file.open(filename.c_str(), std::ios::out);
+    
+    if( !file.is_open() ){
+        errorLog << "saveProfilingReport(const string &filename) - Failed to open file: " << filename << endl;
+        return false;
+    }
+    
+    file << getProfilingReport();
+    file.close();
+    
+    return true;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////  
 ///////////////////////////////////////////          PROTECTED FUNCTIONS              ///////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////// 
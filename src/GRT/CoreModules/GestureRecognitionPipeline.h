@@ -44,6 +44,7 @@
 #include "../DataStructures/TimeSeriesClassificationDataStream.h"
 #include "../Util/ClassificationResult.h"
 #include "../Util/TestResult.h"
+#include "../Util/PipelineProfiler.h"
 
 namespace GRT{
     
@@ -242,7 +243,7 @@ public:
 
     /**
      This function will load an entire pipeline from a file.  This includes all the modules types, settings, and models.
-     This calls the older loadPipelineFromFile function
+     This calls loadPipelineFromBinaryFile if the file is a binary model file, otherwise it calls the older loadPipelineFromFile function
      
      @param const string &filename: the name of the file you want to load the pipeline from
      @return bool returns true if the pipeline was loaded successful, false otherwise
@@ -257,6 +258,26 @@ public:
 	*/
     bool loadPipelineFromFile(const string &filename);
     
+    /**
+     This function will save the entire pipeline to a binary model file (see BinaryModelFile).  This includes all the modules types, settings, and models.
+     The binary file is much faster to load than the text file, as the model values are stored as raw arrays rather than text.
+     Every module in the pipeline must support the binary format (i.e. override MLBase::saveModelToBinaryFile), otherwise this will fail
+     and the pipeline should be saved with savePipelineToFile instead.
+
+     @param const string &filename: the name of the file you want to save the pipeline to
+     @return bool returns true if the pipeline was saved successful, false otherwise
+     */
+    bool savePipelineToBinaryFile(const string &filename) const;
+    
+    /**
+     This function will load an entire pipeline from a binary model file written by savePipelineToBinaryFile.
+
+     @param const string &filename: the name of the file you want to load the pipeline from
+     @param const bool useMemoryMap: if true the file is memory mapped rather than read, when this is supported by the OS. Default useMemoryMap = true
+     @return bool returns true if the pipeline was loaded successful, false otherwise
+     */
+    bool loadPipelineFromBinaryFile(const string &filename,const bool useMemoryMap = true);
+    
     /**
      This function will pass the input vector through any preprocessing or feature extraction modules added to the pipeline.  This function
      can be useful for testing and validating a preprocessing or feature extraction module, without having to acutally train a classification or
@@ -925,6 +946,17 @@ public:
 	 @return returns true if the preprocessing module was removed successfully, false otherwise
 	 */
     bool removePreProcessingModule(UINT moduleIndex);
+    
+    /**
+     Fuses each run of consecutive linear time invariant preprocessing modules (such as LowPassFilter -> Derivative ->
+     HighPassFilter) into one FilterCascade module, which computes the same output as a cascade of second order sections.
+     Runs of a single module and modules that are not linear filters (see PreProcessing::appendToFilterCascade) are
+     kept as they are. The fused modules start from their reset state, and the profiling stats are reset if any modules
+     were fused as the module indexes change. The pipeline does not need to be retrained.
+     
+     @return returns true if the preprocessing modules were fused (or there was nothing to fuse), false otherwise
+     */
+    bool fusePreProcessingModules();
 
     /**
 	 Removes all the feature extraction modules from the current pipeline. If the pipeline has been trained it will need to be retrained before it can be used.
@@ -999,6 +1031,52 @@ public:
 	 @return returns true if the test results were cleared successfully, false otherwise
 	 */
     bool clearTestResults();
+    
+    /**
+     Enables or disables the profiler. When the profiler is enabled, each call to predict(const VectorDouble &inputVector)
+     records the time and number of memory allocations of each stage and each module of the pipeline. See PipelineProfiler
+     for more info. The profiler is disabled by default.
+     
+     @param const bool enabled: true if the pipeline should be profiled
+     @return returns true if the parameter was set
+     */
+    bool setProfilingEnabled(const bool enabled);
+    
+    /**
+     Gets if the profiler is enabled.
+     
+     @return returns true if the profiler is enabled, false otherwise
+     */
+    bool getProfilingEnabled() const;
+    
+    /**
+     Removes all the values recorded by the profiler.
+     
+     @return returns true if the profiler was reset
+     */
+    bool resetProfiling();
+    
+    /**
+     Gets a reference to the profiler, which can be used to read the stats of each stage and module.
+     
+     @return returns a const reference to the profiler
+     */
+    const PipelineProfiler& getProfiler() const;
+    
+    /**
+     Gets the profiler stats of each stage and module as a JSON string, with the modules named by their type. The times are in nanoseconds.
+     
+     @return returns a JSON string with the profiler stats
+     */
+    string getProfilingReport() const;
+    
+    /**
+     Saves the profiler stats of each stage and module to a JSON file.
+     
+     @param const string &filename: the name of the file the report should be saved to
+     @return returns true if the report was saved, false otherwise
+     */
+    bool saveProfilingReport(const string &filename) const;
 
 protected:
     bool predict_classifier(VectorDouble inputVector);
@@ -1042,8 +1120,11 @@ protected:
     Regressifier *regressifier;
     vector< PostProcessing* > postProcessingModules;
     vector< vector< Context* > > contextModules;
+    PipelineProfiler profiler;
     
     enum PipelineModes{PIPELINE_MODE_NOT_SET=0,CLASSIFICATION_MODE,REGRESSION_MODE};
+
+    friend class PipelinePool;
     
 public:
     enum ContextLevels{START_OF_PIPELINE=0,AFTER_PREPROCESSING,AFTER_FEATURE_EXTRACTION,AFTER_CLASSIFIER,END_OF_PIPELINE,NUM_CONTEXT_LEVELS};
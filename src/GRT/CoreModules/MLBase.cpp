@@ -69,6 +69,7 @@ bool MLBase::copyMLBaseVariables(const MLBase *mlBase){
     this->totalSquaredTrainingError = mlBase->totalSquaredTrainingError;
     this->useValidationSet = mlBase->useValidationSet;
     this->randomiseTrainingOrder = mlBase->randomiseTrainingOrder;
+    this->random = mlBase->random;
     this->numTrainingIterationsToConverge = mlBase->numTrainingIterationsToConverge;
     this->trainingResults = mlBase->trainingResults;
     this->trainingResultsObserverManager = mlBase->trainingResultsObserverManager;
@@ -171,6 +172,16 @@ bool MLBase::loadModelFromFile(const string filename){
 
 bool MLBase::loadModelFromFile(fstream &file){ return false; }
 
+bool MLBase::saveModelToBinaryFile(BinaryModelFileWriter &file,const string &prefix) const{
+    errorLog << "saveModelToBinaryFile(BinaryModelFileWriter &file,const string &prefix) - This module does not support the binary model format!" << endl;
+    return false;
+}
+
+bool MLBase::loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix){
+    errorLog << "loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - This module does not support the binary model format!" << endl;
+    return false;
+}
+
 UINT MLBase::getBaseType() const{ return baseType; }
 
 UINT MLBase::getNumInputFeatures() const{ return getNumInputDimensions(); }
@@ -222,6 +233,8 @@ bool MLBase::getIsBaseTypeRegressifier() const{ return baseType==REGRESSIFIER; }
     
 bool MLBase::getIsBaseTypeClusterer() const{ return baseType==CLUSTERER; }
 
+unsigned long long MLBase::getRandomSeed() const{ return random.getSeed(); }
+
 bool MLBase::enableScaling(bool useScaling){ this->useScaling = useScaling; return true; }
     
 bool MLBase::setMaxNumEpochs(const UINT maxNumEpochs){
@@ -276,6 +289,11 @@ bool MLBase::setRandomiseTrainingOrder(const bool randomiseTrainingOrder){
     this->randomiseTrainingOrder = randomiseTrainingOrder;
     return true;
 }
+
+bool MLBase::setRandomSeed(const unsigned long long seed){
+    random.setSeed( seed );
+    return true;
+}
     
 bool MLBase::registerTrainingResultsObserver( Observer< TrainingResult > &observer ){
     return trainingResultsObserverManager.registerObserver( observer );
@@ -455,4 +473,47 @@ bool MLBase::loadBaseSettingsFromFile(fstream &file){
     return true;
 }
 
+bool MLBase::saveBaseSettingsToBinaryFile(BinaryModelFileWriter &file,const string &prefix) const{
+    
+    if( !file.addBool( prefix + "Trained", trained ) ) return false;
+    if( !file.addBool( prefix + "UseScaling", useScaling ) ) return false;
+    if( !file.addUInt( prefix + "NumInputDimensions", numInputDimensions ) ) return false;
+    if( !file.addUInt( prefix + "NumOutputDimensions", numOutputDimensions ) ) return false;
+    if( !file.addUInt( prefix + "NumTrainingIterationsToConverge", numTrainingIterationsToConverge ) ) return false;
+    if( !file.addUInt( prefix + "MinNumEpochs", minNumEpochs ) ) return false;
+    if( !file.addUInt( prefix + "MaxNumEpochs", maxNumEpochs ) ) return false;
+    if( !file.addUInt( prefix + "ValidationSetSize", validationSetSize ) ) return false;
+    if( !file.addDouble( prefix + "LearningRate", learningRate ) ) return false;
+    if( !file.addDouble( prefix + "MinChange", minChange ) ) return false;
+    if( !file.addBool( prefix + "UseValidationSet", useValidationSet ) ) return false;
+    if( !file.addBool( prefix + "RandomiseTrainingOrder", randomiseTrainingOrder ) ) return false;
+    
+    return true;
+}
+
+bool MLBase::loadBaseSettingsFromBinaryFile(const BinaryModelFileReader &file,const string &prefix){
+    
+    //Clear any previous setup
+    clear();
+    
+    if( !file.getBool( prefix + "Trained", trained ) ||
+        !file.getBool( prefix + "UseScaling", useScaling ) ||
+        !file.getUInt( prefix + "NumInputDimensions", numInputDimensions ) ||
+        !file.getUInt( prefix + "NumOutputDimensions", numOutputDimensions ) ||
+        !file.getUInt( prefix + "NumTrainingIterationsToConverge", numTrainingIterationsToConverge ) ||
+        !file.getUInt( prefix + "MinNumEpochs", minNumEpochs ) ||
+        !file.getUInt( prefix + "MaxNumEpochs", maxNumEpochs ) ||
+        !file.getUInt( prefix + "ValidationSetSize", validationSetSize ) ||
+        !file.getDouble( prefix + "LearningRate", learningRate ) ||
+        !file.getDouble( prefix + "MinChange", minChange ) ||
+        !file.getBool( prefix + "UseValidationSet", useValidationSet ) ||
+        !file.getBool( prefix + "RandomiseTrainingOrder", randomiseTrainingOrder ) ){
+        errorLog << "loadBaseSettingsFromBinaryFile(const BinaryModelFileReader &file,const string &prefix) - Failed to read the base settings!" << endl;
+        clear();
+        return false;
+    }
+    
+    return true;
+}
+
 } //End of namespace GRT
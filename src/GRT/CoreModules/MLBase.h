@@ -37,6 +37,7 @@
 #include "../DataStructures/RegressionData.h"
 #include "../DataStructures/TimeSeriesClassificationData.h"
 #include "../DataStructures/TimeSeriesClassificationDataStream.h"
+#include "../Util/BinaryModelFile.h"
 
 namespace GRT{
 
@@ -316,6 +317,26 @@ public:
      */
     virtual bool loadModelFromFile(fstream &file);
     
+    /**
+     This saves the trained model to a binary model file, using sections whose names start with the prefix.
+     This function should be overwritten by the derived class, the base class does not support the binary format.
+     
+     @param BinaryModelFileWriter &file: a reference to the binary model file the model will be added to
+     @param const string &prefix: the prefix of the section names, such as "Classifier/"
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveModelToBinaryFile(BinaryModelFileWriter &file,const string &prefix) const;
+    
+    /**
+     This loads a trained model from a binary model file, from the sections whose names start with the prefix.
+     This function should be overwritten by the derived class, the base class does not support the binary format.
+     
+     @param const BinaryModelFileReader &file: a reference to the binary model file the model will be loaded from
+     @param const string &prefix: the prefix of the section names, such as "Classifier/"
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromBinaryFile(const BinaryModelFileReader &file,const string &prefix);
+    
     /**
      Scales the input value x (which should be in the range [minSource maxSource]) to a value in the new target range of [minTarget maxTarget].
      
@@ -327,7 +348,7 @@ public:
      @param const bool constrain: sets if the scaled value should be constrained to the target range
      @return returns a new value that has been scaled based on the input parameters
      */
-    double inline scale(const double &x,const double &minSource,const double &maxSource,const double &minTarget,const double &maxTarget,const bool constrain=false){
+    double inline scale(const double &x,const double &minSource,const double &maxSource,const double &minTarget,const double &maxTarget,const bool constrain=false) const{
         if( constrain ){
             if( x <= minSource ) return minTarget;
             if( x >= maxSource ) return maxTarget;
@@ -444,6 +465,14 @@ public:
      */
 	bool getRandomiseTrainingOrder() const;
     
+    /**
+     Gets the seed of the random number generator used to train the model. If no seed has been set, this is the seed
+     that was generated from the system time.
+     
+     @return returns the seed of the random number generator
+     */
+    unsigned long long getRandomSeed() const;
+    
 	/**
      Gets if the model for the derived class has been succesfully trained.
      
@@ -556,6 +585,16 @@ public:
      */
     bool setRandomiseTrainingOrder(const bool randomiseTrainingOrder);
     
+    /**
+     Sets the seed of the random number generator used to train the model (for example to randomize the training order
+     or the starting weights). Training the model twice from the same seed gives the same model, even if the training
+     is run on several threads, as each parallel task uses its own stream split from this generator.
+     
+     @param const unsigned long long seed: the new seed, zero will set the seed using the current system time
+     @return returns true if the seed was updated
+     */
+    bool setRandomSeed(const unsigned long long seed);
+    
     /**
      Registers the observer with the training result observer manager. The observer will then be notified when any new training result is computed.
      
@@ -649,6 +688,20 @@ protected:
      */
     bool loadBaseSettingsFromFile(fstream &file);
     
+    /**
+     Saves the core base settings to a binary model file.
+     
+     @return returns true if the base settings were saved, false otherwise
+     */
+    bool saveBaseSettingsToBinaryFile(BinaryModelFileWriter &file,const string &prefix) const;
+    
+    /**
+     Loads the core base settings from a binary model file.
+     
+     @return returns true if the base settings were loaded, false otherwise
+     */
+    bool loadBaseSettingsFromBinaryFile(const BinaryModelFileReader &file,const string &prefix);
+    
     bool trained;
     bool useScaling;
     UINT baseType;
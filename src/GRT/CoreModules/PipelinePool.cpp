@@ -0,0 +1,265 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PipelinePool.h"
+#include "../Util/ParallelTaskRunner.h"
+
+namespace GRT{
+
+//Runs one input vector through each session, each task only touches its own session
+class PipelinePoolTask : public ParallelTask{
+public:
+    PipelinePoolTask(const vector< GestureRecognitionPipeline* > &sessions,const vector< VectorDouble > &inputVectors):sessions(sessions),inputVectors(inputVectors){
+        results.resize( sessions.size(), 0 );
+    }
+
+    virtual bool runTask(const UINT taskIndex,const UINT threadIndex){
+        results[ taskIndex ] = sessions[ taskIndex ]->predict( inputVectors[ taskIndex ] ) ? 1 : 0;
+
+        //Always succeed, so one failed session does not stop the others from being run
+        return true;
+    }
+
+    const vector< GestureRecognitionPipeline* > &sessions;
+    const vector< VectorDouble > &inputVectors;
+    vector< char > results;                     ///< Not a vector< bool >, so each task writes its own byte
+};
+
+PipelinePool::PipelinePool(){
+    setupDone = false;
+    nextSessionId = 1;
+    numThreads = 0;
+    sharedClassifier = NULL;
+    classType = "PipelinePool";
+    debugLog.setProceedingText("[DEBUG PipelinePool]");
+    errorLog.setProceedingText("[ERROR PipelinePool]");
+    warningLog.setProceedingText("[WARNING PipelinePool]");
+}
+
+PipelinePool::~PipelinePool(){
+    clear();
+}
+
+bool PipelinePool::setup(const GestureRecognitionPipeline &pipeline){
+
+    clear();
+
+    if( !pipeline.getTrained() ){
+        errorLog << "setup(const GestureRecognitionPipeline &pipeline) - The pipeline has not been trained!" << endl;
+        return false;
+    }
+
+    if( !pipeline.getIsClassifierSet() ){
+        errorLog << "setup(const GestureRecognitionPipeline &pipeline) - The pipeline is not in classification mode!" << endl;
+        return false;
+    }
+
+    //Copy the modules that hold the per session state
+    for(UINT i=0; i<pipeline.getNumPreProcessingModules(); i++){
+        if( !sessionTemplate.addPreProcessingModule( *pipeline.getPreProcessingModule(i) ) ){
+            errorLog << "setup(const GestureRecognitionPipeline &pipeline) - Failed to copy PreProcessingModule " << i << endl;
+            clear();
+            return false;
+        }
+    }
+    for(UINT i=0; i<pipeline.getNumFeatureExtractionModules(); i++){
+        if( !sessionTemplate.addFeatureExtractionModule( *pipeline.getFeatureExtractionModule(i) ) ){
+            errorLog << "setup(const GestureRecognitionPipeline &pipeline) - Failed to copy FeatureExtractionModule " << i << endl;
+            clear();
+            return false;
+        }
+    }
+    for(UINT i=0; i<pipeline.getNumPostProcessingModules(); i++){
+        if( !sessionTemplate.addPostProcessingModule( *pipeline.getPostProcessingModule(i) ) ){
+            errorLog << "setup(const GestureRecognitionPipeline &pipeline) - Failed to copy PostProcessingModule " << i << endl;
+            clear();
+            return false;
+        }
+    }
+    for(UINT k=0; k<GestureRecognitionPipeline::NUM_CONTEXT_LEVELS; k++){
+        for(UINT i=0; i<pipeline.contextModules[k].size(); i++){
+            if( !sessionTemplate.addContextModule( *pipeline.contextModules[k][i], k ) ){
+                errorLog << "setup(const GestureRecognitionPipeline &pipeline) - Failed to copy the ContextModule " << i << " at level " << k << endl;
+                clear();
+                return false;
+            }
+        }
+    }
+
+    //Share one copy of the trained classifier if it supports it, otherwise each session gets its own copy
+    const Classifier *classifier = pipeline.getClassifier();
+    bool classifierSet = false;
+    if( classifier->getSupportsSharedPrediction() ){
+        sharedClassifier = classifier->deepCopy();
+        classifierSet = sharedClassifier != NULL && sessionTemplate.setClassifier( SharedClassifier( sharedClassifier ) );
+    }else{
+        warningLog << "setup(const GestureRecognitionPipeline &pipeline) - The " << classifier->getClassifierType() << " classifier does not support shared prediction, each session will hold its own copy of the classifier" << endl;
+        classifierSet = sessionTemplate.setClassifier( *classifier );
+    }
+    if( !classifierSet ){
+        errorLog << "setup(const GestureRecognitionPipeline &pipeline) - Failed to set the classifier of the sessions!" << endl;
+        clear();
+        return false;
+    }
+
+    //The modules are already trained, so the sessions are trained too
+    sessionTemplate.inputVectorDimensions = pipeline.inputVectorDimensions;
+    sessionTemplate.outputVectorDimensions = pipeline.outputVectorDimensions;
+    sessionTemplate.trained = true;
+    sessionTemplate.reset();
+
+    setupDone = true;
+
+    return true;
+}
+
+bool PipelinePool::clear(){
+
+    for(SessionMap::iterator it = sessions.begin(); it != sessions.end(); ++it){
+        delete it->second;
+    }
+    sessions.clear();
+
+    //The sessions point to the shared classifier, so it is deleted after them
+    sessionTemplate.clearAll();
+    if( sharedClassifier != NULL ){
+        delete sharedClassifier;
+        sharedClassifier = NULL;
+    }
+    setupDone = false;
+
+    return true;
+}
+
+bool PipelinePool::createSession(UINT &sessionId){
+
+    if( !setupDone ){
+        errorLog << "createSession(UINT &sessionId) - The pool has not been set up!" << endl;
+        return false;
+    }
+
+    sessionId = nextSessionId++;
+    sessions[ sessionId ] = new GestureRecognitionPipeline( sessionTemplate );
+
+    return true;
+}
+
+bool PipelinePool::deleteSession(const UINT sessionId){
+
+    SessionMap::iterator it = sessions.find( sessionId );
+    if( it == sessions.end() ){
+        errorLog << "deleteSession(const UINT sessionId) - There is no session with the id " << sessionId << endl;
+        return false;
+    }
+
+    delete it->second;
+    sessions.erase( it );
+
+    return true;
+}
+
+bool PipelinePool::resetSession(const UINT sessionId){
+
+    GestureRecognitionPipeline *session = getSession( sessionId );
+    if( session == NULL ){
+        errorLog << "resetSession(const UINT sessionId) - There is no session with the id " << sessionId << endl;
+        return false;
+    }
+
+    return session->reset();
+}
+
+bool PipelinePool::predict(const UINT sessionId,const VectorDouble &inputVector){
+
+    GestureRecognitionPipeline *session = getSession( sessionId );
+    if( session == NULL ){
+        errorLog << "predict(const UINT sessionId,const VectorDouble &inputVector) - There is no session with the id " << sessionId << endl;
+        return false;
+    }
+
+    return session->predict( inputVector );
+}
+
+bool PipelinePool::predict(const vector< UINT > &sessionIds,const vector< VectorDouble > &inputVectors){
+
+    if( sessionIds.size() != inputVectors.size() ){
+        errorLog << "predict(const vector< UINT > &sessionIds,const vector< VectorDouble > &inputVectors) - The number of session ids (" << sessionIds.size() << ") does not match the number of input vectors (" << inputVectors.size() << ")" << endl;
+        return false;
+    }
+
+    //Find the sessions, a session listed twice would be run by two threads at once
+    vector< GestureRecognitionPipeline* > sessionList( sessionIds.size() );
+    vector< UINT > sortedIds = sessionIds;
+    std::sort( sortedIds.begin(), sortedIds.end() );
+    if( std::adjacent_find( sortedIds.begin(), sortedIds.end() ) != sortedIds.end() ){
+        errorLog << "predict(const vector< UINT > &sessionIds,const vector< VectorDouble > &inputVectors) - A session can only be listed once!" << endl;
+        return false;
+    }
+    for(UINT i=0; i<sessionIds.size(); i++){
+        sessionList[i] = getSession( sessionIds[i] );
+        if( sessionList[i] == NULL ){
+            errorLog << "predict(const vector< UINT > &sessionIds,const vector< VectorDouble > &inputVectors) - There is no session with the id " << sessionIds[i] << endl;
+            return false;
+        }
+    }
+
+    PipelinePoolTask task( sessionList, inputVectors );
+    ParallelTaskRunner::run( task, (UINT)sessionList.size(), numThreads );
+
+    bool result = true;
+    for(UINT i=0; i<sessionIds.size(); i++){
+        if( !task.results[i] ){
+            errorLog << "predict(const vector< UINT > &sessionIds,const vector< VectorDouble > &inputVectors) - The prediction failed for the session with the id " << sessionIds[i] << endl;
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+GestureRecognitionPipeline* PipelinePool::getSession(const UINT sessionId){
+    SessionMap::iterator it = sessions.find( sessionId );
+    return it != sessions.end() ? it->second : NULL;
+}
+
+const GestureRecognitionPipeline* PipelinePool::getSession(const UINT sessionId) const{
+    SessionMap::const_iterator it = sessions.find( sessionId );
+    return it != sessions.end() ? it->second : NULL;
+}
+
+UINT PipelinePool::getPredictedClassLabel(const UINT sessionId) const{
+    const GestureRecognitionPipeline *session = getSession( sessionId );
+    return session != NULL ? session->getPredictedClassLabel() : 0;
+}
+
+vector< UINT > PipelinePool::getSessionIds() const{
+    vector< UINT > sessionIds;
+    for(SessionMap::const_iterator it = sessions.begin(); it != sessions.end(); ++it){
+        sessionIds.push_back( it->first );
+    }
+    return sessionIds;
+}
+
+bool PipelinePool::setNumThreads(const UINT numThreads){
+    this->numThreads = numThreads;
+    return true;
+}
+
+}//End of namespace GRT
@@ -0,0 +1,174 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The PipelinePool class runs many independent sessions (for example one per tracked face) through one trained
+ GestureRecognitionPipeline, sharing the trained classifier between the sessions.
+
+ Each session has its own state: its own copies of the pre processing, feature extraction, post processing and context
+ modules (the filter histories, buffers and ClassLabelFilter windows), and its own prediction results. The trained
+ classifier is copied once into the pool and is shared by all the sessions through a SharedClassifier, so the memory
+ used by each new session grows with the size of its state and not with the size of the model (such as the training
+ set of a KNN classifier). Classifiers that do not support shared prediction still work, but each session then holds
+ its own copy of the classifier.
+
+ The predictions of several sessions can be run in parallel with predict(sessionIds,inputVectors), which schedules one
+ task per session on the ParallelTaskRunner threads. The pool itself is not thread safe: create, delete and predict
+ from one thread at a time.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_PIPELINE_POOL_HEADER
+#define GRT_PIPELINE_POOL_HEADER
+
+#include "GestureRecognitionPipeline.h"
+#include "../ClassificationModules/SharedClassifier/SharedClassifier.h"
+
+namespace GRT{
+
+class PipelinePool : public GRTBase{
+public:
+    /**
+     Default Constructor.
+     */
+    PipelinePool();
+
+    /**
+     Default Destructor, deletes all the sessions and the shared classifier.
+     */
+    ~PipelinePool();
+
+    /**
+     Sets up the pool from a trained classification pipeline. The trained classifier is copied once and shared by all
+     the sessions, the other modules are copied into each new session. Any existing sessions are deleted.
+
+     @param const GestureRecognitionPipeline &pipeline: a trained pipeline in classification mode
+     @return returns true if the pool was set up, false otherwise
+     */
+    bool setup(const GestureRecognitionPipeline &pipeline);
+
+    /**
+     Deletes all the sessions and the shared classifier.
+
+     @return returns true if the pool was cleared
+     */
+    bool clear();
+
+    /**
+     Creates a new session with reset pipeline state.
+
+     @param UINT &sessionId: returns the id of the new session, ids are never reused
+     @return returns true if the session was created, false otherwise
+     */
+    bool createSession(UINT &sessionId);
+
+    /**
+     Deletes a session.
+
+     @param const UINT sessionId: the id of the session
+     @return returns true if the session was deleted, false if there is no session with that id
+     */
+    bool deleteSession(const UINT sessionId);
+
+    /**
+     Resets the state of a session, as if it had just been created.
+
+     @param const UINT sessionId: the id of the session
+     @return returns true if the session was reset, false otherwise
+     */
+    bool resetSession(const UINT sessionId);
+
+    /**
+     Runs one input vector through one session.
+
+     @param const UINT sessionId: the id of the session
+     @param const VectorDouble &inputVector: the input vector
+     @return returns true if the prediction was made, false otherwise
+     */
+    bool predict(const UINT sessionId,const VectorDouble &inputVector);
+
+    /**
+     Runs one input vector through each of the sessions, the sessions are run in parallel. Each session can only be
+     listed once. All the sessions are run even if some of them fail.
+
+     @param const vector< UINT > &sessionIds: the ids of the sessions
+     @param const vector< VectorDouble > &inputVectors: the input vector for each session, in the same order as the ids
+     @return returns true if all the predictions were made, false otherwise
+     */
+    bool predict(const vector< UINT > &sessionIds,const vector< VectorDouble > &inputVectors);
+
+    /**
+     Gets the pipeline of a session, which holds the results of its last prediction (getPredictedClassLabel(),
+     getClassLikelihoods(), ...). The pipeline must not be trained, saved or given a new classifier.
+
+     @param const UINT sessionId: the id of the session
+     @return returns a pointer to the pipeline of the session, or NULL if there is no session with that id
+     */
+    GestureRecognitionPipeline* getSession(const UINT sessionId);
+    const GestureRecognitionPipeline* getSession(const UINT sessionId) const;
+
+    /**
+     Gets the predicted class label of the last prediction of a session.
+
+     @param const UINT sessionId: the id of the session
+     @return returns the predicted class label, or 0 if there is no session with that id
+     */
+    UINT getPredictedClassLabel(const UINT sessionId) const;
+
+    vector< UINT > getSessionIds() const;
+    UINT getNumSessions() const{ return (UINT)sessions.size(); }
+    bool getIsSetup() const{ return setupDone; }
+
+    /**
+     @return returns true if the sessions share one classifier, false if each session holds its own copy of the classifier
+     */
+    bool getIsClassifierShared() const{ return sharedClassifier != NULL; }
+
+    /**
+     @return returns a pointer to the classifier shared by the sessions, or NULL if the classifier is not shared
+     */
+    const Classifier* getSharedClassifier() const{ return sharedClassifier; }
+
+    /**
+     Sets the maximum number of threads used by predict(sessionIds,inputVectors).
+
+     @param const UINT numThreads: the maximum number of threads, zero uses the ParallelTaskRunner default
+     @return returns true if the number of threads was set
+     */
+    bool setNumThreads(const UINT numThreads);
+    UINT getNumThreads() const{ return numThreads; }
+
+protected:
+    typedef std::map< UINT, GestureRecognitionPipeline* > SessionMap;
+
+    bool setupDone;
+    UINT nextSessionId;
+    UINT numThreads;
+    Classifier *sharedClassifier;                   ///< The trained classifier shared by the sessions, or NULL if each session has its own copy
+    GestureRecognitionPipeline sessionTemplate;     ///< The state of a new session, new sessions are copied from this
+    SessionMap sessions;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_PIPELINE_POOL_HEADER
@@ -72,6 +72,30 @@ bool PreProcessing::copyBaseVariables(const PreProcessing *preProcessingModule){
     return true;
 }
     
+bool PreProcessing::processBlock(const MatrixDouble &inputData,MatrixDouble &outputData){
+    
+    if( !initialized ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - The module has not been initialized!" << endl;
+        return false;
+    }
+    
+    const UINT M = inputData.getNumRows();
+    if( M == 0 ) return true;
+    
+    if( !outputData.resize( M, numOutputDimensions ) ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - Failed to resize the output data!" << endl;
+        return false;
+    }
+    
+    for(UINT i=0; i<M; i++){
+        if( !process( inputData.getRowVector(i) ) ) return false;
+        if( processedData.size() != numOutputDimensions ) return false;
+        std::copy( processedData.begin(), processedData.end(), outputData[i] );
+    }
+    
+    return true;
+}
+    
 bool PreProcessing::reset(){
     
     //Reset the processed data vector
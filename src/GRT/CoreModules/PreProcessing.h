@@ -35,6 +35,8 @@
 
 namespace GRT{
 
+class FilterCascade;
+
 class PreProcessing : public MLBase
 {
 public:
@@ -72,6 +74,27 @@ public:
      */
     virtual bool process(const VectorDouble &inputVector){ return false; }
     
+    /**
+     Processes a block of input samples, with one sample per row. The base class calls process for each row in turn,
+     modules that can process a block faster (such as the FIR based filters) should override this function. After the
+     block has been processed the processed data is the output for the last row of the block.
+     
+     @param const MatrixDouble &inputData: the samples that should be processed, with one sample per row
+     @param MatrixDouble &outputData: returns the processed samples, with one sample per row
+     @return returns true if the block was processed, false otherwise
+     */
+    virtual bool processBlock(const MatrixDouble &inputData,MatrixDouble &outputData);
+    
+    /**
+     Appends the module to a FilterCascade. Only linear time invariant filters (such as the LowPassFilter, HighPassFilter
+     and Derivative) can be written as a cascade of second order sections, so the base class returns false. This is used
+     by GestureRecognitionPipeline::fusePreProcessingModules to replace a chain of filters with one FilterCascade.
+     
+     @param FilterCascade &cascade: the cascade the filter should be appended to
+     @return returns true if the filter was appended to the cascade, false otherwise (the base class always returns false)
+     */
+    virtual bool appendToFilterCascade(FilterCascade &cascade) const{ return false; }
+    
     /**
      This is the main reset interface for all the GRT preprocessing modules. This should be overwritten by the derived class.
      
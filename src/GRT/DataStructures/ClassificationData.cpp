@@ -640,6 +640,11 @@ bool ClassificationData::sortClassLabels(){
 }
 
 ClassificationData ClassificationData::partition(const UINT trainingSizePercentage,const bool useStratifiedSampling){
+    Random random;
+    return partition(trainingSizePercentage,useStratifiedSampling,random);
+}
+
+ClassificationData ClassificationData::partition(const UINT trainingSizePercentage,const bool useStratifiedSampling,Random &random){
 
     //Partitions the dataset into a training dataset (which is kept by this instance of the ClassificationData) and
 	//a testing/validation dataset (which is return as a new instance of the ClassificationData).  The trainingSizePercentage
@@ -657,7 +662,6 @@ ClassificationData ClassificationData::partition(const UINT trainingSizePercenta
     vector< UINT > indexs( totalNumSamples );
 
 	//Create the random partion indexs
-	Random random;
     UINT randomIndex = 0;
 
     if( useStratifiedSampling ){
@@ -711,8 +715,6 @@ ClassificationData ClassificationData::partition(const UINT trainingSizePercenta
 
         const UINT numTrainingExamples = (UINT) floor( double(totalNumSamples) / 100.0 * double(trainingSizePercentage) );
         //Create the random partion indexs
-        Random random;
-        UINT randomIndex = 0;
         for(UINT i=0; i<totalNumSamples; i++) indexs[i] = i;
         for(UINT x=0; x<totalNumSamples; x++){
             //Pick a random index
@@ -775,6 +777,11 @@ bool ClassificationData::merge(const ClassificationData &labelledData){
 }
 
 bool ClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling){
+    Random random;
+    return spiltDataIntoKFolds(K,useStratifiedSampling,random);
+}
+
+bool ClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling,Random &random){
 
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -812,7 +819,6 @@ bool ClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifi
     crossValidationIndexs.resize(K);
 
 	//Create the random partion indexs
-	Random random;
     UINT randomIndex = 0;
 
     if( useStratifiedSampling ){
@@ -958,8 +964,12 @@ ClassificationData ClassificationData::getClassData(const UINT classLabel) const
 }
     
 ClassificationData ClassificationData::getBootstrappedDataset(UINT numSamples) const{
+    Random random;
+    return getBootstrappedDataset(numSamples,random);
+}
+    
+ClassificationData ClassificationData::getBootstrappedDataset(UINT numSamples,Random &random) const{
     
-    Random rand;
     ClassificationData newDataset;
     newDataset.setNumDimensions( getNumDimensions() );
     newDataset.setAllowNullGestureClass( allowNullGestureClass );
@@ -977,7 +987,7 @@ ClassificationData ClassificationData::getBootstrappedDataset(UINT numSamples) c
     //Randomly select the training samples to add to the new data set
     UINT randomIndex;
     for(UINT i=0; i<numSamples; i++){
-        randomIndex = rand.getRandomNumberInt(0, totalNumSamples);
+        randomIndex = random.getRandomNumberInt(0, totalNumSamples);
         newDataset.addSample(data[randomIndex].getClassLabel(), data[randomIndex].getSample());
     }
 
@@ -327,6 +327,17 @@ public:
      */
 	ClassificationData partition(const UINT partitionPercentage,const bool useStratifiedSampling = false);
     
+    /**
+     Partitions the dataset into a training dataset and a testing/validation dataset, using the random number generator
+     of the caller. This is used by the learning algorithms, so the validation set only depends on the seed of the algorithm.
+     
+     @param const UINT partitionPercentage: sets the percentage of data which remains in this instance, the remaining percentage of data is then returned as the testing/validation dataset
+     @param const bool useStratifiedSampling: sets if the dataset should be broken into homogeneous groups first before randomly being spilt
+     @param Random &random: the random number generator used to pick the samples
+     @return a new ClassificationData instance, containing the remaining data not kept but this instance
+     */
+	ClassificationData partition(const UINT partitionPercentage,const bool useStratifiedSampling,Random &random);
+    
     /**
      This function prepares the dataset for k-fold cross validation and should be called prior to calling the getTrainingFold(UINT foldIndex) or getTestingFold(UINT foldIndex) functions.  It will spilt the dataset into K-folds, as long as K < M, where M is the number of samples in the dataset.
      
@@ -336,6 +347,17 @@ public:
     */
     bool spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling = false);
     
+    /**
+     Splits the dataset into K folds for cross validation, using the random number generator of the caller. This is used
+     by the pipeline, so the folds only depend on the seed of the learning algorithm.
+     
+     @param const UINT K: the number of folds the dataset will be split into, K should be less than the number of samples in the dataset
+     @param const bool useStratifiedSampling: sets if the dataset should be broken into homogeneous groups first before randomly being spilt
+     @param Random &random: the random number generator used to pick the folds
+     @return returns true if the dataset was split correctly, false otherwise
+     */
+    bool spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling,Random &random);
+    
     /**
      Returns the training dataset for the k-th fold for cross validation.  The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
      The foldIndex should be in the range [0 K-1], where K is the number of folds the data was spilt into.
@@ -373,6 +395,16 @@ public:
      */
     ClassificationData getBootstrappedDataset(UINT numSamples=0) const;
     
+    /**
+     Gets a bootstrapped dataset from the current dataset, using the random number generator of the caller. This is used
+     by the ensemble algorithms, so the bootstrapped datasets only depend on the seed of the algorithm.
+     
+     @param UINT numSamples: the size of the bootstrapped dataset, zero will match the size of the current dataset
+     @param Random &random: the random number generator used to pick the samples
+     @return returns a bootstrapped ClassificationData
+     */
+    ClassificationData getBootstrappedDataset(UINT numSamples,Random &random) const;
+    
 	/**
      Reformats the ClassificationData as LabelledRegressionData to enable regression algorithms like the MLP to be used as a classifier.
 	 This sets the number of targets in the regression data equal to the number of classes in the classification data.  The output target ouput of each regression sample will therefore
@@ -260,6 +260,11 @@ bool RegressionData::printStats() const{
 }
     
 RegressionData RegressionData::partition(const UINT trainingSizePercentage){
+    Random random;
+    return partition(trainingSizePercentage,random);
+}
+
+RegressionData RegressionData::partition(const UINT trainingSizePercentage,Random &random){
 
 	//Partitions the dataset into a training dataset (which is kept by this instance of the RegressionData) and
 	//a testing/validation dataset (which is return as a new instance of the RegressionData).  The trainingSizePercentage
@@ -273,7 +278,6 @@ RegressionData RegressionData::partition(const UINT trainingSizePercentage){
 	vector< UINT > indexs( totalNumSamples );
 
 	//Create the random partion indexs
-	Random random;
     UINT randomIndex = 0;
 	for(UINT i=0; i<totalNumSamples; i++) indexs[i] = i;
 	for(UINT x=0; x<totalNumSamples; x++){
@@ -325,6 +329,11 @@ bool RegressionData::merge(const RegressionData &regressionData){
 }
 
 bool RegressionData::spiltDataIntoKFolds(const UINT K){
+    Random random;
+    return spiltDataIntoKFolds(K,random);
+}
+
+bool RegressionData::spiltDataIntoKFolds(const UINT K,Random &random){
 
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -352,7 +361,6 @@ bool RegressionData::spiltDataIntoKFolds(const UINT K){
     crossValidationIndexs.resize(K);
 
     //Create the random partion indexs
-    Random random;
     UINT randomIndex = 0;
 
     //Randomize the order of the data
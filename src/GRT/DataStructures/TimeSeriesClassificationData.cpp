@@ -685,6 +685,11 @@ bool TimeSeriesClassificationData::printStats() const {
 }
     
 TimeSeriesClassificationData TimeSeriesClassificationData::partition(const UINT trainingSizePercentage,const bool useStratifiedSampling){
+    Random random;
+    return partition(trainingSizePercentage,useStratifiedSampling,random);
+}
+
+TimeSeriesClassificationData TimeSeriesClassificationData::partition(const UINT trainingSizePercentage,const bool useStratifiedSampling,Random &random){
 
     //Partitions the dataset into a training dataset (which is kept by this instance of the TimeSeriesClassificationData) and
     //a testing/validation dataset (which is return as a new instance of the TimeSeriesClassificationData).  The trainingSizePercentage
@@ -702,7 +707,6 @@ TimeSeriesClassificationData TimeSeriesClassificationData::partition(const UINT
     vector< UINT > indexs( totalNumSamples );
 
     //Create the random partion indexs
-    Random random;
     UINT randomIndex = 0;
 
     if( useStratifiedSampling ){
@@ -746,7 +750,6 @@ TimeSeriesClassificationData TimeSeriesClassificationData::partition(const UINT
 
         const UINT numTrainingExamples = (UINT) floor( double(totalNumSamples) / 100.0 * double(trainingSizePercentage) );
         //Create the random partion indexs
-        Random random;
         for(UINT i=0; i<totalNumSamples; i++) indexs[i] = i;
         for(UINT x=0; x<totalNumSamples; x++){
             //Pick a random index
@@ -798,6 +801,11 @@ bool TimeSeriesClassificationData::merge(const TimeSeriesClassificationData &lab
 }
 
 bool TimeSeriesClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling){
+    Random random;
+    return spiltDataIntoKFolds(K,useStratifiedSampling,random);
+}
+
+bool TimeSeriesClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling,Random &random){
 
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -835,7 +843,6 @@ bool TimeSeriesClassificationData::spiltDataIntoKFolds(const UINT K,const bool u
     crossValidationIndexs.resize( K );
 
     //Create the random partion indexs
-    Random random;
     UINT randomIndex = 0;
 
     if( useStratifiedSampling ){
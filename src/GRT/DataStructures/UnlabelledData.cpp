@@ -412,6 +412,11 @@ bool UnlabelledData::loadDatasetFromCSVFile(const string &filename){
 }
 
 UnlabelledData UnlabelledData::partition(const UINT trainingSizePercentage){
+    Random random;
+    return partition(trainingSizePercentage,random);
+}
+
+UnlabelledData UnlabelledData::partition(const UINT trainingSizePercentage,Random &random){
 
     //Partitions the dataset into a training dataset (which is kept by this instance of the UnlabelledData) and
 	//a testing/validation dataset (which is return as a new instance of the UnlabelledData).  The trainingSizePercentage
@@ -429,7 +434,6 @@ UnlabelledData UnlabelledData::partition(const UINT trainingSizePercentage){
 	vector< UINT > indexs( totalNumSamples );
 
 	//Create the random partion indexs
-	Random random;
     UINT randomIndex = 0;
 	for(UINT i=0; i<totalNumSamples; i++) indexs[i] = i;
 	for(UINT x=0; x<totalNumSamples; x++){
@@ -479,6 +483,11 @@ bool UnlabelledData::merge(const UnlabelledData &unlabelledData){
 }
 
 bool UnlabelledData::spiltDataIntoKFolds(const UINT K){
+    Random random;
+    return spiltDataIntoKFolds(K,random);
+}
+
+bool UnlabelledData::spiltDataIntoKFolds(const UINT K,Random &random){
 
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -506,7 +515,6 @@ bool UnlabelledData::spiltDataIntoKFolds(const UINT K){
     crossValidationIndexs.resize(K);
 
 	//Create the random partion indexs
-	Random random;
     UINT randomIndex = 0;
 
     //Randomize the order of the data
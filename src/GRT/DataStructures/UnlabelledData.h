@@ -250,6 +250,16 @@ public:
     */
 	UnlabelledData partition(const UINT partitionPercentage);
     
+    /**
+     Partitions the dataset into a training dataset and a testing/validation dataset, using the random number generator
+     of the caller. This is used by the learning algorithms, so the validation set only depends on the seed of the algorithm.
+     
+     @param const UINT partitionPercentage: sets the percentage of data which remains in this instance, the remaining percentage of data is then returned as the testing/validation dataset
+     @param Random &random: the random number generator used to pick the samples
+     @return a new UnlabelledData instance, containing the remaining data not kept but this instance
+     */
+    UnlabelledData partition(const UINT partitionPercentage,Random &random);
+    
     /**
      Adds the data in the unlabelledData set to the current instance of the UnlabelledData.
      The number of dimensions in both datasets must match.
@@ -267,6 +277,16 @@ public:
     */
     bool spiltDataIntoKFolds(const UINT K);
     
+    /**
+     Splits the dataset into K folds for cross validation, using the random number generator of the caller. This is used
+     by the pipeline, so the folds only depend on the seed of the learning algorithm.
+     
+     @param const UINT K: the number of folds the dataset will be split into, K should be less than the number of samples in the dataset
+     @param Random &random: the random number generator used to pick the folds
+     @return returns true if the dataset was split correctly, false otherwise
+     */
+    bool spiltDataIntoKFolds(const UINT K,Random &random);
+    
     /**
      Returns the training dataset for the k-th fold for cross validation.  The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
      The foldIndex should be in the range [0 K-1], where K is the number of folds the data was spilt into.
@@ -34,6 +34,8 @@ FFT::FFT(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindowFuncti
     featureDataReady = false;
     numInputDimensions = 0;
     numOutputDimensions = 0;
+    useSlidingDFT = false;
+    slidingDFTCounter = 0;
     
     infoLog.setProceedingText("[FFT]");
     warningLog.setProceedingText("[WARNING FFT]");
@@ -66,6 +68,8 @@ FFT& FFT::operator=(const FFT &rhs){
         this->hopCounter = rhs.hopCounter;
         this->computeMagnitude = rhs.computeMagnitude;
         this->computePhase = rhs.computePhase;
+        this->useSlidingDFT = rhs.useSlidingDFT;
+        this->slidingDFTCounter = rhs.slidingDFTCounter;
         this->dataBuffer = rhs.dataBuffer;
         this->tempBuffer = rhs.tempBuffer;
         this->fft = rhs.fft;
@@ -244,17 +248,26 @@ bool FFT::init(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindow
     featureVector.resize( numOutputDimensions, 0);
     
     dataBuffer.clear();
-    dataBuffer.resize(dataBufferSize,VectorDouble(numDimensions,0));
+    dataBuffer.resize(dataBufferSize,numDimensions);
     tempBuffer.clear();
     tempBuffer.resize( dataBufferSize );
     fft.clear();
     fft.resize(numDimensions);
     
+    //If the FFT is computed for every sample then a sliding DFT can update the transform in O(fftWindowSize) per sample, the
+    //sliding DFT can not apply the window function so it is only used with the rectangular window
+    useSlidingDFT = hopSize == 1 && fftWindowFunction == RECTANGULAR_WINDOW;
+    slidingDFTCounter = 0;
+    
     for(unsigned int i=0; i<numDimensions; i++){
         if( !fft[i].init(fftWindowSize,fftWindowFunction,computeMagnitude,computePhase) ){
             errorLog << "init(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindowFunction,bool computeMagnitude,bool computePhase) - Failed to initialize fft!" << endl;
             return false;
         }
+        if( useSlidingDFT && !fft[i].initSlidingDFT() ){
+            errorLog << "init(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindowFunction,bool computeMagnitude,bool computePhase) - Failed to initialize sliding DFT!" << endl;
+            return false;
+        }
     }
     
     initialized = true;
@@ -304,6 +317,14 @@ bool FFT::update(const VectorDouble &x){
         return false;
     }
 
+    //If the sliding DFT is being used then update it with the value that is about to be overwritten in the data buffer
+    if( useSlidingDFT ){
+        const UINT writeIndex = dataBuffer.getWritePointerPosition();
+        for(UINT j=0; j<numInputDimensions; j++){
+            fft[j].updateSlidingDFT( writeIndex, dataBuffer(writeIndex)[j], x[j] );
+        }
+    }
+    
     //Add the current input to the data buffers
     dataBuffer.push_back(x);
     
@@ -311,19 +332,38 @@ bool FFT::update(const VectorDouble &x){
     
     if( ++hopCounter == hopSize ){
         hopCounter = 0;
+        
+        //The full FFT is used when the sliding DFT is disabled, or periodically to remove any rounding error from the sliding DFT
+        bool computeFullFFT = true;
+        if( useSlidingDFT ){
+            if( ++slidingDFTCounter < dataBufferSize ) computeFullFFT = false;
+            else slidingDFTCounter = 0;
+        }
+        
         //Compute the FFT for each dimension
+        const UINT readIndex = dataBuffer.getReadPointerPosition();
         for(UINT j=0; j<numInputDimensions; j++){
             
-            //Copy the input data for this dimension into the temp buffer
-            for(UINT i=0; i<dataBufferSize; i++){
-                tempBuffer[i] = dataBuffer[i][j];
+            if( !computeFullFFT ){
+                if( !fft[j].computeSlidingDFT( readIndex ) ){
+                    errorLog << "update(const VectorDouble &x) - Failed to compute sliding DFT!" << endl;
+                    return false;
+                }
+                continue;
             }
             
+            //Copy the input data for this dimension into the temp buffer, the buffer window is contiguous so this is a strided read
+            dataBuffer.getChannel( j, tempBuffer );
+            
             //Compute the FFT
             if( !fft[j].computeFFT( tempBuffer ) ){
                 errorLog << "update(const VectorDouble &x) - Failed to compute FFT!" << endl;
                 return false;
             }
+            
+            if( useSlidingDFT ){
+                fft[j].anchorSlidingDFT( readIndex );
+            }
         }
         
         //Flag that the fft was computed during this update
@@ -312,8 +312,10 @@ protected:
     UINT hopCounter;                                            ///< Keeps track of how many input samples the FFT has seen
     bool computeMagnitude;                                      ///< Tracks if the magnitude (and power) of the FFT need to be computed
     bool computePhase;                                          ///< Tracks if the phase of the FFT needs to be computed
+    bool useSlidingDFT;                                         ///< Tracks if the FFT is updated with a sliding DFT, this is used when the hopSize is 1 and the window is rectangular
+    UINT slidingDFTCounter;                                     ///< Counts the sliding DFT updates since the last full FFT
     GRT::VectorDouble tempBuffer;                               ///< A temporary buffer used to store the input data for the FFT
-    CircularBuffer< VectorDouble > dataBuffer;                  ///< A circular buffer used to store the previous M inputs
+    MultiChannelCircularBuffer dataBuffer;                      ///< A circular buffer used to store the previous M inputs
     vector< FastFourierTransform > fft;                         ///< A buffer used to store the FFT results
     std::map< unsigned int, unsigned int > windowSizeMap;       ///< A map to relate the FFTWindowSize enumerations to actual values
     
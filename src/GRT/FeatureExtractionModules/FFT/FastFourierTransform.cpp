@@ -35,12 +35,11 @@ FastFourierTransform::FastFourierTransform(){
     windowSize = 0;
     windowFunction = RECTANGULAR_WINDOW;
     averagePower = 0;
+    slidingDFTInitialized = false;
     
     infoLog.setProceedingText("[FastFourierTransform]");
     warningLog.setProceedingText("[WARNING FastFourierTransform]");
     errorLog.setProceedingText("[ERROR FastFourierTransform]");
-    
-    initFFT();
 }
     
 FastFourierTransform::FastFourierTransform(const FastFourierTransform &rhs){
@@ -51,7 +50,7 @@ FastFourierTransform::FastFourierTransform(const FastFourierTransform &rhs){
     this->windowSize = rhs.windowSize;
     this->windowFunction = rhs.windowFunction;
     this->averagePower = 0;
-    this->initFFT();
+    this->slidingDFTInitialized = false;
     this->infoLog = rhs.infoLog;
     this->warningLog = rhs.warningLog;
     this->errorLog = rhs.errorLog;
@@ -67,6 +66,13 @@ FastFourierTransform::FastFourierTransform(const FastFourierTransform &rhs){
             this->phase[i] = rhs.phase[i];
             this->power[i] = rhs.power[i];
         }
+        
+        //Copy the sliding DFT state
+        if( rhs.slidingDFTInitialized ){
+            this->initSlidingDFT();
+            this->slidingReal = rhs.slidingReal;
+            this->slidingImag = rhs.slidingImag;
+        }
     }
 }
 
@@ -83,7 +89,7 @@ FastFourierTransform& FastFourierTransform::operator=(const FastFourierTransform
         this->windowSize = rhs.windowSize;
         this->windowFunction = rhs.windowFunction;
         this->averagePower = 0;
-        this->initFFT();
+        this->slidingDFTInitialized = false;
         
         if( rhs.initialized ){
             this->init(rhs.windowSize,rhs.windowFunction,rhs.computeMagnitude,rhs.computePhase);
@@ -96,6 +102,13 @@ FastFourierTransform& FastFourierTransform::operator=(const FastFourierTransform
                 this->phase[i] = rhs.phase[i];
                 this->power[i] = rhs.power[i];
             }
+            
+            //Copy the sliding DFT state
+            if( rhs.slidingDFTInitialized ){
+                this->initSlidingDFT();
+                this->slidingReal = rhs.slidingReal;
+                this->slidingImag = rhs.slidingImag;
+            }
         }
     }
     return *this;
@@ -104,6 +117,7 @@ FastFourierTransform& FastFourierTransform::operator=(const FastFourierTransform
 bool FastFourierTransform::init(const unsigned int windowSize,const unsigned int windowFunction,const bool computeMagnitude,const bool computePhase){
     
     initialized = false;
+    slidingDFTInitialized = false;
     averagePower = 0;
     
     //Validate the window size
@@ -116,8 +130,6 @@ bool FastFourierTransform::init(const unsigned int windowSize,const unsigned int
         return false;
     }
     
-    initFFT();
-    
     this->windowSize = windowSize;
     this->windowFunction = windowFunction;
     this->computeMagnitude = computeMagnitude;
@@ -146,6 +158,9 @@ bool FastFourierTransform::init(const unsigned int windowSize,const unsigned int
         power[i] = 0;
     }
     
+    //Build the FFT plan
+    initPlan();
+    
     //Flag that the FFT has been initialized
     initialized = true;
     
@@ -164,8 +179,119 @@ bool FastFourierTransform::computeFFT( VectorDouble &data ){
     }
     
     //Perform the FFT
-    realFFT(data, &fftReal[0], &fftImag[0]);
-	
+    if( !realFFT(data, &fftReal[0], &fftImag[0]) ){
+        return false;
+    }
+    
+    return computeSpectrum();
+}
+    
+bool FastFourierTransform::initSlidingDFT(){
+    
+    if( !initialized ){
+        return false;
+    }
+    
+    const UINT half = windowSize/2;
+    slidingReal.assign( half+1, 0 );
+    slidingImag.assign( half+1, 0 );
+    slidingCos.resize( windowSize );
+    slidingSin.resize( windowSize );
+    for(UINT m=0; m<windowSize; m++){
+        slidingCos[m] = cos( TWO_PI * m / windowSize );
+        slidingSin[m] = sin( TWO_PI * m / windowSize );
+    }
+    
+    slidingDFTInitialized = true;
+    
+    return true;
+}
+    
+bool FastFourierTransform::updateSlidingDFT(const UINT writeIndex,const double oldValue,const double newValue){
+    
+    if( !slidingDFTInitialized || writeIndex >= windowSize ){
+        return false;
+    }
+    
+    const double delta = newValue - oldValue;
+    if( delta == 0 ) return true;
+    
+    //Add the change in the value at the writeIndex to each bin, this is delta * exp(i*2*PI*k*writeIndex/windowSize)
+    const UINT half = windowSize/2;
+    UINT m = 0;
+    for(UINT k=0; k<=half; k++){
+        slidingReal[k] += delta * slidingCos[m];
+        slidingImag[k] += delta * slidingSin[m];
+        m += writeIndex;
+        if( m >= windowSize ) m -= windowSize;
+    }
+    
+    return true;
+}
+    
+bool FastFourierTransform::computeSlidingDFT(const UINT readIndex){
+    
+    if( !slidingDFTInitialized || readIndex >= windowSize ){
+        return false;
+    }
+    
+    //Rotate the transform of the buffer by the read index to get the transform of the window, this is then stored in the
+    //same packed format as the realFFT where the real part of the windowSize/2 bin is stored in the imaginary part of bin 0
+    const UINT half = windowSize/2;
+    UINT m = 0;
+    for(UINT k=0; k<=half; k++){
+        const double c = slidingCos[m];
+        const double s = -slidingSin[m];
+        const double re = slidingReal[k] * c - slidingImag[k] * s;
+        const double im = slidingReal[k] * s + slidingImag[k] * c;
+        if( k == 0 ){
+            fftReal[0] = re;
+        }else if( k == half ){
+            fftImag[0] = re;
+        }else{
+            fftReal[k] = re;
+            fftImag[k] = im;
+        }
+        m += readIndex;
+        if( m >= windowSize ) m -= windowSize;
+    }
+    
+    return computeSpectrum();
+}
+    
+bool FastFourierTransform::anchorSlidingDFT(const UINT readIndex){
+    
+    if( !slidingDFTInitialized || readIndex >= windowSize ){
+        return false;
+    }
+    
+    //Unpack the last FFT result and rotate it back to the storage order of the buffer
+    const UINT half = windowSize/2;
+    UINT m = 0;
+    for(UINT k=0; k<=half; k++){
+        double re = 0;
+        double im = 0;
+        if( k == 0 ){
+            re = fftReal[0];
+        }else if( k == half ){
+            re = fftImag[0];
+        }else{
+            re = fftReal[k];
+            im = fftImag[k];
+        }
+        const double c = slidingCos[m];
+        const double s = slidingSin[m];
+        slidingReal[k] = re * c - im * s;
+        slidingImag[k] = re * s + im * c;
+        m += readIndex;
+        if( m >= windowSize ) m -= windowSize;
+    }
+    
+    return true;
+}
+    
+bool FastFourierTransform::computeSpectrum(){
+    
     averagePower = 0;
     
     for(unsigned int i = 0; i<windowSize/2; i++){
@@ -194,33 +320,20 @@ bool FastFourierTransform::windowData( VectorDouble &data ){
         return false;
     }
     
-    switch( windowFunction ){
-        case RECTANGULAR_WINDOW:
-            return true;
-            break;
-        case BARTLETT_WINDOW:
-            for(unsigned int i=0; i<windowSize/2; i++) {
-                data[i] *= (i / (double) (windowSize / 2));
-                data[i + (windowSize/2)] *= (1.0 - (i / (double) (windowSize/2)));
-            }
-            return true;
-            break;
-        case HAMMING_WINDOW:
-            for(unsigned int i=0; i<windowSize; i++)
-                data[i] *= 0.54 - 0.46 * cos(2 * PI * i / (windowSize - 1));
-            return true;
-            break;
-        case HANNING_WINDOW:
-            for(unsigned int i=0; i <windowSize; i++)
-                data[i] *= 0.50 - 0.50 * cos(2 * PI * i / (windowSize - 1));
-            return true;
-            break;
-        default:
-            return false;
-            break;
+    //The window coefficients are precomputed by the plan, the rectangular window does not need to be applied
+    if( windowFunction == RECTANGULAR_WINDOW ){
+        return true;
+    }
+    
+    if( windowCoefficients.size() != windowSize ){
+        return false;
     }
     
-    return false;
+    for(unsigned int i=0; i<windowSize; i++){
+        data[i] *= windowCoefficients[i];
+    }
+    
+    return true;
 }
     
 VectorDouble FastFourierTransform::getMagnitudeData(){
@@ -296,8 +409,6 @@ bool FastFourierTransform::realFFT( const VectorDouble &realIn, double *realOut,
     int Half = NumSamples / 2;
     int i;
     
-    double theta = PI / Half;
-    
     for (i = 0; i < Half; i++) {
         tmpReal[i] = realIn[2 * i];
         tmpImag[i] = realIn[2 * i + 1];
@@ -307,20 +418,15 @@ bool FastFourierTransform::realFFT( const VectorDouble &realIn, double *realOut,
         return false;
     }
     
-    double wtemp = double(sin(0.5 * theta));
-    
-    double wpr = -2.0 * wtemp * wtemp;
-    double wpi = double (sin(theta));
-    double wr = 1.0 + wpr;
-    double wi = wpi;
-    
     int i3;
     
-    double h1r, h1i, h2r, h2i;
+    double h1r, h1i, h2r, h2i, wr, wi;
     
     for (i = 1; i < Half / 2; i++) {
         
         i3 = Half - i;
+        wr = unpackReal[i];
+        wi = unpackImag[i];
         
         h1r = 0.5 * (realOut[i] + realOut[i3]);
         h1i = 0.5 * (imagOut[i] - imagOut[i3]);
@@ -331,9 +437,6 @@ bool FastFourierTransform::realFFT( const VectorDouble &realIn, double *realOut,
         imagOut[i] = h1i + wr * h2i + wi * h2r;
         realOut[i3] = h1r - wr * h2r + wi * h2i;
         imagOut[i3] = -h1i + wr * h2i + wi * h2r;
-        
-        wr = (wtemp = wr) * wpr - wi * wpi + wr;
-        wi = wi * wpr + wtemp * wpi + wi;
     }
     
     realOut[0] = (h1r = realOut[0]) + imagOut[0];
@@ -343,11 +446,9 @@ bool FastFourierTransform::realFFT( const VectorDouble &realIn, double *realOut,
 }
 
 bool FastFourierTransform::FFT(int numSamples,bool inverseTransform,double *realIn, double *imagIn, double *realOut, double *imagOut){
-    int NumBits;                 /* Number of bits needed to store indices */
     int i, j, k, n;
     int BlockSize, BlockEnd;
     
-    double angle_numerator = 2.0 * PI;
     double tr, ti;                /* temp real, temp imaginary */
     
     if( !isPowerOfTwo(numSamples) ) {
@@ -355,15 +456,17 @@ bool FastFourierTransform::FFT(int numSamples,bool inverseTransform,double *real
         return false;
     }
     
-    if( bitTable.size() == 0 ) initFFT();
-    
-    if( inverseTransform ) angle_numerator = -angle_numerator;
+    //The twiddle factors and bit reversal table are precomputed by the plan for the complex FFT of size windowSize/2
+    if( numSamples != (int)bitReverseTable.size() ){
+        errorLog << "FFT(...) - The number of samples (" << numSamples << ") does not match the FFT plan (" << bitReverseTable.size() << ")!" << endl;
+        return false;
+    }
     
-    NumBits = numberOfBitsNeeded(numSamples);
+    const double sign = inverseTransform ? -1.0 : 1.0;
     
     //Simultaneously data copy and bit-reversal ordering into outputs...
     for(i = 0; i < numSamples; i++) {
-        j = fastReverseBits(i, NumBits);
+        j = bitReverseTable[i];
         realOut[j] = realIn[i];
         imagOut[j] = (imagIn == NULL) ? 0.0 : imagIn[i];
     }
@@ -372,30 +475,14 @@ bool FastFourierTransform::FFT(int numSamples,bool inverseTransform,double *real
     BlockEnd = 1;
     for (BlockSize = 2; BlockSize <= numSamples; BlockSize <<= 1) {
         
-        double delta_angle = angle_numerator / (double) BlockSize;
-        
-        double sm2 = sin(-2 * delta_angle);
-        double sm1 = sin(-delta_angle);
-        double cm2 = cos(-2 * delta_angle);
-        double cm1 = cos(-delta_angle);
-        double w = 2 * cm1;
-        double ar0, ar1, ar2, ai0, ai1, ai2;
+        //The twiddle factor for index n of this block is exp(i*2*PI*n/BlockSize), which is entry n*stride in the table
+        const int stride = numSamples / BlockSize;
+        double ar0, ai0;
         
         for (i = 0; i < numSamples; i += BlockSize) {
-            ar2 = cm2;
-            ar1 = cm1;
-            
-            ai2 = sm2;
-            ai1 = sm1;
-            
             for (j = i, n = 0; n < BlockEnd; j++, n++) {
-                ar0 = w * ar1 - ar2;
-                ar2 = ar1;
-                ar1 = ar0;
-                
-                ai0 = w * ai1 - ai2;
-                ai2 = ai1;
-                ai1 = ai0;
+                ar0 = twiddleReal[n*stride];
+                ai0 = sign * twiddleImag[n*stride];
                 
                 k = j + BlockEnd;
                 tr = ar0 * realOut[k] - ai0 * imagOut[k];
@@ -425,6 +512,63 @@ bool FastFourierTransform::FFT(int numSamples,bool inverseTransform,double *real
     return true;
 }
     
+bool FastFourierTransform::initPlan(){
+    
+    const unsigned int half = windowSize/2;
+    
+    //Precompute the window function
+    windowCoefficients.clear();
+    switch( windowFunction ){
+        case RECTANGULAR_WINDOW:
+            break;
+        case BARTLETT_WINDOW:
+            windowCoefficients.resize( windowSize );
+            for(unsigned int i=0; i<half; i++) {
+                windowCoefficients[i] = (i / (double) (windowSize / 2));
+                windowCoefficients[i + half] = (1.0 - (i / (double) (windowSize/2)));
+            }
+            break;
+        case HAMMING_WINDOW:
+            windowCoefficients.resize( windowSize );
+            for(unsigned int i=0; i<windowSize; i++)
+                windowCoefficients[i] = 0.54 - 0.46 * cos(2 * PI * i / (windowSize - 1));
+            break;
+        case HANNING_WINDOW:
+            windowCoefficients.resize( windowSize );
+            for(unsigned int i=0; i <windowSize; i++)
+                windowCoefficients[i] = 0.50 - 0.50 * cos(2 * PI * i / (windowSize - 1));
+            break;
+        default:
+            return false;
+            break;
+    }
+    
+    //Precompute the twiddle factors for the complex FFT of size half
+    twiddleReal.resize( half/2 > 0 ? half/2 : 1 );
+    twiddleImag.resize( twiddleReal.size() );
+    for(unsigned int m=0; m<twiddleReal.size(); m++){
+        twiddleReal[m] = cos( 2.0 * PI * m / half );
+        twiddleImag[m] = sin( 2.0 * PI * m / half );
+    }
+    
+    //Precompute the twiddle factors used to unpack the real FFT, these are exp(i*m*PI/half)
+    unpackReal.resize( half/2 > 0 ? half/2 : 1 );
+    unpackImag.resize( unpackReal.size() );
+    for(unsigned int m=0; m<unpackReal.size(); m++){
+        unpackReal[m] = cos( m * PI / half );
+        unpackImag[m] = sin( m * PI / half );
+    }
+    
+    //Precompute the bit reversal table
+    const int numBits = numberOfBitsNeeded( half );
+    bitReverseTable.resize( half );
+    for(unsigned int i=0; i<half; i++){
+        bitReverseTable[i] = reverseBits(i, numBits);
+    }
+    
+    return true;
+}
+    
 int FastFourierTransform::numberOfBitsNeeded(int powerOfTwo)
 {
     for (int i = 0;; i++){
@@ -447,30 +591,6 @@ int FastFourierTransform::reverseBits(int index, int numBits)
     return rev;
 }
 
-void FastFourierTransform::initFFT()
-{
-    bitTable.resize( MAX_FAST_BITS );
-    
-    int len = 2;
-    for (int b = 1; b <= MAX_FAST_BITS; b++) {
-        
-        bitTable[b - 1].resize(len);
-        
-        for (int i = 0; i < len; i++)
-            bitTable[b - 1][i] = reverseBits(i, b);
-        
-        len <<= 1;
-    }
-}
-
-inline int FastFourierTransform::fastReverseBits(const int i, const int numBits)
-{
-    if (numBits <= MAX_FAST_BITS)
-        return bitTable[numBits - 1][i];
-    else
-        return reverseBits(i, numBits);
-}
-    
 inline bool FastFourierTransform::isPowerOfTwo(const unsigned int x){
     if (x < 2) return false;
     if (x & (x - 1)) return false;
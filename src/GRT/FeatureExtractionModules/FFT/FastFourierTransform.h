@@ -47,6 +47,46 @@ public:
     
     bool computeFFT( VectorDouble &data );
     
+    /**
+     Initializes the sliding DFT mode. In this mode the transform of the buffer is updated in O(windowSize) each time a
+     single value in the buffer changes, rather than recomputing the full FFT. The sliding DFT does not apply the window
+     function, so it should only be used with the RECTANGULAR_WINDOW.
+     
+     The sliding DFT tracks the transform of the buffer in its storage order (i.e. the physical order of a circular
+     buffer), the readIndex passed to computeSlidingDFT is used to rotate the result into the order of the window.
+     
+     @return returns true if the sliding DFT was initialized, false otherwise
+     */
+    bool initSlidingDFT();
+    
+    /**
+     Updates the sliding DFT with a change to a single value in the buffer.
+     
+     @param const UINT writeIndex: the storage index of the value that changed, must be less than the windowSize
+     @param const double oldValue: the previous value at the writeIndex
+     @param const double newValue: the new value at the writeIndex
+     @return returns true if the sliding DFT was updated, false otherwise
+     */
+    bool updateSlidingDFT(const UINT writeIndex,const double oldValue,const double newValue);
+    
+    /**
+     Computes the magnitude, phase and power data from the sliding DFT, in the same format as computeFFT.
+     
+     @param const UINT readIndex: the storage index of the first value in the window
+     @return returns true if the results were computed, false otherwise
+     */
+    bool computeSlidingDFT(const UINT readIndex);
+    
+    /**
+     Resets the sliding DFT from the results of the last call to computeFFT, this can be used to periodically remove any
+     rounding error that has accumulated in the sliding DFT. The data passed to computeFFT should have been the window
+     starting at the readIndex.
+     
+     @param const UINT readIndex: the storage index of the first value in the window that was passed to computeFFT
+     @return returns true if the sliding DFT was reset, false otherwise
+     */
+    bool anchorSlidingDFT(const UINT readIndex);
+    
     VectorDouble getMagnitudeData();
     VectorDouble getPhaseData();
     VectorDouble getPowerData();
@@ -58,13 +98,13 @@ public:
     UINT getFFTSize(){ return windowSize; }
     
 protected:
+    bool computeSpectrum();
+    bool initPlan();
     bool windowData( VectorDouble &data );
     bool realFFT( const VectorDouble &realIn, double *realOut, double *imagOut );
     bool FFT(int NumSamples,bool InverseTransform,double *realIn, double *imagIn, double *realOut, double *imagOut);
     int numberOfBitsNeeded(int PowerOfTwo);
     int reverseBits(int index, int NumBits);
-    void initFFT();
-    inline int fastReverseBits(const int i, const int NumBits);
     inline bool isPowerOfTwo(const unsigned int x);
     
     unsigned int windowSize;
@@ -80,8 +120,21 @@ protected:
     VectorDouble phase;
     VectorDouble power;
     double averagePower;
-    const static int MAX_FAST_BITS = 16;
-    vector< vector< int > > bitTable;
+    
+    //The FFT plan, these tables are computed when the FFT is initialized so they do not need to be recomputed for each transform
+    VectorDouble windowCoefficients;        //The window function coefficients, this is empty for the RECTANGULAR_WINDOW
+    VectorDouble twiddleReal;               //The twiddle factors for the complex FFT of size windowSize/2
+    VectorDouble twiddleImag;
+    VectorDouble unpackReal;                //The twiddle factors used to unpack the real FFT from the complex FFT
+    VectorDouble unpackImag;
+    vector< unsigned int > bitReverseTable; //The bit reversed index for the complex FFT of size windowSize/2
+    
+    //The sliding DFT state, this is the transform of bins [0 windowSize/2] of the buffer in its storage order
+    bool slidingDFTInitialized;
+    VectorDouble slidingReal;
+    VectorDouble slidingImag;
+    VectorDouble slidingCos;                //cos(2*PI*m/windowSize) for m in [0 windowSize-1]
+    VectorDouble slidingSin;                //sin(2*PI*m/windowSize) for m in [0 windowSize-1]
     
 public:
     enum WindowFunctionOptions{RECTANGULAR_WINDOW=0,BARTLETT_WINDOW,HAMMING_WINDOW,HANNING_WINDOW};
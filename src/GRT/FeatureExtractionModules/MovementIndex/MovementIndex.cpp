@@ -55,6 +55,7 @@ MovementIndex& MovementIndex::operator=(const MovementIndex &rhs){
     if(this!=&rhs){
         this->bufferLength = rhs.bufferLength;
         this->dataBuffer = rhs.dataBuffer;
+        this->bufferStatistics = rhs.bufferStatistics;
         
         //Copy the base variables
         copyBaseVariables( (FeatureExtraction*)&rhs );
@@ -212,6 +213,9 @@ bool MovementIndex::init(UINT bufferLength,UINT numDimensions){
     
     //Resize the raw trajectory data buffer
     dataBuffer.resize( bufferLength, vector< double >(numInputDimensions,0) );
+    
+    //Setup the running statistics, these are rebuilt from the raw data once per buffer length
+    bufferStatistics.init( numInputDimensions, bufferLength, bufferLength );
 
     //Flag that the zero crossing counter has been initialized
     initialized = true;
@@ -238,9 +242,25 @@ vector< double > MovementIndex::update(const vector< double > &x){
     }
 #endif
     
+    //Update the running statistics, the new value either replaces the oldest value or one of the default values if the buffer is still filling up
+    const UINT replaceIndex = dataBuffer.getBufferFilled() ? 0 : dataBuffer.getNumValuesInBuffer();
+    for(UINT j=0; j<numInputDimensions; j++){
+        bufferStatistics.replace( j, dataBuffer[replaceIndex][j], x[j] );
+    }
+    
     //Add the new data to the trajectory data buffer
     dataBuffer.push_back( x );
     
+    //Periodically rebuild the running statistics from the raw data to remove any accumulated rounding error
+    if( bufferStatistics.tick() ){
+        for(UINT j=0; j<numInputDimensions; j++){
+            bufferStatistics.clearAccumulator( j );
+            for(UINT i=0; i<dataBuffer.getSize(); i++){
+                bufferStatistics.add( j, dataBuffer[i][j] );
+            }
+        }
+    }
+    
     //Only flag that the feature data is ready if the trajectory data is full
     if( !dataBuffer.getBufferFilled() ){
         featureDataReady = false;
@@ -251,22 +271,8 @@ vector< double > MovementIndex::update(const vector< double > &x){
     }else featureDataReady = true;
     
     //Compute the movement index (which is the RMS error)
-    vector< double > mu(numInputDimensions,0);
-    
-    //Compute mu
-    for(UINT j=0; j<numInputDimensions; j++){
-        for(UINT i=0; i<dataBuffer.getSize(); i++){
-            mu[j] += dataBuffer[i][j];
-        }
-        mu[j] /= double(dataBuffer.getSize());
-    }
-    
     for(UINT j=0; j<numInputDimensions; j++){
-        featureVector[j] = 0;
-        for(UINT i=0; i<dataBuffer.getSize(); i++){
-            featureVector[j] += SQR( dataBuffer[i][j] - mu[j] );
-        }
-        featureVector[j] = sqrt( featureVector[j]/double(dataBuffer.getSize()) );
+        featureVector[j] = sqrt( bufferStatistics.getSumSquaredDeviations(j)/double(dataBuffer.getSize()) );
     }
     
     return featureVector;
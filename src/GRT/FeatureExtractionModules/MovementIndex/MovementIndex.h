@@ -35,6 +35,7 @@
 
 #include "../../CoreModules/FeatureExtraction.h"
 #include "../../Util/Util.h"
+#include "../../Util/SlidingWindowStatistics.h"
 
 namespace GRT{
     
@@ -173,6 +174,7 @@ public:
 protected:
     UINT bufferLength;
     CircularBuffer< vector< double > > dataBuffer;
+    SlidingWindowStatistics bufferStatistics;
     
     static RegisterFeatureExtractionModule< MovementIndex > registerModule;
 };
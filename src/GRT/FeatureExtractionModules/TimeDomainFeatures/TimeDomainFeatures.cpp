@@ -62,6 +62,7 @@ TimeDomainFeatures& TimeDomainFeatures::operator=(const TimeDomainFeatures &rhs)
         this->useEuclideanNorm = rhs.useEuclideanNorm;
         this->useRMS = rhs.useRMS;
         this->dataBuffer = rhs.dataBuffer;
+        this->frameStatistics = rhs.frameStatistics;
         
         //Copy the base variables
         copyBaseVariables( (FeatureExtraction*)&rhs );
@@ -295,7 +296,10 @@ bool TimeDomainFeatures::init(UINT bufferLength,UINT numFrames,UINT numDimension
     featureVector.resize(numOutputDimensions);
     
     //Resize the raw data buffer
-    dataBuffer.resize( bufferLength, VectorDouble(numInputDimensions,0) );
+    dataBuffer.resize( bufferLength, numInputDimensions );
+    
+    //Setup the running statistics for each frame, these are rebuilt from the raw data once per buffer length
+    frameStatistics.init( numInputDimensions*numFrames, bufferLength / numFrames, bufferLength );
 
     //Flag that the time domain features has been initialized
     initialized = true;
@@ -320,116 +324,77 @@ VectorDouble TimeDomainFeatures::update(const VectorDouble &x){
         return vector<double>();
     }
     
-    //Add the new data to the data buffer
-    dataBuffer.push_back( x );
-    
-    //Only flag that the feature data is ready if the data is full
+    //Update the running statistics of each frame, each frame always holds frameSize values so every update is a replacement
+    const UINT frameSize = bufferLength / numFrames;
     if( dataBuffer.getBufferFilled() ){
-        featureDataReady = true;
-    }else featureDataReady = false;
-    
-    MatrixDouble meanFeatures(numInputDimensions,numFrames);
-    MatrixDouble stdDevFeatures(numInputDimensions,numFrames);
-    MatrixDouble normFeatures(numInputDimensions,numFrames);
-    MatrixDouble rmsFeatures(numInputDimensions,numFrames);
-    MatrixDouble data(bufferLength,numInputDimensions);
-    
-    if( offsetInput ){
+        //The whole window shifts by one sample, so each frame loses its oldest value and gains the first value of the next frame
         for(UINT n=0; n<numInputDimensions; n++){
-            data[0][n] = dataBuffer[0][n];
-            for(UINT i=1; i<bufferLength; i++){
-                data[i][n] = dataBuffer[i][n]-dataBuffer[0][n];
+            for(UINT j=0; j<numFrames; j++){
+                const double newValue = j+1 < numFrames ? dataBuffer[ (j+1)*frameSize ][n] : x[n];
+                frameStatistics.replace( n*numFrames+j, dataBuffer[ j*frameSize ][n], newValue );
             }
         }
     }else{
+        //The buffer is still filling up, so the new sample simply overwrites one of the default values
+        const UINT i = dataBuffer.getNumValuesInBuffer();
+        const UINT j = i / frameSize;
         for(UINT n=0; n<numInputDimensions; n++){
-            for(UINT i=0; i<bufferLength; i++){
-                data[i][n] = dataBuffer[i][n];
-            }
+            frameStatistics.replace( n*numFrames+j, dataBuffer[i][n], x[n] );
         }
     }
     
-    if( useMean || useStdDev ){ meanFeatures.setAllValues(0); stdDevFeatures.setAllValues(0); }
-    if( useEuclideanNorm ) normFeatures.setAllValues(0);
-    if( useRMS ) rmsFeatures.setAllValues(0);
+    //Add the new data to the data buffer
+    dataBuffer.push_back( x );
     
-    UINT frameSize = bufferLength / numFrames;
-    UINT frame = 0;
-    UINT index = 0;
-    for(UINT n=0; n<numInputDimensions; n++){
-        frame = 0;
-        index = 0;
-        for(UINT i=0; i<bufferLength; i++){
-            //Update the mean
-            meanFeatures[n][frame] += data[i][n];
-            
-            //Update the norm features
-            if( useEuclideanNorm )
-                normFeatures[n][frame] += data[i][n]*data[i][n];
-            
-            //Update the rms features
-            if( useRMS )
-                rmsFeatures[n][frame] += data[i][n]*data[i][n];
-            
-            if( ++index == frameSize ){
-                frame++;
-                index = 0;
-            }
-        }
-        
-        //Update the mean
-        for(UINT j=0; j<numFrames; j++){
-            meanFeatures[n][j] /= frameSize;
-        }
-        
-        //Update the std dev if needed
-        if( useStdDev ){
-            frame = 0;
-            index = 0;
-            for(UINT i=0; i<bufferLength; i++){
-                stdDevFeatures[n][frame] += (data[i][n]-meanFeatures[n][frame]) * (data[i][n]-meanFeatures[n][frame]);
-                if( ++index == frameSize ){
-                    frame++;
-                    index = 0;
-                }
-            }
-            double norm = frameSize>1 ? frameSize-1 : 1;
-            for(UINT j=0; j<numFrames; j++){
-                stdDevFeatures[n][j] = sqrt( stdDevFeatures[n][j]/norm );
-            }
-        }
-        
-        //Update the euclidean norm if needed
-        if( useEuclideanNorm ){
-            for(UINT j=0; j<numFrames; j++){
-                normFeatures[n][j] = sqrt( normFeatures[n][j] );
-            }
-        }
-        
-        //Update the rms if needed
-        if( useRMS ){
+    //Only flag that the feature data is ready if the data is full
+    if( dataBuffer.getBufferFilled() ){
+        featureDataReady = true;
+    }else featureDataReady = false;
+    
+    //Periodically rebuild the running statistics from the raw data to remove any accumulated rounding error
+    if( frameStatistics.tick() ){
+        for(UINT n=0; n<numInputDimensions; n++){
             for(UINT j=0; j<numFrames; j++){
-                rmsFeatures[n][j] = sqrt( rmsFeatures[n][j] / frameSize );
+                frameStatistics.clearAccumulator( n*numFrames+j );
+                for(UINT i=0; i<frameSize; i++){
+                    frameStatistics.add( n*numFrames+j, dataBuffer[ j*frameSize+i ][n] );
+                }
             }
         }
     }
     
     //Update the features
-    index = 0;
-    frame = 0;
+    const double stdDevNorm = frameSize>1 ? frameSize-1 : 1;
+    UINT index = 0;
     for(UINT n=0; n<numInputDimensions; n++){
+        
+        //If the input is offset, all the values except the first are relative to the first value in the buffer
+        const double offset = offsetInput ? dataBuffer[0][n] : 0;
+        
         for(UINT j=0; j<numFrames; j++){
+            double mean = frameStatistics.getMean( n*numFrames+j ) - offset;
+            double m2 = frameStatistics.getSumSquaredDeviations( n*numFrames+j );
+            
+            if( offsetInput && j == 0 ){
+                //The first value in the buffer is not offset, so swap its offset value (zero) for its raw value
+                const double oldMean = mean;
+                mean += offset / frameSize;
+                m2 += offset * ( (offset - mean) + (0 - oldMean) );
+                if( m2 < 0 ) m2 = 0;
+            }
+            const double sumOfSquares = m2 + frameSize * mean * mean;
+            
             if( useMean ){
-                featureVector[index++] = meanFeatures[n][j];
+                featureVector[index++] = mean;
             }
             if( useStdDev ){
-                featureVector[index++] = stdDevFeatures[n][j];
+                featureVector[index++] = sqrt( m2 / stdDevNorm );
             }
             if( useEuclideanNorm ){
-                featureVector[index++] = normFeatures[n][j];
+                featureVector[index++] = sqrt( sumOfSquares );
             }
             if( useRMS ){
-                featureVector[index++] = rmsFeatures[n][j];
+                featureVector[index++] = sqrt( sumOfSquares / frameSize );
             }
         }
     }
@@ -437,14 +402,14 @@ VectorDouble TimeDomainFeatures::update(const VectorDouble &x){
     return featureVector;
 }
     
-CircularBuffer< VectorDouble > TimeDomainFeatures::getBufferData(){
+MultiChannelCircularBuffer TimeDomainFeatures::getBufferData(){
     if( initialized ){
         return dataBuffer;
     }
-    return CircularBuffer< VectorDouble >();
+    return MultiChannelCircularBuffer();
 }
     
-const CircularBuffer< VectorDouble > &TimeDomainFeatures::getBufferData() const {
+const MultiChannelCircularBuffer &TimeDomainFeatures::getBufferData() const {
     return dataBuffer;
 }
     
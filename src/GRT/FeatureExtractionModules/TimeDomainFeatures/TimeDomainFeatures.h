@@ -31,6 +31,7 @@
 
 #include "../../CoreModules/FeatureExtraction.h"
 #include "../../Util/Util.h"
+#include "../../Util/SlidingWindowStatistics.h"
 
 namespace GRT{
     
@@ -149,14 +150,14 @@ public:
      
      @return a copy of the circular buffer
      */
-    CircularBuffer< VectorDouble > getBufferData();
+    MultiChannelCircularBuffer getBufferData();
     
     /**
      Gets a reference to the circular buffer.
      
      @return a reference to the circular buffer
      */
-    const CircularBuffer< VectorDouble > &getBufferData() const;
+    const MultiChannelCircularBuffer &getBufferData() const;
     
     //Tell the compiler we are using the following functions from the MLBase class to stop hidden virtual function warnings
     using MLBase::train;
@@ -172,7 +173,8 @@ protected:
     bool useStdDev;
     bool useEuclideanNorm;
     bool useRMS;
-    CircularBuffer< VectorDouble > dataBuffer;
+    MultiChannelCircularBuffer dataBuffer;
+    SlidingWindowStatistics frameStatistics;
     
     static RegisterFeatureExtractionModule< TimeDomainFeatures > registerModule;
 };
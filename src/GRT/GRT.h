@@ -57,6 +57,13 @@
 #include "Util/LUDecomposition.h"
 #include "Util/Cholesky.h"
 #include "Util/EigenvalueDecomposition.h"
+#include "Util/LBFGSOptimizer.h"
+#include "Util/KDTree.h"
+#include "Util/FilterBank.h"
+#include "Util/LatencyHistogram.h"
+#include "Util/PipelineProfiler.h"
+#include "Util/BinaryModelFile.h"
+#include "Util/SPSCQueue.h"
 #include "Util/TestResult.h"
 #include "Util/ClassificationResult.h"
 #include "Util/PeakDetection.h"
@@ -86,9 +93,11 @@
 #include "PreProcessingModules/HighPassFilter.h"
 #include "PreProcessingModules/MovingAverageFilter.h"
 #include "PreProcessingModules/MedianFilter.h"
+#include "PreProcessingModules/PercentileFilter.h"
 #include "PreProcessingModules/DoubleMovingAverageFilter.h"
 #include "PreProcessingModules/SavitzkyGolayFilter.h"
 #include "PreProcessingModules/DeadZone.h"
+#include "PreProcessingModules/FilterCascade.h"
 
 //Include the FeatureExtraction Modules
 #include "FeatureExtractionModules/ZeroCrossingCounter/ZeroCrossingCounter.h"
@@ -121,6 +130,7 @@
 #include "ClassificationModules/LDA/LDA.h"
 #include "ClassificationModules/MinDist/MinDist.h"
 #include "ClassificationModules/RandomForests/RandomForests.h"
+#include "ClassificationModules/SharedClassifier/SharedClassifier.h"
 #include "ClassificationModules/Softmax/Softmax.h"
 #include "ClassificationModules/SVM/SVM.h"
 
@@ -143,5 +153,6 @@
 
 //Include the Recognition Pipeline
 #include "CoreModules/GestureRecognitionPipeline.h"
+#include "CoreModules/PipelinePool.h"
 
 #endif //GRT_MAIN_HEADER
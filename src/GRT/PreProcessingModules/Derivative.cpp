@@ -19,6 +19,7 @@
  */
 
 #include "Derivative.h"
+#include "FilterCascade.h"
 
 namespace GRT{
     
@@ -122,6 +123,18 @@ bool Derivative::reset(){
     return false;
 }
     
+bool Derivative::appendToFilterCascade(FilterCascade &cascade) const{
+    if( !initialized ) return false;
+    if( filterData && filterSize > FilterCascade::MAX_MOVING_AVERAGE_SIZE ) return false;
+    
+    if( filterData && !cascade.addMovingAverage( filterSize ) ) return false;
+    
+    for(UINT i=0; i<derivativeOrder; i++){
+        if( !cascade.addFirstOrderSection( 1.0/delta, -1.0/delta, 0 ) ) return false;
+    }
+    return true;
+}
+    
 bool Derivative::saveModelToFile(string filename) const{
     
     if( !initialized ){
@@ -99,6 +99,16 @@ public:
      */
     virtual bool reset();
     
+    /**
+     Appends the filter to a FilterCascade, overwriting the base PreProcessing function.
+     Each order of the derivative is one first order section, (x[n]-x[n-1])/delta, after the moving average if
+     the data is filtered. The filter can not be appended if the filterSize is larger than FilterCascade::MAX_MOVING_AVERAGE_SIZE.
+     
+     @param FilterCascade &cascade: the cascade the filter will be appended to
+     @return returns true if the filter was appended to the cascade, false otherwise
+     */
+    virtual bool appendToFilterCascade(FilterCascade &cascade) const;
+    
     /**
      This saves the current settings of the Derivative to a file.
      This overrides the saveModelToFile function in the PreProcessing base class.
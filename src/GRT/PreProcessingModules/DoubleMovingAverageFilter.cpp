@@ -114,6 +114,38 @@ bool DoubleMovingAverageFilter::process(const VectorDouble &inputVector){
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
 }
+    
+bool DoubleMovingAverageFilter::processBlock(const MatrixDouble &inputData,MatrixDouble &outputData){
+    
+    if( !initialized ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - The filter has not been initialized!" << endl;
+        return false;
+    }
+    
+    if( inputData.getNumRows() == 0 ) return true;
+    
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - The number of columns in the inputData (" << inputData.getNumCols() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    //Run the first filter over the whole block, then the second filter over the output of the first filter
+    MatrixDouble y;
+    if( !filter1.processBlock( inputData, y ) || !filter2.processBlock( y, outputData ) ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - Failed to filter the block!" << endl;
+        return false;
+    }
+    
+    const UINT M = outputData.getNumRows();
+    for(UINT i=0; i<M; i++){
+        for(UINT j=0; j<numInputDimensions; j++){
+            outputData[i][j] = y[i][j] + (y[i][j] - outputData[i][j]);
+        }
+    }
+    if( M > 0 ) std::copy( outputData[M-1], outputData[M-1] + numInputDimensions, processedData.begin() );
+    
+    return true;
+}
 
 bool DoubleMovingAverageFilter::reset(){
     if( initialized ) return init(filterSize,numInputDimensions);
@@ -86,6 +86,16 @@ public:
      */
     virtual bool process(const VectorDouble &inputVector);
     
+    /**
+     Sets the PreProcessing processBlock function, overwriting the base PreProcessing function.
+     This filters a block of samples at once, with one sample per row.
+     
+	 @param const MatrixDouble &inputData: the samples that should be filtered, the number of columns must match the dimensionality of the filter
+	 @param MatrixDouble &outputData: returns the filtered samples
+	 @return true if the data was processed, false otherwise
+     */
+    virtual bool processBlock(const MatrixDouble &inputData,MatrixDouble &outputData);
+    
     /**
      Sets the PreProcessing reset function, overwriting the base PreProcessing function.
      This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
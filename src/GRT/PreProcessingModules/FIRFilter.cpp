@@ -82,8 +82,8 @@ FIRFilter& FIRFilter::operator=(const FIRFilter &rhs){
         this->cutoffFrequencyLower = rhs.cutoffFrequencyLower;
         this->cutoffFrequencyUpper = rhs.cutoffFrequencyUpper;
         this->gain = rhs.gain;
-        this->y = rhs.y;
         this->z = rhs.z;
+        this->filterBank = rhs.filterBank;
         
         copyBaseVariables( (PreProcessing*)&rhs );
 	}
@@ -127,6 +127,36 @@ bool FIRFilter::process(const VectorDouble &inputVector){
     
     return false;
 }
+    
+bool FIRFilter::processBlock(const MatrixDouble &inputData,MatrixDouble &outputData){
+    
+    if( !initialized ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - Not initialized!" << endl;
+        return false;
+    }
+    
+    if( inputData.getNumRows() == 0 ) return true;
+    
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - The number of columns in the inputData (" << inputData.getNumCols() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    if( !filterBank.processBlock( inputData, outputData ) ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - Failed to filter the block!" << endl;
+        return false;
+    }
+    
+    const UINT M = outputData.getNumRows();
+    for(UINT i=0; i<M; i++){
+        for(UINT n=0; n<numInputDimensions; n++){
+            outputData[i][n] *= gain;
+        }
+    }
+    if( M > 0 ) std::copy( outputData[M-1], outputData[M-1] + numInputDimensions, processedData.begin() );
+    
+    return true;
+}
 
 bool FIRFilter::reset(){
     
@@ -135,11 +165,7 @@ bool FIRFilter::reset(){
     
     if( initialized ){
         //Set the data history buffer to zero
-        for(UINT n=0; n<numInputDimensions; n++){
-            for(UINT i=0; i<numTaps; i++){
-                y[n][i] = 0;
-            }
-        }
+        filterBank.reset();
     }
     
     return true;
@@ -150,8 +176,8 @@ bool FIRFilter::clear(){
     //Clear the base class
     PreProcessing::clear();
     
-    y.clear();
     z.clear();
+    filterBank.clear();
     
     return true;
 }
@@ -318,7 +344,6 @@ bool FIRFilter::loadModelFromFile(fstream &file){
     if( initialized ){
         
         //Setup the memory and then load z
-        y.resize( numTaps, VectorDouble(numInputDimensions,0) );
         z.resize( numTaps );
         
         //Load z
@@ -332,6 +357,13 @@ bool FIRFilter::loadModelFromFile(fstream &file){
         for(UINT i=0; i<numTaps; i++){
             file >> z[i];
         }
+        
+        //Setup the filter bank with the coefficients
+        if( !filterBank.init( z, numInputDimensions ) ){
+            errorLog << "loadModelFromFile(fstream &file) - Failed to init the filter bank!" << endl;
+            clear();
+            return false;
+        }
     }
     
     return true;
@@ -351,9 +383,7 @@ bool FIRFilter::buildFilter(){
     numOutputDimensions = numInputDimensions;
     
     //Reset the memory
-    y.clear();
     z.clear();
-    y.resize( numTaps, VectorDouble(numInputDimensions,0) );
     z.resize( numTaps, 0 );
     
     //Design the filter coeffients (z)
@@ -397,6 +427,12 @@ bool FIRFilter::buildFilter(){
             break;
     }
     
+    //Setup the filter bank, this holds the input history of every dimension
+    if( !filterBank.init( z, numInputDimensions ) ){
+        errorLog << "designFilter() - Failed to init the filter bank!" << endl;
+        return false;
+    }
+    
     //Init the preprocessing base class
     PreProcessing::init();
     
@@ -435,17 +471,10 @@ VectorDouble FIRFilter::filter(const VectorDouble &x){
         return VectorDouble();
     }
     
-    //Add the new sample to the buffer
-    y.push_back( x );
-    
-    const UINT K = numTaps-1;
+    //Add the new sample to the buffer and run the filter for each input dimension
+    filterBank.filter( &x[0], &processedData[0] );
     
-    //Run the filter for each input dimension
     for(UINT n=0; n<numInputDimensions; n++){
-        processedData[n] = 0;
-        for(UINT i=0; i<numTaps; i++){
-            processedData[n] += y[K-i][n] * z[i];
-        }
         processedData[n] *= gain;
     }
     
@@ -482,7 +511,7 @@ double FIRFilter::getGain() const{
 
 vector< VectorDouble > FIRFilter::getInputBuffer() const{
     if( initialized ){
-        y.getDataAsVector();
+        return filterBank.getHistory();
     }
     return vector< VectorDouble >();
 }
@@ -0,0 +1,462 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "FilterCascade.h"
+
+#ifdef GRT_SSE2_ENABLED
+    #include <emmintrin.h>
+#endif
+
+namespace GRT{
+
+//Register the FilterCascade module with the PreProcessing base class
+RegisterPreProcessingModule< FilterCascade > FilterCascade::registerModule("FilterCascade");
+
+FilterCascade::FilterCascade(UINT numDimensions){
+
+    preProcessingType = "FilterCascade";
+    debugLog.setProceedingText("[DEBUG FilterCascade]");
+    errorLog.setProceedingText("[ERROR FilterCascade]");
+    warningLog.setProceedingText("[WARNING FilterCascade]");
+    unpairedSectionIndex = 0;
+    numSamples = 0;
+    maxNormalizationLength = 0;
+    init(numDimensions);
+}
+
+FilterCascade::FilterCascade(const FilterCascade &rhs){
+
+    preProcessingType = "FilterCascade";
+    debugLog.setProceedingText("[DEBUG FilterCascade]");
+    errorLog.setProceedingText("[ERROR FilterCascade]");
+    warningLog.setProceedingText("[WARNING FilterCascade]");
+    *this = rhs;
+}
+
+FilterCascade::~FilterCascade(){
+
+}
+
+FilterCascade& FilterCascade::operator=(const FilterCascade &rhs){
+    if(this!=&rhs){
+        this->sections = rhs.sections;
+        this->unpairedSectionIndex = rhs.unpairedSectionIndex;
+        this->numSamples = rhs.numSamples;
+        this->maxNormalizationLength = rhs.maxNormalizationLength;
+        this->s1 = rhs.s1;
+        this->s2 = rhs.s2;
+        copyBaseVariables( (PreProcessing*)&rhs );
+    }
+    return *this;
+}
+
+bool FilterCascade::deepCopyFrom(const PreProcessing *preProcessing){
+
+    if( preProcessing == NULL ) return false;
+
+    if( this->getPreProcessingType() == preProcessing->getPreProcessingType() ){
+
+        //Clone the FilterCascade values
+        *this = *(FilterCascade*)preProcessing;
+
+        return true;
+    }
+
+    errorLog << "clone(const PreProcessing *preProcessing) -  PreProcessing Types Do Not Match!" << endl;
+
+    return false;
+}
+
+bool FilterCascade::process(const VectorDouble &inputVector){
+
+    if( !initialized ){
+        errorLog << "process(const VectorDouble &inputVector) - Not initialized!" << endl;
+        return false;
+    }
+
+    if( inputVector.size() != numInputDimensions ){
+        errorLog << "process(const VectorDouble &inputVector) - The size of the inputVector (" << inputVector.size() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+
+    computeOutput( &inputVector[0], &processedData[0] );
+
+    return true;
+}
+
+bool FilterCascade::processBlock(const MatrixDouble &inputData,MatrixDouble &outputData){
+
+    if( !initialized ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - Not initialized!" << endl;
+        return false;
+    }
+
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - The number of columns in the inputData (" << inputData.getNumCols() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+
+    const UINT M = inputData.getNumRows();
+    if( M == 0 ) return true;
+
+    if( !outputData.resize( M, numOutputDimensions ) ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - Failed to resize the output data!" << endl;
+        return false;
+    }
+
+    for(UINT i=0; i<M; i++){
+        computeOutput( inputData[i], outputData[i] );
+    }
+    std::copy( outputData[M-1], outputData[M-1] + numOutputDimensions, processedData.begin() );
+
+    return true;
+}
+
+bool FilterCascade::reset(){
+    if( initialized ) return init(numInputDimensions);
+    return false;
+}
+
+bool FilterCascade::appendToFilterCascade(FilterCascade &cascade) const{
+
+    if( !initialized ) return false;
+
+    //The sections are appended as they are, so the sections of this cascade are not paired with those of the other cascade
+    for(UINT k=0; k<sections.size(); k++){
+        cascade.sections.push_back( sections[k] );
+        if( sections[k].normalizationLength > cascade.maxNormalizationLength ){
+            cascade.maxNormalizationLength = sections[k].normalizationLength;
+        }
+    }
+    cascade.unpairedSectionIndex = (UINT)cascade.sections.size();
+
+    return cascade.reset();
+}
+
+bool FilterCascade::saveModelToFile(string filename) const{
+
+    if( !initialized ){
+        errorLog << "saveModelToFile(string filename) - The FilterCascade has not been initialized" << endl;
+        return false;
+    }
+
+    std::fstream file;
+    file.open(filename.c_str(), std::ios::out);
+
+    if( !saveModelToFile( file ) ){
+        file.close();
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
+
+bool FilterCascade::saveModelToFile(fstream &file) const{
+
+    if( !file.is_open() ){
+        errorLog << "saveModelToFile(fstream &file) - The file is not open!" << endl;
+        return false;
+    }
+
+    file << "GRT_FILTER_CASCADE_FILE_V1.0" << endl;
+
+    file << "NumInputDimensions: " << numInputDimensions << endl;
+    file << "NumOutputDimensions: " << numOutputDimensions << endl;
+    file << "NumSections: " << sections.size() << endl;
+    file << "Sections: " << endl;
+
+    //The coefficients are saved at full precision, as small errors in the coefficients of a section can move its poles
+    const std::streamsize precision = file.precision();
+    file.precision( 17 );
+    for(UINT k=0; k<sections.size(); k++){
+        file << sections[k].b0 << "\t" << sections[k].b1 << "\t" << sections[k].b2 << "\t";
+        file << sections[k].a1 << "\t" << sections[k].a2 << "\t" << sections[k].normalizationLength << endl;
+    }
+    file.precision( precision );
+
+    return true;
+}
+
+bool FilterCascade::loadModelFromFile(string filename){
+
+    std::fstream file;
+    file.open(filename.c_str(), std::ios::in);
+
+    if( !loadModelFromFile( file ) ){
+        file.close();
+        initialized = false;
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
+
+bool FilterCascade::loadModelFromFile(fstream &file){
+
+    if( !file.is_open() ){
+        errorLog << "loadModelFromFile(fstream &file) - The file is not open!" << endl;
+        return false;
+    }
+
+    string word;
+
+    //Load the header
+    file >> word;
+
+    if( word != "GRT_FILTER_CASCADE_FILE_V1.0" ){
+        errorLog << "loadModelFromFile(fstream &file) - Invalid file format!" << endl;
+        return false;
+    }
+
+    //Load the number of input dimensions
+    file >> word;
+    if( word != "NumInputDimensions:" ){
+        errorLog << "loadModelFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
+        return false;
+    }
+    file >> numInputDimensions;
+
+    //Load the number of output dimensions
+    file >> word;
+    if( word != "NumOutputDimensions:" ){
+        errorLog << "loadModelFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
+        return false;
+    }
+    file >> numOutputDimensions;
+
+    //Load the number of sections
+    UINT numSections = 0;
+    file >> word;
+    if( word != "NumSections:" ){
+        errorLog << "loadModelFromFile(fstream &file) - Failed to read NumSections header!" << endl;
+        return false;
+    }
+    file >> numSections;
+
+    //Load the sections
+    file >> word;
+    if( word != "Sections:" ){
+        errorLog << "loadModelFromFile(fstream &file) - Failed to read Sections header!" << endl;
+        return false;
+    }
+
+    sections.resize( numSections );
+    maxNormalizationLength = 0;
+    for(UINT k=0; k<numSections; k++){
+        file >> sections[k].b0 >> sections[k].b1 >> sections[k].b2;
+        file >> sections[k].a1 >> sections[k].a2 >> sections[k].normalizationLength;
+        if( sections[k].normalizationLength > maxNormalizationLength ){
+            maxNormalizationLength = sections[k].normalizationLength;
+        }
+    }
+
+    if( !file.good() ){
+        errorLog << "loadModelFromFile(fstream &file) - Failed to read the sections!" << endl;
+        sections.clear();
+        return false;
+    }
+    unpairedSectionIndex = numSections;
+
+    //Init the filter module to ensure everything is initialized correctly
+    return init(numInputDimensions);
+}
+
+bool FilterCascade::init(UINT numDimensions){
+
+    initialized = false;
+
+    if( numDimensions == 0 ){
+        errorLog << "init(UINT numDimensions) - NumDimensions must be greater than 0!" << endl;
+        return false;
+    }
+
+    this->numInputDimensions = numDimensions;
+    this->numOutputDimensions = numDimensions;
+    numSamples = 0;
+    s1.clear();
+    s1.resize(sections.size()*numDimensions,0);
+    s2.clear();
+    s2.resize(sections.size()*numDimensions,0);
+    processedData.clear();
+    processedData.resize(numDimensions,0);
+    initialized = true;
+
+    return true;
+}
+
+double FilterCascade::filter(const double x){
+
+    //If the filter has not been initialised then return 0, otherwise filter x and return y
+    if( !initialized ){
+        errorLog << "filter(const double x) - The filter has not been initialized!" << endl;
+        return 0;
+    }
+
+    VectorDouble y = filter(VectorDouble(1,x));
+
+    if( y.size() == 0 ) return 0;
+    return y[0];
+}
+
+VectorDouble FilterCascade::filter(const VectorDouble &x){
+
+    if( !initialized ){
+        errorLog << "filter(const VectorDouble &x) - Not Initialized!" << endl;
+        return VectorDouble();
+    }
+
+    if( x.size() != numInputDimensions ){
+        errorLog << "filter(const VectorDouble &x) - The Number Of Input Dimensions (" << numInputDimensions << ") does not match the size of the input vector (" << x.size() << ")!" << endl;
+        return VectorDouble();
+    }
+
+    computeOutput( &x[0], &processedData[0] );
+
+    return processedData;
+}
+
+bool FilterCascade::addFirstOrderSection(double b0,double b1,double a1){
+
+    if( unpairedSectionIndex < sections.size() ){
+        //Multiply the two first order sections into one second order section
+        FilterCascadeSection &section = sections[ unpairedSectionIndex ];
+        section.b2 = section.b1 * b1;
+        section.b1 = section.b0 * b1 + section.b1 * b0;
+        section.b0 = section.b0 * b0;
+        section.a2 = section.a1 * a1;
+        section.a1 = section.a1 + a1;
+        unpairedSectionIndex = (UINT)sections.size();
+    }else{
+        unpairedSectionIndex = (UINT)sections.size();
+        sections.push_back( FilterCascadeSection(b0,b1,0,a1,0) );
+    }
+
+    return reset();
+}
+
+bool FilterCascade::addSecondOrderSection(double b0,double b1,double b2,double a1,double a2){
+
+    //Keep the index of any first order section that is still waiting to be paired
+    const bool hasUnpairedSection = unpairedSectionIndex < sections.size();
+
+    sections.push_back( FilterCascadeSection(b0,b1,b2,a1,a2) );
+
+    if( !hasUnpairedSection ) unpairedSectionIndex = (UINT)sections.size();
+
+    return reset();
+}
+
+bool FilterCascade::addMovingAverage(UINT filterSize){
+
+    if( filterSize == 0 ){
+        errorLog << "addMovingAverage(UINT filterSize) - FilterSize must be greater than zero!" << endl;
+        return false;
+    }
+
+    if( filterSize > MAX_MOVING_AVERAGE_SIZE ){
+        warningLog << "addMovingAverage(UINT filterSize) - The filterSize (" << filterSize << ") is larger than MAX_MOVING_AVERAGE_SIZE (" << MAX_MOVING_AVERAGE_SIZE << "), it should be filtered directly" << endl;
+        return false;
+    }
+
+    //A moving average of one sample passes the input straight through
+    if( filterSize == 1 ) return reset();
+
+    //The sum of the last N samples is 1 + z^-1 + ... + z^-(N-1), which has its zeros at the Nth roots of unity (except 1).
+    //Each conjugate pair of zeros gives one second order section, if N is even the zero at -1 gives a first order section.
+    const double N = filterSize;
+    for(UINT k=1; 2*k<filterSize; k++){
+        addSecondOrderSection( 1, -2*cos(2*PI*k/N), 1, 0, 0 );
+    }
+    if( filterSize % 2 == 0 ){
+        addFirstOrderSection( 1, 1, 0 );
+    }
+
+    //Divide the sum by the number of samples in the moving average
+    addNormalization( filterSize );
+
+    return reset();
+}
+
+bool FilterCascade::clearSections(){
+    sections.clear();
+    unpairedSectionIndex = 0;
+    maxNormalizationLength = 0;
+    return reset();
+}
+
+void FilterCascade::addNormalization(UINT normalizationLength){
+
+    sections.back().normalizationLength = normalizationLength;
+    if( normalizationLength > maxNormalizationLength ) maxNormalizationLength = normalizationLength;
+
+    //The normalization is not time invariant during the warm up, so no later section can be paired with one before it
+    unpairedSectionIndex = (UINT)sections.size();
+}
+
+void FilterCascade::computeOutput(const double *x,double *y){
+
+    const UINT N = numInputDimensions;
+    const UINT numSections = (UINT)sections.size();
+
+    if( numSamples < maxNormalizationLength ) numSamples++;
+
+    if( y != x ) std::copy( x, x+N, y );
+
+    //Run each section over all the dimensions, so the inner loop has no dependency between iterations
+    for(UINT k=0; k<numSections; k++){
+        const FilterCascadeSection &section = sections[k];
+        double *z1 = &s1[ k*N ];
+        double *z2 = &s2[ k*N ];
+        UINT n = 0;
+#ifdef GRT_SSE2_ENABLED
+        const __m128d b0 = _mm_set1_pd( section.b0 );
+        const __m128d b1 = _mm_set1_pd( section.b1 );
+        const __m128d b2 = _mm_set1_pd( section.b2 );
+        const __m128d a1 = _mm_set1_pd( section.a1 );
+        const __m128d a2 = _mm_set1_pd( section.a2 );
+        for(; n+2<=N; n+=2){
+            const __m128d in = _mm_loadu_pd( y+n );
+            const __m128d out = _mm_add_pd( _mm_mul_pd( b0, in ), _mm_loadu_pd( z1+n ) );
+            _mm_storeu_pd( z1+n, _mm_add_pd( _mm_sub_pd( _mm_mul_pd( b1, in ), _mm_mul_pd( a1, out ) ), _mm_loadu_pd( z2+n ) ) );
+            _mm_storeu_pd( z2+n, _mm_sub_pd( _mm_mul_pd( b2, in ), _mm_mul_pd( a2, out ) ) );
+            _mm_storeu_pd( y+n, out );
+        }
+#endif
+        for(; n<N; n++){
+            const double in = y[n];
+            const double out = section.b0 * in + z1[n];
+            z1[n] = section.b1 * in - section.a1 * out + z2[n];
+            z2[n] = section.b2 * in - section.a2 * out;
+            y[n] = out;
+        }
+        if( section.normalizationLength > 0 ){
+            const double scale = 1.0 / ( numSamples < section.normalizationLength ? numSamples : section.normalizationLength );
+            for(n=0; n<N; n++){
+                y[n] *= scale;
+            }
+        }
+    }
+}
+
+}//End of namespace GRT
@@ -0,0 +1,273 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The FilterCascade class implements a linear filter as a cascade of second order sections (biquads).
+
+ A chain of linear time invariant PreProcessing modules, such as LowPassFilter -> Derivative -> HighPassFilter, can be
+ replaced by one FilterCascade that gives the same output. Each module appends its own transfer function to the cascade
+ (see PreProcessing::appendToFilterCascade), and the first order sections of neighbouring modules are paired into second
+ order sections. GestureRecognitionPipeline::fusePreProcessingModules uses this to fuse the pre processing modules of a
+ pipeline, which removes the buffers, virtual calls and vector copies of the separate modules.
+
+ Each section filters all the dimensions in one loop, using the transposed direct form II:
+ y[n] = b0*x[n] + s1, s1 = b1*x[n] - a1*y[n] + s2, s2 = b2*x[n] - a2*y[n].
+
+ A MovingAverageFilter divides its sum by the number of samples it has seen until it is full, so a moving average adds
+ a normalization to the section it ends on, which divides the output of that section by min(numSamples,filterSize). This
+ keeps the output of the cascade identical to that of the modules during the warm up, not just once the filters are full.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_FILTER_CASCADE_HEADER
+#define GRT_FILTER_CASCADE_HEADER
+
+#include "../CoreModules/PreProcessing.h"
+
+namespace GRT{
+
+class FilterCascadeSection{
+public:
+    FilterCascadeSection(double b0=1,double b1=0,double b2=0,double a1=0,double a2=0,UINT normalizationLength=0){
+        this->b0 = b0;
+        this->b1 = b1;
+        this->b2 = b2;
+        this->a1 = a1;
+        this->a2 = a2;
+        this->normalizationLength = normalizationLength;
+    }
+
+    double b0,b1,b2;            ///< The numerator coefficients
+    double a1,a2;               ///< The denominator coefficients, a0 is always 1
+    UINT normalizationLength;   ///< If this is not zero the output is divided by min(numSamples,normalizationLength)
+};
+
+class FilterCascade : public PreProcessing{
+public:
+    /**
+     Constructor, sets the dimensionality of the filter. The cascade is empty (i.e. it passes the input straight
+     through) until sections are added to it.
+
+     @param UINT numDimensions: the dimensionality of the input data to filter.  Default numDimensions = 1
+     */
+    FilterCascade(UINT numDimensions = 1);
+
+    /**
+     Copy Constructor, copies the FilterCascade from the rhs instance to this instance
+
+	 @param const FilterCascade &rhs: another instance of the FilterCascade class from which the data will be copied to this instance
+     */
+    FilterCascade(const FilterCascade &rhs);
+
+    /**
+     Default Destructor
+     */
+	virtual ~FilterCascade();
+
+    /**
+     Sets the equals operator, copies the data from the rhs instance to this instance
+
+	 @param const FilterCascade &rhs: another instance of the FilterCascade class from which the data will be copied to this instance
+	 @return a reference to this instance of FilterCascade
+     */
+	FilterCascade& operator=(const FilterCascade &rhs);
+
+    /**
+     Sets the PreProcessing deepCopyFrom function, overwriting the base PreProcessing function.
+     This function is used to deep copy the values from the input pointer to this instance of the PreProcessing module.
+     This function is called by the GestureRecognitionPipeline when the user adds a new PreProcessing module to the pipeline.
+
+	 @param const PreProcessing *preProcessing: a pointer to another instance of a FilterCascade, the values of that instance will be cloned to this instance
+	 @return true if the deep copy was successful, false otherwise
+     */
+    virtual bool deepCopyFrom(const PreProcessing *preProcessing);
+
+    /**
+     Sets the PreProcessing process function, overwriting the base PreProcessing function.
+     This function is called by the GestureRecognitionPipeline when any new input data needs to be processed (during the prediction phase for example).
+     This function calls the FilterCascade's filter function.
+
+	 @param const VectorDouble &inputVector: the inputVector that should be processed.  Must have the same dimensionality as the PreProcessing module
+	 @return true if the data was processed, false otherwise
+     */
+    virtual bool process(const VectorDouble &inputVector);
+
+    /**
+     Filters a block of samples, with one sample per row. This gives the same result as calling process for each row.
+
+     @param const MatrixDouble &inputData: the samples that should be filtered, with one sample per row
+     @param MatrixDouble &outputData: returns the filtered samples, with one sample per row
+     @return returns true if the block was filtered, false otherwise
+     */
+    virtual bool processBlock(const MatrixDouble &inputData,MatrixDouble &outputData);
+
+    /**
+     Sets the PreProcessing reset function, overwriting the base PreProcessing function.
+     This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
+     This function sets the state of every section to zero.
+
+	 @return true if the filter was reset, false otherwise
+     */
+    virtual bool reset();
+
+    /**
+     Appends the sections of this cascade to another cascade, so cascades can themselves be fused.
+
+     @param FilterCascade &cascade: the cascade the sections will be appended to
+     @return returns true if the sections were appended, false otherwise
+     */
+    virtual bool appendToFilterCascade(FilterCascade &cascade) const;
+
+    /**
+     This saves the current settings of the FilterCascade to a file.
+     This overrides the saveModelToFile function in the PreProcessing base class.
+
+     @param string filename: the name of the file to save the settings to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveModelToFile(string filename) const;
+
+    /**
+     This saves the current settings of the FilterCascade to a file.
+     This overrides the saveModelToFile function in the PreProcessing base class.
+
+     @param fstream &file: a reference to the file the settings will be saved to
+     @return returns true if the settings were saved successfully, false otherwise
+     */
+    virtual bool saveModelToFile(fstream &file) const;
+
+    /**
+     This loads the FilterCascade settings from a file.
+     This overrides the loadModelFromFile function in the PreProcessing base class.
+
+     @param string filename: the name of the file to load the settings from
+     @return returns true if the settings were loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromFile(string filename);
+
+    /**
+     This loads the FilterCascade settings from a file.
+     This overrides the loadModelFromFile function in the PreProcessing base class.
+
+     @param fstream &file: a reference to the file to load the settings from
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromFile(fstream &file);
+
+    /**
+     Initializes the filter, setting the dimensionality of the data it will filter. The sections are kept, but the
+     state of every section is set to zero.
+
+     @param UINT numDimensions: the dimensionality of the data to filter
+	 @return true if the filter was initiliazed, false otherwise
+     */
+    bool init(UINT numDimensions);
+
+    /**
+     Filters the input, this should only be called if the dimensionality of the filter was set to 1.
+
+     @param const double x: the value to filter, this should only be called if the dimensionality of the filter was set to 1
+	 @return the filtered value.  Zero will be returned if the value was not filtered
+     */
+    double filter(const double x);
+
+    /**
+     Filters the input, the dimensionality of the input vector should match that of the filter.
+
+     @param const VectorDouble &x: the values to filter, the dimensionality of the input vector should match that of the filter
+	 @return the filtered values.  An empty vector will be returned if the values were not filtered
+     */
+    VectorDouble filter(const VectorDouble &x);
+
+    /**
+     Adds a first order section, y[n] = b0*x[n] + b1*x[n-1] - a1*y[n-1], to the end of the cascade. If the previous
+     first order section has not been paired yet the two are multiplied into one second order section.
+     This will also reset the filter.
+
+     @return returns true if the section was added, false otherwise
+     */
+    bool addFirstOrderSection(double b0,double b1,double a1);
+
+    /**
+     Adds a second order section, y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2], to the end of the cascade.
+     This will also reset the filter.
+
+     @return returns true if the section was added, false otherwise
+     */
+    bool addSecondOrderSection(double b0,double b1,double b2,double a1,double a2);
+
+    /**
+     Adds a moving average of filterSize samples to the end of the cascade, with the same output (including the warm
+     up) as a MovingAverageFilter. The sum of the last filterSize samples is factored into second order sections with
+     their zeros on the unit circle, so the cost grows with the filterSize, which must not be larger than
+     MAX_MOVING_AVERAGE_SIZE. This will also reset the filter.
+
+     @param UINT filterSize: the size of the moving average
+     @return returns true if the moving average was added, false otherwise
+     */
+    bool addMovingAverage(UINT filterSize);
+
+    /**
+     Removes all the sections, the cascade then passes the input straight through.
+     This will also reset the filter.
+
+     @return returns true if the sections were removed, false otherwise
+     */
+    bool clearSections();
+
+    /**
+     @return returns the number of sections in the cascade
+     */
+    UINT getNumSections() const { return (UINT)sections.size(); }
+
+    /**
+     @return returns the sections in the cascade, in the order they are applied
+     */
+    vector< FilterCascadeSection > getSections() const { return sections; }
+
+    /**
+     Returns the last value(s) that were filtered.
+
+	 @return the filtered values.  An empty vector will be returned if the values were not filtered
+     */
+    VectorDouble getFilteredValues(){ if( initialized ){ return processedData; } return vector< double >(); }
+
+    enum{ MAX_MOVING_AVERAGE_SIZE = 32 };
+
+protected:
+    void addNormalization(UINT normalizationLength);
+    void computeOutput(const double *x,double *y);
+
+    vector< FilterCascadeSection > sections;    ///< The sections, in the order they are applied
+    UINT unpairedSectionIndex;                  ///< The index of the first order section that can still be paired, or the number of sections if there is none
+    UINT numSamples;                            ///< The number of samples since the last reset, this stops counting at the longest normalization length
+    UINT maxNormalizationLength;
+    VectorDouble s1;                            ///< The first state of each section, numSections*numInputDimensions values
+    VectorDouble s2;                            ///< The second state of each section
+
+    static RegisterPreProcessingModule< FilterCascade > registerModule;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_FILTER_CASCADE_HEADER
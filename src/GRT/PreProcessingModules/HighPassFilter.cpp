@@ -19,6 +19,7 @@
  */
 
 #include "HighPassFilter.h"
+#include "FilterCascade.h"
 
 namespace GRT{
     
@@ -116,6 +117,11 @@ bool HighPassFilter::reset(){
     return false;
 }
     
+bool HighPassFilter::appendToFilterCascade(FilterCascade &cascade) const{
+    if( !initialized ) return false;
+    return cascade.addFirstOrderSection( filterFactor * gain, -filterFactor * gain, -filterFactor * gain );
+}
+    
 bool HighPassFilter::saveModelToFile(string filename) const{
     
     if( !initialized ){
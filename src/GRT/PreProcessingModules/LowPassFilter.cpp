@@ -19,6 +19,7 @@
  */
 
 #include "LowPassFilter.h"
+#include "FilterCascade.h"
 
 namespace GRT{
     
@@ -103,6 +104,11 @@ bool LowPassFilter::reset(){
     return false;
 }
     
+bool LowPassFilter::appendToFilterCascade(FilterCascade &cascade) const{
+    if( !initialized ) return false;
+    return cascade.addFirstOrderSection( filterFactor, 0, -(1.0 - filterFactor) * gain );
+}
+    
 bool LowPassFilter::saveModelToFile(string filename) const{
     
     if( !initialized ){
@@ -101,6 +101,15 @@ public:
      */
     virtual bool reset();
     
+    /**
+     Appends the filter to a FilterCascade, overwriting the base PreProcessing function.
+     The filter is y[n] = filterFactor*x[n] + (1-filterFactor)*gain*y[n-1], which is one first order section.
+     
+     @param FilterCascade &cascade: the cascade the filter will be appended to
+     @return returns true if the filter was appended to the cascade, false otherwise
+     */
+    virtual bool appendToFilterCascade(FilterCascade &cascade) const;
+    
     /**
      This saves the current settings of the LowPassFilter to a file.
      This overrides the saveModelToFile function in the PreProcessing base class.
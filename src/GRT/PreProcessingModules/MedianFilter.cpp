@@ -66,6 +66,7 @@ MedianFilter& MedianFilter::operator=(const MedianFilter &rhs){
         if( rhs.initialized ){
             this->init( rhs.filterSize, rhs.numInputDimensions );
             this->dataBuffer = rhs.dataBuffer;
+            this->windows = rhs.windows;
         }
         
         //Copy the preprocessing base variables
@@ -237,6 +238,10 @@ bool MedianFilter::init(UINT filterSize,UINT numDimensions){
     processedData.resize(numDimensions,0);
     initialized = dataBuffer.resize( filterSize, VectorDouble(numInputDimensions,0) );
     
+    //Setup the sorted windows used to compute the median of each dimension
+    windows.clear();
+    windows.resize( numDimensions, SlidingWindowOrderStatistics( filterSize ) );
+    
     if( !initialized ){
         errorLog << "init(UINT filterSize,UINT numDimensions) - Failed to resize dataBuffer!" << endl;
     }
@@ -270,17 +275,10 @@ VectorDouble MedianFilter::filter(const VectorDouble &x){
     //Add the new value to the buffer
     dataBuffer.push_back( x );
     
-    //Compute the median value for each dimension
-    vector< double > tmp( inputSampleCounter );
+    //Compute the median value for each dimension, each window is kept sorted so this does not require sorting the buffer
     for(unsigned int j=0; j<numInputDimensions; j++){
-        for(unsigned int i=0; i<inputSampleCounter; i++) {
-            tmp[i] = dataBuffer[i][j];
-        }
-        std::sort(tmp.begin(),tmp.end());
-        
-        //Get the median value
-        unsigned int medianIndex = (inputSampleCounter/2);
-        processedData[j] = tmp[ medianIndex ];
+        windows[j].push( x[j] );
+        processedData[j] = windows[j].getMedian();
     }
     
     return processedData;
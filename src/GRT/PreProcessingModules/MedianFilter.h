@@ -32,6 +32,7 @@
 #define GRT_MEDIAN_FILTER_HEADER
 
 #include "../CoreModules/PreProcessing.h"
+#include "../Util/SlidingWindowOrderStatistics.h"
 
 namespace GRT{
 
@@ -183,6 +184,7 @@ protected:
     UINT filterSize;                                        ///< The size of the filter
     UINT inputSampleCounter;                                ///< A counter to keep track of the number of input samples
     CircularBuffer< VectorDouble > dataBuffer;          	///< A buffer to store the previous N values, N = filterSize
+    vector< SlidingWindowOrderStatistics > windows;         ///< The sorted window of the previous N values for each dimension
     
     static RegisterPreProcessingModule< MedianFilter > registerModule;
 };
@@ -19,6 +19,7 @@
  */
 
 #include "MovingAverageFilter.h"
+#include "FilterCascade.h"
 
 namespace GRT{
     
@@ -60,12 +61,12 @@ MovingAverageFilter& MovingAverageFilter::operator=(const MovingAverageFilter &r
         //Clear this instance
         this->filterSize = 0;
         this->inputSampleCounter = 0;
-        this->dataBuffer.clear();
+        this->filterBank.clear();
         
         //Copy from the rhs instance
         if( rhs.initialized ){
             this->init( rhs.filterSize, rhs.numInputDimensions );
-            this->dataBuffer = rhs.dataBuffer;
+            this->filterBank = rhs.filterBank;
         }
         
         //Copy the preprocessing base variables
@@ -110,12 +111,49 @@ bool MovingAverageFilter::process(const VectorDouble &inputVector){
 
     return false;
 }
+    
+bool MovingAverageFilter::processBlock(const MatrixDouble &inputData,MatrixDouble &outputData){
+    
+    if( !initialized ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - The filter has not been initialized!" << endl;
+        return false;
+    }
+    
+    if( inputData.getNumRows() == 0 ) return true;
+    
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - The number of columns in the inputData (" << inputData.getNumCols() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    //Sum the last filterSize values of each dimension, then divide the sums by the number of values seen so far
+    if( !filterBank.processBlock( inputData, outputData ) ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - Failed to filter the block!" << endl;
+        return false;
+    }
+    
+    const UINT M = outputData.getNumRows();
+    for(UINT i=0; i<M; i++){
+        if( ++inputSampleCounter > filterSize ) inputSampleCounter = filterSize;
+        for(UINT j=0; j<numInputDimensions; j++){
+            outputData[i][j] /= double(inputSampleCounter);
+        }
+    }
+    if( M > 0 ) std::copy( outputData[M-1], outputData[M-1] + numInputDimensions, processedData.begin() );
+    
+    return true;
+}
 
 bool MovingAverageFilter::reset(){
     if( initialized ) return init(filterSize,numInputDimensions);
     return false;
 }
     
+bool MovingAverageFilter::appendToFilterCascade(FilterCascade &cascade) const{
+    if( !initialized || filterSize > FilterCascade::MAX_MOVING_AVERAGE_SIZE ) return false;
+    return cascade.addMovingAverage( filterSize );
+}
+    
 bool MovingAverageFilter::saveModelToFile(string filename) const{
     
     if( !initialized ){
@@ -235,10 +273,10 @@ bool MovingAverageFilter::init(UINT filterSize,UINT numDimensions){
     this->numOutputDimensions = numDimensions;
     processedData.clear();
     processedData.resize(numDimensions,0);
-    initialized = dataBuffer.resize( filterSize, VectorDouble(numInputDimensions,0) );
+    initialized = filterBank.init( VectorDouble(filterSize,1), numDimensions );
     
     if( !initialized ){
-        errorLog << "init(UINT filterSize,UINT numDimensions) - Failed to resize dataBuffer!" << endl;
+        errorLog << "init(UINT filterSize,UINT numDimensions) - Failed to init the filter bank!" << endl;
     }
     
     return initialized;
@@ -273,14 +311,10 @@ VectorDouble MovingAverageFilter::filter(const VectorDouble &x){
     
     if( ++inputSampleCounter > filterSize ) inputSampleCounter = filterSize;
     
-    //Add the new value to the buffer
-    dataBuffer.push_back( x );
+    //Add the new value to the buffer and sum the buffer, the values that have not been filled yet are zero
+    filterBank.filter( &x[0], &processedData[0] );
     
     for(unsigned int j=0; j<numInputDimensions; j++){
-        processedData[j] = 0;
-        for(unsigned int i=0; i<inputSampleCounter; i++) {
-            processedData[j] += dataBuffer[i][j];
-        }
         processedData[j] /= double(inputSampleCounter);
     }
     
@@ -32,6 +32,7 @@
 #define GRT_MOVING_AVERAGE_FILTER_HEADER
 
 #include "../CoreModules/PreProcessing.h"
+#include "../Util/FilterBank.h"
 
 namespace GRT{
 
@@ -85,6 +86,16 @@ public:
      */
     virtual bool process(const VectorDouble &inputVector);
     
+    /**
+     Sets the PreProcessing processBlock function, overwriting the base PreProcessing function.
+     This filters a block of samples at once, with one sample per row.
+     
+	 @param const MatrixDouble &inputData: the samples that should be filtered, the number of columns must match the dimensionality of the filter
+	 @param MatrixDouble &outputData: returns the filtered samples
+	 @return true if the data was processed, false otherwise
+     */
+    virtual bool processBlock(const MatrixDouble &inputData,MatrixDouble &outputData);
+    
     /**
      Sets the PreProcessing reset function, overwriting the base PreProcessing function.
      This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
@@ -94,6 +105,15 @@ public:
      */
     virtual bool reset();
     
+    /**
+     Appends the filter to a FilterCascade, overwriting the base PreProcessing function.
+     The filter can not be appended if the filterSize is larger than FilterCascade::MAX_MOVING_AVERAGE_SIZE.
+     
+     @param FilterCascade &cascade: the cascade the filter will be appended to
+     @return returns true if the filter was appended to the cascade, false otherwise
+     */
+    virtual bool appendToFilterCascade(FilterCascade &cascade) const;
+    
     /**
      This saves the current settings of the MovingAverageFilter to a file.
      This overrides the saveModelToFile function in the PreProcessing base class.
@@ -172,7 +192,7 @@ public:
 protected:
     UINT filterSize;                                        ///< The size of the filter
     UINT inputSampleCounter;                                ///< A counter to keep track of the number of input samples
-    CircularBuffer< VectorDouble > dataBuffer;          	///< A buffer to store the previous N values, N = filterSize
+    FilterBank filterBank;                                  ///< Stores the previous N values, N = filterSize, and sums them for each dimension
     
     static RegisterPreProcessingModule< MovingAverageFilter > registerModule;
 };
@@ -0,0 +1,213 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+ 
+ @brief The PercentileFilter implements a rolling percentile filter, which outputs the given percentile of the last N values
+ of each dimension. A percentile of 0 gives a rolling minimum filter, a percentile of 100 gives a rolling maximum filter and
+ a percentile of 50 gives the same result as the MedianFilter.
+ 
+ */
+
+/**
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_PERCENTILE_FILTER_HEADER
+#define GRT_PERCENTILE_FILTER_HEADER
+
+#include "../CoreModules/PreProcessing.h"
+#include "../Util/SlidingWindowOrderStatistics.h"
+
+namespace GRT{
+
+class PercentileFilter : public PreProcessing {
+public:
+    /**
+     Constructor, sets the size of the percentile filter and the dimensionality of the data it will filter.
+	 
+     @param UINT filterSize: the size of the percentile filter, should be a value greater than zero. Default filterSize = 5
+     @param UINT numDimensions: the dimensionality of the data to filter.  Default numDimensions = 1
+     */
+    PercentileFilter(UINT filterSize = 5,double percentile = 50,UINT numDimensions = 1);
+    
+    /**
+     Copy Constructor, copies the PercentileFilter from the rhs instance to this instance
+     
+	 @param const PercentileFilter &rhs: another instance of the PercentileFilter class from which the data will be copied to this instance
+     */
+    PercentileFilter(const PercentileFilter &rhs);
+
+    /**
+     Default Destructor
+     */
+    virtual ~PercentileFilter();
+    
+    /**
+     Sets the equals operator, copies the data from the rhs instance to this instance
+     
+	 @param const PercentileFilter &rhs: another instance of the PercentileFilter class from which the data will be copied to this instance
+	 @return a reference to this instance of PercentileFilter
+     */
+    PercentileFilter& operator=(const PercentileFilter &rhs);
+    
+    /**
+     Sets the PreProcessing deepCopyFrom function, overwriting the base PreProcessing function.
+     This function is used to deep copy the values from the input pointer to this instance of the PreProcessing module.
+     This function is called by the GestureRecognitionPipeline when the user adds a new PreProcessing module to the pipeline.
+     
+	 @param const PreProcessing *preProcessing: a pointer to another instance of a PercentileFilter, the values of that instance will be cloned to this instance
+	 @return true if the deep copy was successful, false otherwise
+     */
+    virtual bool deepCopyFrom(const PreProcessing *preProcessing);
+    
+    /**
+     Sets the PreProcessing process function, overwriting the base PreProcessing function.
+     This function is called by the GestureRecognitionPipeline when any new input data needs to be processed (during the prediction phase for example).
+     This function calls the PercentileFilter's filter function.
+     
+	 @param const VectorDouble &inputVector: the inputVector that should be processed.  Must have the same dimensionality as the PreProcessing module
+	 @return true if the data was processed, false otherwise
+     */
+    virtual bool process(const VectorDouble &inputVector);
+    
+    /**
+     Sets the PreProcessing reset function, overwriting the base PreProcessing function.
+     This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
+     This function resets the filter values by re-initiliazing the filter.
+     
+	 @return true if the filter was reset, false otherwise
+     */
+    virtual bool reset();
+    
+    /**
+     This saves the current settings of the PercentileFilter to a file.
+     This overrides the saveModelToFile function in the PreProcessing base class.
+     
+     @param string filename: the name of the file to save the settings to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveModelToFile(string filename) const;
+    
+    /**
+     This saves the current settings of the PercentileFilter to a file.
+     This overrides the saveModelToFile function in the PreProcessing base class.
+     
+     @param fstream &file: a reference to the file the settings will be saved to
+     @return returns true if the settings were saved successfully, false otherwise
+     */
+    virtual bool saveModelToFile(fstream &file) const;
+    
+    /**
+     This loads the PercentileFilter settings from a file.
+     This overrides the loadModelFromFile function in the PreProcessing base class.
+     
+     @param string filename: the name of the file to load the settings from
+     @return returns true if the settings were loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromFile(string filename);
+    
+    /**
+     This loads the PercentileFilter settings from a file.
+     This overrides the loadModelFromFile function in the PreProcessing base class.
+     
+     @param fstream &file: a reference to the file to load the settings from
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromFile(fstream &file);
+    
+    /**
+     Initializes the filter, setting the filter size, percentile and dimensionality of the data it will filter.
+     Sets all the filter values to zero.
+     
+     @param UINT filterSize: the size of the percentile filter, should be a value greater than zero
+     @param double percentile: the percentile the filter will output, should be in the range [0 100]
+     @param UINT numDimensions: the dimensionality of the data to filter
+	 @return true if the filter was initiliazed, false otherwise
+     */
+    bool init(UINT filterSize,double percentile,UINT numDimensions);
+    
+    /**
+     Filters the input, this should only be called if the dimensionality of the filter was set to 1.
+     
+     @param double x: the value to filter, this should only be called if the dimensionality of the filter was set to 1
+	 @return the filtered value.  Zero will be returned if the value was not filtered
+     */
+    double filter(const double x);
+    
+    /**
+     Filters the input, the dimensionality of the input vector should match that of the filter.
+     
+     @param const VectorDouble  &x: the values to filter, the dimensionality of the input vector should match that of the filter
+	 @return the filtered values.  An empty vector will be returned if the values were not filtered
+     */
+    VectorDouble filter(const VectorDouble &x);
+
+	/**
+     Gets the current filter size.
+     
+     @return returns the filter size
+     */
+	UINT getFilterSize() const { return filterSize; }
+    
+    /**
+     Gets the current percentile.
+     
+     @return returns the percentile
+     */
+    double getPercentile() const { return percentile; }
+    
+    /**
+     Sets the percentile the filter will output, this does not reset the filter.
+     
+     @param double percentile: the new percentile, should be in the range [0 100]
+     @return returns true if the percentile was updated, false otherwise
+     */
+    bool setPercentile(double percentile);
+    
+    /**
+     Returns the last value(s) that were filtered.
+     
+	 @return the filtered values.  An empty vector will be returned if the values were not filtered
+     */
+    VectorDouble getFilteredData() const { return processedData; }
+    
+    /**
+     Returns the current data in the dataBuffer.
+     This will be a [N M] vector of VectorDoubles, where N is the number of dimensions in the filter and M is the
+     size of the buffer.
+     If the filter has not been initialized then an empty vector will be returned.
+     
+	 @return the current data in the dataBuffer
+     */
+    vector< VectorDouble > getDataBuffer() const;
+    
+protected:
+    UINT filterSize;                                        ///< The size of the filter
+    double percentile;                                      ///< The percentile the filter outputs, in the range [0 100]
+    UINT inputSampleCounter;                                ///< A counter to keep track of the number of input samples
+    CircularBuffer< VectorDouble > dataBuffer;          	///< A buffer to store the previous N values, N = filterSize
+    vector< SlidingWindowOrderStatistics > windows;         ///< The sorted window of the previous N values for each dimension
+    
+    static RegisterPreProcessingModule< PercentileFilter > registerModule;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_PERCENTILE_FILTER_HEADER
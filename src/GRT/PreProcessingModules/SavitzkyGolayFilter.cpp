@@ -42,7 +42,7 @@ SavitzkyGolayFilter::SavitzkyGolayFilter(const SavitzkyGolayFilter &rhs){
     this->numRightHandPoints = rhs.numRightHandPoints;
     this->derivativeOrder = rhs.derivativeOrder;
     this->smoothingPolynomialOrder = rhs.smoothingPolynomialOrder;
-    this->data = rhs.data;
+    this->filterBank = rhs.filterBank;
     this->yy = rhs.yy;
     this->coeff = rhs.coeff;
     
@@ -66,7 +66,7 @@ SavitzkyGolayFilter& SavitzkyGolayFilter::operator=(const SavitzkyGolayFilter &r
         this->numRightHandPoints = rhs.numRightHandPoints;
         this->derivativeOrder = rhs.derivativeOrder;
         this->smoothingPolynomialOrder = rhs.smoothingPolynomialOrder;
-        this->data = rhs.data;
+        this->filterBank = rhs.filterBank;
         this->yy = rhs.yy;
         this->coeff = rhs.coeff;
         copyBaseVariables( (PreProcessing*)&rhs );
@@ -88,7 +88,7 @@ bool SavitzkyGolayFilter::deepCopyFrom(const PreProcessing *preProcessing){
         this->numRightHandPoints = ptr->numRightHandPoints;
         this->derivativeOrder = ptr->derivativeOrder;
         this->smoothingPolynomialOrder = ptr->smoothingPolynomialOrder;
-        this->data = ptr->data;
+        this->filterBank = ptr->filterBank;
         this->yy = ptr->yy;
         this->coeff = ptr->coeff;
         
@@ -119,10 +119,35 @@ bool SavitzkyGolayFilter::process(const VectorDouble &inputVector){
     return false;
 
 }
+    
+bool SavitzkyGolayFilter::processBlock(const MatrixDouble &inputData,MatrixDouble &outputData){
+    
+    if( !initialized ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - Not initialized!" << endl;
+        return false;
+    }
+    
+    if( inputData.getNumRows() == 0 ) return true;
+    
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - The number of columns in the inputData (" << inputData.getNumCols() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    if( !filterBank.processBlock( inputData, outputData ) ){
+        errorLog << "processBlock(const MatrixDouble &inputData,MatrixDouble &outputData) - Failed to filter the block!" << endl;
+        return false;
+    }
+    
+    const UINT M = outputData.getNumRows();
+    if( M > 0 ) std::copy( outputData[M-1], outputData[M-1] + numInputDimensions, processedData.begin() );
+    
+    return true;
+}
 
 bool SavitzkyGolayFilter::reset(){
     if( initialized ){
-        data.setAllValues(VectorDouble(numInputDimensions,0));
+        filterBank.reset();
         yy.clear();
         yy.resize(numInputDimensions,0);
         processedData.clear();
@@ -286,13 +311,22 @@ bool SavitzkyGolayFilter::init(UINT numLeftHandPoints,UINT numRightHandPoints,UI
     yy.resize(numDimensions,0);
     processedData.clear();
     processedData.resize(numDimensions,0);
-    data.resize(numPoints,vector<double>(numDimensions,0));
     
     if( !calCoeff() ){
         errorLog << "init(UINT NL,UINT NR,UINT LD,UINT M,UINT numDimensions) - Failed to compute filter coefficents!" << endl;
         return false;
     }
     
+    //The coefficients are ordered from the oldest input to the newest input, the filter bank expects the newest first
+    VectorDouble filterCoeff( numPoints );
+    for(UINT i=0; i<numPoints; i++){
+        filterCoeff[i] = coeff[ numPoints-1-i ];
+    }
+    if( !filterBank.init( filterCoeff, numDimensions ) ){
+        errorLog << "init(UINT NL,UINT NR,UINT LD,UINT M,UINT numDimensions) - Failed to init the filter bank!" << endl;
+        return false;
+    }
+    
     initialized = true;
     
     return true;
@@ -324,15 +358,8 @@ VectorDouble SavitzkyGolayFilter::filter(const VectorDouble &x){
         return VectorDouble();
     }
     
-    //Add the new input data to the data buffer
-    data.push_back( x );
-    
-    //Filter the data
-    for(UINT j=0; j<x.size(); j++){
-        processedData[j] = 0;
-        for(UINT i=0; i<numPoints; i++) 
-            processedData[j] += data[i][j] * coeff[i];
-    }
+    //Add the new input data to the data buffer and filter the data
+    filterBank.filter( &x[0], &processedData[0] );
     
     return processedData;
 }
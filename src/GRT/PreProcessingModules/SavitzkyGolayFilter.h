@@ -33,6 +33,7 @@
 
 #include "../CoreModules/PreProcessing.h"
 #include "../Util/LUDecomposition.h"
+#include "../Util/FilterBank.h"
 
 namespace GRT{
     
@@ -89,6 +90,16 @@ public:
      */
     virtual bool process(const VectorDouble &inputVector);
     
+    /**
+     Sets the PreProcessing processBlock function, overwriting the base PreProcessing function.
+     This filters a block of samples at once, with one sample per row.
+     
+	 @param const MatrixDouble &inputData: the samples that should be filtered, the number of columns must match the dimensionality of the filter
+	 @param MatrixDouble &outputData: returns the filtered samples
+	 @return true if the data was processed, false otherwise
+     */
+    virtual bool processBlock(const MatrixDouble &inputData,MatrixDouble &outputData);
+    
     /**
      Sets the PreProcessing reset function, overwriting the base PreProcessing function.
      This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
@@ -175,7 +186,7 @@ protected:
 	UINT numRightHandPoints;                     //Num of rightward (future) points to use
 	UINT derivativeOrder;                        //Order of the derivative desired
 	UINT smoothingPolynomialOrder;               //Order of smoothing polynomial
-    CircularBuffer< VectorDouble > data;    //A buffer to hold the input data
+    FilterBank filterBank;                  //Holds the input data and runs the filter over each dimension
     VectorDouble yy;                       //The filtered values
     VectorDouble coeff;                    //Buffer for the filter coefficients
     
@@ -229,9 +229,6 @@ bool MLP::init(const UINT numInputNeurons,
     
     //Clear any previous models
     clear();
-
-	//Initialize the random seed
-	random.setSeed( (UINT)time(NULL) );
     
     if( numInputNeurons == 0 || numHiddenNeurons == 0 || numOutputNeurons == 0 ){
         if( numInputNeurons == 0 ){  errorLog << "init(...) - The number of input neurons is zero!" << endl; }
@@ -267,19 +264,19 @@ bool MLP::init(const UINT numInputNeurons,
     
     //Init the neuron memory for each of the layers
     for(UINT i=0; i<numInputNeurons; i++){
-        inputLayer[i].init(1,inputLayerActivationFunction);
+        inputLayer[i].init(1,inputLayerActivationFunction,random);
         inputLayer[i].weights[0] = 1.0; //The weights for the input layer should always be 1
 		inputLayer[i].bias = 0.0; //The bias for the input layer should always be 0
 		inputLayer[i].gamma = gamma;
     }
     
     for(UINT i=0; i<numHiddenNeurons; i++){
-        hiddenLayer[i].init(numInputNeurons,hiddenLayerActivationFunction);
+        hiddenLayer[i].init(numInputNeurons,hiddenLayerActivationFunction,random);
 		hiddenLayer[i].gamma = gamma;
     }
     
     for(UINT i=0; i<numOutputNeurons; i++){
-        outputLayer[i].init(numHiddenNeurons,outputLayerActivationFunction);
+        outputLayer[i].init(numHiddenNeurons,outputLayerActivationFunction,random);
 		outputLayer[i].gamma = gamma;
     }
     
@@ -326,7 +323,7 @@ bool MLP::trainModel(RegressionData &trainingData){
     //Create a validation dataset, if needed
 	RegressionData validationData;
 	if( useValidationSet ){
-		validationData = trainingData.partition( 100 - validationSetSize );
+		validationData = trainingData.partition( 100 - validationSetSize, random );
 	}
 
     const UINT N = trainingData.getNumInputDimensions();
@@ -538,7 +538,6 @@ protected:
 	double gamma;
     double trainingError;
     bool initialized;
-    Random random;
     
     vector< Neuron > inputLayer;
     vector< Neuron > hiddenLayer;
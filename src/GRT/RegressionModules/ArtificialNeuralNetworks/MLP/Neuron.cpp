@@ -32,7 +32,7 @@ Neuron::Neuron(){
 
 Neuron::~Neuron(){}
 
-bool Neuron::init(const UINT numInputs,const UINT activationFunction){
+bool Neuron::init(const UINT numInputs,const UINT activationFunction,Random &random){
     
     if( !validateActivationFunction(activationFunction) ){
         return false;
@@ -44,10 +44,6 @@ bool Neuron::init(const UINT numInputs,const UINT activationFunction){
     weights.resize(numInputs);
 	previousUpdate.resize(numInputs);
     
-    //Set the random seed
-    Random random;
-    random.setSeed( (unsigned long long)time(NULL) );
-    
     //Randomise the weights between [-0.1 0.1]
     //Note, it's better to set the random values using small weights rather than [-1.0 1.0]
     for(unsigned int i=0; i<numInputs; i++){
@@ -40,7 +40,7 @@ public:
     Neuron();
     ~Neuron();
     
-    bool init(const UINT numInputs,const UINT actvationFunction);
+    bool init(const UINT numInputs,const UINT actvationFunction,Random &random);
     void clear();
     double fire(const VectorDouble &x);
 	double getDerivative(const double &y);
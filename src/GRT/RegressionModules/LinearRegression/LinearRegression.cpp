@@ -33,6 +33,8 @@ LinearRegression::LinearRegression(bool useScaling)
     minChange = 1.0e-5;
     maxNumEpochs = 500;
     learningRate = 0.01;
+    trainingMethod = NORMAL_EQUATIONS;
+    regularization = 1.0e-8;
     classType = "LinearRegression";
     regressifierType = classType;
     debugLog.setProceedingText("[DEBUG LinearRegression]");
@@ -47,6 +49,8 @@ LinearRegression::~LinearRegression(void)
     
 LinearRegression& LinearRegression::operator=(const LinearRegression &rhs){
 	if( this != &rhs ){
+        this->trainingMethod = rhs.trainingMethod;
+        this->regularization = rhs.regularization;
         this->w0 = rhs.w0;
         this->w = rhs.w;
         
@@ -64,6 +68,8 @@ bool LinearRegression::deepCopyFrom(const Regressifier *regressifier){
         
         const LinearRegression *ptr = dynamic_cast<const LinearRegression*>(regressifier);
 
+        this->trainingMethod = ptr->trainingMethod;
+        this->regularization = ptr->regularization;
         this->w0 = ptr->w0;
         this->w = ptr->w;
         
@@ -108,13 +114,20 @@ bool LinearRegression::train_(RegressionData &trainingData){
 		trainingData.scale(inputVectorRanges,targetVectorRanges,0.0,1.0);
 	}
     
-    //Reset the weights
-    Random rand;
-    w0 = rand.getRandomNumberUniform(-0.1,0.1);
-    w.resize(N);
-    for(UINT j=0; j<N; j++){
-        w[j] = rand.getRandomNumberUniform(-0.1,0.1);
+    if( trainingMethod == NORMAL_EQUATIONS ){
+        if( !solveNormalEquations( trainingData ) ){
+            return false;
+        }
+        
+        //Flag that the algorithm has been trained
+        regressionData.resize(1,0);
+        trained = true;
+        return trained;
     }
+    
+    //Reset the weights
+    w0 = random.getRandomNumberUniform(-0.1,0.1);
+    w = random.getRandomVectorUniform(N,-0.1,0.1);
 
     double error = 0;
     double lastError = 0;
@@ -131,7 +144,7 @@ bool LinearRegression::train_(RegressionData &trainingData){
     for(UINT i=0; i<M; i++){
         randomTrainingOrder[i] = i;
     }
-    std::random_shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
+    random.shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
     
     //Run the main stochastic gradient descent training algorithm
     while( keepTraining ){
@@ -311,6 +324,82 @@ bool LinearRegression::loadModelFromFile(fstream &file){
     return true;
 }
 
+bool LinearRegression::solveNormalEquations( const RegressionData &trainingData ){
+    
+    const UINT M = trainingData.getNumSamples();
+    const UINT N = trainingData.getNumInputDimensions();
+    const UINT P = N+1;
+    
+    //Accumulate the upper triangle of X'X and X'y in one pass over the data, where each row of X is the input vector with a leading 1 for the bias
+    MatrixDouble A(P,P);
+    A.setAllValues(0);
+    VectorDouble b(P,0);
+    VectorDouble x(P);
+    x[0] = 1;
+    for(UINT i=0; i<M; i++){
+        const VectorDouble &input = trainingData[i].getInputVector();
+        const double y = trainingData[i].getTargetVector()[0];
+        for(UINT j=0; j<N; j++) x[j+1] = input[j];
+        for(UINT j=0; j<P; j++){
+            const double xj = x[j];
+            double *a = A[j];
+            for(UINT k=j; k<P; k++) a[k] += xj * x[k];
+            b[j] += xj * y;
+        }
+    }
+    for(UINT j=0; j<P; j++)
+        for(UINT k=0; k<j; k++)
+            A[j][k] = A[k][j];
+    
+    //Add the ridge penalty to the weights, the bias is not penalized
+    for(UINT j=1; j<P; j++){
+        A[j][j] += regularization;
+    }
+    
+    Cholesky cholesky( A );
+    if( !cholesky.getSuccess() ){
+        errorLog << "train_(RegressionData &trainingData) - Failed to solve the normal equations, the input dimensions may be constant or linearly dependent. Try increasing the regularization value." << endl;
+        return false;
+    }
+    
+    VectorDouble theta(P);
+    cholesky.solve(b,theta);
+    w0 = theta[0];
+    w.resize(N);
+    for(UINT j=0; j<N; j++){
+        w[j] = theta[j+1];
+    }
+    
+    //Compute the training error of the solution
+    totalSquaredTrainingError = 0;
+    for(UINT i=0; i<M; i++){
+        const VectorDouble &input = trainingData[i].getInputVector();
+        double h = w0;
+        for(UINT j=0; j<N; j++){
+            h += input[j] * w[j];
+        }
+        totalSquaredTrainingError += SQR( trainingData[i].getTargetVector()[0] - h );
+    }
+    
+    if( grt_isinf( totalSquaredTrainingError ) || grt_isnan( totalSquaredTrainingError ) ){
+        errorLog << "train_(RegressionData &trainingData) - Training failed! Total squared training error is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue." << endl;
+        return false;
+    }
+    
+    //Store the training results
+    TrainingResult result;
+    rootMeanSquaredTrainingError = sqrt( totalSquaredTrainingError / double(M) );
+    result.setRegressionResult(1,totalSquaredTrainingError,rootMeanSquaredTrainingError,this);
+    trainingResults.push_back( result );
+    
+    //Notify any observers of the new result
+    trainingResultsObserverManager.notifyObservers( result );
+    
+    trainingLog << "Normal Equations SSE: " << totalSquaredTrainingError << endl;
+    
+    return true;
+}
+
 bool LinearRegression::setMaxNumIterations(const UINT maxNumIterations){
     return setMaxNumEpochs( maxNumIterations );
 }
@@ -319,6 +408,31 @@ UINT LinearRegression::getMaxNumIterations() const{
     return getMaxNumEpochs();
 }
     
+UINT LinearRegression::getTrainingMethod() const{
+    return trainingMethod;
+}
+    
+double LinearRegression::getRegularization() const{
+    return regularization;
+}
+    
+bool LinearRegression::setTrainingMethod(const UINT trainingMethod){
+    if( trainingMethod == STOCHASTIC_GRADIENT_DESCENT || trainingMethod == NORMAL_EQUATIONS ){
+        this->trainingMethod = trainingMethod;
+        return true;
+    }
+    warningLog << "setTrainingMethod(const UINT trainingMethod) - Unknown training method: " << trainingMethod << endl;
+    return false;
+}
+    
+bool LinearRegression::setRegularization(const double regularization){
+    if( regularization >= 0 ){
+        this->regularization = regularization;
+        return true;
+    }
+    return false;
+}
+    
 bool LinearRegression::loadLegacyModelFromFile( fstream &file ){
     
     string word;
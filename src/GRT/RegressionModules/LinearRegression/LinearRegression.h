@@ -121,13 +121,52 @@ public:
      */
     bool setMaxNumIterations(const UINT maxNumIterations);
     
+    /**
+     Gets the method used to train the model, this will be one of the TrainingMethods enums.
+     
+     @return returns the training method
+     */
+    UINT getTrainingMethod() const;
+    
+    /**
+     Gets the ridge regularization value used by the NORMAL_EQUATIONS training method.
+     
+     @return returns the regularization value
+     */
+    double getRegularization() const;
+    
+    /**
+     Sets the method used to train the model, this should be one of the TrainingMethods enums. NORMAL_EQUATIONS (the default)
+     solves for the least squares weights directly in one pass over the training data, STOCHASTIC_GRADIENT_DESCENT
+     uses the learningRate, minChange and maxNumEpochs settings to iteratively update the weights.
+     
+     @param const UINT trainingMethod: the new training method
+     @return returns true if the training method was updated, false otherwise
+     */
+    bool setTrainingMethod(const UINT trainingMethod);
+    
+    /**
+     Sets the ridge regularization value used by the NORMAL_EQUATIONS training method. This penalizes the squared size of
+     the weights (but not the bias), which keeps the solution stable if some of the input dimensions are constant or
+     linearly dependent. The value must be greater than or equal to zero.
+     
+     @param const double regularization: the new regularization value
+     @return returns true if the regularization value was updated, false otherwise
+     */
+    bool setRegularization(const double regularization);
+    
     //Tell the compiler we are using the base class train method to stop hidden virtual function warnings
     using MLBase::saveModelToFile;
     using MLBase::loadModelFromFile;
 
+    enum TrainingMethods{ STOCHASTIC_GRADIENT_DESCENT=0, NORMAL_EQUATIONS };
+
 protected:
     bool loadLegacyModelFromFile( fstream &file );
+    bool solveNormalEquations( const RegressionData &trainingData );
     
+    UINT trainingMethod;
+    double regularization;
     double w0;
     VectorDouble w;
     static RegisterRegressifierModule< LinearRegression > registerModule;
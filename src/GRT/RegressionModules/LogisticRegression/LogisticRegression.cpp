@@ -26,6 +26,53 @@ namespace GRT{
 
 //Register the LogisticRegression module with the Classifier base class
 RegisterRegressifierModule< LogisticRegression >  LogisticRegression::registerModule("LogisticRegression");
+    
+//The cross entropy of the logistic model plus an L2 penalty on the weights, theta[0] is the bias. The training data is packed
+//into one row-major array, so each evaluation is a single pass over contiguous memory
+class LogisticRegressionObjective : public LBFGSObjective{
+public:
+    LogisticRegressionObjective(const VectorDouble &X,const VectorDouble &y,const UINT N,const double regularization):X(X),y(y),N(N),regularization(regularization){
+        sumSquaredError = 0;
+    }
+    
+    virtual double evaluate(const VectorDouble &theta,VectorDouble &gradient){
+        const UINT M = (UINT)y.size();
+        double cost = 0;
+        sumSquaredError = 0;
+        std::fill(gradient.begin(),gradient.end(),0);
+        for(UINT i=0; i<M; i++){
+            const double *x = &X[i*N];
+            double z = theta[0];
+            for(UINT j=0; j<N; j++) z += x[j] * theta[j+1];
+            
+            //log(1+exp(z)) - y*z, written so it does not overflow for large |z|
+            cost += (z > 0 ? z : 0) + log( 1.0 + exp( -fabs(z) ) ) - y[i] * z;
+            
+            const double error = 1.0 / (1.0 + exp(-z)) - y[i];
+            sumSquaredError += error * error;
+            gradient[0] += error;
+            for(UINT j=0; j<N; j++) gradient[j+1] += error * x[j];
+        }
+        cost /= M;
+        for(UINT j=0; j<=N; j++) gradient[j] /= M;
+        for(UINT j=1; j<=N; j++){
+            cost += 0.5 * regularization * theta[j] * theta[j];
+            gradient[j] += regularization * theta[j];
+        }
+        return cost;
+    }
+    
+    virtual void iterationCompleted(const UINT iteration,const double value){
+        iterationErrors.push_back( sumSquaredError );
+    }
+    
+    const VectorDouble &X;
+    const VectorDouble &y;
+    const UINT N;
+    const double regularization;
+    double sumSquaredError;
+    vector< double > iterationErrors;
+};
 
 LogisticRegression::LogisticRegression(const bool useScaling)
 {
@@ -33,6 +80,8 @@ LogisticRegression::LogisticRegression(const bool useScaling)
     minChange = 1.0e-5;
     maxNumEpochs = 500;
     learningRate = 0.01;
+    trainingMethod = LBFGS;
+    regularization = 1.0e-4;
     classType = "LogisticRegression";
     regressifierType = classType;
     debugLog.setProceedingText("[DEBUG LogisticRegression]");
@@ -47,6 +96,8 @@ LogisticRegression::~LogisticRegression(void)
     
 LogisticRegression& LogisticRegression::operator=(const LogisticRegression &rhs){
 	if( this != &rhs ){
+        this->trainingMethod = rhs.trainingMethod;
+        this->regularization = rhs.regularization;
         this->w0 = rhs.w0;
         this->w = rhs.w;
         
@@ -63,6 +114,8 @@ bool LogisticRegression::deepCopyFrom(const Regressifier *regressifier){
     if( this->getRegressifierType() == regressifier->getRegressifierType() ){
         const LogisticRegression *ptr = dynamic_cast<const LogisticRegression*>(regressifier);
         
+        this->trainingMethod = ptr->trainingMethod;
+        this->regularization = ptr->regularization;
         this->w0 = ptr->w0;
         this->w = ptr->w;
         
@@ -107,20 +160,26 @@ bool LogisticRegression::train_(RegressionData &trainingData){
 		trainingData.scale(inputVectorRanges,targetVectorRanges,0.0,1.0);
 	}
     
-    //Reset the weights
-    Random rand;
-    w0 = rand.getRandomNumberUniform(-0.1,0.1);
-    w.resize(N);
-    for(UINT j=0; j<N; j++){
-        w[j] = rand.getRandomNumberUniform(-0.1,0.1);
+    if( trainingMethod == LBFGS ){
+        if( !trainLBFGS( trainingData ) ){
+            return false;
+        }
+        
+        //Flag that the algorithm has been trained
+        regressionData.resize(1,0);
+        trained = true;
+        return trained;
     }
+    
+    //Reset the weights
+    w0 = random.getRandomNumberUniform(-0.1,0.1);
+    w = random.getRandomVectorUniform(N,-0.1,0.1);
 
     double error = 0;
     double lastSquaredError = 0;
     double delta = 0;
     UINT iter = 0;
     bool keepTraining = true;
-    Random random;
     vector< UINT > randomTrainingOrder(M);
     TrainingResult result;
     trainingResults.reserve(M);
@@ -131,7 +190,7 @@ bool LogisticRegression::train_(RegressionData &trainingData){
     for(UINT i=0; i<M; i++){
         randomTrainingOrder[i] = i;
     }
-    std::random_shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
+    random.shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
     
     //Run the main stochastic gradient descent training algorithm
     while( keepTraining ){
@@ -315,6 +374,53 @@ bool LogisticRegression::loadModelFromFile(fstream &file){
     return true;
 }
 
+bool LogisticRegression::trainLBFGS( const RegressionData &trainingData ){
+    
+    const UINT M = trainingData.getNumSamples();
+    const UINT N = trainingData.getNumInputDimensions();
+    
+    //Pack the training data into one contiguous array
+    VectorDouble X(M*N);
+    VectorDouble y(M);
+    for(UINT i=0; i<M; i++){
+        const VectorDouble &input = trainingData[i].getInputVector();
+        std::copy(input.begin(),input.end(),X.begin()+i*N);
+        y[i] = trainingData[i].getTargetVector()[0];
+    }
+    
+    //The cost is convex, so the weights can start at zero
+    VectorDouble theta(N+1,0);
+    LogisticRegressionObjective objective(X,y,N,regularization);
+    LBFGSOptimizer optimizer;
+    if( !optimizer.minimize(objective,theta,maxNumEpochs,minChange) ){
+        errorLog << "train_(RegressionData &trainingData) - Training failed! The cost could not be computed. If scaling is not enabled then you should try to scale your data and see if this solves the issue." << endl;
+        return false;
+    }
+    
+    w0 = theta[0];
+    w.resize(N);
+    for(UINT j=0; j<N; j++){
+        w[j] = theta[j+1];
+    }
+    
+    //Store the training results of each iteration
+    TrainingResult result;
+    trainingResults.reserve( objective.iterationErrors.size() );
+    for(UINT iter=0; iter<objective.iterationErrors.size(); iter++){
+        totalSquaredTrainingError = objective.iterationErrors[iter];
+        rootMeanSquaredTrainingError = sqrt( totalSquaredTrainingError / double(M) );
+        result.setRegressionResult(iter+1,totalSquaredTrainingError,rootMeanSquaredTrainingError,this);
+        trainingResults.push_back( result );
+        
+        //Notify any observers of the new result
+        trainingResultsObserverManager.notifyObservers( result );
+        
+        trainingLog << "Iteration: " << iter+1 << " SSE: " << totalSquaredTrainingError << endl;
+    }
+    
+    return true;
+}
+
 UINT LogisticRegression::getMaxNumIterations() const{
     return getMaxNumEpochs();
 }
@@ -323,6 +429,31 @@ bool LogisticRegression::setMaxNumIterations(const UINT maxNumIterations){
 return setMaxNumEpochs( maxNumIterations );
 }
 
+UINT LogisticRegression::getTrainingMethod() const{
+    return trainingMethod;
+}
+    
+double LogisticRegression::getRegularization() const{
+    return regularization;
+}
+    
+bool LogisticRegression::setTrainingMethod(const UINT trainingMethod){
+    if( trainingMethod == STOCHASTIC_GRADIENT_DESCENT || trainingMethod == LBFGS ){
+        this->trainingMethod = trainingMethod;
+        return true;
+    }
+    warningLog << "setTrainingMethod(const UINT trainingMethod) - Unknown training method: " << trainingMethod << endl;
+    return false;
+}
+    
+bool LogisticRegression::setRegularization(const double regularization){
+    if( regularization >= 0 ){
+        this->regularization = regularization;
+        return true;
+    }
+    return false;
+}
+    
 double LogisticRegression::sigmoid(const double x) const{
 	return 1.0 / (1 + exp(-x));
 }
@@ -121,14 +121,53 @@ public:
      */
     bool setMaxNumIterations(UINT maxNumIterations);
     
+    /**
+     Gets the method used to train the model, this will be one of the TrainingMethods enums.
+     
+     @return returns the training method
+     */
+    UINT getTrainingMethod() const;
+    
+    /**
+     Gets the L2 regularization value used by the LBFGS training method.
+     
+     @return returns the regularization value
+     */
+    double getRegularization() const;
+    
+    /**
+     Sets the method used to train the model, this should be one of the TrainingMethods enums. LBFGS (the default) minimizes
+     the cross entropy of the model using full passes over the training data, and normally converges in far fewer passes
+     than STOCHASTIC_GRADIENT_DESCENT. Both methods stop when the change in the error is less than minChange, or after maxNumEpochs.
+     
+     @param const UINT trainingMethod: the new training method
+     @return returns true if the training method was updated, false otherwise
+     */
+    bool setTrainingMethod(const UINT trainingMethod);
+    
+    /**
+     Sets the L2 regularization value used by the LBFGS training method. This penalizes the squared size of the weights
+     (but not the bias), which stops the weights growing without bound if the training data is linearly separable.
+     The value must be greater than or equal to zero.
+     
+     @param const double regularization: the new regularization value
+     @return returns true if the regularization value was updated, false otherwise
+     */
+    bool setRegularization(const double regularization);
+    
     //Tell the compiler we are using the base class train method to stop hidden virtual function warnings
     using MLBase::saveModelToFile;
     using MLBase::loadModelFromFile;
 
+    enum TrainingMethods{ STOCHASTIC_GRADIENT_DESCENT=0, LBFGS };
+
 protected:
 	inline double sigmoid(const double x) const;
     bool loadLegacyModelFromFile( fstream &file );
+    bool trainLBFGS( const RegressionData &trainingData );
 	
+    UINT trainingMethod;
+    double regularization;
     double w0;
     VectorDouble w;
     static RegisterRegressifierModule< LogisticRegression > registerModule;
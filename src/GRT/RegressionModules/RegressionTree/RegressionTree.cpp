@@ -625,7 +625,6 @@ bool RegressionTree::computeBestSpiltBestRandomSpilt( const RegressionData &trai
 bool RegressionTree::computeNodeRegressionData( const RegressionData &trainingData, VectorDouble &regressionData ){
     
     const UINT M = trainingData.getNumSamples();
-    const UINT N = trainingData.getNumInputDimensions();
     const UINT T = trainingData.getNumTargetDimensions();
     
     if( M == 0 ){
@@ -638,7 +637,7 @@ bool RegressionTree::computeNodeRegressionData( const RegressionData &trainingDa
     regressionData.resize( T, 0 );
     
     //The regression data at this node is simply an average over all the training data at this node
-    for(unsigned int j=0; j<N; j++){
+    for(unsigned int j=0; j<T; j++){
         for(unsigned int i=0; i<M; i++){
             regressionData[j] += trainingData[i].getTargetVector()[j];
         }
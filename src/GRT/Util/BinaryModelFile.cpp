@@ -0,0 +1,444 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "BinaryModelFile.h"
+
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GRT_BINARY_MODEL_FILE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace GRT{
+
+const char BinaryModelFile::magic[8] = {'G','R','T','_','B','I','N','\0'};
+
+static unsigned long long padToEightBytes(const unsigned long long size){
+    return (size + 7) & ~(unsigned long long)7;
+}
+
+//Copies numValues values of elementSize bytes, reversing the bytes of each value if the host is big endian
+static void copyLittleEndian(const char *source,char *target,const UINT elementSize,const unsigned long long numValues){
+    if( BinaryModelFile::isLittleEndianHost() || elementSize == 1 ){
+        memcpy( target, source, (size_t)(elementSize*numValues) );
+        return;
+    }
+    for(unsigned long long i=0; i<numValues; i++){
+        for(UINT j=0; j<elementSize; j++){
+            target[ i*elementSize + j ] = source[ i*elementSize + elementSize - 1 - j ];
+        }
+    }
+}
+
+static void writeUInt64(char *target,const unsigned long long value){
+    for(UINT j=0; j<8; j++) target[j] = (char)( (value >> (8*j)) & 0xFF );
+}
+
+static void writeUInt32(char *target,const UINT value){
+    for(UINT j=0; j<4; j++) target[j] = (char)( (value >> (8*j)) & 0xFF );
+}
+
+static unsigned long long readUInt64(const char *source){
+    unsigned long long value = 0;
+    for(UINT j=0; j<8; j++) value |= (unsigned long long)(unsigned char)source[j] << (8*j);
+    return value;
+}
+
+static UINT readUInt32(const char *source){
+    UINT value = 0;
+    for(UINT j=0; j<4; j++) value |= (UINT)(unsigned char)source[j] << (8*j);
+    return value;
+}
+
+bool BinaryModelFile::isBinaryModelFile(const string &filename){
+    std::fstream file;
+    file.open( filename.c_str(), std::ios::in | std::ios::binary );
+    if( !file.is_open() ) return false;
+
+    char header[8];
+    file.read( header, 8 );
+    const bool isBinary = file.gcount() == 8 && memcmp( header, magic, 8 ) == 0;
+    file.close();
+    return isBinary;
+}
+
+bool BinaryModelFile::isLittleEndianHost(){
+    const UINT one = 1;
+    return *(const unsigned char*)&one == 1;
+}
+
+//////////////////////////////// BinaryModelFileWriter ////////////////////////////////
+
+BinaryModelFileWriter::BinaryModelFileWriter(){
+    errorLog.setProceedingText("[ERROR BinaryModelFileWriter]");
+}
+
+BinaryModelFileWriter::~BinaryModelFileWriter(){
+}
+
+bool BinaryModelFileWriter::clear(){
+    sectionNames.clear();
+    sectionDataTypes.clear();
+    sectionOffsets.clear();
+    sectionNumValues.clear();
+    data.clear();
+    sectionIndexes.clear();
+    return true;
+}
+
+bool BinaryModelFileWriter::addUInt(const string &name,const UINT value){
+    return addSection( name, DATA_TYPE_UINT, &value, sizeof(UINT), 1 );
+}
+
+bool BinaryModelFileWriter::addBool(const string &name,const bool value){
+    return addUInt( name, value ? 1 : 0 );
+}
+
+bool BinaryModelFileWriter::addDouble(const string &name,const double value){
+    return addSection( name, DATA_TYPE_DOUBLE, &value, sizeof(double), 1 );
+}
+
+bool BinaryModelFileWriter::addString(const string &name,const string &value){
+    return addSection( name, DATA_TYPE_CHAR, value.c_str(), 1, (UINT)value.size() );
+}
+
+bool BinaryModelFileWriter::addUIntArray(const string &name,const vector< UINT > &values){
+    return addSection( name, DATA_TYPE_UINT, values.size() > 0 ? &values[0] : NULL, sizeof(UINT), (UINT)values.size() );
+}
+
+bool BinaryModelFileWriter::addDoubleArray(const string &name,const VectorDouble &values){
+    return addDoubleArray( name, values.size() > 0 ? &values[0] : NULL, (UINT)values.size() );
+}
+
+bool BinaryModelFileWriter::addDoubleArray(const string &name,const double *values,const UINT numValues){
+    return addSection( name, DATA_TYPE_DOUBLE, values, sizeof(double), numValues );
+}
+
+bool BinaryModelFileWriter::save(const string &filename) const{
+
+    std::fstream file;
+    file.open( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+
+    if( !file.is_open() ){
+        errorLog << "save(const string &filename) - Failed to open file: " << filename << endl;
+        return false;
+    }
+
+    const UINT numSections = getNumSections();
+    const unsigned long long sectionTableOffset = HEADER_SIZE + data.size();
+
+    char header[ HEADER_SIZE ];
+    memcpy( header, magic, 8 );
+    writeUInt32( header+8, FILE_FORMAT_VERSION );
+    writeUInt32( header+12, numSections );
+    writeUInt64( header+16, sectionTableOffset );
+    file.write( header, HEADER_SIZE );
+
+    if( data.size() > 0 ) file.write( &data[0], data.size() );
+
+    vector< char > entry;
+    for(UINT i=0; i<numSections; i++){
+        const UINT nameLength = (UINT)sectionNames[i].size();
+        entry.assign( 24 + padToEightBytes( nameLength ), 0 );
+        writeUInt32( &entry[0], nameLength );
+        writeUInt32( &entry[4], sectionDataTypes[i] );
+        writeUInt64( &entry[8], sectionOffsets[i] );
+        writeUInt64( &entry[16], sectionNumValues[i] );
+        memcpy( &entry[24], sectionNames[i].c_str(), nameLength );
+        file.write( &entry[0], entry.size() );
+    }
+
+    const bool writeOK = !file.fail();
+    file.close();
+
+    if( !writeOK ){
+        errorLog << "save(const string &filename) - Failed to write file: " << filename << endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool BinaryModelFileWriter::addSection(const string &name,const UINT dataType,const void *values,const UINT elementSize,const UINT numValues){
+
+    if( name.size() == 0 ){
+        errorLog << "addSection(...) - The section name must not be empty!" << endl;
+        return false;
+    }
+
+    if( sectionIndexes.find( name ) != sectionIndexes.end() ){
+        errorLog << "addSection(...) - There is already a section called " << name << endl;
+        return false;
+    }
+
+    const unsigned long long offset = HEADER_SIZE + data.size();
+    const unsigned long long numBytes = (unsigned long long)elementSize*numValues;
+
+    sectionIndexes[ name ] = getNumSections();
+    sectionNames.push_back( name );
+    sectionDataTypes.push_back( dataType );
+    sectionOffsets.push_back( offset );
+    sectionNumValues.push_back( numValues );
+
+    const size_t start = data.size();
+    data.resize( (size_t)(start + padToEightBytes( numBytes )), 0 );
+    if( numBytes > 0 ) copyLittleEndian( (const char*)values, &data[start], elementSize, numValues );
+
+    return true;
+}
+
+//////////////////////////////// BinaryModelFileReader ////////////////////////////////
+
+BinaryModelFileReader::BinaryModelFileReader(){
+    fileData = NULL;
+    fileSize = 0;
+    memoryMapped = false;
+    version = 0;
+    errorLog.setProceedingText("[ERROR BinaryModelFileReader]");
+}
+
+BinaryModelFileReader::~BinaryModelFileReader(){
+    close();
+}
+
+bool BinaryModelFileReader::open(const string &filename,const bool useMemoryMap){
+
+    close();
+
+#ifdef GRT_BINARY_MODEL_FILE_MMAP
+    if( useMemoryMap ){
+        const int fd = ::open( filename.c_str(), O_RDONLY );
+        if( fd < 0 ){
+            errorLog << "open(const string &filename,const bool useMemoryMap) - Failed to open file: " << filename << endl;
+            return false;
+        }
+        struct stat fileStatus;
+        if( fstat( fd, &fileStatus ) != 0 || fileStatus.st_size < HEADER_SIZE ){
+            ::close( fd );
+            errorLog << "open(const string &filename,const bool useMemoryMap) - The file is too small to be a binary model file: " << filename << endl;
+            return false;
+        }
+        void *mapping = mmap( NULL, (size_t)fileStatus.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        ::close( fd );
+        if( mapping == MAP_FAILED ){
+            errorLog << "open(const string &filename,const bool useMemoryMap) - Failed to memory map file: " << filename << endl;
+            return false;
+        }
+        fileData = (const char*)mapping;
+        fileSize = (unsigned long long)fileStatus.st_size;
+        memoryMapped = true;
+    }
+#endif
+
+    if( !memoryMapped ){
+        std::fstream file;
+        file.open( filename.c_str(), std::ios::in | std::ios::binary );
+        if( !file.is_open() ){
+            errorLog << "open(const string &filename,const bool useMemoryMap) - Failed to open file: " << filename << endl;
+            return false;
+        }
+        file.seekg( 0, std::ios::end );
+        const std::streamoff size = file.tellg();
+        file.seekg( 0, std::ios::beg );
+        if( size < HEADER_SIZE ){
+            errorLog << "open(const string &filename,const bool useMemoryMap) - The file is too small to be a binary model file: " << filename << endl;
+            return false;
+        }
+        //The buffer is allocated by operator new, so like a memory mapping its start is aligned for doubles
+        buffer.resize( (size_t)padToEightBytes( size ) );
+        file.read( &buffer[0], size );
+        if( file.gcount() != size ){
+            errorLog << "open(const string &filename,const bool useMemoryMap) - Failed to read file: " << filename << endl;
+            buffer.clear();
+            return false;
+        }
+        fileData = &buffer[0];
+        fileSize = (unsigned long long)size;
+    }
+
+    //Read the header
+    if( memcmp( fileData, magic, 8 ) != 0 ){
+        errorLog << "open(const string &filename,const bool useMemoryMap) - The file is not a binary model file: " << filename << endl;
+        close();
+        return false;
+    }
+
+    version = readUInt32( fileData+8 );
+    if( version != FILE_FORMAT_VERSION ){
+        errorLog << "open(const string &filename,const bool useMemoryMap) - Unsupported file format version: " << version << endl;
+        close();
+        return false;
+    }
+
+    const UINT numSections = readUInt32( fileData+12 );
+    unsigned long long position = readUInt64( fileData+16 );
+
+    //Every entry in the section table takes at least 24 bytes, so a section count that can not fit in the file is rejected
+    //before it is used. The checks below are written without adding to the values read from the file, so a corrupt
+    //position or length can not wrap around
+    if( position > fileSize || numSections > (fileSize-position)/24 ){
+        errorLog << "open(const string &filename,const bool useMemoryMap) - The section table is truncated!" << endl;
+        close();
+        return false;
+    }
+
+    //Read the section table, checking every section lies inside the file
+    for(UINT i=0; i<numSections; i++){
+        if( position > fileSize || fileSize - position < 24 ){
+            errorLog << "open(const string &filename,const bool useMemoryMap) - The section table is truncated!" << endl;
+            close();
+            return false;
+        }
+        const UINT nameLength = readUInt32( fileData+position );
+        Section section;
+        section.dataType = readUInt32( fileData+position+4 );
+        section.offset = readUInt64( fileData+position+8 );
+        section.numValues = readUInt64( fileData+position+16 );
+        position += 24;
+
+        UINT elementSize = 0;
+        switch( section.dataType ){
+            case DATA_TYPE_UINT: elementSize = 4; break;
+            case DATA_TYPE_DOUBLE: elementSize = 8; break;
+            case DATA_TYPE_CHAR: elementSize = 1; break;
+            default: break;
+        }
+
+        if( elementSize == 0 || fileSize - position < nameLength || section.offset > fileSize || section.numValues > (fileSize-section.offset)/elementSize ){
+            errorLog << "open(const string &filename,const bool useMemoryMap) - Section " << i << " is invalid!" << endl;
+            close();
+            return false;
+        }
+
+        sections[ string( fileData+position, nameLength ) ] = section;
+        position += padToEightBytes( nameLength );
+    }
+
+    return true;
+}
+
+bool BinaryModelFileReader::close(){
+#ifdef GRT_BINARY_MODEL_FILE_MMAP
+    if( memoryMapped && fileData != NULL ){
+        munmap( (void*)fileData, (size_t)fileSize );
+    }
+#endif
+    fileData = NULL;
+    fileSize = 0;
+    memoryMapped = false;
+    version = 0;
+    buffer.clear();
+    sections.clear();
+    return true;
+}
+
+bool BinaryModelFileReader::getUInt(const string &name,UINT &value) const{
+    const Section *section = getSection( name, DATA_TYPE_UINT );
+    if( section == NULL ) return false;
+    if( section->numValues != 1 ){
+        errorLog << "getUInt(const string &name,UINT &value) - Section " << name << " does not hold a single value!" << endl;
+        return false;
+    }
+    readValues( *section, sizeof(UINT), &value );
+    return true;
+}
+
+bool BinaryModelFileReader::getBool(const string &name,bool &value) const{
+    UINT x = 0;
+    if( !getUInt( name, x ) ) return false;
+    value = x != 0;
+    return true;
+}
+
+bool BinaryModelFileReader::getDouble(const string &name,double &value) const{
+    const Section *section = getSection( name, DATA_TYPE_DOUBLE );
+    if( section == NULL ) return false;
+    if( section->numValues != 1 ){
+        errorLog << "getDouble(const string &name,double &value) - Section " << name << " does not hold a single value!" << endl;
+        return false;
+    }
+    readValues( *section, sizeof(double), &value );
+    return true;
+}
+
+bool BinaryModelFileReader::getString(const string &name,string &value) const{
+    const Section *section = getSection( name, DATA_TYPE_CHAR );
+    if( section == NULL ) return false;
+    value.assign( fileData + section->offset, (size_t)section->numValues );
+    return true;
+}
+
+bool BinaryModelFileReader::getUIntArray(const string &name,vector< UINT > &values) const{
+    const Section *section = getSection( name, DATA_TYPE_UINT );
+    if( section == NULL ) return false;
+    values.resize( (size_t)section->numValues );
+    if( values.size() > 0 ) readValues( *section, sizeof(UINT), &values[0] );
+    return true;
+}
+
+bool BinaryModelFileReader::getDoubleArray(const string &name,VectorDouble &values) const{
+    const Section *section = getSection( name, DATA_TYPE_DOUBLE );
+    if( section == NULL ) return false;
+    values.resize( (size_t)section->numValues );
+    if( values.size() > 0 ) readValues( *section, sizeof(double), &values[0] );
+    return true;
+}
+
+const double* BinaryModelFileReader::getDoubleArrayPointer(const string &name,UINT &numValues) const{
+    numValues = 0;
+    if( !isLittleEndianHost() ) return NULL;
+    const Section *section = getSection( name, DATA_TYPE_DOUBLE );
+    if( section == NULL ) return NULL;
+    //The sections are written on 8 byte boundaries, so this only fails for a corrupt file
+    if( section->offset % 8 != 0 ) return NULL;
+    numValues = (UINT)section->numValues;
+    return (const double*)(fileData + section->offset);
+}
+
+const BinaryModelFileReader::Section* BinaryModelFileReader::getSection(const string &name,const UINT dataType) const{
+
+    if( fileData == NULL ){
+        errorLog << "getSection(const string &name,const UINT dataType) - The file is not open!" << endl;
+        return NULL;
+    }
+
+    std::map< string, Section >::const_iterator iter = sections.find( name );
+    if( iter == sections.end() ){
+        errorLog << "getSection(const string &name,const UINT dataType) - Failed to find section " << name << endl;
+        return NULL;
+    }
+
+    if( iter->second.dataType != dataType ){
+        errorLog << "getSection(const string &name,const UINT dataType) - Section " << name << " has the wrong data type!" << endl;
+        return NULL;
+    }
+
+    return &iter->second;
+}
+
+void BinaryModelFileReader::readValues(const Section &section,const UINT elementSize,void *values) const{
+    copyLittleEndian( fileData + section.offset, (char*)values, elementSize, section.numValues );
+}
+
+}//End of namespace GRT
@@ -0,0 +1,212 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The BinaryModelFileWriter and BinaryModelFileReader classes write and read the versioned binary model format
+ used by GestureRecognitionPipeline::savePipelineToBinaryFile and the saveModelToBinaryFile functions of the modules.
+
+ A binary model file is a list of named sections, each of which holds an array of UINT, double or char values. Every
+ value is stored in little endian order and every section starts on an 8 byte boundary, so on a little endian host an
+ array of doubles can be used directly from the file without being parsed or copied. Modules name their sections with
+ a prefix (such as "Classifier/"), so the sections of all the modules of a pipeline can be stored in one file.
+
+ The layout of the file is:
+ - a 24 byte header: the magic "GRT_BIN" (8 bytes including the terminating zero), the UINT format version, the UINT
+   number of sections and the 64 bit offset of the section table
+ - the section data, each section padded to a multiple of 8 bytes
+ - the section table, with one entry per section: the UINT length of the name, the UINT data type, the 64 bit offset of
+   the data, the 64 bit number of elements and then the name, padded to a multiple of 8 bytes
+
+ The reader can memory map the file (on POSIX systems), in which case the sections are read straight from the mapping
+ and only the pages that are actually used are loaded from disk. On other systems the file is read into memory.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_BINARY_MODEL_FILE_HEADER
+#define GRT_BINARY_MODEL_FILE_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+class BinaryModelFile{
+public:
+    enum DataTypes{ DATA_TYPE_UINT=1, DATA_TYPE_DOUBLE=2, DATA_TYPE_CHAR=3 };
+    enum{ HEADER_SIZE = 24, FILE_FORMAT_VERSION = 1 };
+
+    /**
+     Checks if a file starts with the binary model file magic.
+
+     @param const string &filename: the name of the file to check
+     @return returns true if the file is a binary model file, false otherwise
+     */
+    static bool isBinaryModelFile(const string &filename);
+
+    /**
+     @return returns true if the host stores values in little endian order, in which case no values need to be swapped
+     */
+    static bool isLittleEndianHost();
+
+protected:
+    static const char magic[8];
+};
+
+class BinaryModelFileWriter : public BinaryModelFile{
+public:
+    /**
+     Default Constructor.
+     */
+    BinaryModelFileWriter();
+
+    /**
+     Default Destructor.
+     */
+    ~BinaryModelFileWriter();
+
+    /**
+     Removes all the sections that have been added to the writer.
+
+     @return returns true if the writer was cleared
+     */
+    bool clear();
+
+    bool addUInt(const string &name,const UINT value);
+    bool addBool(const string &name,const bool value);
+    bool addDouble(const string &name,const double value);
+    bool addString(const string &name,const string &value);
+    bool addUIntArray(const string &name,const vector< UINT > &values);
+    bool addDoubleArray(const string &name,const VectorDouble &values);
+
+    /**
+     Adds an array of doubles to the file.
+
+     @param const string &name: the name of the section, this must not already be used by another section
+     @param const double *values: a pointer to the first value
+     @param const UINT numValues: the number of values
+     @return returns true if the section was added, false otherwise
+     */
+    bool addDoubleArray(const string &name,const double *values,const UINT numValues);
+
+    /**
+     Writes the header, all the sections and the section table to a file.
+
+     @param const string &filename: the name of the file to write
+     @return returns true if the file was written, false otherwise
+     */
+    bool save(const string &filename) const;
+
+    UINT getNumSections() const { return (UINT)sectionNames.size(); }
+
+protected:
+    bool addSection(const string &name,const UINT dataType,const void *values,const UINT elementSize,const UINT numValues);
+
+    vector< string > sectionNames;
+    vector< UINT > sectionDataTypes;
+    vector< unsigned long long > sectionOffsets;
+    vector< unsigned long long > sectionNumValues;
+    vector< char > data;                ///< The data of all the sections, already in little endian order, data[0] is at offset HEADER_SIZE in the file
+    std::map< string, UINT > sectionIndexes;
+
+    ErrorLog errorLog;
+};
+
+class BinaryModelFileReader : public BinaryModelFile{
+public:
+    /**
+     Default Constructor.
+     */
+    BinaryModelFileReader();
+
+    /**
+     Default Destructor, closes the file.
+     */
+    ~BinaryModelFileReader();
+
+    /**
+     Opens a binary model file and reads its section table.
+
+     @param const string &filename: the name of the file to open
+     @param const bool useMemoryMap: if true the file is memory mapped, otherwise (or if memory mapping is not supported) it is read into memory. Default useMemoryMap = true
+     @return returns true if the file was opened, false otherwise
+     */
+    bool open(const string &filename,const bool useMemoryMap = true);
+
+    /**
+     Closes the file, any pointers returned by getDoubleArrayPointer are no longer valid after this.
+
+     @return returns true if the file was closed
+     */
+    bool close();
+
+    bool getIsOpen() const { return fileData != NULL; }
+    bool getIsMemoryMapped() const { return memoryMapped; }
+    UINT getVersion() const { return version; }
+    UINT getNumSections() const { return (UINT)sections.size(); }
+    bool hasSection(const string &name) const { return sections.find( name ) != sections.end(); }
+
+    bool getUInt(const string &name,UINT &value) const;
+    bool getBool(const string &name,bool &value) const;
+    bool getDouble(const string &name,double &value) const;
+    bool getString(const string &name,string &value) const;
+    bool getUIntArray(const string &name,vector< UINT > &values) const;
+    bool getDoubleArray(const string &name,VectorDouble &values) const;
+
+    /**
+     Gets a pointer to an array of doubles in the file, so the values can be used without being copied. This is only
+     possible on a little endian host, on other hosts NULL is returned and getDoubleArray should be used instead. The
+     pointer is valid until the file is closed.
+
+     @param const string &name: the name of the section
+     @param UINT &numValues: returns the number of values in the section
+     @return returns a pointer to the first value, or NULL if the section does not exist or can not be used in place
+     */
+    const double* getDoubleArrayPointer(const string &name,UINT &numValues) const;
+
+protected:
+    class Section{
+    public:
+        UINT dataType;
+        unsigned long long offset;
+        unsigned long long numValues;
+    };
+
+    const Section* getSection(const string &name,const UINT dataType) const;
+    void readValues(const Section &section,const UINT elementSize,void *values) const;
+
+    const char *fileData;
+    unsigned long long fileSize;
+    bool memoryMapped;
+    UINT version;
+    vector< char > buffer;              ///< Holds the file if it is not memory mapped
+    std::map< string, Section > sections;
+
+    ErrorLog errorLog;
+
+private:
+    BinaryModelFileReader(const BinaryModelFileReader &rhs);
+    BinaryModelFileReader& operator=(const BinaryModelFileReader &rhs);
+};
+
+}//End of namespace GRT
+
+#endif //GRT_BINARY_MODEL_FILE_HEADER
@@ -8,6 +8,9 @@
  its elements shuffled around each time a new element is added.  The circular buffer therefore works well
  for FIFO (first in first out) buffers.
  
+ The MultiChannelCircularBuffer class is a circular buffer for samples with a fixed number of channels. It mirrors its
+ storage so the buffer window is always contiguous and can be read without a modulo or a copy.
+ 
  @example UtilExamples/CircularBufferExample/CircularBufferExample.cpp
  */
 
@@ -35,6 +38,7 @@
 #define GRT_CIRCULAR_BUFFER_HEADER
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include "ErrorLog.h"
 using namespace std;
 
@@ -348,6 +352,330 @@ protected:
     ErrorLog errorLog;
 };
 
+/**
+ The MultiChannelCircularBuffer class is a circular buffer for samples with a fixed number of channels, such as the
+ VectorDouble samples buffered by the DTW, FFT and TimeDomainFeatures modules. The samples are stored in one contiguous
+ block of doubles, one row of numChannels values per sample, and the block is mirrored: each sample is written both to
+ row writePtr and to row writePtr+bufferSize. The buffer window (the bufferSize rows starting at the read pointer) is
+ therefore always contiguous, so operator[] returns a pointer to a row without a modulo, and the whole window can be
+ read from getWindow() with a stride of numChannels.
+
+ The read and write pointers work in exactly the same way as those of the CircularBuffer, so the two classes can be
+ swapped without changing the order in which the samples are accessed.
+ */
+class MultiChannelCircularBuffer{
+    public:
+    
+    /**
+     Default Constructor
+     */
+    MultiChannelCircularBuffer(){
+        errorLog.setProceedingText("[ERROR: MultiChannelCircularBuffer]");
+        bufferSize = 0;
+        numChannels = 0;
+        numValuesInBuffer = 0;
+        readPtr = 0;
+        writePtr = 0;
+        bufferInit = false;
+    }
+    
+    /**
+     Copy Constructor. Deep copies the data from the rhs instance to this instance
+     
+     @param const MultiChannelCircularBuffer &rhs: ths instance the data and settings will be copied from
+     */
+    MultiChannelCircularBuffer(const MultiChannelCircularBuffer &rhs){
+        errorLog.setProceedingText("[ERROR: MultiChannelCircularBuffer]");
+        *this = rhs;
+    }
+    
+    /**
+     Init Constructor. Resizes the buffer to bufferSize samples of numChannels values, all set to zero.
+     
+     @param const unsigned int bufferSize: sets the number of samples in the buffer
+     @param const unsigned int numChannels: sets the number of values in each sample
+     */
+    MultiChannelCircularBuffer(const unsigned int bufferSize,const unsigned int numChannels){
+        errorLog.setProceedingText("[ERROR: MultiChannelCircularBuffer]");
+        bufferInit = false;
+        resize(bufferSize,numChannels);
+    }
+    
+    /**
+     Default Destructor.
+     */
+    ~MultiChannelCircularBuffer(){
+    }
+    
+    /**
+     Sets the equals operator. Defines how the data will be copied from the rhs instance to this instance.
+     
+     @param const MultiChannelCircularBuffer &rhs: the instance the data will be copied from
+     @return returns a reference to this instance
+     */
+    MultiChannelCircularBuffer& operator=(const MultiChannelCircularBuffer &rhs){
+        if(this!=&rhs){
+            this->bufferSize = rhs.bufferSize;
+            this->numChannels = rhs.numChannels;
+            this->numValuesInBuffer = rhs.numValuesInBuffer;
+            this->readPtr = rhs.readPtr;
+            this->writePtr = rhs.writePtr;
+            this->buffer = rhs.buffer;
+            this->bufferInit = rhs.bufferInit;
+        }
+        return *this;
+    }
+    
+    /**
+     This is the main access operator and will return the sample at the index relative to the current read pointer.
+     
+     @param const unsigned int index: the index of the sample you want access to, should be in the range [0 bufferSize-1]
+     @return returns a pointer to the numChannels values of the sample
+     */
+    inline const double* operator[](const unsigned int index) const{
+        return &buffer[ (readPtr + index) * numChannels ];
+    }
+    
+    /**
+     This is a special access operator that will return the sample at the specific storage index (regardless of the
+     position of the read pointer).
+     
+     @param const unsigned int index: the storage index of the sample you want access to, should be in the range [0 bufferSize-1]
+     @return returns a pointer to the numChannels values of the sample
+     */
+    inline const double* operator()(const unsigned int index) const{
+        return &buffer[ index * numChannels ];
+    }
+    
+    /**
+     Gets the buffer window, this is the same as operator[](0). The bufferSize samples in the window are stored one
+     after the other, oldest first, so value n of sample i is at getWindow()[ i*getNumChannels() + n ].
+     
+     @return returns a pointer to the first value of the window, or NULL if the buffer has not been initialized
+     */
+    inline const double* getWindow() const{
+        return bufferInit ? &buffer[ readPtr * numChannels ] : NULL;
+    }
+    
+    /**
+     Resizes the buffer to newBufferSize samples of newNumChannels values, both must be greater than zero, and sets all
+     the values to the default value.
+     
+     @param const unsigned int newBufferSize: the new number of samples in the buffer
+     @param const unsigned int newNumChannels: the new number of values in each sample
+     @param const double defaultValue: the value that will be copied to every element. Default value = 0
+     @return returns true if the buffer was resized
+     */
+    bool resize(const unsigned int newBufferSize,const unsigned int newNumChannels,const double defaultValue = 0){
+        
+        //Cleanup the old memory
+        clear();
+        
+        if( newBufferSize == 0 || newNumChannels == 0 ) return false;
+        
+        //Setup the memory for the new buffer, twice the buffer size is needed for the mirror
+        bufferSize = newBufferSize;
+        numChannels = newNumChannels;
+        buffer.resize(2*bufferSize*numChannels,defaultValue);
+        numValuesInBuffer = 0;
+        readPtr = 0;
+        writePtr = 0;
+        
+        //Flag that the buffer has been initialised
+        bufferInit = true;
+        
+        return true;
+    }
+    
+    /**
+     Push the new sample into the end of the buffer, this will move both the read and write pointers.
+     
+     @param const vector< double > &value: the sample that should be added to the end of the buffer, the size must match the number of channels
+     @return returns true if the sample was pushed, false otherwise
+     */
+    bool push_back(const vector< double > &value){
+        
+        if( value.size() != numChannels || value.size() == 0 ){
+            errorLog << "Can't push_back value to circular buffer as the size of the value (" << value.size() << ") does not match the number of channels (" << numChannels << ")!" << endl;
+            return false;
+        }
+        
+        return push_back( &value[0] );
+    }
+    
+    /**
+     Push the new sample into the end of the buffer, this will move both the read and write pointers.
+     
+     @param const double *value: the sample that should be added to the end of the buffer, this must have numChannels values
+     @return returns true if the sample was pushed, false otherwise
+     */
+    bool push_back(const double *value){
+        
+        if( !bufferInit ){
+            errorLog << "Can't push_back value to circular buffer as the buffer has not been initialized!" << endl;
+            return false;
+        }
+        
+        //Add the value to the buffer and to its mirror
+        std::copy( value, value+numChannels, buffer.begin() + writePtr*numChannels );
+        std::copy( value, value+numChannels, buffer.begin() + (writePtr+bufferSize)*numChannels );
+        
+        //Update the write pointer
+        if( ++writePtr == bufferSize ) writePtr = 0;
+        
+        //Check if the buffer is full
+        if( ++numValuesInBuffer > bufferSize ){
+            numValuesInBuffer = bufferSize;
+            
+            //Only update the read pointer if the buffer has been filled
+            if( ++readPtr == bufferSize ) readPtr = 0;
+        }
+        
+        return true;
+    }
+    
+    /**
+     Sets all the values in the buffer to the value.
+     
+     @param const double value: the value that will be copied to all the elements in the buffer
+     @return returns true if the buffer was updated, false otherwise
+     */
+    bool setAllValues(const double value){
+        if( !bufferInit ){
+            return false;
+        }
+        
+        std::fill(buffer.begin(),buffer.end(),value);
+        
+        return true;
+    }
+    
+    /**
+     Resets the numValuesInBuffer, read and write pointers to 0.
+     @return returns true if the buffer was reset, false otherwise
+     */
+    bool reset(){
+        numValuesInBuffer = 0;
+        readPtr = 0;
+        writePtr = 0;
+        return true;
+    }
+    
+    /**
+     Clears the buffer, setting the size to 0.
+     */
+    void clear(){
+        bufferSize = 0;
+        numChannels = 0;
+        numValuesInBuffer = 0;
+        readPtr = 0;
+        writePtr = 0;
+        buffer.clear();
+        bufferInit = false;
+    }
+    
+    /**
+     Gets all the data in the buffer, oldest first, with one vector per sample.
+     
+     @return returns a vector will all the data in the buffer
+     */
+    vector< vector< double > > getDataAsVector() const{
+        if( bufferInit ){
+            vector< vector< double > > data( bufferSize );
+            const double *window = getWindow();
+            for(unsigned int i=0; i<bufferSize; i++){
+                data[i].assign( window + i*numChannels, window + (i+1)*numChannels );
+            }
+            return data;
+        }
+        return vector< vector< double > >();
+    }
+    
+    /**
+     Copies one channel of the buffer window, oldest first, into the data vector.
+     
+     @param const unsigned int channel: the channel that should be copied, must be less than the number of channels
+     @param vector< double > &data: returns the bufferSize values of the channel
+     @return returns true if the channel was copied, false otherwise
+     */
+    bool getChannel(const unsigned int channel,vector< double > &data) const{
+        if( !bufferInit || channel >= numChannels ) return false;
+        
+        if( data.size() != bufferSize ) data.resize( bufferSize );
+        const double *window = getWindow() + channel;
+        for(unsigned int i=0; i<bufferSize; i++){
+            data[i] = window[ i*numChannels ];
+        }
+        return true;
+    }
+    
+    /**
+     Returns true if the buffer has been initialized.
+     
+     @return returns true if the buffer has been initialized, false otherwise
+     */
+    bool getInit() const { return bufferInit; }
+    
+    /**
+     Returns true if the buffer has been filled. If the buffer has not been initialized then this function will always return false.
+     
+     @return returns true if the buffer has been filled, false otherwise
+     */
+    bool getBufferFilled() const { return bufferInit ? numValuesInBuffer==bufferSize : false; }
+    
+    /**
+     Returns the number of samples in the buffer window.
+     
+     @return returns the size of the bufer
+     */
+    unsigned int getSize() const { return bufferInit ? bufferSize : 0; }
+    
+    /**
+     Returns the number of values in each sample.
+     
+     @return returns the number of channels
+     */
+    unsigned int getNumChannels() const { return bufferInit ? numChannels : 0; }
+    
+    /**
+     Returns the number of values in the buffer.
+     
+     @return returns the number of values in the buffer
+     */
+    unsigned int getNumValuesInBuffer() const { return bufferInit ? numValuesInBuffer : 0; }
+    
+    /**
+     Returns the current position of the read pointer.
+     
+     @return returns the current position of the read pointer
+     */
+    unsigned int getReadPointerPosition() const { return bufferInit ? readPtr : 0; }
+    
+    /**
+     Returns the current position of the write pointer.
+     
+     @return returns the current position of the write pointer
+     */
+    unsigned int getWritePointerPosition() const { return bufferInit ? writePtr : 0; }
+    
+    vector< double > getBack() const {
+        if( !bufferInit || numValuesInBuffer == 0 ) return vector< double >();
+        const double *back = (*this)[ numValuesInBuffer - 1 ];
+        return vector< double >( back, back + numChannels );
+    }
+    
+protected:
+    unsigned int bufferSize;
+    unsigned int numChannels;
+    unsigned int numValuesInBuffer;
+    unsigned int readPtr;
+    unsigned int writePtr;
+    vector< double > buffer;            ///< The mirrored buffer, 2*bufferSize rows of numChannels values
+    bool bufferInit;
+    
+    ErrorLog errorLog;
+};
+
 
 }//End of namespace GRT
 
@@ -73,6 +73,33 @@ bool EigenvalueDecomposition::decompose(const MatrixDouble &a){
     
     return true;
 }
+
+bool EigenvalueDecomposition::decomposeSymmetric(const MatrixDouble &a){
+    
+    if( a.getNumRows() != a.getNumCols() || a.getNumRows() == 0 ) return false;
+    
+    n = a.getNumCols();
+    eigenvectors.resize(n,n);
+    realEigenvalues.resize(n);
+    complexEigenvalues.resize(n);
+    issymmetric = true;
+    
+    //Copy the lower triangle, so any rounding differences between the two triangles are ignored
+    for(int i = 0; i < n; i++) {
+        for(int j = 0; j <= i; j++) {
+            eigenvectors[i][j] = a[i][j];
+            eigenvectors[j][i] = a[i][j];
+        }
+    }
+    
+    // Tridiagonalize.
+    tred2();
+    
+    // Diagonalize.
+    tql2();
+    
+    return true;
+}
     
 void EigenvalueDecomposition::tred2(){
     
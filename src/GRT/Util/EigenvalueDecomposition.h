@@ -32,6 +32,16 @@ public:
     
     bool decompose(const MatrixDouble &a);
     
+    /**
+     Decomposes a symmetric matrix, such as a covariance matrix, using the symmetric tridiagonal QL algorithm. Unlike
+     decompose(...), this does not check if the matrix is symmetric, only the lower triangle of the matrix is used.
+     The eigenvalues are sorted in ascending order and the eigenvectors are orthonormal.
+     
+     @param const MatrixDouble &a: the symmetric matrix that should be decomposed, this must be a square matrix
+     @return returns true if the matrix was decomposed, false otherwise
+     */
+    bool decomposeSymmetric(const MatrixDouble &a);
+    
     /**
      Returns the eigenvector matrix
      
@@ -0,0 +1,348 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "FilterBank.h"
+
+#ifdef GRT_SSE2_ENABLED
+    #include <emmintrin.h>
+#endif
+
+namespace GRT{
+
+FilterBank::FilterBank(){
+    initialized = false;
+    numTaps = 0;
+    numChannels = 0;
+    writeIndex = 0;
+    fftMinNumTaps = DEFAULT_FFT_MIN_NUM_TAPS;
+    fftSize = 0;
+}
+
+FilterBank::~FilterBank(){
+
+}
+
+bool FilterBank::init(const VectorDouble &coefficients,const UINT numChannels){
+
+    clear();
+
+    if( coefficients.size() == 0 || numChannels == 0 ) return false;
+
+    this->numTaps = (UINT)coefficients.size();
+    this->numChannels = numChannels;
+    reversedCoefficients.resize( numTaps );
+    for(UINT i=0; i<numTaps; i++){
+        reversedCoefficients[i] = coefficients[ numTaps-1-i ];
+    }
+    history.resize( 2*numTaps*numChannels, 0 );
+    writeIndex = 0;
+    initialized = true;
+
+    return true;
+}
+
+bool FilterBank::reset(){
+    if( !initialized ) return false;
+    std::fill( history.begin(), history.end(), 0 );
+    writeIndex = 0;
+    return true;
+}
+
+bool FilterBank::clear(){
+    initialized = false;
+    numTaps = 0;
+    numChannels = 0;
+    writeIndex = 0;
+    reversedCoefficients.clear();
+    history.clear();
+    fftSize = 0;
+    fftFilterReal.clear();
+    fftFilterImag.clear();
+    fftCos.clear();
+    fftSin.clear();
+    fftBitReverse.clear();
+    fftReal.clear();
+    fftImag.clear();
+    fftInput.clear();
+    return true;
+}
+
+bool FilterBank::filter(const double *x,double *y){
+    if( !initialized ) return false;
+    push( x );
+    computeOutput( y );
+    return true;
+}
+
+bool FilterBank::processBlock(const MatrixDouble &input,MatrixDouble &output){
+
+    if( !initialized ) return false;
+
+    const UINT M = input.getNumRows();
+    if( M == 0 ) return true;
+    if( input.getNumCols() != numChannels ) return false;
+
+    if( !output.resize( M, numChannels ) ) return false;
+
+    if( fftMinNumTaps > 0 && numTaps >= fftMinNumTaps && M >= numTaps ){
+        return processBlockFFT( input, output );
+    }
+
+    for(UINT i=0; i<M; i++){
+        push( input[i] );
+        computeOutput( output[i] );
+    }
+
+    return true;
+}
+
+vector< VectorDouble > FilterBank::getHistory() const{
+    vector< VectorDouble > samples( numTaps, VectorDouble(numChannels,0) );
+    for(UINT i=0; i<numTaps; i++){
+        const double *row = &history[ (writeIndex+i)*numChannels ];
+        std::copy( row, row + numChannels, samples[i].begin() );
+    }
+    return samples;
+}
+
+VectorDouble FilterBank::getCoefficients() const{
+    VectorDouble coefficients( numTaps );
+    for(UINT i=0; i<numTaps; i++){
+        coefficients[i] = reversedCoefficients[ numTaps-1-i ];
+    }
+    return coefficients;
+}
+
+bool FilterBank::setFFTMinNumTaps(const UINT fftMinNumTaps){
+    this->fftMinNumTaps = fftMinNumTaps;
+    return true;
+}
+
+void FilterBank::push(const double *x){
+
+    //Write the sample to both halves of the history, the last numTaps samples are then always the rows
+    //[writeIndex writeIndex+numTaps) once the write index has moved on
+    std::copy( x, x + numChannels, history.begin() + writeIndex*numChannels );
+    std::copy( x, x + numChannels, history.begin() + (writeIndex+numTaps)*numChannels );
+    if( ++writeIndex == numTaps ) writeIndex = 0;
+}
+
+void FilterBank::computeOutput(double *y) const{
+
+    const UINT C = numChannels;
+    const double *window = &history[ writeIndex*C ];
+    const double *h = &reversedCoefficients[0];
+    UINT c = 0;
+
+#ifdef GRT_SSE2_ENABLED
+    //Keep the sums for 8 channels in registers while running over the taps
+    for(; c+8<=C; c+=8){
+        __m128d a0 = _mm_setzero_pd();
+        __m128d a1 = _mm_setzero_pd();
+        __m128d a2 = _mm_setzero_pd();
+        __m128d a3 = _mm_setzero_pd();
+        const double *x = window + c;
+        for(UINT i=0; i<numTaps; i++,x+=C){
+            const __m128d hi = _mm_set1_pd( h[i] );
+            a0 = _mm_add_pd( a0, _mm_mul_pd( hi, _mm_loadu_pd( x ) ) );
+            a1 = _mm_add_pd( a1, _mm_mul_pd( hi, _mm_loadu_pd( x+2 ) ) );
+            a2 = _mm_add_pd( a2, _mm_mul_pd( hi, _mm_loadu_pd( x+4 ) ) );
+            a3 = _mm_add_pd( a3, _mm_mul_pd( hi, _mm_loadu_pd( x+6 ) ) );
+        }
+        _mm_storeu_pd( y+c, a0 );
+        _mm_storeu_pd( y+c+2, a1 );
+        _mm_storeu_pd( y+c+4, a2 );
+        _mm_storeu_pd( y+c+6, a3 );
+    }
+    for(; c+2<=C; c+=2){
+        __m128d a0 = _mm_setzero_pd();
+        const double *x = window + c;
+        for(UINT i=0; i<numTaps; i++,x+=C){
+            a0 = _mm_add_pd( a0, _mm_mul_pd( _mm_set1_pd( h[i] ), _mm_loadu_pd( x ) ) );
+        }
+        _mm_storeu_pd( y+c, a0 );
+    }
+#else
+    for(; c+4<=C; c+=4){
+        double a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+        const double *x = window + c;
+        for(UINT i=0; i<numTaps; i++,x+=C){
+            a0 += h[i] * x[0];
+            a1 += h[i] * x[1];
+            a2 += h[i] * x[2];
+            a3 += h[i] * x[3];
+        }
+        y[c] = a0;
+        y[c+1] = a1;
+        y[c+2] = a2;
+        y[c+3] = a3;
+    }
+#endif
+
+    for(; c<C; c++){
+        double a0 = 0;
+        const double *x = window + c;
+        for(UINT i=0; i<numTaps; i++,x+=C){
+            a0 += h[i] * x[0];
+        }
+        y[c] = a0;
+    }
+}
+
+bool FilterBank::initFFT(){
+
+    //Use the smallest power of two that holds at least four filter lengths, so most of each FFT is output rather than
+    //the overlap with the previous segment
+    fftSize = 2;
+    while( fftSize < 4*numTaps ) fftSize *= 2;
+
+    UINT numBits = 0;
+    while( (1u << numBits) < fftSize ) numBits++;
+
+    fftBitReverse.resize( fftSize );
+    for(UINT i=0; i<fftSize; i++){
+        UINT r = 0;
+        for(UINT b=0; b<numBits; b++){
+            if( i & (1u << b) ) r |= 1u << (numBits-1-b);
+        }
+        fftBitReverse[i] = r;
+    }
+
+    fftCos.resize( fftSize/2 );
+    fftSin.resize( fftSize/2 );
+    for(UINT k=0; k<fftSize/2; k++){
+        fftCos[k] = cos( TWO_PI * k / fftSize );
+        fftSin[k] = sin( TWO_PI * k / fftSize );
+    }
+
+    //Compute the transform of the impulse response, coefficients[i] is the response i samples after the impulse
+    fftFilterReal.assign( fftSize, 0 );
+    fftFilterImag.assign( fftSize, 0 );
+    for(UINT i=0; i<numTaps; i++){
+        fftFilterReal[i] = reversedCoefficients[ numTaps-1-i ];
+    }
+    computeFFT( &fftFilterReal[0], &fftFilterImag[0], false );
+
+    fftReal.resize( fftSize );
+    fftImag.resize( fftSize );
+
+    return true;
+}
+
+void FilterBank::computeFFT(double *re,double *im,const bool inverse) const{
+
+    const UINT N = fftSize;
+
+    for(UINT i=0; i<N; i++){
+        const UINT j = fftBitReverse[i];
+        if( j > i ){
+            std::swap( re[i], re[j] );
+            std::swap( im[i], im[j] );
+        }
+    }
+
+    const double sign = inverse ? 1.0 : -1.0;
+    for(UINT length=2; length<=N; length*=2){
+        const UINT half = length/2;
+        const UINT step = N/length;
+        for(UINT start=0; start<N; start+=length){
+            for(UINT k=0; k<half; k++){
+                const double wr = fftCos[ k*step ];
+                const double wi = sign * fftSin[ k*step ];
+                const UINT a = start + k;
+                const UINT b = a + half;
+                const double tr = re[b]*wr - im[b]*wi;
+                const double ti = re[b]*wi + im[b]*wr;
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+}
+
+bool FilterBank::processBlockFFT(const MatrixDouble &input,MatrixDouble &output){
+
+    if( fftSize == 0 && !initFFT() ) return false;
+
+    const UINT T = numTaps;
+    const UINT C = numChannels;
+    const UINT M = input.getNumRows();
+    const UINT N = fftSize;
+    const UINT L = N - T + 1;                   //The number of outputs from each FFT
+    const UINT inputLength = T - 1 + M;         //The last T-1 samples of the history, followed by the block
+    const double scale = 1.0 / N;
+
+    fftInput.resize( 2*inputLength );
+    double *inputA = &fftInput[0];
+    double *inputB = &fftInput[ inputLength ];
+    double *re = &fftReal[0];
+    double *im = &fftImag[0];
+
+    //Filter two channels with each FFT, one in the real part and one in the imaginary part. The coefficients are real,
+    //so the two channels do not mix
+    for(UINT c=0; c<C; c+=2){
+        const bool hasPair = c+1 < C;
+
+        for(UINT j=0; j<T-1; j++){
+            const double *row = &history[ (writeIndex+1+j)*C ];
+            inputA[j] = row[c];
+            inputB[j] = hasPair ? row[c+1] : 0;
+        }
+        for(UINT m=0; m<M; m++){
+            inputA[T-1+m] = input[m][c];
+            inputB[T-1+m] = hasPair ? input[m][c+1] : 0;
+        }
+
+        for(UINT s=0; s<M; s+=L){
+            for(UINT n=0; n<N; n++){
+                const UINT index = s + n;
+                re[n] = index < inputLength ? inputA[index] : 0;
+                im[n] = index < inputLength ? inputB[index] : 0;
+            }
+
+            computeFFT( re, im, false );
+            for(UINT n=0; n<N; n++){
+                const double r = re[n]*fftFilterReal[n] - im[n]*fftFilterImag[n];
+                const double i = re[n]*fftFilterImag[n] + im[n]*fftFilterReal[n];
+                re[n] = r;
+                im[n] = i;
+            }
+            computeFFT( re, im, true );
+
+            //The first T-1 values wrap around the end of the FFT, the rest are the outputs for this segment
+            const UINT numOutputs = MIN( L, M-s );
+            for(UINT m=0; m<numOutputs; m++){
+                output[s+m][c] = re[T-1+m] * scale;
+                if( hasPair ) output[s+m][c+1] = im[T-1+m] * scale;
+            }
+        }
+    }
+
+    //Only the last numTaps samples of the block are needed in the history
+    for(UINT m=M-T; m<M; m++){
+        push( input[m] );
+    }
+
+    return true;
+}
+
+}//End of namespace GRT
@@ -0,0 +1,160 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The FilterBank class runs the same FIR filter over many channels at once. It is the engine used by the
+ FIRFilter, SavitzkyGolayFilter and MovingAverageFilter.
+
+ The history of all the channels is stored in one contiguous buffer, interleaved by channel, and the buffer is mirrored
+ (each sample is written twice) so the last numTaps samples are always contiguous and the filter never needs a modulo
+ to find a sample. Each output is computed for a group of channels at a time, so the inner loop runs over adjacent
+ channels and uses SSE2 when it is available.
+
+ A block of samples can be filtered with processBlock. If the filter has at least getFFTMinNumTaps() taps and the block
+ is at least as long as the filter, the block is filtered with FFT overlap-save convolution, which costs O(log numTaps)
+ per output rather than O(numTaps). Two channels are filtered by each complex FFT, one in the real part and one in the
+ imaginary part.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_FILTER_BANK_HEADER
+#define GRT_FILTER_BANK_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+class FilterBank{
+public:
+    /**
+     Default Constructor.
+     */
+    FilterBank();
+
+    /**
+     Default Destructor.
+     */
+    ~FilterBank();
+
+    /**
+     Initializes the filter bank. The history of every channel is set to zero.
+
+     @param const VectorDouble &coefficients: the filter coefficients, coefficients[i] is applied to the input from i samples ago, so coefficients[0] is applied to the newest input
+     @param const UINT numChannels: the number of channels, must be greater than zero
+     @return returns true if the filter bank was initialized, false otherwise
+     */
+    bool init(const VectorDouble &coefficients,const UINT numChannels);
+
+    /**
+     Sets the history of every channel to zero, without changing the coefficients.
+
+     @return returns true if the filter bank was reset, false otherwise
+     */
+    bool reset();
+
+    /**
+     Removes the coefficients and the history.
+
+     @return returns true if the filter bank was cleared
+     */
+    bool clear();
+
+    /**
+     Adds a new sample to the history and filters it.
+
+     @param const double *x: the new sample, with one value per channel
+     @param double *y: returns the filtered sample, with one value per channel
+     @return returns true if the sample was filtered, false otherwise
+     */
+    bool filter(const double *x,double *y);
+
+    /**
+     Filters a block of samples, with one sample per row and one channel per column. The result is the same as calling
+     filter for each row in turn (to within rounding error if the FFT is used).
+
+     @param const MatrixDouble &input: the samples to filter, the number of columns must match the number of channels
+     @param MatrixDouble &output: returns the filtered samples, this will be resized to match the input
+     @return returns true if the block was filtered, false otherwise
+     */
+    bool processBlock(const MatrixDouble &input,MatrixDouble &output);
+
+    /**
+     Gets the history of the filter bank, with the oldest sample first.
+
+     @return returns the last numTaps inputs, with one VectorDouble per sample
+     */
+    vector< VectorDouble > getHistory() const;
+
+    UINT getNumTaps() const { return numTaps; }
+    UINT getNumChannels() const { return numChannels; }
+    bool getInitialized() const { return initialized; }
+    VectorDouble getCoefficients() const;
+
+    /**
+     Gets the minimum number of taps for which processBlock will use the FFT.
+     */
+    UINT getFFTMinNumTaps() const { return fftMinNumTaps; }
+
+    /**
+     Sets the minimum number of taps for which processBlock will use the FFT. Shorter filters are always filtered
+     directly, as the direct filter is faster for them. The default is DEFAULT_FFT_MIN_NUM_TAPS, the direct filter is
+     faster than the FFT up to around 200 taps on a desktop CPU.
+
+     @param const UINT fftMinNumTaps: the minimum number of taps, zero disables the FFT
+     @return returns true if the value was set
+     */
+    bool setFFTMinNumTaps(const UINT fftMinNumTaps);
+
+protected:
+    void push(const double *x);
+    void computeOutput(double *y) const;
+    bool initFFT();
+    void computeFFT(double *re,double *im,const bool inverse) const;
+    bool processBlockFFT(const MatrixDouble &input,MatrixDouble &output);
+
+    bool initialized;
+    UINT numTaps;
+    UINT numChannels;
+    UINT writeIndex;                    ///< The row of the first half of the history the next sample will be written to
+    VectorDouble reversedCoefficients;  ///< The coefficients in the order of the history, i.e. the oldest input first
+    VectorDouble history;               ///< The mirrored history, 2*numTaps rows of numChannels values
+
+    //The overlap-save tables, these are built the first time a block is filtered with the FFT
+    UINT fftMinNumTaps;
+    UINT fftSize;
+    VectorDouble fftFilterReal;         ///< The FFT of the zero padded coefficients
+    VectorDouble fftFilterImag;
+    VectorDouble fftCos;                ///< cos(2*PI*k/fftSize) for k in [0 fftSize/2-1]
+    VectorDouble fftSin;
+    vector< UINT > fftBitReverse;
+    VectorDouble fftReal;               ///< Workspace for one channel pair
+    VectorDouble fftImag;
+    VectorDouble fftInput;              ///< Workspace for the input of one channel pair, [history block]
+
+public:
+    enum{ DEFAULT_FFT_MIN_NUM_TAPS = 256 };
+};
+
+}//End of namespace GRT
+
+#endif //GRT_FILTER_BANK_HEADER
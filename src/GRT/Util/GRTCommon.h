@@ -68,5 +68,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "SVD.h"
 #include "FileParser.h"
 #include "ObserverManager.h"
+#include "ParallelTaskRunner.h"
+#include "LBFGSOptimizer.h"
 
 #endif //GRT_COMMON_HEADER
@@ -96,6 +96,17 @@ typedef signed int SINT;
 typedef unsigned long ULONG;
 #endif
     
+//Flag if the compiler supports C++11, this is used to enable the C++11 threading support
+#if __cplusplus >= 201103L
+    #define GRT_CXX11_ENABLED
+#endif
+
+//Flag if the target supports SSE2, which is part of every x86-64 CPU. The modules that use SSE2 fall back to scalar loops
+//without it, which the compiler can still vectorize itself
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define GRT_SSE2_ENABLED
+#endif
+    
 //Define any common GRT OS independent typedefs
 typedef std::vector<double> VectorDouble;
     
@@ -0,0 +1,267 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "KDTree.h"
+
+namespace GRT{
+
+//Orders point indices by their value in one dimension, used to find the median of a node
+class KDTreeDimensionCompare{
+public:
+    KDTreeDimensionCompare(const vector< double > &data,const UINT numDimensions,const UINT dimension):data(data),numDimensions(numDimensions),dimension(dimension){}
+    bool operator()(const UINT a,const UINT b) const{
+        return data[ a*numDimensions + dimension ] < data[ b*numDimensions + dimension ];
+    }
+    const vector< double > &data;
+    const UINT numDimensions;
+    const UINT dimension;
+};
+
+//Orders the nearest neighbour candidates by distance and then by index, so the search result does not depend on the
+//order the leaves are visited
+class KDTreeNearestCompare{
+public:
+    bool operator()(const IndexedDouble &a,const IndexedDouble &b) const{
+        if( a.value != b.value ) return a.value < b.value;
+        return a.index < b.index;
+    }
+};
+
+KDTree::KDTree(){
+    numPoints = 0;
+    numDimensions = 0;
+}
+
+KDTree::~KDTree(){
+
+}
+
+bool KDTree::build(const vector< VectorDouble > &points,const UINT leafSize){
+
+    clear();
+
+    if( points.size() == 0 || points[0].size() == 0 || leafSize == 0 ) return false;
+
+    numPoints = (UINT)points.size();
+    numDimensions = (UINT)points[0].size();
+    data.resize( numPoints*numDimensions );
+    for(UINT i=0; i<numPoints; i++){
+        if( points[i].size() != numDimensions ){
+            clear();
+            return false;
+        }
+        std::copy( points[i].begin(), points[i].end(), data.begin() + i*numDimensions );
+    }
+
+    return buildTree( leafSize );
+}
+
+bool KDTree::build(const MatrixDouble &matrix,const UINT leafSize){
+
+    clear();
+
+    if( matrix.getNumRows() == 0 || matrix.getNumCols() == 0 || leafSize == 0 ) return false;
+
+    numPoints = matrix.getNumRows();
+    numDimensions = matrix.getNumCols();
+    data.resize( numPoints*numDimensions );
+    for(UINT i=0; i<numPoints; i++){
+        std::copy( matrix[i], matrix[i] + numDimensions, data.begin() + i*numDimensions );
+    }
+
+    return buildTree( leafSize );
+}
+
+bool KDTree::clear(){
+    numPoints = 0;
+    numDimensions = 0;
+    nodes.clear();
+    pointIndex.clear();
+    data.clear();
+    return true;
+}
+
+UINT KDTree::radiusSearch(const VectorDouble &query,const double radius,vector< UINT > &indices) const{
+
+    indices.clear();
+
+    if( numPoints == 0 || query.size() != numDimensions || !(radius > 0) ) return 0;
+
+    searchNode( 0, &query[0], radius*radius, indices );
+
+    return (UINT)indices.size();
+}
+
+UINT KDTree::nearestSearch(const VectorDouble &query,const UINT K,vector< UINT > &indices,vector< double > &distances) const{
+
+    indices.clear();
+    distances.clear();
+
+    if( numPoints == 0 || query.size() != numDimensions || K == 0 ) return 0;
+
+    //The heap holds the K nearest points found so far as (index,squared distance), with the furthest point at the front
+    vector< IndexedDouble > heap;
+    heap.reserve( K < numPoints ? K : numPoints );
+    searchNearestNode( 0, &query[0], K, heap );
+
+    std::sort_heap( heap.begin(), heap.end(), KDTreeNearestCompare() );
+
+    indices.resize( heap.size() );
+    distances.resize( heap.size() );
+    for(UINT i=0; i<heap.size(); i++){
+        indices[i] = heap[i].index;
+        distances[i] = sqrt( heap[i].value );
+    }
+
+    return (UINT)heap.size();
+}
+
+bool KDTree::buildTree(const UINT leafSize){
+
+    //The data is currently in the original order, build the tree using the point indices and then reorder the data
+    const vector< double > unorderedData = data;
+    pointIndex.resize( numPoints );
+    for(UINT i=0; i<numPoints; i++) pointIndex[i] = i;
+
+    nodes.reserve( 2*(numPoints/leafSize) + 1 );
+    buildNode( 0, numPoints, leafSize, unorderedData );
+
+    for(UINT i=0; i<numPoints; i++){
+        std::copy( unorderedData.begin() + pointIndex[i]*numDimensions, unorderedData.begin() + (pointIndex[i]+1)*numDimensions, data.begin() + i*numDimensions );
+    }
+
+    return true;
+}
+
+UINT KDTree::buildNode(const UINT begin,const UINT end,const UINT leafSize,const vector< double > &unorderedData){
+
+    const UINT nodeIndex = (UINT)nodes.size();
+    nodes.push_back( Node() );
+    nodes[nodeIndex].splitDimension = 0;
+    nodes[nodeIndex].splitValue = 0;
+    nodes[nodeIndex].left = 0;
+    nodes[nodeIndex].right = 0;
+    nodes[nodeIndex].begin = begin;
+    nodes[nodeIndex].end = end;
+
+    if( end - begin <= leafSize ) return nodeIndex;
+
+    //Split the node on the dimension with the largest spread
+    UINT splitDimension = 0;
+    double maxSpread = -1;
+    for(UINT j=0; j<numDimensions; j++){
+        double minValue = unorderedData[ pointIndex[begin]*numDimensions + j ];
+        double maxValue = minValue;
+        for(UINT i=begin+1; i<end; i++){
+            const double value = unorderedData[ pointIndex[i]*numDimensions + j ];
+            if( value < minValue ) minValue = value;
+            else if( value > maxValue ) maxValue = value;
+        }
+        if( maxValue - minValue > maxSpread ){
+            maxSpread = maxValue - minValue;
+            splitDimension = j;
+        }
+    }
+
+    //If all the points are the same then there is no point splitting the node
+    if( !(maxSpread > 0) ) return nodeIndex;
+
+    //Split the points at the median, so the points in [begin mid) are less than or equal to the points in [mid end)
+    const UINT mid = begin + (end-begin)/2;
+    std::nth_element( pointIndex.begin()+begin, pointIndex.begin()+mid, pointIndex.begin()+end, KDTreeDimensionCompare(unorderedData,numDimensions,splitDimension) );
+
+    nodes[nodeIndex].splitDimension = splitDimension;
+    nodes[nodeIndex].splitValue = unorderedData[ pointIndex[mid]*numDimensions + splitDimension ];
+
+    //The nodes vector may grow while building the children, so the children are stored after they are built
+    const UINT left = buildNode( begin, mid, leafSize, unorderedData );
+    const UINT right = buildNode( mid, end, leafSize, unorderedData );
+    nodes[nodeIndex].left = left;
+    nodes[nodeIndex].right = right;
+
+    return nodeIndex;
+}
+
+void KDTree::searchNode(const UINT nodeIndex,const double *query,const double radiusSquared,vector< UINT > &indices) const{
+
+    const Node &node = nodes[nodeIndex];
+
+    //If the node is a leaf then check each point
+    if( node.left == 0 ){
+        for(UINT i=node.begin; i<node.end; i++){
+            const double *x = &data[ i*numDimensions ];
+            double dist = 0;
+            for(UINT j=0; j<numDimensions; j++){
+                const double d = x[j] - query[j];
+                dist += d*d;
+            }
+            if( dist < radiusSquared ) indices.push_back( pointIndex[i] );
+        }
+        return;
+    }
+
+    //Search the side of the split that contains the query first, the other side only needs searching if it is within the radius
+    const double diff = query[ node.splitDimension ] - node.splitValue;
+    if( diff < 0 ){
+        searchNode( node.left, query, radiusSquared, indices );
+        if( diff*diff < radiusSquared ) searchNode( node.right, query, radiusSquared, indices );
+    }else{
+        searchNode( node.right, query, radiusSquared, indices );
+        if( diff*diff < radiusSquared ) searchNode( node.left, query, radiusSquared, indices );
+    }
+}
+
+void KDTree::searchNearestNode(const UINT nodeIndex,const double *query,const UINT K,vector< IndexedDouble > &heap) const{
+
+    const Node &node = nodes[nodeIndex];
+    KDTreeNearestCompare compare;
+
+    //If the node is a leaf then check each point, replacing the furthest point in the heap if the point is nearer
+    if( node.left == 0 ){
+        for(UINT i=node.begin; i<node.end; i++){
+            const double *x = &data[ i*numDimensions ];
+            double dist = 0;
+            for(UINT j=0; j<numDimensions; j++){
+                const double d = x[j] - query[j];
+                dist += d*d;
+            }
+            const IndexedDouble candidate( pointIndex[i], dist );
+            if( heap.size() < K ){
+                heap.push_back( candidate );
+                std::push_heap( heap.begin(), heap.end(), compare );
+            }else if( compare( candidate, heap.front() ) ){
+                std::pop_heap( heap.begin(), heap.end(), compare );
+                heap.back() = candidate;
+                std::push_heap( heap.begin(), heap.end(), compare );
+            }
+        }
+        return;
+    }
+
+    //Search the side of the split that contains the query first, the other side only needs searching if it could hold a
+    //point that is nearer than the furthest point in the heap (or as near, as ties are broken by index)
+    const double diff = query[ node.splitDimension ] - node.splitValue;
+    const UINT nearChild = diff < 0 ? node.left : node.right;
+    const UINT farChild = diff < 0 ? node.right : node.left;
+    searchNearestNode( nearChild, query, K, heap );
+    if( heap.size() < K || diff*diff <= heap.front().value ) searchNearestNode( farChild, query, K, heap );
+}
+
+}//End of namespace GRT
@@ -0,0 +1,131 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The KDTree class builds a kd-tree over a fixed set of points, so that all the points within a radius of a query
+ point can be found without checking every point.
+
+ The tree is built by splitting each node at the median of the dimension with the largest spread, until each leaf holds
+ no more than leafSize points. The points are copied into one contiguous array in tree order when the tree is built, so
+ the points in each leaf are next to each other in memory. The search functions do not change the tree, so a built tree
+ can be searched from several threads at the same time.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_KD_TREE_HEADER
+#define GRT_KD_TREE_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+class KDTree{
+public:
+    /**
+     Default Constructor.
+     */
+    KDTree();
+
+    /**
+     Default Destructor.
+     */
+    ~KDTree();
+
+    /**
+     Builds the tree from the points. Each point must have the same number of dimensions.
+
+     @param const vector< VectorDouble > &points: the points that will be stored in the tree
+     @param const UINT leafSize: the maximum number of points in each leaf, must be greater than zero. Default value = 16
+     @return returns true if the tree was built, false otherwise
+     */
+    bool build(const vector< VectorDouble > &points,const UINT leafSize = 16);
+
+    /**
+     Builds the tree from the rows of the data matrix.
+
+     @param const MatrixDouble &data: the points that will be stored in the tree, with one point per row
+     @param const UINT leafSize: the maximum number of points in each leaf, must be greater than zero. Default value = 16
+     @return returns true if the tree was built, false otherwise
+     */
+    bool build(const MatrixDouble &data,const UINT leafSize = 16);
+
+    /**
+     Removes all the points from the tree.
+
+     @return returns true if the tree was cleared
+     */
+    bool clear();
+
+    /**
+     Finds all the points whose Euclidean distance to the query point is less than the radius. The indices are the
+     positions of the points in the vector or matrix the tree was built from. They are returned in the order the leaves
+     of the tree are visited, which is the same each time the tree is built from the same points.
+
+     @param const VectorDouble &query: the query point, this must have the same number of dimensions as the points in the tree
+     @param const double radius: the search radius
+     @param vector< UINT > &indices: returns the indices of the points that are within the radius
+     @return returns the number of points that are within the radius
+     */
+    UINT radiusSearch(const VectorDouble &query,const double radius,vector< UINT > &indices) const;
+
+    /**
+     Finds the K points with the smallest Euclidean distance to the query point. The points are returned in order of
+     increasing distance, points at the same distance are returned in order of their index.
+
+     @param const VectorDouble &query: the query point, this must have the same number of dimensions as the points in the tree
+     @param const UINT K: the number of points to find, if this is larger than the number of points then all the points are returned
+     @param vector< UINT > &indices: returns the indices of the nearest points
+     @param vector< double > &distances: returns the Euclidean distance of each of the nearest points
+     @return returns the number of points that were found
+     */
+    UINT nearestSearch(const VectorDouble &query,const UINT K,vector< UINT > &indices,vector< double > &distances) const;
+
+    UINT getNumPoints() const { return numPoints; }
+    UINT getNumDimensions() const { return numDimensions; }
+    bool getTreeBuilt() const { return numPoints > 0; }
+
+protected:
+    struct Node{
+        UINT splitDimension;        ///< The dimension the node is split on
+        double splitValue;          ///< Points below this value are in the left child, the others are in the right child
+        UINT left;                  ///< The index of the left child, or 0 if the node is a leaf
+        UINT right;                 ///< The index of the right child, or 0 if the node is a leaf
+        UINT begin;                 ///< The first point in the node, in tree order
+        UINT end;                   ///< One past the last point in the node, in tree order
+    };
+
+    bool buildTree(const UINT leafSize);
+    UINT buildNode(const UINT begin,const UINT end,const UINT leafSize,const vector< double > &unorderedData);
+    void searchNode(const UINT nodeIndex,const double *query,const double radiusSquared,vector< UINT > &indices) const;
+    void searchNearestNode(const UINT nodeIndex,const double *query,const UINT K,vector< IndexedDouble > &heap) const;
+
+    UINT numPoints;
+    UINT numDimensions;
+    vector< Node > nodes;           ///< The nodes of the tree, the root is node 0
+    vector< UINT > pointIndex;      ///< The original index of each point, in tree order
+    vector< double > data;          ///< The points in tree order, stored as [point][dimension]
+};
+
+}//End of namespace GRT
+
+#endif //GRT_KD_TREE_HEADER
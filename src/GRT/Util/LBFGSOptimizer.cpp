@@ -0,0 +1,165 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "LBFGSOptimizer.h"
+
+namespace GRT{
+
+//The constant of the sufficient decrease condition used by the line search
+#define LBFGS_ARMIJO_CONSTANT 1.0e-4
+#define LBFGS_MAX_LINE_SEARCH_STEPS 40
+
+static inline double lbfgsDot(const double *a,const double *b,const UINT N){
+    double sum = 0;
+    for(UINT i=0; i<N; i++) sum += a[i]*b[i];
+    return sum;
+}
+
+LBFGSOptimizer::LBFGSOptimizer(const UINT historySize){
+    this->historySize = historySize > 0 ? historySize : 1;
+    numIterations = 0;
+    value = 0;
+    converged = false;
+}
+
+LBFGSOptimizer::~LBFGSOptimizer(){
+
+}
+
+bool LBFGSOptimizer::minimize(LBFGSObjective &objective,VectorDouble &x,const UINT maxNumIterations,const double minChange){
+
+    const UINT N = (UINT)x.size();
+    numIterations = 0;
+    converged = false;
+
+    if( N == 0 ) return false;
+
+    VectorDouble gradient(N);
+    value = objective.evaluate( x, gradient );
+    if( grt_isnan( value ) || grt_isinf( value ) ) return false;
+
+    //The last historySize steps (s) and gradient changes (y) are stored in a ring buffer
+    MatrixDouble S(historySize,N);
+    MatrixDouble Y(historySize,N);
+    VectorDouble rho(historySize,0);
+    VectorDouble alpha(historySize,0);
+    UINT numStored = 0;
+    UINT newest = 0;
+
+    VectorDouble direction(N);
+    VectorDouble newX(N);
+    VectorDouble newGradient(N);
+    VectorDouble s(N);
+    VectorDouble y(N);
+
+    while( numIterations < maxNumIterations ){
+
+        //Stop if the gradient is zero
+        double maxGradient = 0;
+        for(UINT i=0; i<N; i++) maxGradient = MAX(maxGradient,fabs(gradient[i]));
+        if( maxGradient == 0 ){
+            converged = true;
+            break;
+        }
+
+        //Compute the search direction using the two loop recursion
+        for(UINT i=0; i<N; i++) direction[i] = -gradient[i];
+        for(UINT k=0; k<numStored; k++){
+            const UINT h = (newest + historySize - k) % historySize;
+            alpha[h] = rho[h] * lbfgsDot( S[h], &direction[0], N );
+            for(UINT i=0; i<N; i++) direction[i] -= alpha[h] * Y[h][i];
+        }
+        double gamma = 0;
+        if( numStored > 0 ){
+            gamma = lbfgsDot( S[newest], Y[newest], N ) / lbfgsDot( Y[newest], Y[newest], N );
+        }else{
+            //Without any curvature information, the first step is scaled so it has a unit length
+            gamma = 1.0 / sqrt( lbfgsDot( &gradient[0], &gradient[0], N ) );
+        }
+        for(UINT i=0; i<N; i++) direction[i] *= gamma;
+        for(UINT k=numStored; k>0; k--){
+            const UINT h = (newest + historySize - (k-1)) % historySize;
+            const double beta = rho[h] * lbfgsDot( Y[h], &direction[0], N );
+            for(UINT i=0; i<N; i++) direction[i] += S[h][i] * (alpha[h] - beta);
+        }
+
+        //If the direction is not a descent direction then the curvature estimate is wrong, so restart from steepest descent
+        double slope = lbfgsDot( &gradient[0], &direction[0], N );
+        if( slope >= 0 ){
+            numStored = 0;
+            const double scale = 1.0 / sqrt( lbfgsDot( &gradient[0], &gradient[0], N ) );
+            for(UINT i=0; i<N; i++) direction[i] = -gradient[i] * scale;
+            slope = lbfgsDot( &gradient[0], &direction[0], N );
+        }
+
+        //Backtracking line search
+        double step = 1.0;
+        double newValue = 0;
+        bool stepFound = false;
+        for(UINT k=0; k<LBFGS_MAX_LINE_SEARCH_STEPS; k++){
+            for(UINT i=0; i<N; i++) newX[i] = x[i] + step * direction[i];
+            newValue = objective.evaluate( newX, newGradient );
+            if( !grt_isnan( newValue ) && !grt_isinf( newValue ) && newValue <= value + LBFGS_ARMIJO_CONSTANT * step * slope ){
+                stepFound = true;
+                break;
+            }
+            step *= 0.5;
+        }
+
+        //If no step reduces the function then the optimizer is at the minimum, to within the precision of the function
+        if( !stepFound ){
+            converged = true;
+            break;
+        }
+
+        //Store the step and the change in the gradient, if it has positive curvature, replacing the oldest step if the history is full
+        for(UINT i=0; i<N; i++){
+            s[i] = newX[i] - x[i];
+            y[i] = newGradient[i] - gradient[i];
+        }
+        const double sy = lbfgsDot( &s[0], &y[0], N );
+        if( sy > 1.0e-12 * lbfgsDot( &y[0], &y[0], N ) ){
+            newest = numStored == 0 ? 0 : (newest + 1) % historySize;
+            for(UINT i=0; i<N; i++){
+                S[newest][i] = s[i];
+                Y[newest][i] = y[i];
+            }
+            rho[newest] = 1.0 / sy;
+            if( numStored < historySize ) numStored++;
+        }
+
+        const double change = fabs( value - newValue );
+        x = newX;
+        gradient = newGradient;
+        value = newValue;
+        numIterations++;
+
+        objective.iterationCompleted( numIterations, value );
+
+        if( change <= minChange * MAX( fabs(value), 1.0 ) ){
+            converged = true;
+            break;
+        }
+    }
+
+    return true;
+}
+
+}//End of namespace GRT
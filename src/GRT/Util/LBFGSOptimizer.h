@@ -0,0 +1,104 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The LBFGSOptimizer class minimizes a smooth function using the limited memory BFGS algorithm.
+
+ The function is defined by a class that inherits from LBFGSObjective and computes the value and the gradient of the
+ function at a given point. L-BFGS builds an estimate of the curvature of the function from the last few gradients, so
+ it normally needs far fewer evaluations than gradient descent and does not need a learning rate. Each iteration uses
+ a backtracking line search, so the value of the function never increases.
+
+ @remark This implementation is based on Nocedal, Jorge, and Stephen J. Wright. Numerical Optimization. Springer, 2006.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_LBFGS_OPTIMIZER_HEADER
+#define GRT_LBFGS_OPTIMIZER_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+class LBFGSObjective{
+public:
+    virtual ~LBFGSObjective(){}
+
+    /**
+     Computes the value and the gradient of the function at x.
+
+     @param const VectorDouble &x: the point at which the function should be evaluated
+     @param VectorDouble &gradient: the gradient of the function at x, this will have the same size as x
+     @return returns the value of the function at x
+     */
+    virtual double evaluate(const VectorDouble &x,VectorDouble &gradient) = 0;
+
+    /**
+     Called at the end of each iteration of the optimizer, this can be used to log the progress of the optimizer.
+
+     @param const UINT iteration: the number of iterations that have been completed
+     @param const double value: the value of the function at the end of the iteration
+     */
+    virtual void iterationCompleted(const UINT iteration,const double value){}
+};
+
+class LBFGSOptimizer{
+public:
+    /**
+     Default Constructor.
+
+     @param const UINT historySize: the number of previous steps that are used to estimate the curvature of the function. Default value = 10
+     */
+    LBFGSOptimizer(const UINT historySize = 10);
+
+    /**
+     Default Destructor
+     */
+    ~LBFGSOptimizer();
+
+    /**
+     Minimizes the objective function, starting from x. The optimizer stops when the relative change in the value of the
+     function between two iterations is less than minChange, when the gradient is zero or when maxNumIterations have been run.
+
+     @param LBFGSObjective &objective: the function that should be minimized
+     @param VectorDouble &x: the starting point, this will be set to the minimum that was found
+     @param const UINT maxNumIterations: the maximum number of iterations
+     @param const double minChange: the minimum relative change in the value of the function for the optimizer to keep going
+     @return returns true if the optimizer found a minimum or reached the maximum number of iterations, false if the function could not be evaluated
+     */
+    bool minimize(LBFGSObjective &objective,VectorDouble &x,const UINT maxNumIterations,const double minChange);
+
+    UINT getNumIterations() const { return numIterations; }
+    double getValue() const { return value; }
+    bool getConverged() const { return converged; }
+
+protected:
+    UINT historySize;
+    UINT numIterations;
+    double value;
+    bool converged;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_LBFGS_OPTIMIZER_HEADER
@@ -0,0 +1,139 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "LatencyHistogram.h"
+
+namespace GRT{
+
+LatencyHistogram::LatencyHistogram(){
+    reset();
+}
+
+LatencyHistogram::LatencyHistogram(const LatencyHistogram &rhs){
+    *this = rhs;
+}
+
+LatencyHistogram::~LatencyHistogram(){
+
+}
+
+LatencyHistogram& LatencyHistogram::operator=(const LatencyHistogram &rhs){
+    if( this != &rhs ){
+        for(UINT i=0; i<NUM_BUCKETS; i++){
+            store( counts[i], load(rhs.counts[i]) );
+        }
+        store( numSamples, load(rhs.numSamples) );
+        store( sum, load(rhs.sum) );
+        store( maximum, load(rhs.maximum) );
+    }
+    return *this;
+}
+
+void LatencyHistogram::record(const unsigned long long value){
+#ifdef GRT_CXX11_ENABLED
+    counts[ getBucketIndex(value) ].fetch_add( 1, std::memory_order_relaxed );
+    numSamples.fetch_add( 1, std::memory_order_relaxed );
+    sum.fetch_add( value, std::memory_order_relaxed );
+    unsigned long long currentMaximum = maximum.load( std::memory_order_relaxed );
+    while( value > currentMaximum && !maximum.compare_exchange_weak( currentMaximum, value, std::memory_order_relaxed ) ){}
+#else
+    counts[ getBucketIndex(value) ]++;
+    numSamples++;
+    sum += value;
+    if( value > maximum ) maximum = value;
+#endif
+}
+
+void LatencyHistogram::reset(){
+    for(UINT i=0; i<NUM_BUCKETS; i++){
+        store( counts[i], 0 );
+    }
+    store( numSamples, 0 );
+    store( sum, 0 );
+    store( maximum, 0 );
+}
+
+unsigned long long LatencyHistogram::getNumSamples() const{
+    return load( numSamples );
+}
+
+unsigned long long LatencyHistogram::getSum() const{
+    return load( sum );
+}
+
+unsigned long long LatencyHistogram::getMaximum() const{
+    return load( maximum );
+}
+
+double LatencyHistogram::getMean() const{
+    const unsigned long long n = load( numSamples );
+    if( n == 0 ) return 0;
+    return load( sum ) / (double)n;
+}
+
+unsigned long long LatencyHistogram::getPercentile(const double percentile) const{
+
+    //The counts may change while they are read, so the total is taken from the buckets rather than numSamples
+    unsigned long long total = 0;
+    for(UINT i=0; i<NUM_BUCKETS; i++){
+        total += load( counts[i] );
+    }
+    if( total == 0 ) return 0;
+
+    const double p = percentile < 0 ? 0 : (percentile > 100 ? 100 : percentile);
+    unsigned long long rank = (unsigned long long)ceil( p / 100.0 * total );
+    if( rank == 0 ) rank = 1;
+
+    const unsigned long long maxValue = load( maximum );
+    unsigned long long count = 0;
+    for(UINT i=0; i<NUM_BUCKETS; i++){
+        count += load( counts[i] );
+        if( count >= rank ){
+            const unsigned long long upperBound = getBucketUpperBound( i );
+            return upperBound < maxValue ? upperBound : maxValue;
+        }
+    }
+    return maxValue;
+}
+
+UINT LatencyHistogram::getBucketIndex(const unsigned long long value){
+
+    //Values below NUM_SUB_BUCKETS are counted exactly
+    if( value < NUM_SUB_BUCKETS ) return (UINT)value;
+
+    //Otherwise find the shift that puts the value in the range [NUM_SUB_BUCKETS 2*NUM_SUB_BUCKETS), the shift selects
+    //the power of two and the remaining bits select the sub bucket
+    UINT shift = 0;
+    unsigned long long x = value >> 5;
+    while( x ){
+        x >>= 1;
+        shift++;
+    }
+    return NUM_SUB_BUCKETS*(shift+1) + (UINT)( (value >> shift) - NUM_SUB_BUCKETS );
+}
+
+unsigned long long LatencyHistogram::getBucketUpperBound(const UINT bucketIndex){
+    if( bucketIndex < NUM_SUB_BUCKETS ) return bucketIndex;
+    const UINT shift = bucketIndex/NUM_SUB_BUCKETS - 1;
+    const unsigned long long lowerBound = (unsigned long long)( NUM_SUB_BUCKETS + bucketIndex%NUM_SUB_BUCKETS ) << shift;
+    return lowerBound + ( (1ull << shift) - 1 );
+}
+
+}//End of namespace GRT
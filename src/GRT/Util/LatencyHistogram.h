@@ -0,0 +1,138 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The LatencyHistogram class counts a stream of non-negative integer values (such as times in nanoseconds) in a
+ fixed set of log-linear buckets, so that the median, the 99th percentile or any other percentile of the stream can be
+ estimated without storing the values.
+
+ Each power of two is split into 16 buckets, so a percentile is always within 1/16 (6.25%) of the true value, while the
+ whole range of a 64 bit value fits in a fixed number of buckets. The maximum value is stored exactly. The counters are
+ atomic if the compiler supports C++11, so one thread can record values without locking while other threads read the
+ percentiles.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_LATENCY_HISTOGRAM_HEADER
+#define GRT_LATENCY_HISTOGRAM_HEADER
+
+#include "GRTCommon.h"
+
+#ifdef GRT_CXX11_ENABLED
+    #include <atomic>
+#endif
+
+namespace GRT{
+
+class LatencyHistogram{
+public:
+    enum{ NUM_SUB_BUCKETS=16, NUM_BUCKETS=976 };
+
+    /**
+     Default Constructor.
+     */
+    LatencyHistogram();
+
+    /**
+     Copy Constructor, copies the counts from the rhs instance.
+     */
+    LatencyHistogram(const LatencyHistogram &rhs);
+
+    /**
+     Default Destructor.
+     */
+    ~LatencyHistogram();
+
+    /**
+     Defines the equals operator, copies the counts from the rhs instance.
+     */
+    LatencyHistogram& operator=(const LatencyHistogram &rhs);
+
+    /**
+     Adds a value to the histogram. This does not allocate any memory or take any locks.
+
+     @param const unsigned long long value: the value to add
+     */
+    void record(const unsigned long long value);
+
+    /**
+     Removes all the values from the histogram.
+     */
+    void reset();
+
+    unsigned long long getNumSamples() const;
+    unsigned long long getSum() const;
+    unsigned long long getMaximum() const;
+    double getMean() const;
+
+    /**
+     Gets an estimate of the percentile of the values that have been added. The estimate is the upper bound of the
+     bucket that contains the percentile, limited to the maximum value.
+
+     @param const double percentile: the percentile, in the range [0 100]
+     @return returns the estimated percentile, or zero if no values have been added
+     */
+    unsigned long long getPercentile(const double percentile) const;
+
+    /**
+     Gets the index of the bucket that counts the value.
+     */
+    static UINT getBucketIndex(const unsigned long long value);
+
+    /**
+     Gets the largest value that is counted in the bucket.
+     */
+    static unsigned long long getBucketUpperBound(const UINT bucketIndex);
+
+protected:
+#ifdef GRT_CXX11_ENABLED
+    typedef std::atomic< unsigned long long > Counter;
+#else
+    typedef unsigned long long Counter;
+#endif
+
+    static inline unsigned long long load(const Counter &counter){
+#ifdef GRT_CXX11_ENABLED
+        return counter.load( std::memory_order_relaxed );
+#else
+        return counter;
+#endif
+    }
+
+    static inline void store(Counter &counter,const unsigned long long value){
+#ifdef GRT_CXX11_ENABLED
+        counter.store( value, std::memory_order_relaxed );
+#else
+        counter = value;
+#endif
+    }
+
+    Counter counts[NUM_BUCKETS];
+    Counter numSamples;
+    Counter sum;
+    Counter maximum;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_LATENCY_HISTOGRAM_HEADER
@@ -0,0 +1,179 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ParallelTaskRunner.h"
+#include <vector>
+
+//Pick the thread implementation
+#if defined(GRT_CXX11_ENABLED)
+    #include <thread>
+    #include <mutex>
+#elif defined(__GRT_OSX_BUILD__) || defined(__GRT_LINUX_BUILD__)
+    #define GRT_PTHREADS_ENABLED
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+namespace GRT{
+
+UINT ParallelTaskRunner::defaultNumThreads = 0;
+
+//The state that is shared by all the threads running the same set of tasks
+class ParallelTaskRunnerState{
+public:
+    ParallelTaskRunnerState(ParallelTask &task,const UINT numTasks):task(task),numTasks(numTasks){
+        nextTask = 0;
+        failed = false;
+#ifdef GRT_PTHREADS_ENABLED
+        pthread_mutex_init( &mutex, NULL );
+#endif
+    }
+    ~ParallelTaskRunnerState(){
+#ifdef GRT_PTHREADS_ENABLED
+        pthread_mutex_destroy( &mutex );
+#endif
+    }
+
+    inline void lock(){
+#if defined(GRT_CXX11_ENABLED)
+        mutex.lock();
+#elif defined(GRT_PTHREADS_ENABLED)
+        pthread_mutex_lock( &mutex );
+#endif
+    }
+
+    inline void unlock(){
+#if defined(GRT_CXX11_ENABLED)
+        mutex.unlock();
+#elif defined(GRT_PTHREADS_ENABLED)
+        pthread_mutex_unlock( &mutex );
+#endif
+    }
+
+    //Runs tasks until there are none left, this is called by each thread
+    void runTasks(const UINT threadIndex){
+        while( true ){
+            lock();
+            const UINT taskIndex = failed ? numTasks : nextTask++;
+            unlock();
+
+            if( taskIndex >= numTasks ) return;
+
+            if( !task.runTask(taskIndex,threadIndex) ){
+                lock();
+                failed = true;
+                unlock();
+            }
+        }
+    }
+
+    ParallelTask &task;
+    const UINT numTasks;
+    UINT nextTask;
+    bool failed;
+#if defined(GRT_CXX11_ENABLED)
+    std::mutex mutex;
+#elif defined(GRT_PTHREADS_ENABLED)
+    pthread_mutex_t mutex;
+#endif
+};
+
+#ifdef GRT_PTHREADS_ENABLED
+struct ParallelTaskRunnerThreadData{
+    ParallelTaskRunnerState *state;
+    UINT threadIndex;
+};
+
+static void* parallelTaskRunnerThreadFunction(void *data){
+    ParallelTaskRunnerThreadData *threadData = (ParallelTaskRunnerThreadData*)data;
+    threadData->state->runTasks( threadData->threadIndex );
+    return NULL;
+}
+#endif
+
+bool ParallelTaskRunner::run(ParallelTask &task,const UINT numTasks,const UINT numThreads){
+
+    if( numTasks == 0 ) return true;
+
+    const UINT numThreadsToUse = getNumThreadsForTasks(numTasks,numThreads);
+    ParallelTaskRunnerState state(task,numTasks);
+
+    //If there is only one thread then just run the tasks on this thread
+    if( numThreadsToUse == 1 ){
+        state.runTasks( 0 );
+        return !state.failed;
+    }
+
+#if defined(GRT_CXX11_ENABLED)
+    std::vector< std::thread > threads;
+    threads.reserve( numThreadsToUse-1 );
+    for(UINT i=1; i<numThreadsToUse; i++){
+        threads.push_back( std::thread(&ParallelTaskRunnerState::runTasks,&state,i) );
+    }
+    state.runTasks( 0 );
+    for(UINT i=0; i<threads.size(); i++){
+        threads[i].join();
+    }
+#elif defined(GRT_PTHREADS_ENABLED)
+    std::vector< pthread_t > threads( numThreadsToUse-1 );
+    std::vector< bool > threadStarted( numThreadsToUse-1, false );
+    std::vector< ParallelTaskRunnerThreadData > threadData( numThreadsToUse-1 );
+    for(UINT i=1; i<numThreadsToUse; i++){
+        threadData[i-1].state = &state;
+        threadData[i-1].threadIndex = i;
+        threadStarted[i-1] = pthread_create( &threads[i-1], NULL, parallelTaskRunnerThreadFunction, &threadData[i-1] ) == 0;
+    }
+    //If a thread could not be started then the other threads (including this one) will run its share of the tasks
+    state.runTasks( 0 );
+    for(UINT i=0; i<threads.size(); i++){
+        if( threadStarted[i] ) pthread_join( threads[i], NULL );
+    }
+#else
+    state.runTasks( 0 );
+#endif
+
+    return !state.failed;
+}
+
+UINT ParallelTaskRunner::getNumThreadsForTasks(const UINT numTasks,const UINT numThreads){
+    UINT n = numThreads > 0 ? numThreads : getDefaultNumThreads();
+    if( n > numTasks ) n = numTasks;
+    return n > 0 ? n : 1;
+}
+
+void ParallelTaskRunner::setDefaultNumThreads(const UINT numThreads){
+    defaultNumThreads = numThreads;
+}
+
+UINT ParallelTaskRunner::getDefaultNumThreads(){
+    return defaultNumThreads > 0 ? defaultNumThreads : getNumHardwareThreads();
+}
+
+UINT ParallelTaskRunner::getNumHardwareThreads(){
+    long n = 1;
+#if defined(GRT_CXX11_ENABLED)
+    n = (long)std::thread::hardware_concurrency();
+#elif defined(GRT_PTHREADS_ENABLED)
+    n = sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+    return n > 0 ? (UINT)n : 1;
+}
+
+}//End of namespace GRT
@@ -0,0 +1,111 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The ParallelTaskRunner class runs a number of independent tasks across a number of threads.
+
+ A task is any class that inherits from ParallelTask and implements the runTask(...) function. The runner calls
+ runTask once for each task index, and passes the index of the thread that is running the task so that each thread
+ can use its own workspace. The tasks are handed out to the threads one at a time, so the order in which the tasks
+ are run is not fixed. Algorithms that need the same result regardless of the number of threads should therefore
+ write the result of each task into its own slot and reduce the slots in task order once all the tasks have finished.
+
+ The threads are created using std::thread if the compiler supports C++11, or pthreads on OS X and Linux. If neither
+ is available then all the tasks are run on the calling thread.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_PARALLEL_TASK_RUNNER_HEADER
+#define GRT_PARALLEL_TASK_RUNNER_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+class ParallelTask{
+public:
+    virtual ~ParallelTask(){}
+
+    /**
+     Runs one task. This function will be called from several threads at the same time, so it must only write to
+     data that belongs to this task index or to this thread index.
+
+     @param const UINT taskIndex: the index of the task that should be run, in the range [0 numTasks-1]
+     @param const UINT threadIndex: the index of the thread that is running the task, in the range [0 numThreads-1]
+     @return returns true if the task was successful, false otherwise
+     */
+    virtual bool runTask(const UINT taskIndex,const UINT threadIndex) = 0;
+};
+
+class ParallelTaskRunner{
+public:
+    /**
+     Runs numTasks tasks using up to numThreads threads (including the calling thread). The function returns once all
+     the tasks have finished.
+
+     @param ParallelTask &task: the task that should be run
+     @param const UINT numTasks: the number of tasks that should be run
+     @param const UINT numThreads: the maximum number of threads that should be used, zero will use the default number of threads
+     @return returns true if all the tasks were successful, false otherwise
+     */
+    static bool run(ParallelTask &task,const UINT numTasks,const UINT numThreads = 0);
+
+    /**
+     Gets the number of threads that run(...) will use for the given number of tasks. This can be used to allocate
+     one workspace for each thread before the tasks are run.
+
+     @param const UINT numTasks: the number of tasks that will be run
+     @param const UINT numThreads: the maximum number of threads that should be used, zero will use the default number of threads
+     @return returns the number of threads that will be used, this will be at least 1
+     */
+    static UINT getNumThreadsForTasks(const UINT numTasks,const UINT numThreads = 0);
+
+    /**
+     Sets the default maximum number of threads, which is used when a module does not set its own number of threads.
+     Setting this to 1 will run all the tasks on the calling thread.
+
+     @param const UINT numThreads: the default number of threads, zero will use the number of hardware threads
+     */
+    static void setDefaultNumThreads(const UINT numThreads);
+
+    /**
+     Gets the default maximum number of threads.
+
+     @return returns the default number of threads, this will be the number of hardware threads unless it has been set by setDefaultNumThreads(...)
+     */
+    static UINT getDefaultNumThreads();
+
+    /**
+     Gets the number of threads that the hardware can run at the same time.
+
+     @return returns the number of hardware threads, or 1 if threads are not supported or the number is unknown
+     */
+    static UINT getNumHardwareThreads();
+
+protected:
+    static UINT defaultNumThreads;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_PARALLEL_TASK_RUNNER_HEADER
@@ -0,0 +1,187 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PipelineProfiler.h"
+
+//Allocation counting replaces the global operator new, so it is only built if it is requested
+#if defined(GRT_PROFILE_ALLOCATIONS) && defined(GRT_CXX11_ENABLED)
+    #define GRT_ALLOCATION_COUNTING_ENABLED
+    #include <new>
+
+static thread_local unsigned long long grtThreadAllocationCount = 0;
+
+void* operator new(std::size_t size){
+    grtThreadAllocationCount++;
+    void *p = malloc( size > 0 ? size : 1 );
+    if( p == NULL ) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size){
+    grtThreadAllocationCount++;
+    void *p = malloc( size > 0 ? size : 1 );
+    if( p == NULL ) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept{
+    free( p );
+}
+
+void operator delete[](void *p) noexcept{
+    free( p );
+}
+#endif
+
+namespace GRT{
+
+PipelineProfiler::PipelineProfiler(){
+    //The stats are allocated by the first record, so a pipeline that is never profiled doesn't carry the histograms
+    enabled = false;
+}
+
+PipelineProfiler::~PipelineProfiler(){
+
+}
+
+bool PipelineProfiler::setEnabled(const bool enabled){
+    this->enabled = enabled;
+    return true;
+}
+
+bool PipelineProfiler::reset(){
+    stageStats.clear();
+    moduleStats.clear();
+    return true;
+}
+
+bool PipelineProfiler::record(const UINT stage,const UINT moduleIndex,const unsigned long long time,const unsigned long long numAllocations){
+
+    if( stage >= NUM_STAGES ) return false;
+
+    if( stageStats.size() == 0 ){
+        stageStats.resize( NUM_STAGES );
+        moduleStats.resize( NUM_STAGES );
+    }
+
+    PipelineProfilerStats *stats = NULL;
+    if( moduleIndex == STAGE_TOTAL ){
+        stats = &stageStats[ stage ];
+    }else{
+        if( moduleIndex >= moduleStats[ stage ].size() ){
+            moduleStats[ stage ].resize( moduleIndex+1 );
+        }
+        stats = &moduleStats[ stage ][ moduleIndex ];
+    }
+
+    stats->time.record( time );
+    stats->allocations.record( numAllocations );
+
+    return true;
+}
+
+UINT PipelineProfiler::getNumModules(const UINT stage) const{
+    if( stage >= moduleStats.size() ) return 0;
+    return (UINT)moduleStats[ stage ].size();
+}
+
+const PipelineProfilerStats* PipelineProfiler::getStats(const UINT stage,const UINT moduleIndex) const{
+    if( stage >= stageStats.size() ) return NULL;
+    if( moduleIndex == STAGE_TOTAL ) return &stageStats[ stage ];
+    if( moduleIndex >= moduleStats[ stage ].size() ) return NULL;
+    return &moduleStats[ stage ][ moduleIndex ];
+}
+
+string PipelineProfiler::getJSON(const vector< vector< string > > &moduleNames) const{
+
+    std::ostringstream stream;
+    stream << "{\n";
+    stream << "  \"allocationCountingEnabled\": " << (getAllocationCountingEnabled() ? "true" : "false") << ",\n";
+    stream << "  \"stages\": [\n";
+
+    bool firstStage = true;
+    for(UINT stage=0; stage<stageStats.size(); stage++){
+
+        //Only write the stages that have been used
+        if( stageStats[stage].time.getNumSamples() == 0 && moduleStats[stage].size() == 0 ) continue;
+
+        if( !firstStage ) stream << ",\n";
+        firstStage = false;
+
+        stream << "    {\"stage\": \"" << getStageName(stage) << "\", ";
+        writeStats( stream, stageStats[stage] );
+        stream << ", \"modules\": [";
+        for(UINT i=0; i<moduleStats[stage].size(); i++){
+            if( i > 0 ) stream << ",";
+            stream << "\n      {\"index\": " << i << ", \"name\": \"";
+            if( stage < moduleNames.size() && i < moduleNames[stage].size() ) stream << moduleNames[stage][i];
+            stream << "\", ";
+            writeStats( stream, moduleStats[stage][i] );
+            stream << "}";
+        }
+        stream << (moduleStats[stage].size() > 0 ? "\n    ]}" : "]}");
+    }
+
+    stream << "\n  ]\n}\n";
+
+    return stream.str();
+}
+
+string PipelineProfiler::getStageName(const UINT stage){
+    switch( stage ){
+        case PREDICT: return "PREDICT";
+        case CONTEXT_START_OF_PIPELINE: return "CONTEXT_START_OF_PIPELINE";
+        case PRE_PROCESSING: return "PRE_PROCESSING";
+        case CONTEXT_AFTER_PREPROCESSING: return "CONTEXT_AFTER_PREPROCESSING";
+        case FEATURE_EXTRACTION: return "FEATURE_EXTRACTION";
+        case CONTEXT_AFTER_FEATURE_EXTRACTION: return "CONTEXT_AFTER_FEATURE_EXTRACTION";
+        case CLASSIFIER: return "CLASSIFIER";
+        case CONTEXT_AFTER_CLASSIFIER: return "CONTEXT_AFTER_CLASSIFIER";
+        case POST_PROCESSING: return "POST_PROCESSING";
+        case CONTEXT_END_OF_PIPELINE: return "CONTEXT_END_OF_PIPELINE";
+    }
+    return "UNKNOWN";
+}
+
+unsigned long long PipelineProfiler::getThreadAllocationCount(){
+#ifdef GRT_ALLOCATION_COUNTING_ENABLED
+    return grtThreadAllocationCount;
+#else
+    return 0;
+#endif
+}
+
+bool PipelineProfiler::getAllocationCountingEnabled(){
+#ifdef GRT_ALLOCATION_COUNTING_ENABLED
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PipelineProfiler::writeStats(std::ostream &stream,const PipelineProfilerStats &stats){
+    stream << "\"calls\": " << stats.time.getNumSamples();
+    stream << ", \"timeNs\": {\"mean\": " << stats.time.getMean() << ", \"p50\": " << stats.time.getPercentile(50) << ", \"p99\": " << stats.time.getPercentile(99) << ", \"max\": " << stats.time.getMaximum() << "}";
+    if( getAllocationCountingEnabled() ){
+        stream << ", \"allocations\": {\"mean\": " << stats.allocations.getMean() << ", \"p50\": " << stats.allocations.getPercentile(50) << ", \"p99\": " << stats.allocations.getPercentile(99) << ", \"max\": " << stats.allocations.getMaximum() << "}";
+    }
+}
+
+}//End of namespace GRT
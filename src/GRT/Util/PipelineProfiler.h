@@ -0,0 +1,185 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The PipelineProfiler class records how long each stage and each module of a GestureRecognitionPipeline takes
+ to process each prediction, and how many memory allocations it makes, so that you can see which module is using up
+ the frame budget.
+
+ The times are measured with Timer::getHighResolutionTime() and stored in nanoseconds in a LatencyHistogram for each
+ stage and each module, so the mean, median, 99th percentile and maximum can be read at any time. Allocations are only
+ counted if the GRT is built with GRT_PROFILE_ALLOCATIONS defined, which replaces the global operator new with a
+ version that counts the allocations made by each thread. The stats for a module are created the first time the
+ module is recorded, after that recording a value does not allocate memory or take a lock.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_PIPELINE_PROFILER_HEADER
+#define GRT_PIPELINE_PROFILER_HEADER
+
+#include "GRTCommon.h"
+#include "LatencyHistogram.h"
+
+namespace GRT{
+
+class PipelineProfilerStats{
+public:
+    LatencyHistogram time;              ///< The time of each call, in nanoseconds
+    LatencyHistogram allocations;       ///< The number of memory allocations made by each call
+};
+
+class PipelineProfiler{
+public:
+    enum Stages{
+        PREDICT=0,
+        CONTEXT_START_OF_PIPELINE,
+        PRE_PROCESSING,
+        CONTEXT_AFTER_PREPROCESSING,
+        FEATURE_EXTRACTION,
+        CONTEXT_AFTER_FEATURE_EXTRACTION,
+        CLASSIFIER,
+        CONTEXT_AFTER_CLASSIFIER,
+        POST_PROCESSING,
+        CONTEXT_END_OF_PIPELINE,
+        NUM_STAGES
+    };
+
+    //The module index used to record the total time of a stage
+    enum{ STAGE_TOTAL=0xFFFFFFFF };
+
+    /**
+     Default Constructor. The profiler is disabled by default.
+     */
+    PipelineProfiler();
+
+    /**
+     Default Destructor.
+     */
+    ~PipelineProfiler();
+
+    /**
+     Enables or disables the profiler. When the profiler is disabled, the pipeline does not read the clock.
+
+     @param const bool enabled: true if the profiler should record the pipeline
+     @return returns true if the parameter was set
+     */
+    bool setEnabled(const bool enabled);
+
+    /**
+     Removes all the recorded values.
+
+     @return returns true if the profiler was reset
+     */
+    bool reset();
+
+    /**
+     Records the time and number of allocations of one call to a stage or a module.
+
+     @param const UINT stage: the stage, this must be one of the Stages enums
+     @param const UINT moduleIndex: the index of the module within the stage, or STAGE_TOTAL for the whole stage
+     @param const unsigned long long time: the time of the call, in nanoseconds
+     @param const unsigned long long numAllocations: the number of memory allocations made during the call
+     @return returns true if the values were recorded, false otherwise
+     */
+    bool record(const UINT stage,const UINT moduleIndex,const unsigned long long time,const unsigned long long numAllocations);
+
+    bool getEnabled() const { return enabled; }
+
+    /**
+     Gets the number of modules that have been recorded in the stage.
+     */
+    UINT getNumModules(const UINT stage) const;
+
+    /**
+     Gets the stats of a stage or a module.
+
+     @param const UINT stage: the stage, this must be one of the Stages enums
+     @param const UINT moduleIndex: the index of the module within the stage, or STAGE_TOTAL for the whole stage
+     @return returns a pointer to the stats, or NULL if the stage or module has not been recorded
+     */
+    const PipelineProfilerStats* getStats(const UINT stage,const UINT moduleIndex = STAGE_TOTAL) const;
+
+    /**
+     Gets the stats of every stage and module as a JSON string. Times are in nanoseconds.
+
+     @param const vector< vector< string > > &moduleNames: the name of each module in each stage, this can be empty or shorter than the number of modules
+     @return returns a JSON string with the stats
+     */
+    string getJSON(const vector< vector< string > > &moduleNames = vector< vector< string > >()) const;
+
+    /**
+     Gets the name of a stage, as used in the JSON output.
+     */
+    static string getStageName(const UINT stage);
+
+    /**
+     Gets the number of memory allocations made by the calling thread so far. This is always zero unless the GRT was
+     built with GRT_PROFILE_ALLOCATIONS defined.
+     */
+    static unsigned long long getThreadAllocationCount();
+
+    /**
+     Gets if allocations are being counted, i.e. if the GRT was built with GRT_PROFILE_ALLOCATIONS defined.
+     */
+    static bool getAllocationCountingEnabled();
+
+protected:
+    static void writeStats(std::ostream &stream,const PipelineProfilerStats &stats);
+
+    bool enabled;
+    vector< PipelineProfilerStats > stageStats;                     ///< The total stats for each stage
+    vector< vector< PipelineProfilerStats > > moduleStats;          ///< The stats for each module in each stage
+};
+
+/**
+ Records the time and allocations between the construction and destruction of the scope, if the profiler is enabled.
+ */
+class PipelineProfilerScope{
+public:
+    PipelineProfilerScope(PipelineProfiler &profiler,const UINT stage,const UINT moduleIndex = PipelineProfiler::STAGE_TOTAL):profiler(profiler),stage(stage),moduleIndex(moduleIndex){
+        enabled = profiler.getEnabled();
+        if( enabled ){
+            startAllocations = PipelineProfiler::getThreadAllocationCount();
+            startTime = Timer::getHighResolutionTime();
+        }
+    }
+
+    ~PipelineProfilerScope(){
+        if( enabled ){
+            const unsigned long long time = Timer::getHighResolutionTime() - startTime;
+            profiler.record( stage, moduleIndex, time, PipelineProfiler::getThreadAllocationCount() - startAllocations );
+        }
+    }
+
+protected:
+    PipelineProfiler &profiler;
+    const UINT stage;
+    const UINT moduleIndex;
+    bool enabled;
+    unsigned long long startTime;
+    unsigned long long startAllocations;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_PIPELINE_PROFILER_HEADER
@@ -0,0 +1,130 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "GRTCommon.h"
+
+#ifdef GRT_SSE2_ENABLED
+    #include <emmintrin.h>
+#endif
+
+namespace GRT{
+
+#ifdef GRT_SSE2_ENABLED
+//The 32x32 bit products of the four lanes of a and m (m must hold the same value in every lane)
+static inline void philoxMulHiLo(const __m128i a,const __m128i m,__m128i &hi,__m128i &lo){
+    const __m128i p02 = _mm_mul_epu32( a, m );
+    const __m128i p13 = _mm_mul_epu32( _mm_srli_epi64( a, 32 ), m );
+    lo = _mm_unpacklo_epi32( _mm_shuffle_epi32( p02, _MM_SHUFFLE(0,0,2,0) ), _mm_shuffle_epi32( p13, _MM_SHUFFLE(0,0,2,0) ) );
+    hi = _mm_unpacklo_epi32( _mm_shuffle_epi32( p02, _MM_SHUFFLE(0,0,3,1) ), _mm_shuffle_epi32( p13, _MM_SHUFFLE(0,0,3,1) ) );
+}
+#endif
+
+void Random::getRandomNumbersUniform(double *values,UINT N,double minRange,double maxRange){
+
+    const double range = maxRange-minRange;
+    UINT i = 0;
+
+    //Use up the rest of the current block first, so the values carry on from the last scalar call
+    while( i < N && bufferIndex != 2 ){
+        values[i++] = (doub()*range)+minRange;
+    }
+
+#ifdef GRT_SSE2_ENABLED
+    //Compute four blocks at a time, with one block in each lane. x[w*4+b] holds word w of block b
+    const __m128i m0 = _mm_set1_epi32( (int)PHILOX_M0 );
+    const __m128i m1 = _mm_set1_epi32( (int)PHILOX_M1 );
+    const __m128i w0 = _mm_set1_epi32( (int)PHILOX_W0 );
+    const __m128i w1 = _mm_set1_epi32( (int)PHILOX_W1 );
+    unsigned int x[16];
+    while( N - i >= 8 ){
+        const unsigned long long n = blockIndex;
+        __m128i x0 = _mm_set_epi32( (int)(unsigned int)(n+3), (int)(unsigned int)(n+2), (int)(unsigned int)(n+1), (int)(unsigned int)n );
+        __m128i x1 = _mm_set_epi32( (int)(unsigned int)((n+3)>>32), (int)(unsigned int)((n+2)>>32), (int)(unsigned int)((n+1)>>32), (int)(unsigned int)(n>>32) );
+        __m128i x2 = _mm_set1_epi32( (int)(unsigned int)stream );
+        __m128i x3 = _mm_set1_epi32( (int)(unsigned int)(stream >> 32) );
+        __m128i k0 = _mm_set1_epi32( (int)(unsigned int)seed );
+        __m128i k1 = _mm_set1_epi32( (int)(unsigned int)(seed >> 32) );
+        __m128i hi0,lo0,hi1,lo1;
+        for(UINT r=0; r<10; r++){
+            philoxMulHiLo( x0, m0, hi0, lo0 );
+            philoxMulHiLo( x2, m1, hi1, lo1 );
+            x0 = _mm_xor_si128( _mm_xor_si128( hi1, x1 ), k0 );
+            x1 = lo1;
+            x2 = _mm_xor_si128( _mm_xor_si128( hi0, x3 ), k1 );
+            x3 = lo0;
+            k0 = _mm_add_epi32( k0, w0 );
+            k1 = _mm_add_epi32( k1, w1 );
+        }
+        _mm_storeu_si128( (__m128i*)&x[0], x0 );
+        _mm_storeu_si128( (__m128i*)&x[4], x1 );
+        _mm_storeu_si128( (__m128i*)&x[8], x2 );
+        _mm_storeu_si128( (__m128i*)&x[12], x3 );
+        for(UINT b=0; b<4; b++){
+            values[i++] = (toDouble( ((unsigned long long)x[4+b] << 32) | x[b] )*range)+minRange;
+            values[i++] = (toDouble( ((unsigned long long)x[12+b] << 32) | x[8+b] )*range)+minRange;
+        }
+        blockIndex += 4;
+    }
+#endif
+
+    //Compute the remaining whole blocks one at a time
+    unsigned int y[4];
+    while( N - i >= 2 ){
+        philox(seed,stream,blockIndex++,y);
+        values[i++] = (toDouble( ((unsigned long long)y[1] << 32) | y[0] )*range)+minRange;
+        values[i++] = (toDouble( ((unsigned long long)y[3] << 32) | y[2] )*range)+minRange;
+    }
+
+    //The last value starts a new block, the other half of the block is kept for the next call
+    if( i < N ){
+        values[i++] = (doub()*range)+minRange;
+    }
+}
+
+void Random::getRandomNumbersGauss(double *values,UINT N,double mu,double sigma){
+
+    UINT i = 0;
+    if( i < N && hasStoredGauss ){
+        hasStoredGauss = false;
+        values[i++] = mu + sigma*storedGauss;
+    }
+
+    //Draw the uniform values in chunks, each pair of uniform values gives two Gaussian values
+    const UINT CHUNK_SIZE = 64;
+    double u[ CHUNK_SIZE ];
+    while( i < N ){
+        const UINT numPairs = std::min( (N-i+1)/2, CHUNK_SIZE/2 );
+        getRandomNumbersUniform(u,numPairs*2);
+        for(UINT p=0; p<numPairs; p++){
+            double z0 = 0;
+            double z1 = 0;
+            boxMuller( u[p*2], u[p*2+1], z0, z1 );
+            values[i++] = mu + sigma*z0;
+            if( i < N ){
+                values[i++] = mu + sigma*z1;
+            }else{
+                storedGauss = z1;
+                hasStoredGauss = true;
+            }
+        }
+    }
+}
+
+}//End of namespace GRT
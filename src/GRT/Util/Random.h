@@ -5,6 +5,13 @@
 
  @brief This file contains the Random class, a useful wrapper for generating cross platform random functions. 
  This includes functions for uniform distributions (both integer and double) and Gaussian distributions.
+
+ The random numbers are generated by the Philox4x32-10 counter-based generator (Salmon et al., "Parallel random numbers:
+ as easy as 1, 2, 3", SC 2011). Each block of random numbers is a function of the seed, the stream and the index of the
+ block, so the generator has no hidden state beyond those values and the random numbers are the same on every platform.
+ A generator can be split into any number of independent streams (see split), for example one stream for each task run
+ by the ParallelTaskRunner. As each stream only depends on the seed and the stream index, and not on the thread that uses
+ it or the order the tasks are run in, a model trained in parallel can be bit-for-bit reproduced by setting the seed.
  */
 
 /*
@@ -32,6 +39,7 @@
 
 #include "../Util/GRTVersionInfo.h"
 #include "Timer.h"
+#include <algorithm>
 
 namespace GRT{
 
@@ -42,13 +50,10 @@ public:
 	Sets the random seed. If no seed is supplied then the seed will be set using the current system time.
 	
 	@param unsigned long long seed: sets the current seed, If no seed is supplied then the seed will be set using the current system time
+	@param unsigned long long stream: sets the stream of random numbers that will be used for this seed. Default stream = 0
 	*/
-    Random(unsigned long long seed = 0):v(4101842887655102017LL), w(1), storedval(0.0){
-        if( seed == 0 ){
-            Timer t;
-            seed = (unsigned long long)t.getSystemTime();
-        }
-        setSeed( seed );
+    Random(unsigned long long seed = 0,unsigned long long stream = 0){
+        setSeed( seed, stream );
     }
 
     /**
@@ -58,24 +63,53 @@ public:
     }
     
     /**
-	Sets the current seed used to compute the random distrubutions.
+	Sets the current seed used to compute the random distrubutions. This restarts the stream from its first random number.
 	
 	@param unsigned long long seed: sets the current seed, If no seed is supplied then the seed will be set using the current system time
+	@param unsigned long long stream: sets the stream of random numbers that will be used for this seed. Default stream = 0
 	@return returns void
 	*/
-    void setSeed(unsigned long long seed = 0){
+    void setSeed(unsigned long long seed = 0,unsigned long long stream = 0){
         if( seed == 0 ){
+            //Mix in the address of this instance, so generators that are created at the same time get different seeds
             Timer t;
-            seed = (unsigned long long)t.getSystemTime();
+            seed = mix( (unsigned long long)t.getSystemTime() ) ^ mix( (unsigned long long)(size_t)this );
+            if( seed == 0 ) seed = 1;
         }
-        v = 4101842887655102017LL;
-        w = 1;
-        storedval = 0;
-        u = seed ^ v; int64();
-        v = u; int64();
-        w = v; int64();
+        this->seed = seed;
+        this->stream = stream;
+        blockIndex = 0;
+        bufferIndex = 2;
+        hasStoredGauss = false;
+        storedGauss = 0;
     }
-    
+
+    /**
+     Gets the seed used by this generator. If the generator was seeded with zero, this is the seed that was generated
+     from the system time, so it can be used to reproduce the random numbers.
+
+     @return returns the seed
+     */
+    unsigned long long getSeed() const{ return seed; }
+
+    /**
+     @return returns the stream used by this generator
+     */
+    unsigned long long getStream() const{ return stream; }
+
+    /**
+     Creates a new generator that uses an independent stream of random numbers. The stream of the new generator only
+     depends on the seed and stream of this generator and the streamIndex, it does not depend on how many random numbers
+     have already been drawn from this generator. Splitting a generator with the task index therefore gives each task
+     the same random numbers for any number of threads, and streams can be split again to build a tree of streams.
+
+     @param unsigned long long streamIndex: the index of the new stream, each index gives a different stream
+     @return returns a new generator, starting at the first random number of the new stream
+     */
+    Random split(unsigned long long streamIndex) const{
+        return Random( seed, mix( stream ^ mix( streamIndex + 0x9E3779B97F4A7C15ULL ) ) );
+    }
+
     /**
 	Gets a random integer in the range [minRange maxRange-1], using a uniform distribution
 	
@@ -86,6 +120,40 @@ public:
     inline int getRandomNumberInt(int minRange,int maxRange){
         return int( floor(getRandomNumberUniform(minRange,maxRange)) );
     }
+
+    /**
+     Gets a random index in the range [0 n-1], using a uniform distribution
+
+     @param unsigned int n: the number of possible indexs, must be greater than zero
+     @return returns an index in the range [0 n-1]
+     */
+    inline unsigned int getRandomIndex(unsigned int n){
+        return (unsigned int)( ( (unsigned long long)int32() * n ) >> 32 );
+    }
+
+    /**
+     Gets a random 64 bit integer, using a uniform distribution. This can be used to seed another generator.
+
+     @return returns a random 64 bit integer
+     */
+    inline unsigned long long getRandomNumberUInt64(){
+        return int64();
+    }
+
+    /**
+     Randomly shuffles the values in the range [first last), using the Fisher-Yates shuffle. Unlike std::random_shuffle
+     this does not use the global rand() state, so the order only depends on the seed and stream of this generator.
+
+     @param RandomAccessIterator first: the start of the range that should be shuffled
+     @param RandomAccessIterator last: the end of the range that should be shuffled
+     @return returns void
+     */
+    template< class RandomAccessIterator >
+    void shuffle(RandomAccessIterator first,RandomAccessIterator last){
+        for(unsigned int i=(unsigned int)(last-first); i>1; i--){
+            std::swap( first[i-1], first[ getRandomIndex(i) ] );
+        }
+    }
     
     /**
      Gets a random integer from the vector values. The probability of choosing a specific integer from the
@@ -177,11 +245,10 @@ public:
         //Generate a random value between min and the max weighted double values
         double randValue = getRandomNumberUniform(0,x[N-1]);
         
-        //Find which bin the rand value falls into, return the index of that bin
-        for(unsigned int i=0; i<N; i++){
-            if( randValue <= x[i] ){
-                return weightedValues[ i ].index;
-            }
+        //Find which bin the rand value falls into, the lookup table is sorted so a binary search can be used
+        vector< double >::const_iterator bin = std::lower_bound(x.begin(),x.end(),randValue);
+        if( bin != x.end() ){
+            return weightedValues[ bin - x.begin() ].index;
         }
         return 0;
     }
@@ -205,24 +272,44 @@ public:
 	@return returns a double from the Gaussian distribution controlled by mu and sigma
 	*/
     double getRandomNumberGauss(double mu=0.0,double sigma=1.0){
-        double v1,v2,rsq,fac;
-        
-        if (storedval == 0.){
-            do {
-                v1=2.0*doub()-1.0;
-                v2=2.0*doub()-1.0;
-                rsq=v1*v1+v2*v2;
-            } while (rsq >= 1.0 || rsq == 0.0);
-            fac=sqrt(-2.0*log(rsq)/rsq);
-            storedval = v1*fac;
-            return mu + sigma*v2*fac;
-        } else {
-            fac = storedval;
-            storedval = 0.;
-            return mu + sigma*fac;
+        if( hasStoredGauss ){
+            hasStoredGauss = false;
+            return mu + sigma*storedGauss;
         }
+        //Box-Muller, each pair of uniform values gives two Gaussian values
+        const double u1 = doub();
+        const double u2 = doub();
+        double z0 = 0;
+        boxMuller( u1, u2, z0, storedGauss );
+        hasStoredGauss = true;
+        return mu + sigma*z0;
     }
     
+    /**
+     Fills an array with random doubles drawn from the uniform distribution set by the minRange and maxRange. The values
+     are the same as calling getRandomNumberUniform N times, but whole blocks of the generator are computed at once
+     (using SSE2 if it is available), which is several times faster for large arrays.
+
+     @param double *values: the array that will be filled, this must have space for N values
+     @param UINT N: the number of values
+     @param double minRange: the minimum value in the range (inclusive)
+     @param double maxRange: the maximum value in the range (inclusive)
+     @return returns void
+     */
+    void getRandomNumbersUniform(double *values,UINT N,double minRange=0.0,double maxRange=1.0);
+
+    /**
+     Fills an array with random doubles drawn from the Gaussian distribution controlled by mu and sigma. The values are
+     the same as calling getRandomNumberGauss N times.
+
+     @param double *values: the array that will be filled, this must have space for N values
+     @param UINT N: the number of values
+     @param double mu: the mu parameter for the Gaussian distribution
+     @param double sigma: the sigma parameter for the Gaussian distribution
+     @return returns void
+     */
+    void getRandomNumbersGauss(double *values,UINT N,double mu=0.0,double sigma=1.0);
+
     /**
 	Gets an N-dimensional vector of random doubles drawn from the uniform distribution set by the minRange and maxRange.
 	
@@ -233,9 +320,7 @@ public:
 	*/
     VectorDouble getRandomVectorUniform(UINT numDimensions,double minRange=0.0,double maxRange=1.0){
         VectorDouble randomValues(numDimensions);
-        for(UINT i=0; i<numDimensions; i++){
-            randomValues[i] = getRandomNumberUniform(minRange,maxRange);
-        }
+        if( numDimensions > 0 ) getRandomNumbersUniform(&randomValues[0],numDimensions,minRange,maxRange);
         return randomValues;
     }
     
@@ -249,27 +334,74 @@ public:
 	*/
     VectorDouble getRandomVectorGauss(UINT numDimensions,double mu=0.0,double sigma=1.0){
         VectorDouble randomValues(numDimensions);
-        for(UINT i=0; i<numDimensions; i++){
-            randomValues[i] = getRandomNumberGauss(mu,sigma);
-        }
+        if( numDimensions > 0 ) getRandomNumbersGauss(&randomValues[0],numDimensions,mu,sigma);
         return randomValues;
     }
     
 private:
+    static const unsigned int PHILOX_M0 = 0xD2511F53U;
+    static const unsigned int PHILOX_M1 = 0xCD9E8D57U;
+    static const unsigned int PHILOX_W0 = 0x9E3779B9U;
+    static const unsigned int PHILOX_W1 = 0xBB67AE85U;
+
+    //Computes the 4 words of block n of the stream, each block holds two 64 bit random numbers
+    static inline void philox(const unsigned long long seed,const unsigned long long stream,const unsigned long long n,unsigned int x[4]){
+        unsigned int k0 = (unsigned int)seed;
+        unsigned int k1 = (unsigned int)(seed >> 32);
+        x[0] = (unsigned int)n;
+        x[1] = (unsigned int)(n >> 32);
+        x[2] = (unsigned int)stream;
+        x[3] = (unsigned int)(stream >> 32);
+        for(unsigned int r=0; r<10; r++){
+            const unsigned long long p0 = (unsigned long long)PHILOX_M0 * x[0];
+            const unsigned long long p1 = (unsigned long long)PHILOX_M1 * x[2];
+            const unsigned int y0 = (unsigned int)(p1 >> 32) ^ x[1] ^ k0;
+            const unsigned int y2 = (unsigned int)(p0 >> 32) ^ x[3] ^ k1;
+            x[0] = y0;
+            x[1] = (unsigned int)p1;
+            x[2] = y2;
+            x[3] = (unsigned int)p0;
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+    }
+
+    //The splitmix64 finalizer, used to derive the seeds and streams
+    static inline unsigned long long mix(unsigned long long z){
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    static inline double toDouble(const unsigned long long x){ return (x >> 11) * (1.0/9007199254740992.0); }
+
+    static inline void boxMuller(const double u1,const double u2,double &z0,double &z1){
+        const double r = sqrt( -2.0*log(1.0-u1) );
+        const double theta = TWO_PI*u2;
+        z0 = r*cos(theta);
+        z1 = r*sin(theta);
+    }
+
     inline unsigned long long int64() {
-        u = u * 2862933555777941757LL + 7046029254386353087LL;
-        v ^= v >> 17; v ^= v << 31; v ^= v >> 8;
-        w = 4294957665U*(w & 0xffffffff) + (w >> 32);
-        unsigned long long x = u ^ (u << 21); x ^= x >> 35; x ^= x << 4;
-        return (x + v) ^ w;
+        if( bufferIndex == 2 ){
+            unsigned int x[4];
+            philox(seed,stream,blockIndex++,x);
+            buffer[0] = ((unsigned long long)x[1] << 32) | x[0];
+            buffer[1] = ((unsigned long long)x[3] << 32) | x[2];
+            bufferIndex = 0;
+        }
+        return buffer[ bufferIndex++ ];
     }
-    inline double doub() { return 5.42101086242752217E-20 * int64(); }
-    inline unsigned int int32() { return (unsigned int)int64(); } 
+    inline double doub() { return toDouble( int64() ); }
+    inline unsigned int int32() { return (unsigned int)(int64() >> 32); } 
     
-    unsigned long long u;
-    unsigned long long v;
-    unsigned long long w;
-    double storedval;               //This is for the Gauss Box-Muller 
+    unsigned long long seed;
+    unsigned long long stream;
+    unsigned long long blockIndex;  //The index of the next block of the stream
+    unsigned long long buffer[2];   //The random numbers of the current block
+    unsigned int bufferIndex;       //The next random number in the buffer, 2 if the buffer is empty
+    bool hasStoredGauss;            //This is for the Gauss Box-Muller
+    double storedGauss;
 };
 
 }; //End of namespace GRT
@@ -0,0 +1,209 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The SPSCQueue class is a bounded, lock-free FIFO queue that passes values from one producer thread to one
+ consumer thread.
+
+ The values are stored in a ring buffer that is allocated once by resize, so push and pop never allocate memory or take
+ a lock. Only the producer may call push and only the consumer may call pop and popLatest. The consumer swaps each value
+ out of its slot, so a value that owns memory (such as a VectorDouble) hands its old buffer back to the producer to
+ reuse.
+
+ popLatest implements a drop-oldest policy for consumers that only care about the newest value (for example a
+ classifier that falls behind the sensor): it takes every value that is waiting and keeps the newest one.
+
+ The indexes are std::atomic when C++11 is available. Otherwise they are volatile and are ordered with a full memory
+ barrier on GCC and Clang, and by the acquire/release semantics MSVC gives to volatile.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_SPSC_QUEUE_HEADER
+#define GRT_SPSC_QUEUE_HEADER
+
+#include "GRTCommon.h"
+
+#ifdef GRT_CXX11_ENABLED
+    #include <atomic>
+#endif
+
+namespace GRT{
+
+template< class T >
+class SPSCQueue{
+public:
+    /**
+     Constructor, allocates a queue that can hold capacity values.
+
+     @param const UINT capacity: the maximum number of values the queue can hold. Default capacity = 0
+     */
+    SPSCQueue(const UINT capacity = 0){
+        store( head, 0 );
+        store( tail, 0 );
+        resize( capacity );
+    }
+
+    /**
+     Default Destructor.
+     */
+    ~SPSCQueue(){}
+
+    /**
+     Sets the capacity of the queue and removes all the values. This is not thread safe, it must be called before the
+     producer and the consumer start.
+
+     @param const UINT capacity: the maximum number of values the queue can hold
+     @return returns true if the queue was resized
+     */
+    bool resize(const UINT capacity){
+        //One slot is always left empty, so a full queue can be told apart from an empty one
+        buffer.clear();
+        buffer.resize( capacity+1 );
+        store( head, 0 );
+        store( tail, 0 );
+        return true;
+    }
+
+    /**
+     Adds a value to the back of the queue. This must only be called by the producer.
+
+     @param const T &value: the value to add
+     @return returns true if the value was added, false if the queue is full
+     */
+    bool push(const T &value){
+        const UINT writeIndex = load( tail );
+        const UINT nextIndex = increment( writeIndex );
+        if( nextIndex == acquire( head ) ) return false;
+        buffer[ writeIndex ] = value;
+        release( tail, nextIndex );
+        return true;
+    }
+
+    /**
+     Takes the value at the front of the queue. This must only be called by the consumer.
+
+     @param T &value: returns the value, the value that was passed in is swapped into the queue's slot
+     @return returns true if a value was taken, false if the queue is empty
+     */
+    bool pop(T &value){
+        const UINT readIndex = load( head );
+        if( readIndex == acquire( tail ) ) return false;
+        std::swap( value, buffer[ readIndex ] );
+        release( head, increment( readIndex ) );
+        return true;
+    }
+
+    /**
+     Takes every value that is in the queue and keeps the newest one, the older values are dropped. This must only be
+     called by the consumer.
+
+     @param T &value: returns the newest value
+     @return returns the number of values that were taken, 0 if the queue was empty (in which case value is not changed)
+     */
+    UINT popLatest(T &value){
+        UINT numValues = 0;
+        while( pop( value ) ) numValues++;
+        return numValues;
+    }
+
+    /**
+     @return returns the number of values in the queue, this is only a snapshot if the other thread is running
+     */
+    UINT getNumValues() const{
+        const UINT size = (UINT)buffer.size();
+        return size == 0 ? 0 : (acquire( tail ) + size - acquire( head )) % size;
+    }
+
+    /**
+     @return returns the maximum number of values the queue can hold
+     */
+    UINT getCapacity() const{ return buffer.size() > 0 ? (UINT)buffer.size()-1 : 0; }
+
+    bool getIsEmpty() const{ return acquire( head ) == acquire( tail ); }
+
+protected:
+#ifdef GRT_CXX11_ENABLED
+    typedef std::atomic< UINT > Index;
+#else
+    typedef volatile UINT Index;
+#endif
+
+    UINT increment(const UINT index) const{
+        return index+1 == buffer.size() ? 0 : index+1;
+    }
+
+    //Reads an index that only this thread writes
+    static inline UINT load(const Index &index){
+#ifdef GRT_CXX11_ENABLED
+        return index.load( std::memory_order_relaxed );
+#else
+        return index;
+#endif
+    }
+
+    static inline void store(Index &index,const UINT value){
+#ifdef GRT_CXX11_ENABLED
+        index.store( value, std::memory_order_relaxed );
+#else
+        index = value;
+#endif
+    }
+
+    //Reads an index written by the other thread, the slots it published are visible after this
+    static inline UINT acquire(const Index &index){
+#ifdef GRT_CXX11_ENABLED
+        return index.load( std::memory_order_acquire );
+#else
+        const UINT value = index;
+    #if defined(__GNUC__)
+        __sync_synchronize();
+    #endif
+        return value;
+#endif
+    }
+
+    //Publishes an index to the other thread, the slots written before this are visible to it
+    static inline void release(Index &index,const UINT value){
+#ifdef GRT_CXX11_ENABLED
+        index.store( value, std::memory_order_release );
+#else
+    #if defined(__GNUC__)
+        __sync_synchronize();
+    #endif
+        index = value;
+#endif
+    }
+
+    std::vector< T > buffer;
+    Index head;                     ///< The slot the consumer reads next, only written by the consumer
+    char padding[64];               ///< Keeps head and tail on different cache lines
+    Index tail;                     ///< The slot the producer writes next, only written by the producer
+
+private:
+    SPSCQueue(const SPSCQueue &rhs);
+    SPSCQueue& operator=(const SPSCQueue &rhs);
+};
+
+}//End of namespace GRT
+
+#endif //GRT_SPSC_QUEUE_HEADER
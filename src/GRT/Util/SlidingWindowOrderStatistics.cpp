@@ -0,0 +1,217 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "SlidingWindowOrderStatistics.h"
+
+namespace GRT{
+
+//The index used to mark the end of a list
+#define GRT_SKIPLIST_NIL 0xFFFFFFFF
+
+SlidingWindowOrderStatistics::SlidingWindowOrderStatistics(UINT windowSize){
+    this->windowSize = 0;
+    numValues = 0;
+    writeIndex = 0;
+    numLevels = 0;
+    head = 0;
+    randomState = 0;
+    if( windowSize > 0 ) init( windowSize );
+}
+
+SlidingWindowOrderStatistics::~SlidingWindowOrderStatistics(){
+
+}
+
+bool SlidingWindowOrderStatistics::init(UINT windowSize){
+
+    if( windowSize == 0 ) return false;
+
+    this->windowSize = windowSize;
+
+    //Use enough levels so that the top level is expected to skip over most of the window
+    numLevels = 1;
+    while( numLevels < 32 && (1u << (numLevels-1)) < windowSize ) numLevels++;
+
+    //The last node is the head of the list
+    head = windowSize;
+    values.resize( windowSize+1 );
+    nodeLevels.resize( windowSize+1 );
+    links.resize( numLevels*(windowSize+1) );
+    widths.resize( numLevels*(windowSize+1) );
+    chain.resize( numLevels );
+    chainPositions.resize( numLevels );
+
+    return clear();
+}
+
+bool SlidingWindowOrderStatistics::clear(){
+
+    if( windowSize == 0 ) return false;
+
+    numValues = 0;
+    writeIndex = 0;
+    randomState = 2463534242u;
+
+    std::fill(values.begin(),values.end(),0);
+    nodeLevels[head] = numLevels;
+    for(UINT l=0; l<numLevels; l++){
+        next(l,head) = GRT_SKIPLIST_NIL;
+        width(l,head) = 1;
+    }
+
+    return true;
+}
+
+bool SlidingWindowOrderStatistics::push(const double x){
+
+    if( windowSize == 0 ) return false;
+
+    //The nodes are used as a ring buffer, so if the window is full then the node at the write index holds the oldest value
+    if( numValues == windowSize ){
+        removeNode( writeIndex );
+    }
+
+    values[ writeIndex ] = x;
+    insertNode( writeIndex );
+
+    if( ++writeIndex == windowSize ) writeIndex = 0;
+
+    return true;
+}
+
+double SlidingWindowOrderStatistics::getValueAtRank(const UINT rank) const{
+
+    if( rank >= numValues ) return 0;
+
+    //The head is at position 0, so the value with rank r is at position r+1
+    const UINT target = rank+1;
+    UINT node = head;
+    UINT position = 0;
+    for(UINT i=numLevels; i>0; i--){
+        const UINT l = i-1;
+        while( next(l,node) != GRT_SKIPLIST_NIL && position + width(l,node) <= target ){
+            position += width(l,node);
+            node = next(l,node);
+        }
+    }
+
+    return values[ node ];
+}
+
+double SlidingWindowOrderStatistics::getMedian() const{
+    return getValueAtRank( numValues/2 );
+}
+
+double SlidingWindowOrderStatistics::getPercentile(const double percentile) const{
+    if( numValues == 0 ) return 0;
+    double p = percentile < 0 ? 0 : (percentile > 100 ? 100 : percentile);
+    return getValueAtRank( (UINT)floor( p/100.0 * (numValues-1) + 0.5 ) );
+}
+
+double SlidingWindowOrderStatistics::getMinimum() const{
+    if( numValues == 0 ) return 0;
+    return values[ next(0,head) ];
+}
+
+double SlidingWindowOrderStatistics::getMaximum() const{
+    if( numValues == 0 ) return 0;
+    return getValueAtRank( numValues-1 );
+}
+
+void SlidingWindowOrderStatistics::insertNode(const UINT node){
+
+    //Find the last node before the new node at each level, and the position of that node in the list
+    UINT x = head;
+    UINT position = 0;
+    for(UINT i=numLevels; i>0; i--){
+        const UINT l = i-1;
+        while( next(l,x) != GRT_SKIPLIST_NIL && nodeLessThan(next(l,x),node) ){
+            position += width(l,x);
+            x = next(l,x);
+        }
+        chain[l] = x;
+        chainPositions[l] = position;
+    }
+
+    //Link the new node into the lower levels, the new node will be at position+1
+    const UINT level = getRandomLevel();
+    nodeLevels[node] = level;
+    for(UINT l=0; l<level; l++){
+        const UINT prev = chain[l];
+        const UINT stepsFromPrev = position - chainPositions[l];
+        next(l,node) = next(l,prev);
+        next(l,prev) = node;
+        width(l,node) = width(l,prev) - stepsFromPrev;
+        width(l,prev) = stepsFromPrev + 1;
+    }
+
+    //The links that pass over the new node now skip one more value
+    for(UINT l=level; l<numLevels; l++){
+        width(l,chain[l])++;
+    }
+
+    numValues++;
+}
+
+void SlidingWindowOrderStatistics::removeNode(const UINT node){
+
+    //Find the last node before the node at each level
+    UINT x = head;
+    for(UINT i=numLevels; i>0; i--){
+        const UINT l = i-1;
+        while( next(l,x) != GRT_SKIPLIST_NIL && next(l,x) != node && nodeLessThan(next(l,x),node) ){
+            x = next(l,x);
+        }
+        chain[l] = x;
+    }
+
+    //Unlink the node
+    const UINT level = nodeLevels[node];
+    for(UINT l=0; l<level; l++){
+        const UINT prev = chain[l];
+        width(l,prev) += width(l,node) - 1;
+        next(l,prev) = next(l,node);
+    }
+
+    //The links that passed over the node now skip one less value
+    for(UINT l=level; l<numLevels; l++){
+        width(l,chain[l])--;
+    }
+
+    numValues--;
+}
+
+UINT SlidingWindowOrderStatistics::getRandomLevel(){
+
+    //Xorshift generator, the level of each node only affects the speed of the list so a fixed seed keeps the filter deterministic
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+
+    UINT level = 1;
+    UINT bits = randomState;
+    while( level < numLevels && (bits & 1) ){
+        level++;
+        bits >>= 1;
+    }
+    return level;
+}
+
+}//End of namespace GRT
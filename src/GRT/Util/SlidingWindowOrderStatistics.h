@@ -0,0 +1,146 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The SlidingWindowOrderStatistics class keeps the values of a fixed-length sliding window in sorted order, so
+ that the median, any percentile, the minimum or the maximum of the window can be found without sorting the window.
+
+ The values are stored in an indexable skiplist. Adding a new value (and removing the oldest value once the window
+ is full) and finding the value at any rank both take O(log N) expected time, where N is the size of the window. All
+ the memory is allocated when the window is initialized, so pushing new values does not allocate any memory.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_SLIDING_WINDOW_ORDER_STATISTICS_HEADER
+#define GRT_SLIDING_WINDOW_ORDER_STATISTICS_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+class SlidingWindowOrderStatistics{
+public:
+    /**
+     Default Constructor. If the windowSize is greater than zero then the window will be initialized.
+
+     @param UINT windowSize: the maximum number of values in the window
+     */
+    SlidingWindowOrderStatistics(UINT windowSize = 0);
+
+    /**
+     Default Destructor
+     */
+    ~SlidingWindowOrderStatistics();
+
+    /**
+     Initializes the window, removing any values that were in the window.
+
+     @param UINT windowSize: the maximum number of values in the window, must be greater than zero
+     @return returns true if the window was initialized, false otherwise
+     */
+    bool init(UINT windowSize);
+
+    /**
+     Removes all the values from the window, without changing the window size.
+
+     @return returns true if the window was cleared, false otherwise
+     */
+    bool clear();
+
+    /**
+     Adds a new value to the window. If the window is full then the oldest value will be removed from the window.
+
+     @param const double x: the new value
+     @return returns true if the value was added, false otherwise
+     */
+    bool push(const double x);
+
+    /**
+     Gets the value at the specific rank in the window, where rank 0 is the smallest value.
+
+     @param const UINT rank: the rank of the value, must be less than the number of values in the window
+     @return returns the value at the rank, or zero if the rank is invalid
+     */
+    double getValueAtRank(const UINT rank) const;
+
+    /**
+     Gets the median of the window. If the window contains an even number of values then the upper median is returned.
+
+     @return returns the median of the window, or zero if the window is empty
+     */
+    double getMedian() const;
+
+    /**
+     Gets the percentile of the window using the nearest rank, so percentile 0 is the minimum, percentile 100 is the
+     maximum and percentile 50 is the same as getMedian().
+
+     @param const double percentile: the percentile, must be in the range [0 100]
+     @return returns the percentile of the window, or zero if the window is empty
+     */
+    double getPercentile(const double percentile) const;
+
+    double getMinimum() const;
+    double getMaximum() const;
+
+    UINT getWindowSize() const { return windowSize; }
+    UINT getNumValuesInWindow() const { return numValues; }
+    bool getWindowFilled() const { return windowSize > 0 && numValues == windowSize; }
+
+protected:
+    //Strict ordering of the nodes by value, equal values are ordered by their node index and NaN values sort last
+    inline bool nodeLessThan(const UINT a,const UINT b) const{
+        const double va = values[a];
+        const double vb = values[b];
+        if( va < vb ) return true;
+        if( vb < va ) return false;
+        const bool aIsNaN = va != va;
+        const bool bIsNaN = vb != vb;
+        if( aIsNaN != bIsNaN ) return bIsNaN;
+        return a < b;
+    }
+    inline UINT &next(const UINT level,const UINT node){ return links[ level*(windowSize+1) + node ]; }
+    inline UINT next(const UINT level,const UINT node) const{ return links[ level*(windowSize+1) + node ]; }
+    inline UINT &width(const UINT level,const UINT node){ return widths[ level*(windowSize+1) + node ]; }
+    inline UINT width(const UINT level,const UINT node) const{ return widths[ level*(windowSize+1) + node ]; }
+
+    void insertNode(const UINT node);
+    void removeNode(const UINT node);
+    UINT getRandomLevel();
+
+    UINT windowSize;                            ///< The maximum number of values in the window
+    UINT numValues;                             ///< The current number of values in the window
+    UINT writeIndex;                            ///< The node that will be used for the next value
+    UINT numLevels;                             ///< The number of levels in the skiplist
+    UINT head;                                  ///< The index of the head node, this is windowSize
+    UINT randomState;                           ///< The state of the generator used to pick the node levels
+    vector< double > values;                    ///< The value of each node, the node index is the position of the value in the window's ring buffer
+    vector< UINT > nodeLevels;                  ///< The number of levels of each node
+    vector< UINT > links;                       ///< The next node at each level, stored as [level][node]
+    vector< UINT > widths;                      ///< The number of values skipped by each link, stored as [level][node]
+    vector< UINT > chain;                       ///< Workspace for the search path
+    vector< UINT > chainPositions;              ///< Workspace for the positions of the search path
+};
+
+}//End of namespace GRT
+
+#endif //GRT_SLIDING_WINDOW_ORDER_STATISTICS_HEADER
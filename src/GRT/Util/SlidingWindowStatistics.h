@@ -0,0 +1,159 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The SlidingWindowStatistics class maintains the mean and the sum of squared deviations of a number of
+ fixed-length windows, without having to rescan the windows each time they change. Each window is updated in O(1)
+ by replacing its oldest value with its newest value, using a sliding version of Welford's algorithm.
+
+ Small rounding errors can slowly accumulate over many updates, so the class counts the number of updates since
+ each accumulator was last rebuilt from its raw data and flags when it should be re-anchored. Re-anchoring once per
+ window length keeps the amortized cost of each update independent of the window length.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_SLIDING_WINDOW_STATISTICS_HEADER
+#define GRT_SLIDING_WINDOW_STATISTICS_HEADER
+
+#include <vector>
+#include <cmath>
+
+namespace GRT{
+
+class SlidingWindowStatistics{
+public:
+    /**
+     Default Constructor
+     */
+    SlidingWindowStatistics(){
+        windowSize = 0;
+        reanchorInterval = 0;
+        updateCounter = 0;
+    }
+
+    /**
+     Default Destructor
+     */
+    ~SlidingWindowStatistics(){}
+
+    /**
+     Initializes the accumulators. Each window is assumed to initially contain windowSize values of zero, which matches
+     the way the GRT CircularBuffer is filled when it is resized.
+
+     @param const unsigned int numAccumulators: the number of independent windows that should be tracked
+     @param const unsigned int windowSize: the number of values in each window, must be greater than zero
+     @param const unsigned int reanchorInterval: the number of updates after which the accumulators should be rebuilt from the raw data, zero disables re-anchoring
+     @return returns true if the accumulators were initialized, false otherwise
+     */
+    bool init(const unsigned int numAccumulators,const unsigned int windowSize,const unsigned int reanchorInterval){
+        if( numAccumulators == 0 || windowSize == 0 ) return false;
+        this->windowSize = windowSize;
+        this->reanchorInterval = reanchorInterval;
+        updateCounter = 0;
+        mean.assign(numAccumulators,0);
+        m2.assign(numAccumulators,0);
+        count.assign(numAccumulators,windowSize);
+        return true;
+    }
+
+    /**
+     Replaces one value in the window with a new value. The size of the window does not change.
+
+     @param const unsigned int i: the index of the accumulator
+     @param const double oldValue: the value that is leaving the window
+     @param const double newValue: the value that is entering the window
+     */
+    inline void replace(const unsigned int i,const double oldValue,const double newValue){
+        const double delta = newValue - oldValue;
+        const double oldMean = mean[i];
+        mean[i] += delta / windowSize;
+        m2[i] += delta * ( (newValue - mean[i]) + (oldValue - oldMean) );
+        if( m2[i] < 0 ) m2[i] = 0;
+    }
+
+    /**
+     Clears an accumulator so that it can be rebuilt from the raw data using add(...).
+
+     @param const unsigned int i: the index of the accumulator
+     */
+    inline void clearAccumulator(const unsigned int i){
+        mean[i] = 0;
+        m2[i] = 0;
+        count[i] = 0;
+    }
+
+    /**
+     Adds a value to an accumulator that is being rebuilt, using the standard Welford update.
+
+     @param const unsigned int i: the index of the accumulator
+     @param const double x: the value to add
+     */
+    inline void add(const unsigned int i,const double x){
+        const double delta = x - mean[i];
+        mean[i] += delta / ++count[i];
+        m2[i] += delta * (x - mean[i]);
+    }
+
+    /**
+     Should be called once after each set of updates, this increments the counter that is used to trigger the re-anchoring.
+
+     @return returns true if the accumulators should now be rebuilt from the raw data, false otherwise
+     */
+    inline bool tick(){
+        if( reanchorInterval == 0 ) return false;
+        if( ++updateCounter >= reanchorInterval ){
+            updateCounter = 0;
+            return true;
+        }
+        return false;
+    }
+
+    inline unsigned int getNumAccumulators() const { return (unsigned int)mean.size(); }
+    inline unsigned int getWindowSize() const { return windowSize; }
+    inline double getMean(const unsigned int i) const { return mean[i]; }
+
+    /**
+     Gets the sum of the squared deviations from the mean of the window.
+     */
+    inline double getSumSquaredDeviations(const unsigned int i) const { return m2[i]; }
+
+    /**
+     Gets the sum of the squared values in the window, with the values offset by the constant c, i.e. sum (x-c)^2.
+     */
+    inline double getSumOfSquares(const unsigned int i,const double c = 0) const {
+        const double d = mean[i] - c;
+        return m2[i] + windowSize * d * d;
+    }
+
+protected:
+    unsigned int windowSize;
+    unsigned int reanchorInterval;
+    unsigned int updateCounter;
+    std::vector< double > mean;
+    std::vector< double > m2;
+    std::vector< unsigned int > count;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_SLIDING_WINDOW_STATISTICS_HEADER
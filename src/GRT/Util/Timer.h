@@ -31,10 +31,12 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #if defined(__GRT_OSX_BUILD__)
     #include <sys/time.h>
+    #include <mach/mach_time.h>
 #endif
 
 #if defined(__GRT_LINUX_BUILD__)
     #include <sys/time.h>
+    #include <time.h>
 #endif
 
 namespace GRT{
@@ -180,6 +182,34 @@ public:
 #endif
         return 0;
     }
+    
+    /**
+    Gets the time from a monotonic, high resolution clock. Unlike getSystemTime(), this clock is not affected by changes
+    to the system time, so it should be used to measure short intervals such as the time spent in each pipeline module.
+    The value is only meaningful relative to other values from this function.
+    
+    @return returns the current monotonic time in nanoseconds
+    */
+    static unsigned long long getHighResolutionTime(){
+#ifdef __GRT_OSX_BUILD__
+        static mach_timebase_info_data_t timebase = {0,0};
+        if( timebase.denom == 0 ) mach_timebase_info( &timebase );
+        return (unsigned long long)( mach_absolute_time() * ( (double)timebase.numer / timebase.denom ) );
+#endif
+#ifdef __GRT_WINDOWS_BUILD__
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER counter;
+        QueryPerformanceFrequency( &frequency );
+        QueryPerformanceCounter( &counter );
+        return (unsigned long long)( counter.QuadPart * ( 1.0e9 / frequency.QuadPart ) );
+#endif
+#ifdef __GRT_LINUX_BUILD__
+        struct timespec now;
+        clock_gettime( CLOCK_MONOTONIC, &now );
+        return (unsigned long long)now.tv_sec*1000000000ull + (unsigned long long)now.tv_nsec;
+#endif
+        return 0;
+    }
 
 protected:
     unsigned long startTime;
@@ -0,0 +1,195 @@
+#include "ImageCache.h"
+
+//--------------------------------------------------------------
+ImageDecoder::ImageDecoder(ImageCache *cache){
+    this->cache = cache;
+}
+
+//--------------------------------------------------------------
+void ImageDecoder::threadedFunction(){
+    while(isThreadRunning()) {
+        if(!cache->decodeNext()) {
+            sleep(2);
+        }
+    }
+}
+
+//--------------------------------------------------------------
+ImageCache::ImageCache(){
+    capacity = DEFAULT_CAPACITY;
+}
+
+//--------------------------------------------------------------
+ImageCache::~ImageCache(){
+    close();
+}
+
+//--------------------------------------------------------------
+void ImageCache::setup(const vector<string> &paths, int capacity, int numThreads){
+    close();
+
+    this->paths = paths;
+    this->capacity = MAX(capacity, 1);
+    states.assign(paths.size(), NOT_LOADED);
+    images.assign(paths.size(), NULL);
+    lruPositions.assign(paths.size(), lru.end());
+
+    for(int i = 0; i < MAX(numThreads, 1); i++) {
+        decoders.push_back(new ImageDecoder(this));
+        decoders.back()->startThread();
+    }
+}
+
+//--------------------------------------------------------------
+void ImageCache::close(){
+    for(size_t i = 0; i < decoders.size(); i++) {
+        decoders[i]->waitForThread(true);
+        delete decoders[i];
+    }
+    decoders.clear();
+
+    for(size_t i = 0; i < decoded.size(); i++) {
+        delete decoded[i].pixels;
+    }
+    decoded.clear();
+    requests.clear();
+
+    for(size_t i = 0; i < images.size(); i++) {
+        delete images[i];
+    }
+    images.clear();
+    states.clear();
+    lru.clear();
+    lruPositions.clear();
+    paths.clear();
+}
+
+//--------------------------------------------------------------
+void ImageCache::update(){
+    deque<Decoded> ready;
+    {
+        ofScopedLock lock(mutex);
+        ready.swap(decoded);
+    }
+
+    // the textures can only be created on the main thread
+    for(size_t i = 0; i < ready.size(); i++) {
+        int index = ready[i].index;
+        if(states[index] == LOADED) {
+            // already loaded by an earlier request
+        } else if(ready[i].pixels->isAllocated()) {
+            images[index] = new ofImage;
+            images[index]->setFromPixels(*ready[i].pixels);
+            states[index] = LOADED;
+            lru.push_front(index);
+            lruPositions[index] = lru.begin();
+        } else {
+            // don't retry, the image would fail again every frame
+            ofLogError("ImageCache") << "failed to load " << paths[index];
+            states[index] = FAILED;
+        }
+        delete ready[i].pixels;
+    }
+
+    evict();
+}
+
+//--------------------------------------------------------------
+ofImage* ImageCache::get(int index){
+    if(index < 0 || index >= (int) paths.size()) {
+        return NULL;
+    }
+
+    if(states[index] == LOADED) {
+        touch(index);
+        return images[index];
+    }
+
+    if(states[index] == NOT_LOADED || states[index] == PREFETCH_QUEUED) {
+        // queue the image ahead of the prefetches, a prefetched image is moved to the front
+        // unless it is already being decoded
+        ofScopedLock lock(mutex);
+        bool queued = states[index] == NOT_LOADED;
+        for(deque<Request>::iterator it = requests.begin(); it != requests.end(); ++it) {
+            if(it->index == index) {
+                requests.erase(it);
+                queued = true;
+                break;
+            }
+        }
+        if(queued) {
+            Request request = { index, false };
+            requests.push_front(request);
+        }
+        states[index] = QUEUED;
+    }
+    return NULL;
+}
+
+//--------------------------------------------------------------
+void ImageCache::prefetch(const vector<int> &indexes){
+    ofScopedLock lock(mutex);
+
+    // drop the prefetches that have not started yet, they were for an older prediction
+    for(deque<Request>::iterator it = requests.begin(); it != requests.end(); ) {
+        if(it->prefetch) {
+            states[it->index] = NOT_LOADED;
+            it = requests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // never prefetch more than the cache can hold, or the prefetches would evict each other
+    for(size_t i = 0; i < indexes.size() && (int) i < capacity - 1; i++) {
+        int index = indexes[i];
+        if(index < 0 || index >= (int) paths.size()) {
+            continue;
+        }
+        if(states[index] == LOADED) {
+            touch(index);
+        } else if(states[index] == NOT_LOADED) {
+            Request request = { index, true };
+            requests.push_back(request);
+            states[index] = PREFETCH_QUEUED;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+bool ImageCache::decodeNext(){
+    int index;
+    {
+        ofScopedLock lock(mutex);
+        if(requests.empty()) {
+            return false;
+        }
+        index = requests.front().index;
+        requests.pop_front();
+    }
+
+    ofPixels *pixels = new ofPixels;
+    ofLoadImage(*pixels, paths[index]);
+
+    Decoded result = { index, pixels };
+    ofScopedLock lock(mutex);
+    decoded.push_back(result);
+    return true;
+}
+
+//--------------------------------------------------------------
+void ImageCache::touch(int index){
+    lru.splice(lru.begin(), lru, lruPositions[index]);
+}
+
+//--------------------------------------------------------------
+void ImageCache::evict(){
+    while((int) lru.size() > capacity) {
+        int index = lru.back();
+        lru.pop_back();
+        lruPositions[index] = lru.end();
+        delete images[index];
+        images[index] = NULL;
+        states[index] = NOT_LOADED;
+    }
+}
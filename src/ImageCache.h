@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ofMain.h"
+
+// ImageCache keeps a bounded number of decoded images in memory and loads the
+// others on demand. The PNGs are decoded into ofPixels on a pool of worker
+// threads, and update() (on the main thread) uploads the decoded pixels into
+// textures. When more than capacity images are loaded the least recently used
+// image is released, so memory stays flat however many images there are.
+//
+// get(index) returns NULL (and queues the image) if the image is not loaded
+// yet. prefetch() queues images that are likely to be needed soon at a lower
+// priority, replacing the previous prefetch list.
+
+class ImageCache;
+
+class ImageDecoder : public ofThread {
+public:
+    ImageDecoder(ImageCache *cache);
+    void threadedFunction();
+
+protected:
+    ImageCache *cache;
+};
+
+class ImageCache {
+public:
+    ImageCache();
+    ~ImageCache();
+
+    void setup(const vector<string> &paths, int capacity = DEFAULT_CAPACITY, int numThreads = DEFAULT_NUM_THREADS);
+    void close();
+
+    // call once per frame from the main thread
+    void update();
+
+    ofImage* get(int index);
+    void prefetch(const vector<int> &indexes);
+
+    int size() const { return paths.size(); }
+    int getNumLoaded() const { return lru.size(); }
+    int getCapacity() const { return capacity; }
+
+    enum { DEFAULT_CAPACITY = 16, DEFAULT_NUM_THREADS = 2 };
+
+protected:
+    friend class ImageDecoder;
+
+    enum State { NOT_LOADED = 0, QUEUED, PREFETCH_QUEUED, LOADED, FAILED };
+
+    struct Request {
+        int index;
+        bool prefetch;
+    };
+
+    struct Decoded {
+        int index;
+        ofPixels *pixels;
+    };
+
+    // called by the decoder threads
+    bool decodeNext();
+
+    void touch(int index);
+    void evict();
+
+    // not changed while the decoder threads run
+    vector<string> paths;
+    int capacity;
+
+    // only used on the main thread, an image stays QUEUED or PREFETCH_QUEUED while it is being decoded
+    vector<State> states;
+    vector<ofImage*> images;
+    list<int> lru;                          // the loaded images, most recently used first
+    vector<list<int>::iterator> lruPositions;
+
+    // shared with the decoder threads, guarded by mutex
+    ofMutex mutex;
+    deque<Request> requests;                // the requested images first, then the prefetches
+    deque<Decoded> decoded;
+
+    vector<ImageDecoder*> decoders;
+};
@@ -0,0 +1,141 @@
+#include "RecognitionThreads.h"
+
+using namespace ofxCv;
+
+// the queues only need to absorb short stalls, the consumers always want the newest value
+int queueCapacity = 4;
+
+//--------------------------------------------------------------
+TrackingThread::TrackingThread(){
+    width = 0;
+    height = 0;
+    frameNumber = 0;
+    numNotQueued = 0;
+}
+
+//--------------------------------------------------------------
+void TrackingThread::setup(int width, int height){
+    this->width = width;
+    this->height = height;
+
+    gestures.resize(queueCapacity);
+    frames.resize(queueCapacity);
+    commands.resize(16);
+
+    // the frames are drawn from a copy on the render thread, so the grabber doesn't need a texture
+    cam.setUseTexture(false);
+    cam.initGrabber(width, height);
+
+    tracker.setup();
+    tracker.setRescale(.5);
+
+    classifier.load("expressions");
+}
+
+//--------------------------------------------------------------
+void TrackingThread::threadedFunction(){
+    while(isThreadRunning()) {
+        int key;
+        while(commands.pop(key)) {
+            runCommand(key);
+        }
+
+        cam.update();
+        if(!cam.isFrameNew()) {
+            sleep(1);
+            continue;
+        }
+        frameNumber++;
+
+        bool found = tracker.update(toCv(cam));
+        if(found) {
+            classifier.classify(tracker);
+
+            // only classify the frames with a face in them
+            gestureFrame.frameNumber = frameNumber;
+            gestureFrame.gestures.resize(gestureCount);
+            for(int j = 0; j < gestureCount; j++) {
+                gestureFrame.gestures[j] = tracker.getGesture(gestureIds[j]);
+            }
+            gestureFrame.numNotQueued = numNotQueued;
+            if(!gestures.push(gestureFrame)) {
+                // the classifier is more than a full queue behind, the next frame that fits reports this one as dropped
+                numNotQueued++;
+            }
+        }
+
+        trackedFrame.frameNumber = frameNumber;
+        trackedFrame.pixels = cam.getPixelsRef();
+        trackedFrame.found = found;
+        if(found) {
+            trackedFrame.mesh = tracker.getImageMesh();
+        }
+        int n = classifier.size();
+        trackedFrame.probabilities.resize(n);
+        trackedFrame.descriptions.resize(n);
+        for(int i = 0; i < n; i++) {
+            trackedFrame.probabilities[i] = classifier.getProbability(i);
+            trackedFrame.descriptions[i] = classifier.getDescription(i);
+        }
+        trackedFrame.primaryExpression = classifier.getPrimaryExpression();
+        // the queue is only full if rendering has stalled, the frame is then lost
+        frames.push(trackedFrame);
+    }
+}
+
+//--------------------------------------------------------------
+void TrackingThread::runCommand(int key){
+    if(key == 'r') {
+        tracker.reset();
+        classifier.reset();
+    }
+    if(key == 'e') {
+        classifier.addExpression();
+    }
+    if(key == 'a') {
+        classifier.addSample(tracker);
+    }
+    if(key == 's') {
+        classifier.save("expressions");
+    }
+    if(key == 'l') {
+        classifier.load("expressions");
+    }
+}
+
+//--------------------------------------------------------------
+ClassificationThread::ClassificationThread(){
+    pipeline = NULL;
+    gestures = NULL;
+    numSkipped = 0;
+}
+
+//--------------------------------------------------------------
+void ClassificationThread::setup(GRT::GestureRecognitionPipeline *pipeline, GRT::SPSCQueue<GestureFrame> *gestures){
+    this->pipeline = pipeline;
+    this->gestures = gestures;
+    predictions.resize(queueCapacity);
+}
+
+//--------------------------------------------------------------
+void ClassificationThread::threadedFunction(){
+    while(isThreadRunning()) {
+        // drop-oldest: take every waiting frame and only classify the newest
+        GRT::UINT n = gestures->popLatest(gestureFrame);
+        if(n == 0) {
+            sleep(1);
+            continue;
+        }
+        numSkipped += n - 1;
+
+        if(pipeline->predict(gestureFrame.gestures)) {
+            prediction.frameNumber = gestureFrame.frameNumber;
+            prediction.predictedLabel = pipeline->getPredictedClassLabel();
+            prediction.likelihoods = pipeline->getClassLikelihoods();
+            prediction.labels = pipeline->getClassLabels();
+            prediction.numDropped = numSkipped + gestureFrame.numNotQueued;
+            // as above, only lost if rendering has stalled
+            predictions.push(prediction);
+        }
+    }
+}
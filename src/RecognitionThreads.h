@@ -0,0 +1,113 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxFaceTracker.h"
+#include "GRT.h"
+
+// The recognition runs on two threads so that neither the camera nor the
+// classifier holds up rendering:
+//
+// TrackingThread grabs the camera frames, runs the face tracker and the
+// expression classifier and measures the gestures of each frame. It hands the
+// gestures to the ClassificationThread and the image, mesh and expression
+// probabilities to the render thread.
+//
+// ClassificationThread runs the GRT pipeline on the newest gestures. If it falls
+// behind the camera, gesture frames are dropped, as only the newest prediction is
+// ever shown: the classification thread skips every queued frame but the newest,
+// and while the queue is full the tracking thread cannot queue new frames. Both
+// are counted in the dropped count that is shown on screen.
+//
+// The render thread takes the newest frame and prediction in every update(), so
+// their queues only fill up (and the frames that don't fit are lost) if rendering
+// stalls.
+//
+// The threads are connected by single producer, single consumer queues, so no
+// thread ever waits for a lock. The render thread takes the newest value from
+// each queue in update() and draws its own copy.
+
+extern ofxFaceTracker::Gesture gestureIds[];
+extern string gestureNames[];
+extern int gestureCount;
+
+// the gestures measured in one camera frame, for the classification thread
+struct GestureFrame {
+    GestureFrame() : frameNumber(0), numNotQueued(0) {}
+
+    unsigned long frameNumber;
+    vector<double> gestures;
+    unsigned long numNotQueued;         // the gesture frames the tracking thread has dropped so far because the queue was full
+};
+
+// what the render thread needs to draw one camera frame
+struct TrackedFrame {
+    TrackedFrame() : frameNumber(0), found(false), primaryExpression(0) {}
+
+    unsigned long frameNumber;
+    ofPixels pixels;
+    bool found;
+    ofMesh mesh;
+    vector<float> probabilities;
+    vector<string> descriptions;
+    int primaryExpression;
+};
+
+// the result of classifying one gesture frame
+struct Prediction {
+    Prediction() : frameNumber(0), predictedLabel(0), numDropped(0) {}
+
+    unsigned long frameNumber;
+    int predictedLabel;
+    GRT::VectorDouble likelihoods;
+    vector<GRT::UINT> labels;
+    unsigned long numDropped;           // the gesture frames dropped so far because the classifier fell behind
+};
+
+class TrackingThread : public ofThread {
+public:
+    TrackingThread();
+
+    // call from the main thread before startThread()
+    void setup(int width, int height);
+    void threadedFunction();
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    GRT::SPSCQueue<GestureFrame> gestures;  // to the classification thread
+    GRT::SPSCQueue<TrackedFrame> frames;    // to the render thread
+    GRT::SPSCQueue<int> commands;           // key presses from the render thread
+
+protected:
+    void runCommand(int key);
+
+    ofVideoGrabber cam;
+    ofxFaceTracker tracker;
+    ExpressionClassifier classifier;
+    int width, height;
+    unsigned long frameNumber;
+    unsigned long numNotQueued;
+
+    // reused for every frame, so copying them into the queue slots doesn't allocate once the slots have grown
+    GestureFrame gestureFrame;
+    TrackedFrame trackedFrame;
+};
+
+class ClassificationThread : public ofThread {
+public:
+    ClassificationThread();
+
+    // call from the main thread before startThread(), the pipeline must not be used by any other thread after this
+    void setup(GRT::GestureRecognitionPipeline *pipeline, GRT::SPSCQueue<GestureFrame> *gestures);
+    void threadedFunction();
+
+    GRT::SPSCQueue<Prediction> predictions; // to the render thread
+
+protected:
+    GRT::GestureRecognitionPipeline *pipeline;
+    GRT::SPSCQueue<GestureFrame> *gestures;
+    unsigned long numSkipped;           // the gesture frames that were queued but skipped for a newer one
+
+    GestureFrame gestureFrame;
+    Prediction prediction;
+};
@@ -24,6 +24,38 @@ string gestureNames[] = {
 
 int gestureCount = 8;
 
+// the number of runner-up classes whose images are prefetched after each prediction
+int prefetchCount = 4;
+
+struct GestureRecord {
+    bool valid;
+    vector<double> sample;
+    ofVec4f position;
+};
+
+// parses one JSON gesture record per task, so the records are parsed in parallel
+class GestureRecordParser : public ParallelTask {
+public:
+    GestureRecordParser(const vector<string> &paths, vector<GestureRecord> &records) : paths(paths), records(records) {}
+    
+    bool runTask(const UINT taskIndex, const UINT threadIndex){
+        ofxJSONElement result;
+        GestureRecord &record = records[taskIndex];
+        record.valid = result.open(paths[taskIndex]);
+        if (record.valid) {
+            for(int j = 0; j < gestureCount; j++) {
+                record.sample.push_back(result[gestureNames[gestureIds[j]]].asDouble());
+            }
+            record.position = ofVec4f(result["posX"].asFloat(), result["posY"].asFloat(), result["scale"].asFloat(), 0.0f);
+        }
+        return true;
+    }
+    
+protected:
+    const vector<string> &paths;
+    vector<GestureRecord> &records;
+};
+
 //--------------------------------------------------------------
 void ofApp::setup(){
     cout << "Hello World!" << endl;
@@ -31,15 +63,11 @@ void ofApp::setup(){
     drawDebug = true;
     trainedData = false;
     predictedLabel = 0;
+    drawnLabel = 0;
     GRTtrainingData.setNumDimensions(8);
     
     ofSetVerticalSync(true);
-    cam.initGrabber(640, 480);
-    
-    tracker.setup();
-    tracker.setRescale(.5);
-    
-    classifier.load("expressions");
+    tracking.setup(640, 480);
     
     // list all JSON files in "images" directory
     ofDirectory imgDir("images");
@@ -47,40 +75,32 @@ void ofApp::setup(){
     imgDir.listDir();
     
     if (imgDir.numFiles()) {
-        images.resize(imgDir.numFiles());
-        positions.resize(imgDir.numFiles());
-        
-        // create GRT data and load images for each JSON file
+        vector<string> jsonPaths(imgDir.numFiles());
+        vector<string> imgPaths(imgDir.numFiles());
         for(int i = 0; i < imgDir.numFiles(); i++){
-            
-            bool parsingSuccessful = result.open(imgDir.getPath(i));
-            
-            if (parsingSuccessful)
-            {
-                vector<double> sample;
-                for(int j = 0; j < gestureCount; j++) {
-                    sample.push_back(result[gestureNames[gestureIds[j]]].asDouble());
-                }
-                
-                // add GRT data point
-                GRTtrainingData.addSample(i+1, sample);
-                
-                // load associated image
-                ofImage* img = new ofImage;
-                string imgName = ofToDataPath("images/" + imgDir.getFile(i).getBaseName()+".png");
-                img->loadImage(imgName);
-                cout << "ofApp::setup() -- loading images [" + ofToString(i+1) + " / " + ofToString(imgDir.numFiles()) + "]" << endl;
-                images[i] = img;
-                positions[i] = ofVec4f(result["posX"].asFloat(), result["posY"].asFloat(), result["scale"].asFloat(), 0.0f);
-                
-                cout << "ofApp::setup() -- imgName = " << imgName << endl;
-            }
-            else
-            {
-                ofLogNotice("ofApp::setup")  << "Failed to parse JSON" << endl;
+            jsonPaths[i] = imgDir.getPath(i);
+            imgPaths[i] = ofToDataPath("images/" + imgDir.getFile(i).getBaseName()+".png");
+        }
+        
+        // parse the JSON files in parallel
+        vector<GestureRecord> records(jsonPaths.size());
+        GestureRecordParser parser(jsonPaths, records);
+        ParallelTaskRunner::run(parser, records.size());
+        
+        // create GRT data for each JSON file, label i+1 shows image i
+        positions.resize(records.size());
+        for(int i = 0; i < records.size(); i++){
+            if (records[i].valid) {
+                GRTtrainingData.addSample(i+1, records[i].sample);
+                positions[i] = records[i].position;
+            } else {
+                ofLogNotice("ofApp::setup")  << "Failed to parse JSON \"" << jsonPaths[i] << "\"" << endl;
             }
-            cout << "ofApp::setup() -- imgDir.getPath(i) = \"" << imgDir.getPath(i) << "\"" << endl;
         }
+        cout << "ofApp::setup() -- parsed " << records.size() << " gesture records" << endl;
+        
+        // the images are decoded in the background when they are first needed
+        images.setup(imgPaths);
         
         GRTtrainingData.save(ofToDataPath("GRTtrainingData.grt"));
         GRTpipeline.setClassifier( KNN() );
@@ -90,32 +110,29 @@ void ofApp::setup(){
             cout << "ofApp::setup() -- trained the pipeline!\n";
             trainedData = true;
             GRTpipeline.save(ofToDataPath("GRTpipeline.grt"));
+            GRTpipeline.savePipelineToBinaryFile(ofToDataPath("GRTpipeline.grtb"));
         }
     }
+    
+    // the pipeline belongs to the classification thread from here on
+    if (trainedData) {
+        classification.setup(&GRTpipeline, &tracking.gestures);
+        classification.startThread();
+    }
+    tracking.startThread();
 }
 
 //--------------------------------------------------------------
 void ofApp::update(){
-    cam.update();
-    if(cam.isFrameNew()) {
-        if(tracker.update(toCv(cam))) {
-            classifier.classify(tracker);
-        }		
-    }
+    images.update();
     
-    // predict label
-    if (trainedData) {
-        vector<double> sample;
-
-        for(int j = 0; j < gestureCount; j++) {
-            sample.push_back(tracker.getGesture(gestureIds[j]));
-        }
-
-        if(GRTpipeline.predict(sample)) {
-            predictedLabel = GRTpipeline.getPredictedClassLabel();
-        }
-        cout << "ofApp::update() -- sample = " << ofToString(sample) << endl;
-        cout << "ofApp::update() -- predictedLabel = " << predictedLabel << endl;
+    // take the newest results, the older ones were never drawn
+    if (tracking.frames.popLatest(latestFrame)) {
+        camImage.setFromPixels(latestFrame.pixels);
+    }
+    if (classification.predictions.popLatest(latestPrediction)) {
+        predictedLabel = latestPrediction.predictedLabel;
+        prefetchLikelyImages(latestPrediction);
     }
 }
 
@@ -123,17 +140,27 @@ void ofApp::update(){
 void ofApp::draw(){
     ofBackground(0);
     ofSetColor(255);
-    float camScale = ofGetWidth() / cam.getWidth();
-    cam.draw(0, 0, cam.getWidth()*camScale, cam.getHeight()*camScale);
+    float camScale = ofGetWidth() / (float) tracking.getWidth();
+    if (camImage.isAllocated()) {
+        camImage.draw(0, 0, tracking.getWidth()*camScale, tracking.getHeight()*camScale);
+    }
     
     if (trainedData && predictedLabel && drawInteractive) {
-        // draw predicted image
-        float scale = positions[predictedLabel-1].z * 1.125;
-        int x = (ofGetWidth()  - images[predictedLabel-1]->getWidth()*scale)  / 2;
-        int y = (ofGetHeight() - images[predictedLabel-1]->getHeight()*scale) / 2;
-        int w = images[predictedLabel-1]->getWidth() * scale;
-        int h = images[predictedLabel-1]->getHeight() * scale;
-        images[predictedLabel-1]->draw(x, y, w, h);
+        // draw predicted image, keep drawing the previous one until it has been loaded
+        ofImage* img = images.get(predictedLabel-1);
+        if (img) {
+            drawnLabel = predictedLabel;
+        } else {
+            img = images.get(drawnLabel-1);
+        }
+        if (img) {
+            float scale = positions[drawnLabel-1].z * 1.125;
+            int x = (ofGetWidth()  - img->getWidth()*scale)  / 2;
+            int y = (ofGetHeight() - img->getHeight()*scale) / 2;
+            int w = img->getWidth() * scale;
+            int h = img->getHeight() * scale;
+            img->draw(x, y, w, h);
+        }
     }
     
     ofPushMatrix();
@@ -141,27 +168,33 @@ void ofApp::draw(){
     
     ofScale(camScale, camScale);
 
-    if (drawSmallDebug) cam.draw(0, 0);
-    if (drawDebug) tracker.draw();
+    if (drawSmallDebug && camImage.isAllocated()) camImage.draw(0, 0);
+    if (drawDebug && latestFrame.found) latestFrame.mesh.drawWireframe();
     ofPopMatrix();
     
     int w = 100, h = 12;
     ofPushStyle();
     ofPushMatrix();
     ofTranslate(5, 10);
-    int n = classifier.size();
-    int primary = classifier.getPrimaryExpression();
+    int n = latestFrame.probabilities.size();
+    int primary = latestFrame.primaryExpression;
     for(int i = 0; i < n; i++){
         ofSetColor(i == primary ? ofColor::red : ofColor::black);
-        ofRect(0, 0, w * classifier.getProbability(i) + .5, h);
+        ofRect(0, 0, w * latestFrame.probabilities[i] + .5, h);
         ofSetColor(255);
-        ofDrawBitmapString(classifier.getDescription(i), 5, 9);
+        ofDrawBitmapString(latestFrame.descriptions[i], 5, 9);
         ofTranslate(0, h + 5);
     }
     ofPopMatrix();
     ofPopStyle();
     
     ofDrawBitmapString(ofToString((int) ofGetFrameRate()), ofGetWidth() - 20, ofGetHeight() - 10);
+    if (trainedData) {
+        // how far recognition trails the camera, and how many frames the classifier skipped to keep up
+        ofDrawBitmapString("prediction lag " + ofToString((long) (latestFrame.frameNumber - latestPrediction.frameNumber)) +
+                           " frames, dropped " + ofToString(latestPrediction.numDropped),
+                           ofGetWidth() - 300, ofGetHeight() - 24);
+    }
     drawHighlightString(
                         string() +
                         "r - reset\n" +
@@ -172,26 +205,42 @@ void ofApp::draw(){
                         14, ofGetHeight() - 7 * 12);
 }
 
+//--------------------------------------------------------------
+void ofApp::exit(){
+    classification.waitForThread(true);
+    tracking.waitForThread(true);
+    images.close();
+}
+
+//--------------------------------------------------------------
+void ofApp::prefetchLikelyImages(const Prediction &prediction){
+    // the runner-up classes of the last prediction are the most likely to be predicted next
+    const VectorDouble &likelihoods = prediction.likelihoods;
+    const vector<UINT> &labels = prediction.labels;
+    
+    vector<IndexedDouble> ranked;
+    for(int i = 0; i < likelihoods.size() && i < labels.size(); i++) {
+        if (likelihoods[i] > 0 && labels[i] != predictedLabel) {
+            ranked.push_back(IndexedDouble(labels[i], likelihoods[i]));
+        }
+    }
+    sort(ranked.begin(), ranked.end(), IndexedDouble::sortIndexedDoubleByValueDescending);
+    
+    vector<int> indexes;
+    for(int i = 0; i < ranked.size() && i < prefetchCount; i++) {
+        indexes.push_back(ranked[i].index - 1);
+    }
+    images.prefetch(indexes);
+}
+
 //--------------------------------------------------------------
 void ofApp::keyPressed(int key){
     if(key == 'f' || key == 'F'){
         ofToggleFullscreen();
     }
-    if(key == 'r') {
-        tracker.reset();
-        classifier.reset();
-    }
-    if(key == 'e') {
-        classifier.addExpression();
-    }
-    if(key == 'a') {
-        classifier.addSample(tracker);
-    }
-    if(key == 's') {
-        classifier.save("expressions");
-    }
-    if(key == 'l') {
-        classifier.load("expressions");
+    if(key == 'r' || key == 'e' || key == 'a' || key == 's' || key == 'l') {
+        // the tracker and the expression classifier belong to the tracking thread
+        tracking.commands.push(key);
     }
     
     if(key == 'i') {
@@ -4,6 +4,8 @@
 #include "ofxFaceTracker.h"
 #include "GRT.h"
 #include "ofxJSON.h"
+#include "ImageCache.h"
+#include "RecognitionThreads.h"
 
 using namespace ofxCv;
 using namespace cv;
@@ -15,6 +17,7 @@ public:
     void setup();
     void update();
     void draw();
+    void exit();
 
     void keyPressed(int key);
     void keyReleased(int key);
@@ -26,13 +29,15 @@ public:
     void dragEvent(ofDragInfo dragInfo);
     void gotMessage(ofMessage msg);
     
-    ofVideoGrabber cam;
-    ofxFaceTracker tracker;
-    ExpressionClassifier classifier;
-
-    ofxJSONElement result;
+    TrackingThread tracking;
+    ClassificationThread classification;
+    
+    // the newest results of the recognition threads, only used on the render thread
+    TrackedFrame latestFrame;
+    Prediction latestPrediction;
+    ofImage camImage;
 
-    vector<ofImage*> images;
+    ImageCache images;
     vector<ofVec4f> positions;
     
     GestureRecognitionPipeline GRTpipeline;
@@ -40,5 +45,7 @@ public:
     bool    trainedData;
     bool drawInteractive, drawDebug, drawSmallDebug;
     int    predictedLabel;
+    int    drawnLabel;
     
+    void prefetchLikelyImages(const Prediction &prediction);
 };